@@ -31,7 +31,7 @@
 
 #define GRAPHICS_OPTIONS_TITLE "Advanced Graphics Options"
 #define GRAPHICS_OPTIONS_WIDTH 266
-#define GRAPHICS_OPTIONS_HEIGHT 486
+#define GRAPHICS_OPTIONS_HEIGHT 526
 #define GRAPHICS_OPTIONS_CANCEL_EVENTID 1000
 #define GRAPHICS_OPTIONS_OK_EVENTID 1001
 #define GRAPHICS_OPTIONS_HELP_LINK "http://www.tibia.com/gameguides/?subtopic=manual&section=options"
@@ -66,6 +66,11 @@
 #define GRAPHICS_OPTIONS_SCROLLBAR_FPS_W 230
 #define GRAPHICS_OPTIONS_SCROLLBAR_FPS_H 12
 #define GRAPHICS_OPTIONS_SCROLLBAR_FPS_EVENTID 1008
+#define GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_X 18
+#define GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_Y 453
+#define GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_W 230
+#define GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_H 12
+#define GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_EVENTID 1014
 #define GRAPHICS_OPTIONS_CHECKBOX_SHARPEN_TITLE "Game-Screen Sharpening"
 #define GRAPHICS_OPTIONS_CHECKBOX_SHARPEN_X 18
 #define GRAPHICS_OPTIONS_CHECKBOX_SHARPEN_Y 335
@@ -96,14 +101,46 @@
 #define GRAPHICS_OPTIONS_LABEL_CTRL_FPS_X 18
 #define GRAPHICS_OPTIONS_LABEL_CTRL_FPS_Y 398
 #define GRAPHICS_OPTIONS_LABEL_CTRL_FPS_EVENTID 1013
+#define GRAPHICS_OPTIONS_LABEL_CTRL_SPRITEBUDGET_X 18
+#define GRAPHICS_OPTIONS_LABEL_CTRL_SPRITEBUDGET_Y 438
+#define GRAPHICS_OPTIONS_LABEL_CTRL_SPRITEBUDGET_EVENTID 1015
 #define GRAPHICS_OPTIONS_LIGHTS_TEXT "Set Ambient Light: %d%%"
 #define GRAPHICS_OPTIONS_LEVELSEPARATOR_TEXT "Set Level Separator: %d%%"
 #define GRAPHICS_OPTIONS_FPS_TEXT "Adjust Framerate Limit: %d"
 #define GRAPHICS_OPTIONS_FPS_MAX_TEXT "Adjust Framerate Limit: max"
+#define GRAPHICS_OPTIONS_SPRITEBUDGET_TEXT "Sprite Budget: %u sprites (%u MB)"
+#define GRAPHICS_OPTIONS_SPRITEBUDGET_AUTO_TEXT "Sprite Budget: auto"
+#define GRAPHICS_OPTIONS_SPRITEBUDGET_STEPS 6
 
 extern Engine g_engine;
 extern bool g_inited;
 
+//Scrollbar position 0 means auto-detect and the rest are power of two budgets from SPRITE_BUDGET_MIN
+static Uint32 getSpriteBudgetFromPos(Sint32 pos)
+{
+	return (pos > 0 ? (SPRITE_BUDGET_MIN << (pos - 1)) : 0);
+}
+
+static Sint32 getSpriteBudgetPos(Uint32 spriteBudget)
+{
+	if(spriteBudget == 0)
+		return 0;
+
+	Sint32 pos = 1;
+	while(pos < GRAPHICS_OPTIONS_SPRITEBUDGET_STEPS && getSpriteBudgetFromPos(pos) < spriteBudget)
+		++pos;
+	return pos;
+}
+
+static void setSpriteBudgetText(Sint32 pos)
+{
+	Uint32 spriteBudget = getSpriteBudgetFromPos(pos);
+	if(spriteBudget == 0)
+		SDL_snprintf(g_buffer, sizeof(g_buffer), GRAPHICS_OPTIONS_SPRITEBUDGET_AUTO_TEXT);
+	else
+		SDL_snprintf(g_buffer, sizeof(g_buffer), GRAPHICS_OPTIONS_SPRITEBUDGET_TEXT, spriteBudget, (spriteBudget * 4096) / (1024 * 1024));
+}
+
 void advanced_graphics_options_Events(Uint32 event, Sint32 status)
 {
 	switch(event)
@@ -141,6 +178,10 @@ void advanced_graphics_options_Events(Uint32 event, Sint32 status)
 				pScrollBar = SDL_static_cast(GUI_HScrollBar*, pWindow->getChild(GRAPHICS_OPTIONS_SCROLLBAR_LEVELSEPARATOR_EVENTID));
 				if(pScrollBar)
 					g_engine.setLevelSeparator(UTIL_min<Uint8>(100, SDL_static_cast(Uint8, pScrollBar->getScrollPos())));
+
+				pScrollBar = SDL_static_cast(GUI_HScrollBar*, pWindow->getChild(GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_EVENTID));
+				if(pScrollBar)
+					g_engine.setSpriteBudget(getSpriteBudgetFromPos(pScrollBar->getScrollPos()));
 				
 				GUI_CheckBox* pCheckBox = SDL_static_cast(GUI_CheckBox*, pWindow->getChild(GRAPHICS_OPTIONS_CHECKBOX_SHARPEN_EVENTID));
 				if(pCheckBox)
@@ -308,6 +349,20 @@ void advanced_graphics_options_Events(Uint32 event, Sint32 status)
 			}
 		}
 		break;
+		case GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_EVENTID:
+		{
+			GUI_Window* pWindow = g_engine.getCurrentWindow();
+			if(pWindow && pWindow->getInternalID() == GUI_WINDOW_ADVANCEDGRAPHICSOPTIONS)
+			{
+				GUI_Label* pLabel = SDL_static_cast(GUI_Label*, pWindow->getChild(GRAPHICS_OPTIONS_LABEL_CTRL_SPRITEBUDGET_EVENTID));
+				if(pLabel)
+				{
+					setSpriteBudgetText(status);
+					pLabel->setName(g_buffer);
+				}
+			}
+		}
+		break;
 		default: break;
 	}
 }
@@ -436,6 +491,9 @@ void UTIL_advancedGraphicsOptions()
 	SDL_snprintf(g_buffer, sizeof(g_buffer), GRAPHICS_OPTIONS_LEVELSEPARATOR_TEXT, g_engine.getLevelSeparator());
 	newLabel = new GUI_Label(iRect(GRAPHICS_OPTIONS_LABEL_CTRL_LEVELSEPARATOR_X, GRAPHICS_OPTIONS_LABEL_CTRL_LEVELSEPARATOR_Y, 0, 0), g_buffer, GRAPHICS_OPTIONS_LABEL_CTRL_LEVELSEPARATOR_EVENTID);
 	newWindow->addChild(newLabel);
+	setSpriteBudgetText(getSpriteBudgetPos(g_engine.getConfiguredSpriteBudget()));
+	newLabel = new GUI_Label(iRect(GRAPHICS_OPTIONS_LABEL_CTRL_SPRITEBUDGET_X, GRAPHICS_OPTIONS_LABEL_CTRL_SPRITEBUDGET_Y, 0, 0), g_buffer, GRAPHICS_OPTIONS_LABEL_CTRL_SPRITEBUDGET_EVENTID);
+	newWindow->addChild(newLabel);
 	newLabel = new GUI_Label(iRect(GRAPHICS_OPTIONS_LABEL_ANTIALIAS_X, GRAPHICS_OPTIONS_LABEL_ANTIALIAS_Y, 0, 0), GRAPHICS_OPTIONS_LABEL_ANTIALIAS_TITLE);
 	newWindow->addChild(newLabel);
 	newLabel = new GUI_Label(iRect(GRAPHICS_OPTIONS_LABEL_LIGHTS_X, GRAPHICS_OPTIONS_LABEL_LIGHTS_Y, 0, 0), GRAPHICS_OPTIONS_LABEL_LIGHTS_TITLE);
@@ -484,5 +542,9 @@ void UTIL_advancedGraphicsOptions()
 	newHScrollBar->setBarEventCallback(&advanced_graphics_options_Events, GRAPHICS_OPTIONS_SCROLLBAR_LEVELSEPARATOR_EVENTID);
 	newHScrollBar->startEvents();
 	newWindow->addChild(newHScrollBar);
+	newHScrollBar = new GUI_HScrollBar(iRect(GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_X, GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_Y, GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_W, GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_H), GRAPHICS_OPTIONS_SPRITEBUDGET_STEPS, getSpriteBudgetPos(g_engine.getConfiguredSpriteBudget()), GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_EVENTID);
+	newHScrollBar->setBarEventCallback(&advanced_graphics_options_Events, GRAPHICS_OPTIONS_SCROLLBAR_SPRITEBUDGET_EVENTID);
+	newHScrollBar->startEvents();
+	newWindow->addChild(newHScrollBar);
 	g_engine.addWindow(newWindow, true);
 }
@@ -1479,28 +1479,28 @@ void Chat::onMouseMove(iRect& rect, Sint32 x, Sint32 y)
 
 void Chat::render(iRect& rect)
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, rect.x1, rect.y1, rect.x2, 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, rect.x1, rect.y1 + 1, rect.x2, 3);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, rect.x1, rect.y1 + 4, rect.x2, 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_CONSOLE_BACKGROUND_X, GUI_UI_ICON_CONSOLE_BACKGROUND_Y, GUI_UI_ICON_CONSOLE_BACKGROUND_W, GUI_UI_ICON_CONSOLE_BACKGROUND_H, rect.x1, rect.y1 + 5, rect.x2, 16);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, rect.x1 + 2, rect.y1 + 23, rect.x2 - 4, rect.y2 - 25);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, rect.x1, rect.y1, rect.x2, 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, rect.x1, rect.y1 + 1, rect.x2, 3);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, rect.x1, rect.y1 + 4, rect.x2, 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_CONSOLE_BACKGROUND_X, GUI_UI_ICON_CONSOLE_BACKGROUND_Y, GUI_UI_ICON_CONSOLE_BACKGROUND_W, GUI_UI_ICON_CONSOLE_BACKGROUND_H, rect.x1, rect.y1 + 5, rect.x2, 16);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, rect.x1 + 2, rect.y1 + 23, rect.x2 - 4, rect.y2 - 25);
 	
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPLEFT_BORDER_X, GUI_UI_ICON_TOPLEFT_BORDER_Y, rect.x1 + 4, rect.y1 + 26, GUI_UI_ICON_TOPLEFT_BORDER_W, GUI_UI_ICON_TOPLEFT_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTLEFT_BORDER_X, GUI_UI_ICON_BOTLEFT_BORDER_Y, rect.x1 + 4, rect.y1 + rect.y2 - 25, GUI_UI_ICON_BOTLEFT_BORDER_W, GUI_UI_ICON_BOTLEFT_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPRIGHT_BORDER_X, GUI_UI_ICON_TOPRIGHT_BORDER_Y, rect.x1 + rect.x2 - 7, rect.y1 + 26, GUI_UI_ICON_TOPRIGHT_BORDER_W, GUI_UI_ICON_TOPRIGHT_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTRIGHT_BORDER_X, GUI_UI_ICON_BOTRIGHT_BORDER_Y, rect.x1 + rect.x2 - 7, rect.y1 + rect.y2 - 25, GUI_UI_ICON_BOTRIGHT_BORDER_W, GUI_UI_ICON_BOTRIGHT_BORDER_H);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, rect.x1 + 7, rect.y1 + 26, rect.x2 - 14, 3);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, rect.x1 + 7, rect.y1 + rect.y2 - 25, rect.x2 - 14, 3);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, rect.x1 + 4, rect.y1 + 29, 3, rect.y2 - 54);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, rect.x1 + rect.x2 - 7, rect.y1 + 29, 3, rect.y2 - 54);
-
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, rect.x1 + rect.x2 - 2, rect.y1 + 21, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, rect.x1, rect.y1 + rect.y2 - 2, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, rect.x1, rect.y1 + 21, rect.x2 - 2, 2);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, rect.x1, rect.y1 + 23, 2, rect.y2 - 25);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, rect.x1 + 2, rect.y1 + rect.y2 - 2, rect.x2 - 2, 2);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, rect.x1 + rect.x2 - 2, rect.y1 + 23, 2, rect.y2 - 25);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPLEFT_BORDER_X, GUI_UI_ICON_TOPLEFT_BORDER_Y, rect.x1 + 4, rect.y1 + 26, GUI_UI_ICON_TOPLEFT_BORDER_W, GUI_UI_ICON_TOPLEFT_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTLEFT_BORDER_X, GUI_UI_ICON_BOTLEFT_BORDER_Y, rect.x1 + 4, rect.y1 + rect.y2 - 25, GUI_UI_ICON_BOTLEFT_BORDER_W, GUI_UI_ICON_BOTLEFT_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPRIGHT_BORDER_X, GUI_UI_ICON_TOPRIGHT_BORDER_Y, rect.x1 + rect.x2 - 7, rect.y1 + 26, GUI_UI_ICON_TOPRIGHT_BORDER_W, GUI_UI_ICON_TOPRIGHT_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTRIGHT_BORDER_X, GUI_UI_ICON_BOTRIGHT_BORDER_Y, rect.x1 + rect.x2 - 7, rect.y1 + rect.y2 - 25, GUI_UI_ICON_BOTRIGHT_BORDER_W, GUI_UI_ICON_BOTRIGHT_BORDER_H);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, rect.x1 + 7, rect.y1 + 26, rect.x2 - 14, 3);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, rect.x1 + 7, rect.y1 + rect.y2 - 25, rect.x2 - 14, 3);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, rect.x1 + 4, rect.y1 + 29, 3, rect.y2 - 54);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, rect.x1 + rect.x2 - 7, rect.y1 + 29, 3, rect.y2 - 54);
+
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, rect.x1 + rect.x2 - 2, rect.y1 + 21, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, rect.x1, rect.y1 + rect.y2 - 2, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, rect.x1, rect.y1 + 21, rect.x2 - 2, 2);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, rect.x1, rect.y1 + 23, 2, rect.y2 - 25);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, rect.x1 + 2, rect.y1 + rect.y2 - 2, rect.x2 - 2, 2);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, rect.x1 + rect.x2 - 2, rect.y1 + 23, 2, rect.y2 - 25);
 
 	Channel* selectedchannel = getCurrentChannel();
 	if(!selectedchannel)
@@ -1532,23 +1532,23 @@ void Chat::render(iRect& rect)
 			if(buttonType == 2)
 			{
 				if(m_buttonNext == 1)
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_X, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_W, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_X, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_W, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_DOWN_H);
 				else
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_X, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_W, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_X, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_W, GUI_UI_ICON_BROWSE_RIGHT_UPDATE_UP_H);
 			}
 			else if(buttonType == 1)
 			{
 				if(m_buttonNext == 1)
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_X, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_W, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_X, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_W, GUI_UI_ICON_BROWSE_RIGHT_FLASH_DOWN_H);
 				else
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_X, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_W, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_X, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_W, GUI_UI_ICON_BROWSE_RIGHT_FLASH_UP_H);
 			}
 			else
 			{
 				if(m_buttonNext == 1)
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_DOWN_X, GUI_UI_ICON_BROWSE_RIGHT_DOWN_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_DOWN_W, GUI_UI_ICON_BROWSE_RIGHT_DOWN_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_DOWN_X, GUI_UI_ICON_BROWSE_RIGHT_DOWN_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_DOWN_W, GUI_UI_ICON_BROWSE_RIGHT_DOWN_H);
 				else
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_UP_X, GUI_UI_ICON_BROWSE_RIGHT_UP_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_UP_W, GUI_UI_ICON_BROWSE_RIGHT_UP_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_RIGHT_UP_X, GUI_UI_ICON_BROWSE_RIGHT_UP_Y, rect.x1 + rect.x2 - 82, rect.y1 + 5, GUI_UI_ICON_BROWSE_RIGHT_UP_W, GUI_UI_ICON_BROWSE_RIGHT_UP_H);
 			}
 		}
 		if(m_currentPage != 0)
@@ -1568,23 +1568,23 @@ void Chat::render(iRect& rect)
 			if(buttonType == 2)
 			{
 				if(m_buttonPrevious == 1)
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_X, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_W, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_X, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_W, GUI_UI_ICON_BROWSE_LEFT_UPDATE_DOWN_H);
 				else
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_X, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_W, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_X, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_W, GUI_UI_ICON_BROWSE_LEFT_UPDATE_UP_H);
 			}
 			else if(buttonType == 1)
 			{
 				if(m_buttonPrevious == 1)
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_X, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_W, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_X, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_W, GUI_UI_ICON_BROWSE_LEFT_FLASH_DOWN_H);
 				else
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_X, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_W, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_X, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_W, GUI_UI_ICON_BROWSE_LEFT_FLASH_UP_H);
 			}
 			else
 			{
 				if(m_buttonPrevious == 1)
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_DOWN_X, GUI_UI_ICON_BROWSE_LEFT_DOWN_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_DOWN_W, GUI_UI_ICON_BROWSE_LEFT_DOWN_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_DOWN_X, GUI_UI_ICON_BROWSE_LEFT_DOWN_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_DOWN_W, GUI_UI_ICON_BROWSE_LEFT_DOWN_H);
 				else
-					renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_UP_X, GUI_UI_ICON_BROWSE_LEFT_UP_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_UP_W, GUI_UI_ICON_BROWSE_LEFT_UP_H);
+					renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BROWSE_LEFT_UP_X, GUI_UI_ICON_BROWSE_LEFT_UP_Y, rect.x1, rect.y1 + 5, GUI_UI_ICON_BROWSE_LEFT_UP_W, GUI_UI_ICON_BROWSE_LEFT_UP_H);
 			}
 		}
 	}
@@ -1592,18 +1592,18 @@ void Chat::render(iRect& rect)
 		m_currentPage = 0;
 
 	Sint32 posX = rect.x1 + 18;
-	renderer->setClipRect(posX, rect.y1 + 5, rect.x2 - 100, 18);
+	renderer.setClipRect(posX, rect.y1 + 5, rect.x2 - 100, 18);
 	for(size_t it = m_currentPage, end = UTIL_min<size_t>(m_channels.size(), it + calculatedPages.second + 1); it != end; ++it)
 	{
 		Channel& currentChannel = m_channels[it];
 		if(m_selectedChannel == it)
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, posX, rect.y1 + 5, GUI_UI_ICON_ACTIVE_CHANNEL_W, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, posX, rect.y1 + 5, GUI_UI_ICON_ACTIVE_CHANNEL_W, GUI_UI_ICON_ACTIVE_CHANNEL_H);
 			g_engine.drawFont(CLIENT_FONT_OUTLINED, posX + 48, rect.y1 + 9, currentChannel.channelName, 223, 223, 223, CLIENT_FONT_ALIGN_CENTER);
 		}
 		else
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, posX, rect.y1 + 5, GUI_UI_ICON_UNACTIVE_CHANNEL_W, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, posX, rect.y1 + 5, GUI_UI_ICON_UNACTIVE_CHANNEL_W, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
 			if(currentChannel.highlightTime >= g_frameTime)
 				g_engine.drawFont(CLIENT_FONT_OUTLINED, posX + 48, rect.y1 + 9, currentChannel.channelName, 250, 250, 250, CLIENT_FONT_ALIGN_CENTER);
 			else if(currentChannel.unreadMessage)
@@ -1613,27 +1613,27 @@ void Chat::render(iRect& rect)
 		}
 		posX += 96;
 	}
-	renderer->disableClipRect();
+	renderer.disableClipRect();
 
 	if(m_ignoreListTime >= g_frameTime)
-		renderer->drawPicture(GUI_UI_IMAGE, (m_ignoreListStatus == 1 ? GUI_UI_ICON_IGNORE_WINDOW_DOWN_X : GUI_UI_ICON_IGNORE_WINDOW_FLASH_X), (m_ignoreListStatus == 1 ? GUI_UI_ICON_IGNORE_WINDOW_DOWN_Y : GUI_UI_ICON_IGNORE_WINDOW_FLASH_Y), rect.x1 + rect.x2 - 16, rect.y1 + 5, GUI_UI_ICON_IGNORE_WINDOW_FLASH_W, GUI_UI_ICON_IGNORE_WINDOW_FLASH_H);
+		renderer.drawPicture(GUI_UI_IMAGE, (m_ignoreListStatus == 1 ? GUI_UI_ICON_IGNORE_WINDOW_DOWN_X : GUI_UI_ICON_IGNORE_WINDOW_FLASH_X), (m_ignoreListStatus == 1 ? GUI_UI_ICON_IGNORE_WINDOW_DOWN_Y : GUI_UI_ICON_IGNORE_WINDOW_FLASH_Y), rect.x1 + rect.x2 - 16, rect.y1 + 5, GUI_UI_ICON_IGNORE_WINDOW_FLASH_W, GUI_UI_ICON_IGNORE_WINDOW_FLASH_H);
 	else
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_IGNORE_WINDOW_UP_X, (m_ignoreListStatus == 1 ? GUI_UI_ICON_IGNORE_WINDOW_DOWN_Y : GUI_UI_ICON_IGNORE_WINDOW_UP_Y), rect.x1 + rect.x2 - 16, rect.y1 + 5, GUI_UI_ICON_IGNORE_WINDOW_UP_W, GUI_UI_ICON_IGNORE_WINDOW_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_IGNORE_WINDOW_UP_X, (m_ignoreListStatus == 1 ? GUI_UI_ICON_IGNORE_WINDOW_DOWN_Y : GUI_UI_ICON_IGNORE_WINDOW_UP_Y), rect.x1 + rect.x2 - 16, rect.y1 + 5, GUI_UI_ICON_IGNORE_WINDOW_UP_W, GUI_UI_ICON_IGNORE_WINDOW_UP_H);
 
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_REQUEST_CHANNELS_UP_X, (m_channelListStatus == 1 ? GUI_UI_ICON_REQUEST_CHANNELS_DOWN_Y : GUI_UI_ICON_REQUEST_CHANNELS_UP_Y), rect.x1 + rect.x2 - 32, rect.y1 + 5, GUI_UI_ICON_REQUEST_CHANNELS_UP_W, GUI_UI_ICON_REQUEST_CHANNELS_UP_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_REQUEST_CHANNELS_UP_X, (m_channelListStatus == 1 ? GUI_UI_ICON_REQUEST_CHANNELS_DOWN_Y : GUI_UI_ICON_REQUEST_CHANNELS_UP_Y), rect.x1 + rect.x2 - 32, rect.y1 + 5, GUI_UI_ICON_REQUEST_CHANNELS_UP_W, GUI_UI_ICON_REQUEST_CHANNELS_UP_H);
 	if(selectedchannel->channelClosable)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_CONSOLE_MESSAGES_UP_X, ((selectedchannel->workAsServerLog || m_serverLogStatus == 1) ? GUI_UI_ICON_CONSOLE_MESSAGES_DOWN_Y : GUI_UI_ICON_CONSOLE_MESSAGES_UP_Y), rect.x1 + rect.x2 - 48, rect.y1 + 5, GUI_UI_ICON_CONSOLE_MESSAGES_UP_W, GUI_UI_ICON_CONSOLE_MESSAGES_UP_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_CLOSE_CHANNEL_UP_X, (m_closeChannelStatus == 1 ? GUI_UI_ICON_CLOSE_CHANNEL_DOWN_Y : GUI_UI_ICON_CLOSE_CHANNEL_UP_Y), rect.x1 + rect.x2 - 64, rect.y1 + 5, GUI_UI_ICON_CLOSE_CHANNEL_UP_W, GUI_UI_ICON_CLOSE_CHANNEL_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_CONSOLE_MESSAGES_UP_X, ((selectedchannel->workAsServerLog || m_serverLogStatus == 1) ? GUI_UI_ICON_CONSOLE_MESSAGES_DOWN_Y : GUI_UI_ICON_CONSOLE_MESSAGES_UP_Y), rect.x1 + rect.x2 - 48, rect.y1 + 5, GUI_UI_ICON_CONSOLE_MESSAGES_UP_W, GUI_UI_ICON_CONSOLE_MESSAGES_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_CLOSE_CHANNEL_UP_X, (m_closeChannelStatus == 1 ? GUI_UI_ICON_CLOSE_CHANNEL_DOWN_Y : GUI_UI_ICON_CLOSE_CHANNEL_UP_Y), rect.x1 + rect.x2 - 64, rect.y1 + 5, GUI_UI_ICON_CLOSE_CHANNEL_UP_W, GUI_UI_ICON_CLOSE_CHANNEL_UP_H);
 	}
 	else
 	{
 		if(m_volumeAdjustement == VOLUME_SAY)
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_VOLUME1_WINDOW_UP_X, (m_volumeStatus == 1 ? GUI_UI_ICON_VOLUME1_WINDOW_DOWN_Y : GUI_UI_ICON_VOLUME1_WINDOW_UP_Y), rect.x1 + 5, rect.y1 + rect.y2 - 20, GUI_UI_ICON_VOLUME1_WINDOW_UP_W, GUI_UI_ICON_VOLUME1_WINDOW_UP_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_VOLUME1_WINDOW_UP_X, (m_volumeStatus == 1 ? GUI_UI_ICON_VOLUME1_WINDOW_DOWN_Y : GUI_UI_ICON_VOLUME1_WINDOW_UP_Y), rect.x1 + 5, rect.y1 + rect.y2 - 20, GUI_UI_ICON_VOLUME1_WINDOW_UP_W, GUI_UI_ICON_VOLUME1_WINDOW_UP_H);
 		else if(m_volumeAdjustement == VOLUME_YELL)
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_VOLUME2_WINDOW_UP_X, (m_volumeStatus == 1 ? GUI_UI_ICON_VOLUME2_WINDOW_DOWN_Y : GUI_UI_ICON_VOLUME2_WINDOW_UP_Y), rect.x1 + 5, rect.y1 + rect.y2 - 20, GUI_UI_ICON_VOLUME2_WINDOW_UP_W, GUI_UI_ICON_VOLUME2_WINDOW_UP_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_VOLUME2_WINDOW_UP_X, (m_volumeStatus == 1 ? GUI_UI_ICON_VOLUME2_WINDOW_DOWN_Y : GUI_UI_ICON_VOLUME2_WINDOW_UP_Y), rect.x1 + 5, rect.y1 + rect.y2 - 20, GUI_UI_ICON_VOLUME2_WINDOW_UP_W, GUI_UI_ICON_VOLUME2_WINDOW_UP_H);
 		else if(m_volumeAdjustement == VOLUME_WHISPER)
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_VOLUME0_WINDOW_UP_X, (m_volumeStatus == 1 ? GUI_UI_ICON_VOLUME0_WINDOW_DOWN_Y : GUI_UI_ICON_VOLUME0_WINDOW_UP_Y), rect.x1 + 5, rect.y1 + rect.y2 - 20, GUI_UI_ICON_VOLUME0_WINDOW_UP_W, GUI_UI_ICON_VOLUME0_WINDOW_UP_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_VOLUME0_WINDOW_UP_X, (m_volumeStatus == 1 ? GUI_UI_ICON_VOLUME0_WINDOW_DOWN_Y : GUI_UI_ICON_VOLUME0_WINDOW_UP_Y), rect.x1 + 5, rect.y1 + rect.y2 - 20, GUI_UI_ICON_VOLUME0_WINDOW_UP_W, GUI_UI_ICON_VOLUME0_WINDOW_UP_H);
 	}
 
 	if(!m_textbox->isActive())
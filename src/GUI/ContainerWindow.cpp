@@ -440,11 +440,11 @@ void GUI_ContainerContainer::render()
 		Container* container = g_game.findContainer(m_index);
 		if(container)
 		{
-			auto& renderer = g_engine.getRender();
+			RenderCommandList& renderer = g_engine.getRenderCommands();
 			if(container->isUnlocked())
-				renderer->drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 255, 255, 255, 255);
+				renderer.drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 255, 255, 255, 255);
 			else
-				renderer->drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 255, 0, 0, 255);
+				renderer.drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 255, 0, 0, 255);
 		}
 	}
 }
@@ -516,8 +516,8 @@ void GUI_ContainerItem::onRMouseDown(Sint32, Sint32)
 
 void GUI_ContainerItem::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
 
 	Container* container = g_game.findContainer(m_cid);
 	if(!container)
@@ -536,9 +536,9 @@ void GUI_ContainerItem::render()
 			}
 
 			if(container->isUnlocked())
-				renderer->drawRectangle(m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2, 1, 255, 255, 255, 255);
+				renderer.drawRectangle(m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2, 1, 255, 255, 255, 255);
 			else
-				renderer->drawRectangle(m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2, 1, 255, 0, 0, 255);
+				renderer.drawRectangle(m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2, 1, 255, 0, 0, 255);
 		}
 	}
 }
@@ -198,9 +198,9 @@ GUI_Health::GUI_Health(iRect boxRect, Uint32 internalID)
 
 void GUI_Health::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_EMPTY_X, GUI_UI_BAR_EMPTY_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_HEALTH_X, GUI_UI_BAR_HEALTH_Y, m_tRect.x1, m_tRect.y1, m_percent, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_EMPTY_X, GUI_UI_BAR_EMPTY_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_HEALTH_X, GUI_UI_BAR_HEALTH_Y, m_tRect.x1, m_tRect.y1, m_percent, m_tRect.y2);
 }
 
 GUI_Mana::GUI_Mana(iRect boxRect, Uint32 internalID)
@@ -211,7 +211,7 @@ GUI_Mana::GUI_Mana(iRect boxRect, Uint32 internalID)
 
 void GUI_Mana::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_EMPTY_X, GUI_UI_BAR_EMPTY_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_MANA_X, GUI_UI_BAR_MANA_Y, m_tRect.x1, m_tRect.y1, m_percent, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_EMPTY_X, GUI_UI_BAR_EMPTY_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_BAR_MANA_X, GUI_UI_BAR_MANA_Y, m_tRect.x1, m_tRect.y1, m_percent, m_tRect.y2);
 }
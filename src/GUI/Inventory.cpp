@@ -761,105 +761,105 @@ void GUI_Icons::onMouseMove(Sint32 x, Sint32 y, bool isInsideParent)
 
 void GUI_Icons::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_STATUS_BAR_X, GUI_UI_ICON_STATUS_BAR_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_STATUS_BAR_X, GUI_UI_ICON_STATUS_BAR_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 	
 	Sint32 posX = m_tRect.x1 + 2;
 	Sint32 posY = m_tRect.y1 + 2;
 	Uint32 playerIcons = g_game.getIcons();
 	if(playerIcons & ICON_POISON)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_POISON_X, GUI_UI_STATUS_POISON_Y, posX, posY, GUI_UI_STATUS_POISON_W, GUI_UI_STATUS_POISON_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_POISON_X, GUI_UI_STATUS_POISON_Y, posX, posY, GUI_UI_STATUS_POISON_W, GUI_UI_STATUS_POISON_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_BURN)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BURN_X, GUI_UI_STATUS_BURN_Y, posX, posY, GUI_UI_STATUS_BURN_W, GUI_UI_STATUS_BURN_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BURN_X, GUI_UI_STATUS_BURN_Y, posX, posY, GUI_UI_STATUS_BURN_W, GUI_UI_STATUS_BURN_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_ENERGY)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_ENERGY_X, GUI_UI_STATUS_ENERGY_Y, posX, posY, GUI_UI_STATUS_ENERGY_W, GUI_UI_STATUS_ENERGY_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_ENERGY_X, GUI_UI_STATUS_ENERGY_Y, posX, posY, GUI_UI_STATUS_ENERGY_W, GUI_UI_STATUS_ENERGY_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_SWORDS)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_SWORDS_X, GUI_UI_STATUS_SWORDS_Y, posX, posY, GUI_UI_STATUS_SWORDS_W, GUI_UI_STATUS_SWORDS_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_SWORDS_X, GUI_UI_STATUS_SWORDS_Y, posX, posY, GUI_UI_STATUS_SWORDS_W, GUI_UI_STATUS_SWORDS_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_DRUNK)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_DRUNK_X, GUI_UI_STATUS_DRUNK_Y, posX, posY, GUI_UI_STATUS_DRUNK_W, GUI_UI_STATUS_DRUNK_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_DRUNK_X, GUI_UI_STATUS_DRUNK_Y, posX, posY, GUI_UI_STATUS_DRUNK_W, GUI_UI_STATUS_DRUNK_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_MANASHIELD)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_MANASHIELD_X, GUI_UI_STATUS_MANASHIELD_Y, posX, posY, GUI_UI_STATUS_MANASHIELD_W, GUI_UI_STATUS_MANASHIELD_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_MANASHIELD_X, GUI_UI_STATUS_MANASHIELD_Y, posX, posY, GUI_UI_STATUS_MANASHIELD_W, GUI_UI_STATUS_MANASHIELD_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_HASTE)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_HASTE_X, GUI_UI_STATUS_HASTE_Y, posX, posY, GUI_UI_STATUS_HASTE_W, GUI_UI_STATUS_HASTE_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_HASTE_X, GUI_UI_STATUS_HASTE_Y, posX, posY, GUI_UI_STATUS_HASTE_W, GUI_UI_STATUS_HASTE_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_PARALYZE)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_PARALYZE_X, GUI_UI_STATUS_PARALYZE_Y, posX, posY, GUI_UI_STATUS_PARALYZE_W, GUI_UI_STATUS_PARALYZE_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_PARALYZE_X, GUI_UI_STATUS_PARALYZE_Y, posX, posY, GUI_UI_STATUS_PARALYZE_W, GUI_UI_STATUS_PARALYZE_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_DROWNING)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_DROWNING_X, GUI_UI_STATUS_DROWNING_Y, posX, posY, GUI_UI_STATUS_DROWNING_W, GUI_UI_STATUS_DROWNING_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_DROWNING_X, GUI_UI_STATUS_DROWNING_Y, posX, posY, GUI_UI_STATUS_DROWNING_W, GUI_UI_STATUS_DROWNING_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_FREEZING)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_FREEZING_X, GUI_UI_STATUS_FREEZING_Y, posX, posY, GUI_UI_STATUS_FREEZING_W, GUI_UI_STATUS_FREEZING_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_FREEZING_X, GUI_UI_STATUS_FREEZING_Y, posX, posY, GUI_UI_STATUS_FREEZING_W, GUI_UI_STATUS_FREEZING_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_DAZZLED)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_DAZZLED_X, GUI_UI_STATUS_DAZZLED_Y, posX, posY, GUI_UI_STATUS_DAZZLED_W, GUI_UI_STATUS_DAZZLED_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_DAZZLED_X, GUI_UI_STATUS_DAZZLED_Y, posX, posY, GUI_UI_STATUS_DAZZLED_W, GUI_UI_STATUS_DAZZLED_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_CURSED)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_CURSED_X, GUI_UI_STATUS_CURSED_Y, posX, posY, GUI_UI_STATUS_CURSED_W, GUI_UI_STATUS_CURSED_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_CURSED_X, GUI_UI_STATUS_CURSED_Y, posX, posY, GUI_UI_STATUS_CURSED_W, GUI_UI_STATUS_CURSED_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_PARTY_BUFF)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BUFF_X, GUI_UI_STATUS_BUFF_Y, posX, posY, GUI_UI_STATUS_BUFF_W, GUI_UI_STATUS_BUFF_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BUFF_X, GUI_UI_STATUS_BUFF_Y, posX, posY, GUI_UI_STATUS_BUFF_W, GUI_UI_STATUS_BUFF_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_REDSWORDS)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_PZLOCK_X, GUI_UI_STATUS_PZLOCK_Y, posX, posY, GUI_UI_STATUS_PZLOCK_W, GUI_UI_STATUS_PZLOCK_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_PZLOCK_X, GUI_UI_STATUS_PZLOCK_Y, posX, posY, GUI_UI_STATUS_PZLOCK_W, GUI_UI_STATUS_PZLOCK_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_PIGEON)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_PIGEON_X, GUI_UI_STATUS_PIGEON_Y, posX, posY, GUI_UI_STATUS_PIGEON_W, GUI_UI_STATUS_PIGEON_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_PIGEON_X, GUI_UI_STATUS_PIGEON_Y, posX, posY, GUI_UI_STATUS_PIGEON_W, GUI_UI_STATUS_PIGEON_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_BLEEDING)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BLEEDING_X, GUI_UI_STATUS_BLEEDING_Y, posX, posY, GUI_UI_STATUS_BLEEDING_W, GUI_UI_STATUS_BLEEDING_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BLEEDING_X, GUI_UI_STATUS_BLEEDING_Y, posX, posY, GUI_UI_STATUS_BLEEDING_W, GUI_UI_STATUS_BLEEDING_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_LESSERHEX)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_LESSERHEX_X, GUI_UI_STATUS_LESSERHEX_Y, posX, posY, GUI_UI_STATUS_LESSERHEX_W, GUI_UI_STATUS_LESSERHEX_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_LESSERHEX_X, GUI_UI_STATUS_LESSERHEX_Y, posX, posY, GUI_UI_STATUS_LESSERHEX_W, GUI_UI_STATUS_LESSERHEX_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_INTENSEHEX)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_INTENSEHEX_X, GUI_UI_STATUS_INTENSEHEX_Y, posX, posY, GUI_UI_STATUS_INTENSEHEX_W, GUI_UI_STATUS_INTENSEHEX_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_INTENSEHEX_X, GUI_UI_STATUS_INTENSEHEX_Y, posX, posY, GUI_UI_STATUS_INTENSEHEX_W, GUI_UI_STATUS_INTENSEHEX_H);
 		posX += 10;
 	}
 	if(playerIcons & ICON_GREATEREHEX)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_GREATEREHEX_X, GUI_UI_STATUS_GREATEREHEX_Y, posX, posY, GUI_UI_STATUS_GREATEREHEX_W, GUI_UI_STATUS_GREATEREHEX_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_GREATEREHEX_X, GUI_UI_STATUS_GREATEREHEX_Y, posX, posY, GUI_UI_STATUS_GREATEREHEX_W, GUI_UI_STATUS_GREATEREHEX_H);
 		posX += 10;
 	}
 
@@ -869,7 +869,7 @@ void GUI_Icons::render()
 
 	if(g_game.hasGameFeature(GAME_FEATURE_REGENERATION_TIME) && g_game.getPlayerRegeneration() == 0)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_HUNGRY_X, GUI_UI_STATUS_HUNGRY_Y, posX, posY, GUI_UI_STATUS_HUNGRY_W, GUI_UI_STATUS_HUNGRY_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_HUNGRY_X, GUI_UI_STATUS_HUNGRY_Y, posX, posY, GUI_UI_STATUS_HUNGRY_W, GUI_UI_STATUS_HUNGRY_H);
 		posX += 10;
 	}
 
@@ -878,37 +878,37 @@ void GUI_Icons::render()
 	{
 		case SKULL_YELLOW:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_YELLOWSKULL_X, GUI_UI_STATUS_YELLOWSKULL_Y, posX, posY, GUI_UI_STATUS_YELLOWSKULL_W, GUI_UI_STATUS_YELLOWSKULL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_YELLOWSKULL_X, GUI_UI_STATUS_YELLOWSKULL_Y, posX, posY, GUI_UI_STATUS_YELLOWSKULL_W, GUI_UI_STATUS_YELLOWSKULL_H);
 			posX += 10;
 		}
 		break;
 		case SKULL_GREEN:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_GREENSKULL_X, GUI_UI_STATUS_GREENSKULL_Y, posX, posY, GUI_UI_STATUS_GREENSKULL_W, GUI_UI_STATUS_GREENSKULL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_GREENSKULL_X, GUI_UI_STATUS_GREENSKULL_Y, posX, posY, GUI_UI_STATUS_GREENSKULL_W, GUI_UI_STATUS_GREENSKULL_H);
 			posX += 10;
 		}
 		break;
 		case SKULL_WHITE:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_WHITESKULL_X, GUI_UI_STATUS_WHITESKULL_Y, posX, posY, GUI_UI_STATUS_WHITESKULL_W, GUI_UI_STATUS_WHITESKULL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_WHITESKULL_X, GUI_UI_STATUS_WHITESKULL_Y, posX, posY, GUI_UI_STATUS_WHITESKULL_W, GUI_UI_STATUS_WHITESKULL_H);
 			posX += 10;
 		}
 		break;
 		case SKULL_RED:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_REDSKULL_X, GUI_UI_STATUS_REDSKULL_Y, posX, posY, GUI_UI_STATUS_REDSKULL_W, GUI_UI_STATUS_REDSKULL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_REDSKULL_X, GUI_UI_STATUS_REDSKULL_Y, posX, posY, GUI_UI_STATUS_REDSKULL_W, GUI_UI_STATUS_REDSKULL_H);
 			posX += 10;
 		}
 		break;
 		case SKULL_BLACK:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BLACKSKULL_X, GUI_UI_STATUS_BLACKSKULL_Y, posX, posY, GUI_UI_STATUS_BLACKSKULL_W, GUI_UI_STATUS_BLACKSKULL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_BLACKSKULL_X, GUI_UI_STATUS_BLACKSKULL_Y, posX, posY, GUI_UI_STATUS_BLACKSKULL_W, GUI_UI_STATUS_BLACKSKULL_H);
 			posX += 10;
 		}
 		break;
 		case SKULL_ORANGE:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_ORANGOSKULL_X, GUI_UI_STATUS_ORANGOSKULL_Y, posX, posY, GUI_UI_STATUS_ORANGOSKULL_W, GUI_UI_STATUS_ORANGOSKULL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_ORANGOSKULL_X, GUI_UI_STATUS_ORANGOSKULL_Y, posX, posY, GUI_UI_STATUS_ORANGOSKULL_W, GUI_UI_STATUS_ORANGOSKULL_H);
 			posX += 10;
 		}
 		break;
@@ -918,7 +918,7 @@ void GUI_Icons::render()
 	Uint8 playerEmblem = localPlayer->getEmblem();
 	if(playerEmblem != GUILDEMBLEM_NONE && playerEmblem <= GUILDEMBLEM_NEUTRAL)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_GUILDWAR_X, GUI_UI_STATUS_GUILDWAR_Y, posX, posY, GUI_UI_STATUS_GUILDWAR_W, GUI_UI_STATUS_GUILDWAR_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_STATUS_GUILDWAR_X, GUI_UI_STATUS_GUILDWAR_Y, posX, posY, GUI_UI_STATUS_GUILDWAR_W, GUI_UI_STATUS_GUILDWAR_H);
 		posX += 10;
 	}
 }
@@ -979,14 +979,14 @@ void GUI_InventoryItem::onRMouseDown(Sint32, Sint32)
 
 void GUI_InventoryItem::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
 
 	ItemUI* item = g_game.getInventoryItem(m_slot);
 	if(item)
 		item->render(m_tRect.x1, m_tRect.y1, m_tRect.y2);
 	else
-		renderer->drawPicture(GUI_UI_IMAGE, m_skinX, m_skinY, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, m_skinX, m_skinY, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 
 	if(m_selected)
 	{
@@ -996,6 +996,6 @@ void GUI_InventoryItem::render()
 			return;
 		}
 
-		renderer->drawRectangle(m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2, 1, 255, 255, 255, 255);
+		renderer.drawRectangle(m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2, 1, 255, 255, 255, 255);
 	}
 }
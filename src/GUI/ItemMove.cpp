@@ -214,7 +214,7 @@ void GUI_ItemMove::render()
 	if(!isActive())
 		UTIL_SafeEventHandler(&item_move_Events, ITEM_MOVE_ACTIVATE_EVENTID, 1);
 
-	g_engine.getRender()->drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
+	g_engine.getRenderCommands().drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
 	if(m_item)
 		m_item->render(m_tRect.x1, m_tRect.y1, m_tRect.y2);
 }
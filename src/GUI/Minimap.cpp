@@ -271,25 +271,25 @@ GUI_MinimapTime::GUI_MinimapTime(iRect boxRect, Uint32 internalID)
 
 void GUI_MinimapTime::render()
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	Sint32 time = SDL_static_cast(Sint32, g_game.getGameTime()) / 10;
 	if(time >= 58)
 	{
 		time -= 58;
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X + time, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X + time, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 	}
 	else if(time >= 8)
 	{
 		time = SDL_static_cast(Sint32, (time - 8) * 0.6f);
 		time += 94;
 		Sint32 width = 124 - time;
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X + time, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1, m_tRect.y1, width, m_tRect.y2);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1 + width, m_tRect.y1, 31 - width, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X + time, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1, m_tRect.y1, width, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1 + width, m_tRect.y1, 31 - width, m_tRect.y2);
 	}
 	else
 	{
 		time += 86;
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X + time, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MAP_TIME_X + time, GUI_UI_ICON_MAP_TIME_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 	}
 }
 
@@ -332,15 +332,15 @@ void GUI_MinimapFlag::render()
 	bool pressed = (m_pressed == 1 ? true : false);
 	pressed = (m_type == g_minimapFlag ? true : pressed);
 
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(pressed)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_DOWN_X, GUI_UI_ICON_TEXTURED_DOWN_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_DOWN_X, GUI_UI_ICON_TEXTURED_DOWN_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 		AutomapArea::renderMark(m_type, m_tRect.x1 + 3, m_tRect.y1 + 3);
 	}
 	else
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_UP_X, GUI_UI_ICON_TEXTURED_UP_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_UP_X, GUI_UI_ICON_TEXTURED_UP_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 		AutomapArea::renderMark(m_type, m_tRect.x1 + 2, m_tRect.y1 + 2);
 	}
 }
@@ -830,6 +830,8 @@ void GUI_Outfit_View::render()
 	Uint32 outfitColor = (g_outfitColors[3] << 24) | (g_outfitColors[2] << 16) | (g_outfitColors[1] << 8) | (g_outfitColors[0]);
 	updateMovement();
 
+	//The preview reuses the game scene render target so it has to be drawn right away
+	g_engine.getRenderCommands().flush();
 	auto& renderer = g_engine.getRender();
 	renderer->beginGameScene();
 	Sint32 startX = -getOffsetX();
@@ -1058,46 +1060,46 @@ void GUI_Outfit_Colors::onLMouseUp(Sint32 x, Sint32 y)
 
 void GUI_Outfit_Colors::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + 16, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 2, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1, m_tRect.y1 + 16, m_tRect.x2 - 2, 2);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_tRect.x1, m_tRect.y1 + 18, 2, m_tRect.y2 - 20);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_tRect.x1 + 2, m_tRect.y1 + m_tRect.y2 - 2, m_tRect.x2 - 2, 2);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + 18, 2, m_tRect.y2 - 20);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + 16, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 2, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1, m_tRect.y1 + 16, m_tRect.x2 - 2, 2);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_tRect.x1, m_tRect.y1 + 18, 2, m_tRect.y2 - 20);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_tRect.x1 + 2, m_tRect.y1 + m_tRect.y2 - 2, m_tRect.x2 - 2, 2);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + 18, 2, m_tRect.y2 - 20);
 
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1, m_tRect.y1, 62, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 62, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + 1, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 64, m_tRect.y1, 61, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 125, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + 1, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 127, m_tRect.y1, 61, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 188, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + 1, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 190, m_tRect.y1, 61, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 251, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1, m_tRect.y1, 62, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 62, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + 1, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 64, m_tRect.y1, 61, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 125, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + 1, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 127, m_tRect.y1, 61, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 188, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + 1, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 190, m_tRect.y1, 61, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_UNACTIVE_CHANNEL_X + GUI_UI_ICON_UNACTIVE_CHANNEL_W - 2, GUI_UI_ICON_UNACTIVE_CHANNEL_Y, m_tRect.x1 + 251, m_tRect.y1, 2, GUI_UI_ICON_UNACTIVE_CHANNEL_H);
 	switch(m_selected)
 	{
 		case 1:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 63, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 125, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 63, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 125, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
 		}
 		break;
 		case 2:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 126, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 188, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 126, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 188, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
 		}
 		break;
 		case 3:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 189, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 251, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 189, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 251, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
 		}
 		break;
 		default:
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 62, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1, m_tRect.y1, 62, GUI_UI_ICON_ACTIVE_CHANNEL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_ACTIVE_CHANNEL_X + GUI_UI_ICON_ACTIVE_CHANNEL_W - 2, GUI_UI_ICON_ACTIVE_CHANNEL_Y, m_tRect.x1 + 62, m_tRect.y1, 2, GUI_UI_ICON_ACTIVE_CHANNEL_H);
 		}
 		break;
 	}
@@ -1116,14 +1118,14 @@ void GUI_Outfit_Colors::render()
 		{
 			Uint8 red, green, blue;
 			getOutfitColorRGB(c, red, green, blue);
-			renderer->fillRectangle(posX + 2, posY + 2, 8, 8, red, green, blue, 255);
+			renderer.fillRectangle(posX + 2, posY + 2, 8, 8, red, green, blue, 255);
 			if(g_outfitColors[m_selected] == c)
 			{
-				renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_COLOR_BOX_DOWN_X, GUI_UI_ICON_COLOR_BOX_DOWN_Y, posX, posY, GUI_UI_ICON_COLOR_BOX_DOWN_W, GUI_UI_ICON_COLOR_BOX_DOWN_H);
-				renderer->drawRectangle(posX - 1, posY - 1, 14, 14, 1, 255, 255, 255, 255);
+				renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_COLOR_BOX_DOWN_X, GUI_UI_ICON_COLOR_BOX_DOWN_Y, posX, posY, GUI_UI_ICON_COLOR_BOX_DOWN_W, GUI_UI_ICON_COLOR_BOX_DOWN_H);
+				renderer.drawRectangle(posX - 1, posY - 1, 14, 14, 1, 255, 255, 255, 255);
 			}
 			else
-				renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_COLOR_BOX_UP_X, (hoverC == c ? GUI_UI_ICON_COLOR_BOX_DOWN_Y : GUI_UI_ICON_COLOR_BOX_UP_Y), posX, posY, GUI_UI_ICON_COLOR_BOX_UP_W, GUI_UI_ICON_COLOR_BOX_UP_H);
+				renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_COLOR_BOX_UP_X, (hoverC == c ? GUI_UI_ICON_COLOR_BOX_DOWN_Y : GUI_UI_ICON_COLOR_BOX_UP_Y), posX, posY, GUI_UI_ICON_COLOR_BOX_UP_W, GUI_UI_ICON_COLOR_BOX_UP_H);
 			
 			++c;
 			posX += 13;
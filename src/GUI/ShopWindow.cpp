@@ -865,7 +865,7 @@ void GUI_ShopContainer::onRMouseUp(Sint32 x, Sint32 y)
 
 void GUI_ShopContainer::render()
 {
-	g_engine.getRender()->fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 64, 64, 64, 255);
+	g_engine.getRenderCommands().fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 64, 64, 64, 255);
 	GUI_Container::render();
 }
 
@@ -940,8 +940,8 @@ void GUI_ShopItem::setItemData(Uint16 itemId, Uint16 itemCount)
 
 void GUI_ShopItem::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 - 1, m_tRect.y1 - 1, m_tRect.x2 + 2, m_tRect.y2 + 2);
 	if(m_item)
 		m_item->render(m_tRect.x1, m_tRect.y1, m_tRect.y2);
 }
@@ -997,11 +997,11 @@ void GUI_ShopSelectItem::setRect(iRect& NewRect)
 
 void GUI_ShopSelectItem::render()
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_NPCActiveOffer == m_index)
-		g_engine.getRender()->fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 112, 112, 112, 255);
+		g_engine.getRenderCommands().fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 112, 112, 112, 255);
 
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 + 3, m_tRect.y1 + 1, 34, 34);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_INVENTORY_EMPTY_X, GUI_UI_INVENTORY_EMPTY_Y, m_tRect.x1 + 3, m_tRect.y1 + 1, 34, 34);
 	if(m_item)
 		m_item->render(m_tRect.x1 + 4, m_tRect.y1 + 2, 32);
 
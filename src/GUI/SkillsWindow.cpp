@@ -1493,7 +1493,7 @@ GUI_SkillSeparator::GUI_SkillSeparator(iRect boxRect, Uint32 internalID)
 
 void GUI_SkillSeparator::render()
 {
-	g_engine.getRender()->fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 176, 176, 176, 255);
+	g_engine.getRenderCommands().fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 176, 176, 176, 255);
 }
 
 GUI_SkillBar::GUI_SkillBar(iRect boxRect, Uint32 internalID)
@@ -1511,10 +1511,10 @@ void GUI_SkillBar::setPercent(Uint8 percent)
 
 void GUI_SkillBar::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 0, 0, 0, 255);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 0, 0, 0, 255);
 	if(m_percent > 0)
-		renderer->fillRectangle(m_tRect.x1 + 1, m_tRect.y1 + 1, m_percent, m_tRect.y2 - 2, m_red, m_green, m_blue, 255);
+		renderer.fillRectangle(m_tRect.x1 + 1, m_tRect.y1 + 1, m_percent, m_tRect.y2 - 2, m_red, m_green, m_blue, 255);
 }
 
 GUI_SkillDescription::GUI_SkillDescription(iRect boxRect, Uint32 internalID)
@@ -1222,19 +1222,19 @@ void GUI_VipIcon::onLMouseUp(Sint32, Sint32)
 
 void GUI_VipIcon::renderIcon(Uint32 iconId, Sint32 x, Sint32 y)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	switch(iconId)
 	{
-		case 1: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_001_X, GUI_UI_VIP_001_Y, x, y, GUI_UI_VIP_001_W, GUI_UI_VIP_001_H); break;
-		case 2: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_002_X, GUI_UI_VIP_002_Y, x, y, GUI_UI_VIP_002_W, GUI_UI_VIP_002_H); break;
-		case 3: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_003_X, GUI_UI_VIP_003_Y, x, y, GUI_UI_VIP_003_W, GUI_UI_VIP_003_H); break;
-		case 4: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_004_X, GUI_UI_VIP_004_Y, x, y, GUI_UI_VIP_004_W, GUI_UI_VIP_004_H); break;
-		case 5: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_005_X, GUI_UI_VIP_005_Y, x, y, GUI_UI_VIP_005_W, GUI_UI_VIP_005_H); break;
-		case 6: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_006_X, GUI_UI_VIP_006_Y, x, y, GUI_UI_VIP_006_W, GUI_UI_VIP_006_H); break;
-		case 7: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_007_X, GUI_UI_VIP_007_Y, x, y, GUI_UI_VIP_007_W, GUI_UI_VIP_007_H); break;
-		case 8: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_008_X, GUI_UI_VIP_008_Y, x, y, GUI_UI_VIP_008_W, GUI_UI_VIP_008_H); break;
-		case 9: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_009_X, GUI_UI_VIP_009_Y, x, y, GUI_UI_VIP_009_W, GUI_UI_VIP_009_H); break;
-		case 10: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_010_X, GUI_UI_VIP_010_Y, x, y, GUI_UI_VIP_010_W, GUI_UI_VIP_010_H); break;
+		case 1: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_001_X, GUI_UI_VIP_001_Y, x, y, GUI_UI_VIP_001_W, GUI_UI_VIP_001_H); break;
+		case 2: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_002_X, GUI_UI_VIP_002_Y, x, y, GUI_UI_VIP_002_W, GUI_UI_VIP_002_H); break;
+		case 3: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_003_X, GUI_UI_VIP_003_Y, x, y, GUI_UI_VIP_003_W, GUI_UI_VIP_003_H); break;
+		case 4: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_004_X, GUI_UI_VIP_004_Y, x, y, GUI_UI_VIP_004_W, GUI_UI_VIP_004_H); break;
+		case 5: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_005_X, GUI_UI_VIP_005_Y, x, y, GUI_UI_VIP_005_W, GUI_UI_VIP_005_H); break;
+		case 6: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_006_X, GUI_UI_VIP_006_Y, x, y, GUI_UI_VIP_006_W, GUI_UI_VIP_006_H); break;
+		case 7: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_007_X, GUI_UI_VIP_007_Y, x, y, GUI_UI_VIP_007_W, GUI_UI_VIP_007_H); break;
+		case 8: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_008_X, GUI_UI_VIP_008_Y, x, y, GUI_UI_VIP_008_W, GUI_UI_VIP_008_H); break;
+		case 9: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_009_X, GUI_UI_VIP_009_Y, x, y, GUI_UI_VIP_009_W, GUI_UI_VIP_009_H); break;
+		case 10: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_VIP_010_X, GUI_UI_VIP_010_Y, x, y, GUI_UI_VIP_010_W, GUI_UI_VIP_010_H); break;
 		default: break;
 	}
 }
@@ -1244,15 +1244,15 @@ void GUI_VipIcon::render()
 	bool pressed = (m_pressed == 1 ? true : false);
 	pressed = (m_iconId == g_vipIconId ? true : pressed);
 
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(pressed)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_DOWN_X, GUI_UI_ICON_TEXTURED_DOWN_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_DOWN_X, GUI_UI_ICON_TEXTURED_DOWN_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 		GUI_VipIcon::renderIcon(m_iconId, m_tRect.x1 + 3, m_tRect.y1 + 3);
 	}
 	else
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_UP_X, GUI_UI_ICON_TEXTURED_UP_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TEXTURED_UP_X, GUI_UI_ICON_TEXTURED_UP_Y, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 		GUI_VipIcon::renderIcon(m_iconId, m_tRect.x1 + 2, m_tRect.y1 + 2);
 	}
 }
@@ -182,8 +182,8 @@ void GUI_Button::render()
 {
 	bool pressed = (m_pressed == 1 ? true : false);
 
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 	g_engine.drawFont(CLIENT_FONT_SMALL, m_tRect.x1 + (m_tRect.x2 / 2) + (pressed ? 1 : 0) - m_startX, m_tRect.y1 + (pressed ? 7 : 6), m_label, 255, 255, 255, CLIENT_FONT_ALIGN_LEFT);
 }
 
@@ -218,7 +218,7 @@ void GUI_RadioButton::render()
 	if(m_eventRadioChecked && m_eventRadioChecked())
 		pressed = true;
 	
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(GUI_UI_IMAGE, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(GUI_UI_IMAGE, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 	g_engine.drawFont(CLIENT_FONT_SMALL, m_tRect.x1 + (m_tRect.x2 / 2) + (pressed ? 1 : 0) - m_startX, m_tRect.y1 + (pressed ? 7 : 6), m_label, 255, 255, 255, CLIENT_FONT_ALIGN_LEFT);
 }
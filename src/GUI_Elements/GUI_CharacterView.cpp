@@ -38,13 +38,13 @@ void GUI_CharacterView::render()
 	std::vector<CharacterDetail>& accountCharList = g_engine.getAccountCharList();
 	Sint32 lastSelectId = g_engine.getCharacterSelectId();
 
-	auto& renderer = g_engine.getRender();
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1, m_tRect.x2, 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1 + 1, 1, m_tRect.y2 - 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1 + 1, m_tRect.y1 + m_tRect.y2 - 1, m_tRect.x2 - 1, 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_tRect.x1 + m_tRect.x2 - 1, m_tRect.y1 + 1, 1, m_tRect.y2 - 2);
-	renderer->fillRectangle(m_tRect.x1 + 1, m_tRect.y1 + 1, m_tRect.x2 - 2, m_tRect.y2 - 2, 64, 64, 64, 255);
-	renderer->setClipRect(m_tRect.x1 + 1, m_tRect.y1 + 1, m_tRect.x2 - 2, m_tRect.y2 - 2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1, m_tRect.x2, 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1 + 1, 1, m_tRect.y2 - 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1 + 1, m_tRect.y1 + m_tRect.y2 - 1, m_tRect.x2 - 1, 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_tRect.x1 + m_tRect.x2 - 1, m_tRect.y1 + 1, 1, m_tRect.y2 - 2);
+	renderer.fillRectangle(m_tRect.x1 + 1, m_tRect.y1 + 1, m_tRect.x2 - 2, m_tRect.y2 - 2, 64, 64, 64, 255);
+	renderer.setClipRect(m_tRect.x1 + 1, m_tRect.y1 + 1, m_tRect.x2 - 2, m_tRect.y2 - 2);
 
 	CharacterDetail& character = accountCharList[SDL_static_cast(size_t, lastSelectId)];
 	ThingType* thingType = g_thingManager.getThingType(ThingCategory_Creature, character.lookType);
@@ -72,9 +72,9 @@ void GUI_CharacterView::render()
 					if(sprite != 0)
 					{
 						if(spriteMask != 0)
-							renderer->drawSpriteMask(sprite, spriteMask, drawX, drawY, outfitColors);
+							renderer.drawSpriteMask(sprite, spriteMask, drawX, drawY, outfitColors);
 						else
-							renderer->drawSprite(sprite, drawX, drawY);
+							renderer.drawSprite(sprite, drawX, drawY);
 					}
 					if(thingType->m_frameGroup[ThingFrameGroup_Idle].m_patternY > 1)
 					{
@@ -85,9 +85,9 @@ void GUI_CharacterView::render()
 							if(sprite != 0)
 							{
 								if(spriteMask != 0)
-									renderer->drawSpriteMask(sprite, spriteMask, drawX, drawY, outfitColors);
+									renderer.drawSpriteMask(sprite, spriteMask, drawX, drawY, outfitColors);
 								else
-									renderer->drawSprite(sprite, drawX, drawY);
+									renderer.drawSprite(sprite, drawX, drawY);
 							}
 						}
 						if(character.lookAddons & 2)//Second addon
@@ -97,9 +97,9 @@ void GUI_CharacterView::render()
 							if(sprite != 0)
 							{
 								if(spriteMask != 0)
-									renderer->drawSpriteMask(sprite, spriteMask, drawX, drawY, outfitColors);
+									renderer.drawSpriteMask(sprite, spriteMask, drawX, drawY, outfitColors);
 								else
-									renderer->drawSprite(sprite, drawX, drawY);
+									renderer.drawSprite(sprite, drawX, drawY);
 							}
 						}
 					}
@@ -119,20 +119,20 @@ void GUI_CharacterView::render()
 				{
 					Uint32 sprite = thingType->getSprite(ThingFrameGroup_Idle, x, y, 0, DIRECTION_SOUTH, 0, 0, currentAnim);
 					if(sprite != 0)
-						renderer->drawSprite(sprite, drawX, drawY);
+						renderer.drawSprite(sprite, drawX, drawY);
 					if(thingType->m_frameGroup[ThingFrameGroup_Idle].m_patternY > 1)
 					{
 						if(character.lookAddons & 1)//First addon
 						{
 							sprite = thingType->getSprite(ThingFrameGroup_Idle, x, y, 0, DIRECTION_SOUTH, 1, 0, currentAnim);
 							if(sprite != 0)
-								renderer->drawSprite(sprite, drawX, drawY);
+								renderer.drawSprite(sprite, drawX, drawY);
 						}
 						if(character.lookAddons & 2)//Second addon
 						{
 							sprite = thingType->getSprite(ThingFrameGroup_Idle, x, y, 0, DIRECTION_SOUTH, 2, 0, currentAnim);
 							if(sprite != 0)
-								renderer->drawSprite(sprite, drawX, drawY);
+								renderer.drawSprite(sprite, drawX, drawY);
 						}
 					}
 					drawX -= 32;
@@ -149,5 +149,5 @@ void GUI_CharacterView::render()
 	len = SDL_snprintf(g_buffer, sizeof(g_buffer), "%u/%u MP", character.mana, character.manaMax);
 	g_engine.drawFont(CLIENT_FONT_NONOUTLINED, m_tRect.x1 + 140, m_tRect.y1 + 46, std::string(g_buffer, SDL_static_cast(size_t, len)), 180, 180, 180, CLIENT_FONT_ALIGN_CENTER);
 	g_engine.drawFont(CLIENT_FONT_NONOUTLINED, m_tRect.x1 + 140, m_tRect.y1 + 62, character.vocName, 180, 180, 180, CLIENT_FONT_ALIGN_CENTER);
-	renderer->disableClipRect();
+	renderer.disableClipRect();
 }
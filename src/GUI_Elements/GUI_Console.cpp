@@ -544,7 +544,7 @@ void GUI_Console::render()
 		m_keepLastScrollPos = false;
 	}
 
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	m_scrollBar.render();
 
 	Sint32 count = m_scrollBar.getScrollPos();
@@ -561,7 +561,7 @@ void GUI_Console::render()
 
 		ConsoleLine& currentLine = (*it);
 		if(currentLine.selectionWidth != 0)
-			renderer->fillRectangle(m_tRect.x1 + currentLine.selectionStart, posY - 1, currentLine.selectionWidth, 14, 128, 128, 128, 255);
+			renderer.fillRectangle(m_tRect.x1 + currentLine.selectionStart, posY - 1, currentLine.selectionWidth, 14, 128, 128, 128, 255);
 
 		g_engine.drawFont(m_font, m_tRect.x1 + currentLine.startPosition, posY, m_sText, currentLine.red, currentLine.green, currentLine.blue, CLIENT_FONT_ALIGN_LEFT, currentLine.lineStart, currentLine.lineLength);
 		posY += 14;
@@ -263,8 +263,8 @@ void GUI_Container::render()
 	if(!m_visible)
 		return;
 
-	auto& renderer = g_engine.getRender();
-	renderer->setClipRect(m_tRect.x1, m_tRect.y1, m_tRect.x2 - 12, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.setClipRect(m_tRect.x1, m_tRect.y1, m_tRect.x2 - 12, m_tRect.y2);
 
 	Sint32 posY = m_tRect.y1 - (m_scrollBar.getScrollPos() * 4) + 10;
 	if(m_resetPosition || posY != m_lastPosY || m_tRect.x1 != m_lastPosX)
@@ -293,6 +293,6 @@ void GUI_Container::render()
 	for(std::vector<GUI_Element*>::iterator it = m_drawns.begin(), end = m_drawns.end(); it != end; ++it)
 		(*it)->render();
 
-	renderer->disableClipRect();
+	renderer.disableClipRect();
 	m_scrollBar.render();
 }
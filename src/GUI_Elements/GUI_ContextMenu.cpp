@@ -155,16 +155,16 @@ void GUI_ContextMenu::onMouseMove(Sint32 x, Sint32 y, bool isInsideParent)
 
 void GUI_ContextMenu::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_tRect.x1 + 3, m_tRect.y1 + 3, m_tRect.x2 - 6, m_tRect.y2 - 6);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPLEFT_BORDER_X, GUI_UI_ICON_TOPLEFT_BORDER_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_TOPLEFT_BORDER_W, GUI_UI_ICON_TOPLEFT_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPRIGHT_BORDER_X, GUI_UI_ICON_TOPRIGHT_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 3, m_tRect.y1, GUI_UI_ICON_TOPRIGHT_BORDER_W, GUI_UI_ICON_TOPRIGHT_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTLEFT_BORDER_X, GUI_UI_ICON_BOTLEFT_BORDER_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 3, GUI_UI_ICON_BOTLEFT_BORDER_W, GUI_UI_ICON_BOTLEFT_BORDER_H);
-	renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTRIGHT_BORDER_X, GUI_UI_ICON_BOTRIGHT_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 3, m_tRect.y1 + m_tRect.y2 - 3, GUI_UI_ICON_BOTRIGHT_BORDER_W, GUI_UI_ICON_BOTRIGHT_BORDER_H);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, m_tRect.x1 + 3, m_tRect.y1, m_tRect.x2 - 6, 3);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, m_tRect.x1, m_tRect.y1 + 3, 3, m_tRect.y2 - 6);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, m_tRect.x1 + 3, m_tRect.y1 + m_tRect.y2 - 3, m_tRect.x2 - 6, 3);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, m_tRect.x1 + m_tRect.x2 - 3, m_tRect.y1 + 3, 3, m_tRect.y2 - 6);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_tRect.x1 + 3, m_tRect.y1 + 3, m_tRect.x2 - 6, m_tRect.y2 - 6);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPLEFT_BORDER_X, GUI_UI_ICON_TOPLEFT_BORDER_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_TOPLEFT_BORDER_W, GUI_UI_ICON_TOPLEFT_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_TOPRIGHT_BORDER_X, GUI_UI_ICON_TOPRIGHT_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 3, m_tRect.y1, GUI_UI_ICON_TOPRIGHT_BORDER_W, GUI_UI_ICON_TOPRIGHT_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTLEFT_BORDER_X, GUI_UI_ICON_BOTLEFT_BORDER_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 3, GUI_UI_ICON_BOTLEFT_BORDER_W, GUI_UI_ICON_BOTLEFT_BORDER_H);
+	renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_BOTRIGHT_BORDER_X, GUI_UI_ICON_BOTRIGHT_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 3, m_tRect.y1 + m_tRect.y2 - 3, GUI_UI_ICON_BOTRIGHT_BORDER_W, GUI_UI_ICON_BOTRIGHT_BORDER_H);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, m_tRect.x1 + 3, m_tRect.y1, m_tRect.x2 - 6, 3);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, m_tRect.x1, m_tRect.y1 + 3, 3, m_tRect.y2 - 6);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_DIVIDER_X, GUI_UI_ICON_HORIZONTAL_DIVIDER_Y, GUI_UI_ICON_HORIZONTAL_DIVIDER_W, GUI_UI_ICON_HORIZONTAL_DIVIDER_H, m_tRect.x1 + 3, m_tRect.y1 + m_tRect.y2 - 3, m_tRect.x2 - 6, 3);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_DIVIDER_X, GUI_UI_ICON_VERTICAL_DIVIDER_Y, GUI_UI_ICON_VERTICAL_DIVIDER_W, GUI_UI_ICON_VERTICAL_DIVIDER_H, m_tRect.x1 + m_tRect.x2 - 3, m_tRect.y1 + 3, 3, m_tRect.y2 - 6);
 
 	Sint32 startY = m_tRect.y1 + 6, index = 0;
 	bool nextLineSeparator = false;
@@ -172,12 +172,12 @@ void GUI_ContextMenu::render()
 	{
 		if(nextLineSeparator)
 		{
-			renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_SEPARATOR_X, GUI_UI_ICON_HORIZONTAL_SEPARATOR_Y, GUI_UI_ICON_HORIZONTAL_SEPARATOR_W, GUI_UI_ICON_HORIZONTAL_SEPARATOR_H, m_tRect.x1 + 4, startY - 2, m_tRect.x2 - 8, 2);
+			renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_SEPARATOR_X, GUI_UI_ICON_HORIZONTAL_SEPARATOR_Y, GUI_UI_ICON_HORIZONTAL_SEPARATOR_W, GUI_UI_ICON_HORIZONTAL_SEPARATOR_H, m_tRect.x1 + 4, startY - 2, m_tRect.x2 - 8, 2);
 			startY += 8;
 			nextLineSeparator = false;
 		}
 		if(m_hoverEvent == index)
-			renderer->fillRectangle(m_tRect.x1 + 4, startY - 2, m_tRect.x2 - 8, 16, 128, 128, 128, 255);
+			renderer.fillRectangle(m_tRect.x1 + 4, startY - 2, m_tRect.x2 - 8, 16, 128, 128, 128, 255);
 
 		if((*it).childStyle & CONTEXTMENU_STYLE_SEPARATED)
 			nextLineSeparator = true;
@@ -185,12 +185,12 @@ void GUI_ContextMenu::render()
 			g_engine.drawFont(CLIENT_FONT_OUTLINED, m_tRect.x1 + 6, startY, (*it).text, 223, 223, 223, CLIENT_FONT_ALIGN_LEFT);
 		if((*it).childStyle & CONTEXTMENU_STYLE_CHECKED)
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_CHECKBOX_CHECKED_X, GUI_UI_CHECKBOX_CHECKED_Y, m_tRect.x1 + 6, startY, GUI_UI_CHECKBOX_CHECKED_W, GUI_UI_CHECKBOX_CHECKED_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_CHECKBOX_CHECKED_X, GUI_UI_CHECKBOX_CHECKED_Y, m_tRect.x1 + 6, startY, GUI_UI_CHECKBOX_CHECKED_W, GUI_UI_CHECKBOX_CHECKED_H);
 			g_engine.drawFont(CLIENT_FONT_OUTLINED, m_tRect.x1 + 22, startY, (*it).text, 223, 223, 223, CLIENT_FONT_ALIGN_LEFT);
 		}
 		if((*it).childStyle & CONTEXTMENU_STYLE_UNCHECKED)
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_CHECKBOX_UNCHECKED_X, GUI_UI_CHECKBOX_UNCHECKED_Y, m_tRect.x1 + 6, startY, GUI_UI_CHECKBOX_UNCHECKED_W, GUI_UI_CHECKBOX_UNCHECKED_H);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_CHECKBOX_UNCHECKED_X, GUI_UI_CHECKBOX_UNCHECKED_Y, m_tRect.x1 + 6, startY, GUI_UI_CHECKBOX_UNCHECKED_W, GUI_UI_CHECKBOX_UNCHECKED_H);
 			g_engine.drawFont(CLIENT_FONT_OUTLINED, m_tRect.x1 + 22, startY, (*it).text, 223, 223, 223, CLIENT_FONT_ALIGN_LEFT);
 		}
 		if(!(*it).shortcut.empty())
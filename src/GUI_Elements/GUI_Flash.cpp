@@ -65,6 +65,6 @@ void GUI_Flash::render()
 		return;
 	}
 
-	auto& renderer = g_engine.getRender();
-	renderer->drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 255, 160, 0, 255);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 1, 255, 160, 0, 255);
 }
@@ -88,8 +88,8 @@ void GUI_Icon::render()
 {
 	bool pressed = (m_pressed == 1 ? true : false);
 
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(m_picture, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(m_picture, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 }
 
 void GUI_RadioIcon::setRadioEventCallback(bool (*eventRadioChecked)(void), const std::string description)
@@ -123,6 +123,6 @@ void GUI_RadioIcon::render()
 	if(m_eventRadioChecked && m_eventRadioChecked())
 		pressed = true;
 
-	auto& renderer = g_engine.getRender();
-	renderer->drawPicture(m_picture, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPicture(m_picture, m_sx[(pressed ? 1 : 0)], m_sy[(pressed ? 1 : 0)], m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 }
@@ -94,8 +94,8 @@ void GUI_Log::onMouseMove(Sint32 x, Sint32 y, bool isInsideParent)
 
 void GUI_Log::render(Sint32 x, Sint32 y, Sint32 w, Sint32 h)
 {
-	auto& renderer = g_engine.getRender();
-	renderer->fillRectangle(x, y, w - 12, h, 0, 0, 0, 128);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.fillRectangle(x, y, w - 12, h, 0, 0, 0, 128);
 
 	iRect nRect = iRect(x, y, w, h);
 	m_console->setRect(nRect);
@@ -330,33 +330,33 @@ void GUI_PanelWindow::onMoveNormal(Sint32 x, Sint32 y)
 
 void GUI_PanelWindow::render()
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_bMouseDragging)
-		renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_DARKGREY_X, GUI_UI_BACKGROUND_DARKGREY_Y, GUI_UI_BACKGROUND_DARKGREY_W, GUI_UI_BACKGROUND_DARKGREY_H, m_nRect.x1, m_nRect.y1, m_nRect.x2, m_nRect.y2);
+		renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_DARKGREY_X, GUI_UI_BACKGROUND_DARKGREY_Y, GUI_UI_BACKGROUND_DARKGREY_W, GUI_UI_BACKGROUND_DARKGREY_H, m_nRect.x1, m_nRect.y1, m_nRect.x2, m_nRect.y2);
 	if(m_windowed)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_LEFT_CENTER_X, GUI_UI_ICON_PWINDOW_LEFT_CENTER_Y, m_tRect.x1 - 2, m_tRect.y1 - 2, GUI_UI_ICON_PWINDOW_LEFT_CENTER_W, GUI_UI_ICON_PWINDOW_LEFT_CENTER_H);
-		renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_TOP_CENTER_X, GUI_UI_ICON_PWINDOW_TOP_CENTER_Y, GUI_UI_ICON_PWINDOW_TOP_CENTER_W, GUI_UI_ICON_PWINDOW_TOP_CENTER_H, m_tRect.x1 + 2, m_tRect.y1 - 2, m_tRect.x2 - 4, 15);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_X, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_Y, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 - 2, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_W, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_X, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_Y, m_tRect.x1 - 2, m_tRect.y1 + m_tRect.y2 - 6, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_W, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_H);
-		renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_BOTTOM_SLIDER_X, GUI_UI_ICON_BOTTOM_SLIDER_Y, GUI_UI_ICON_BOTTOM_SLIDER_W, GUI_UI_ICON_BOTTOM_SLIDER_H, m_tRect.x1 + 2, m_tRect.y1 + m_tRect.y2 - 6, m_tRect.x2 - 4, 4);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_X, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + m_tRect.y2 - 6, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_W, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_LEFT_CENTER_X, GUI_UI_ICON_PWINDOW_LEFT_CENTER_Y, m_tRect.x1 - 2, m_tRect.y1 - 2, GUI_UI_ICON_PWINDOW_LEFT_CENTER_W, GUI_UI_ICON_PWINDOW_LEFT_CENTER_H);
+		renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_TOP_CENTER_X, GUI_UI_ICON_PWINDOW_TOP_CENTER_Y, GUI_UI_ICON_PWINDOW_TOP_CENTER_W, GUI_UI_ICON_PWINDOW_TOP_CENTER_H, m_tRect.x1 + 2, m_tRect.y1 - 2, m_tRect.x2 - 4, 15);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_X, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_Y, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 - 2, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_W, GUI_UI_ICON_PWINDOW_RIGHT_CENTER_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_X, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_Y, m_tRect.x1 - 2, m_tRect.y1 + m_tRect.y2 - 6, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_W, GUI_UI_ICON_PWINDOW_BOTLEFT_BORDER_H);
+		renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_BOTTOM_SLIDER_X, GUI_UI_ICON_BOTTOM_SLIDER_Y, GUI_UI_ICON_BOTTOM_SLIDER_W, GUI_UI_ICON_BOTTOM_SLIDER_H, m_tRect.x1 + 2, m_tRect.y1 + m_tRect.y2 - 6, m_tRect.x2 - 4, 4);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_X, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_Y, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + m_tRect.y2 - 6, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_W, GUI_UI_ICON_PWINDOW_BOTRIGHT_BORDER_H);
 		if(!m_bMouseDragging)
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, m_tRect.x1 + m_tRect.x2, m_tRect.y1 + m_tRect.y2 - 2, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
-			renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1 - 2, m_tRect.y1 + m_tRect.y2 - 2, m_tRect.x2 + 2, 2);
+			renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_EXTRA_BORDER_X, GUI_UI_ICON_EXTRA_BORDER_Y, m_tRect.x1 + m_tRect.x2, m_tRect.y1 + m_tRect.y2 - 2, GUI_UI_ICON_EXTRA_BORDER_W, GUI_UI_ICON_EXTRA_BORDER_H);
+			renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1 - 2, m_tRect.y1 + m_tRect.y2 - 2, m_tRect.x2 + 2, 2);
 		}
 		if(m_tRect.y2 > 19)
 		{
-			renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_tRect.x1 + 2, m_tRect.y1 + 13, m_tRect.x2 - 4, m_tRect.y2 - 19);
-			renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_LEFT_SLIDER_X, GUI_UI_ICON_LEFT_SLIDER_Y, GUI_UI_ICON_LEFT_SLIDER_W, GUI_UI_ICON_LEFT_SLIDER_H, m_tRect.x1 - 2, m_tRect.y1 + 13, 4, m_tRect.y2 - 19);
-			renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_RIGHT_SLIDER_X, GUI_UI_ICON_RIGHT_SLIDER_Y, GUI_UI_ICON_RIGHT_SLIDER_W, GUI_UI_ICON_RIGHT_SLIDER_H, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + 13, 4, m_tRect.y2 - 19);
+			renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_tRect.x1 + 2, m_tRect.y1 + 13, m_tRect.x2 - 4, m_tRect.y2 - 19);
+			renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_LEFT_SLIDER_X, GUI_UI_ICON_LEFT_SLIDER_Y, GUI_UI_ICON_LEFT_SLIDER_W, GUI_UI_ICON_LEFT_SLIDER_H, m_tRect.x1 - 2, m_tRect.y1 + 13, 4, m_tRect.y2 - 19);
+			renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_RIGHT_SLIDER_X, GUI_UI_ICON_RIGHT_SLIDER_Y, GUI_UI_ICON_RIGHT_SLIDER_W, GUI_UI_ICON_RIGHT_SLIDER_H, m_tRect.x1 + m_tRect.x2 - 2, m_tRect.y1 + 13, 4, m_tRect.y2 - 19);
 		}
 	}
 	else
-		renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+		renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 	for(std::vector<GUI_Element*>::iterator it = m_childs.begin(), end = m_childs.end(); it != end; ++it)
 		(*it)->render();
 	if(m_windowed && m_tRect.y2 > 19)
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_RESIZER_X, GUI_UI_ICON_PWINDOW_RESIZER_Y, m_tRect.x1 + 1, m_tRect.y1 + m_tRect.y2 - 21, GUI_UI_ICON_PWINDOW_RESIZER_W, GUI_UI_ICON_PWINDOW_RESIZER_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_PWINDOW_RESIZER_X, GUI_UI_ICON_PWINDOW_RESIZER_Y, m_tRect.x1 + 1, m_tRect.y1 + m_tRect.y2 - 21, GUI_UI_ICON_PWINDOW_RESIZER_W, GUI_UI_ICON_PWINDOW_RESIZER_H);
 }
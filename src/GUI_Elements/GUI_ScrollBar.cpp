@@ -185,12 +185,12 @@ void GUI_HScrollBar::onWheel(Sint32, Sint32, bool wheelUP)
 
 void GUI_HScrollBar::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_X, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_Y, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_W, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_H, m_tRect.x1 + 12, m_tRect.y1, m_tRect.x2 - 24, 12);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_X, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_Y, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_W, GUI_UI_ICON_SCROLLBAR_HORIZONTAL_TEXTURE_H, m_tRect.x1 + 12, m_tRect.y1, m_tRect.x2 - 24, 12);
 	if(m_buttonDown == 1)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_X, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_W, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_X, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_Y, m_tRect.x1 + m_tRect.x2 - 12, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_W, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_X, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_W, GUI_UI_ICON_SCROLLBAR_LEFT_DOWN_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_X, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_Y, m_tRect.x1 + m_tRect.x2 - 12, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_W, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_H);
 		if(g_frameTime - m_lastUpdate >= 100)
 		{
 			m_lastUpdate = g_frameTime;
@@ -199,8 +199,8 @@ void GUI_HScrollBar::render()
 	}
 	else if(m_buttonDown == 2)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_LEFT_UP_X, GUI_UI_ICON_SCROLLBAR_LEFT_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_LEFT_UP_W, GUI_UI_ICON_SCROLLBAR_LEFT_UP_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_X, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_Y, m_tRect.x1 + m_tRect.x2 - 12, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_W, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_LEFT_UP_X, GUI_UI_ICON_SCROLLBAR_LEFT_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_LEFT_UP_W, GUI_UI_ICON_SCROLLBAR_LEFT_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_X, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_Y, m_tRect.x1 + m_tRect.x2 - 12, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_W, GUI_UI_ICON_SCROLLBAR_RIGHT_DOWN_H);
 		if(g_frameTime - m_lastUpdate >= 100)
 		{
 			m_lastUpdate = g_frameTime;
@@ -209,8 +209,8 @@ void GUI_HScrollBar::render()
 	}
 	else
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_LEFT_UP_X, GUI_UI_ICON_SCROLLBAR_LEFT_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_LEFT_UP_W, GUI_UI_ICON_SCROLLBAR_LEFT_UP_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_X, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_Y, m_tRect.x1 + m_tRect.x2 - 12, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_W, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_LEFT_UP_X, GUI_UI_ICON_SCROLLBAR_LEFT_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_LEFT_UP_W, GUI_UI_ICON_SCROLLBAR_LEFT_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_X, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_Y, m_tRect.x1 + m_tRect.x2 - 12, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_W, GUI_UI_ICON_SCROLLBAR_RIGHT_UP_H);
 		if(m_buttonDown == 4 && g_frameTime - m_lastUpdate >= 200)
 		{
 			m_lastUpdate = g_frameTime;
@@ -237,12 +237,12 @@ void GUI_HScrollBar::render()
 
 	if(m_haveHandle)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1 + 12 + m_scrollPos[1], m_tRect.y1, 6, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X + 6, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1 + 12 + m_scrollPos[1] + m_scrollPos[0] + 6, m_tRect.y1, 6, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
-		renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_X, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_Y, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_W, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_H, m_tRect.x1 + 12 + m_scrollPos[1] + 6, m_tRect.y1, m_scrollPos[0], GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1 + 12 + m_scrollPos[1], m_tRect.y1, 6, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X + 6, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1 + 12 + m_scrollPos[1] + m_scrollPos[0] + 6, m_tRect.y1, 6, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
+		renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_X, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_Y, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_W, GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_H, m_tRect.x1 + 12 + m_scrollPos[1] + 6, m_tRect.y1, m_scrollPos[0], GUI_UI_ICON_SCROLLBAR_HANDLE_HORIZONTAL_H);
 	}
 	else
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1 + 12 + m_scrollPos[0], m_tRect.y1, GUI_UI_ICON_SCROLLBAR_HANDLE_W, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1 + 12 + m_scrollPos[0], m_tRect.y1, GUI_UI_ICON_SCROLLBAR_HANDLE_W, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
 }
 
 GUI_VScrollBar::GUI_VScrollBar(iRect boxRect, Sint32 sSize, Sint32 sPos, Uint32 internalID)
@@ -405,12 +405,12 @@ void GUI_VScrollBar::onWheel(Sint32, Sint32, bool wheelUP)
 
 void GUI_VScrollBar::render()
 {
-	auto& renderer = g_engine.getRender();
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_X, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_Y, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_W, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_H, m_tRect.x1, m_tRect.y1 + 12, 12, m_tRect.y2 - 24);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_X, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_Y, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_W, GUI_UI_ICON_SCROLLBAR_VERTICAL_TEXTURE_H, m_tRect.x1, m_tRect.y1 + 12, 12, m_tRect.y2 - 24);
 	if(m_buttonDown == 1)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_UP_DOWN_X, GUI_UI_ICON_SCROLLBAR_UP_DOWN_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_UP_DOWN_W, GUI_UI_ICON_SCROLLBAR_UP_DOWN_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_DOWN_UP_X, GUI_UI_ICON_SCROLLBAR_DOWN_UP_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 12, GUI_UI_ICON_SCROLLBAR_DOWN_UP_W, GUI_UI_ICON_SCROLLBAR_DOWN_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_UP_DOWN_X, GUI_UI_ICON_SCROLLBAR_UP_DOWN_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_UP_DOWN_W, GUI_UI_ICON_SCROLLBAR_UP_DOWN_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_DOWN_UP_X, GUI_UI_ICON_SCROLLBAR_DOWN_UP_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 12, GUI_UI_ICON_SCROLLBAR_DOWN_UP_W, GUI_UI_ICON_SCROLLBAR_DOWN_UP_H);
 		if(g_frameTime - m_lastUpdate >= 100)
 		{
 			m_lastUpdate = g_frameTime;
@@ -419,8 +419,8 @@ void GUI_VScrollBar::render()
 	}
 	else if(m_buttonDown == 2)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_UP_UP_X, GUI_UI_ICON_SCROLLBAR_UP_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_UP_UP_W, GUI_UI_ICON_SCROLLBAR_UP_UP_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_X, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 12, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_W, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_UP_UP_X, GUI_UI_ICON_SCROLLBAR_UP_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_UP_UP_W, GUI_UI_ICON_SCROLLBAR_UP_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_X, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 12, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_W, GUI_UI_ICON_SCROLLBAR_DOWN_DOWN_H);
 		if(g_frameTime - m_lastUpdate >= 100)
 		{
 			m_lastUpdate = g_frameTime;
@@ -429,8 +429,8 @@ void GUI_VScrollBar::render()
 	}
 	else
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_UP_UP_X, GUI_UI_ICON_SCROLLBAR_UP_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_UP_UP_W, GUI_UI_ICON_SCROLLBAR_UP_UP_H);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_DOWN_UP_X, GUI_UI_ICON_SCROLLBAR_DOWN_UP_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 12, GUI_UI_ICON_SCROLLBAR_DOWN_UP_W, GUI_UI_ICON_SCROLLBAR_DOWN_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_UP_UP_X, GUI_UI_ICON_SCROLLBAR_UP_UP_Y, m_tRect.x1, m_tRect.y1, GUI_UI_ICON_SCROLLBAR_UP_UP_W, GUI_UI_ICON_SCROLLBAR_UP_UP_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_DOWN_UP_X, GUI_UI_ICON_SCROLLBAR_DOWN_UP_Y, m_tRect.x1, m_tRect.y1 + m_tRect.y2 - 12, GUI_UI_ICON_SCROLLBAR_DOWN_UP_W, GUI_UI_ICON_SCROLLBAR_DOWN_UP_H);
 		if(m_buttonDown == 4 && g_frameTime - m_lastUpdate >= 200)
 		{
 			m_lastUpdate = g_frameTime;
@@ -457,10 +457,10 @@ void GUI_VScrollBar::render()
 
 	if(m_haveHandle)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[1], GUI_UI_ICON_SCROLLBAR_HANDLE_W, 6);
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y + 6, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[1] + m_scrollPos[0] + 6, GUI_UI_ICON_SCROLLBAR_HANDLE_W, 6);
-		renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_X, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_Y, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_W, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_H, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[1] + 6, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_W, m_scrollPos[0]);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[1], GUI_UI_ICON_SCROLLBAR_HANDLE_W, 6);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y + 6, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[1] + m_scrollPos[0] + 6, GUI_UI_ICON_SCROLLBAR_HANDLE_W, 6);
+		renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_X, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_Y, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_W, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_H, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[1] + 6, GUI_UI_ICON_SCROLLBAR_HANDLE_VERTICAL_W, m_scrollPos[0]);
 	}
 	else
-		renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[0], GUI_UI_ICON_SCROLLBAR_HANDLE_W, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
+		renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_SCROLLBAR_HANDLE_X, GUI_UI_ICON_SCROLLBAR_HANDLE_Y, m_tRect.x1, m_tRect.y1 + 12 + m_scrollPos[0], GUI_UI_ICON_SCROLLBAR_HANDLE_W, GUI_UI_ICON_SCROLLBAR_HANDLE_H);
 }
@@ -40,5 +40,5 @@ void GUI_StaticImage::onMouseMove(Sint32 x, Sint32 y, bool isInsideParent)
 
 void GUI_StaticImage::render()
 {
-	g_engine.getRender()->drawPicture(m_pictureId, m_pictureX, m_pictureY, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
+	g_engine.getRenderCommands().drawPicture(m_pictureId, m_pictureX, m_pictureY, m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2);
 }
@@ -306,26 +306,26 @@ void GUI_TextBox::render()
 		m_bShowCursor = !m_bShowCursor;
 	}
 
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	Uint32 numberOfLetters = getNumberOfLettersToShow();
-	renderer->fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 54, 54, 54, 255);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1, m_tRect.x2, 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1 + 1, 1, m_tRect.y2 - 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1 + 1, m_tRect.y1 + m_tRect.y2 - 1, m_tRect.x2 - 1, 1);
-	renderer->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_tRect.x1 + m_tRect.x2 - 1, m_tRect.y1 + 1, 1, m_tRect.y2 - 2);
+	renderer.fillRectangle(m_tRect.x1, m_tRect.y1, m_tRect.x2, m_tRect.y2, 54, 54, 54, 255);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1, m_tRect.x2, 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_tRect.x1, m_tRect.y1 + 1, 1, m_tRect.y2 - 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_tRect.x1 + 1, m_tRect.y1 + m_tRect.y2 - 1, m_tRect.x2 - 1, 1);
+	renderer.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_tRect.x1 + m_tRect.x2 - 1, m_tRect.y1 + 1, 1, m_tRect.y2 - 2);
 	if(hasSelection())
 	{
 		Uint32 selectionStart = UTIL_max<Uint32>(m_positionOfFirstShownLetter, m_selectionStart);
 		Uint32 selectionLen = UTIL_min<Uint32>(m_positionOfFirstShownLetter + numberOfLetters, m_selectionEnd) - selectionStart;
 		Uint32 selectionWidth = g_engine.calculateFontWidth(m_font, m_sVisibleText, selectionStart, selectionLen);
 		Uint32 positionOfSelection = m_textStartPosition + g_engine.calculateFontWidth(m_font, m_sVisibleText, m_positionOfFirstShownLetter, selectionStart - m_positionOfFirstShownLetter);
-		renderer->fillRectangle(m_tRect.x1 + positionOfSelection, m_tRect.y1 + 2, selectionWidth, m_tRect.y2 - 4, 128, 128, 128, 255);
+		renderer.fillRectangle(m_tRect.x1 + positionOfSelection, m_tRect.y1 + 2, selectionWidth, m_tRect.y2 - 4, 128, 128, 128, 255);
 	}
 	g_engine.drawFont(m_font, m_tRect.x1 + m_textStartPosition, m_tRect.y1 + 3, m_sVisibleText, m_red, m_green, m_blue, CLIENT_FONT_ALIGN_LEFT, m_positionOfFirstShownLetter, numberOfLetters);
 	if(m_bActive && m_bShowCursor)
 	{
 		Uint32 positionOfCursor = m_textStartPosition + g_engine.calculateFontWidth(m_font, m_sVisibleText, m_positionOfFirstShownLetter, m_cursorRelativePosition);
-		renderer->fillRectangle(m_tRect.x1 + positionOfCursor, m_tRect.y1 + 2, 1, m_tRect.y2 - 4, 255, 255, 255, 255);
+		renderer.fillRectangle(m_tRect.x1 + positionOfCursor, m_tRect.y1 + 2, 1, m_tRect.y2 - 4, 255, 255, 255, 255);
 	}
 }
 
@@ -64,34 +64,36 @@ MapMark* AutomapArea::getMark(Sint32 zoom, Sint32 diff, Sint32 x, Sint32 y, Sint
 
 void AutomapArea::render(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh)
 {
+	//The backend updates the tile texture right away so it can't wait in the command list
+	g_engine.getRenderCommands().flush();
 	g_engine.getRender()->drawAutomapTile(m_currentArea, m_recreate, m_color, x, y, w, h, sx, sy, sw, sh);
 }
 
 void AutomapArea::renderMark(Uint8 type, Sint32 x, Sint32 y)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	switch(type)
 	{
-		case MAPMARK_TICK: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_TICK_X, GUI_UI_ICON_MINIMAP_MARK_TICK_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_TICK_W, GUI_UI_ICON_MINIMAP_MARK_TICK_H); break;
-		case MAPMARK_QUESTION: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_QUESTION_X, GUI_UI_ICON_MINIMAP_MARK_QUESTION_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_QUESTION_W, GUI_UI_ICON_MINIMAP_MARK_QUESTION_H); break;
-		case MAPMARK_EXCLAMATION: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_X, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_W, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_H); break;
-		case MAPMARK_STAR: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_STAR_X, GUI_UI_ICON_MINIMAP_MARK_STAR_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_STAR_W, GUI_UI_ICON_MINIMAP_MARK_STAR_H); break;
-		case MAPMARK_CROSS: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_CROSS_X, GUI_UI_ICON_MINIMAP_MARK_CROSS_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_CROSS_W, GUI_UI_ICON_MINIMAP_MARK_CROSS_H); break;
-		case MAPMARK_TEMPLE: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_X, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_W, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_H); break;
-		case MAPMARK_KISS: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_KISS_X, GUI_UI_ICON_MINIMAP_MARK_KISS_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_KISS_W, GUI_UI_ICON_MINIMAP_MARK_KISS_H); break;
-		case MAPMARK_REDNORTH: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_X, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_W, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_H); break;
-		case MAPMARK_REDEAST: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDEAST_X, GUI_UI_ICON_MINIMAP_MARK_REDEAST_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDEAST_W, GUI_UI_ICON_MINIMAP_MARK_REDEAST_H); break;
-		case MAPMARK_GREENNORTH: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_X, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_W, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_H); break;
-		case MAPMARK_SHOVEL: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_X, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_W, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_H); break;
-		case MAPMARK_SWORD: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_SWORD_X, GUI_UI_ICON_MINIMAP_MARK_SWORD_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_SWORD_W, GUI_UI_ICON_MINIMAP_MARK_SWORD_H); break;
-		case MAPMARK_FLAG: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_FLAG_X, GUI_UI_ICON_MINIMAP_MARK_FLAG_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_FLAG_W, GUI_UI_ICON_MINIMAP_MARK_FLAG_H); break;
-		case MAPMARK_LOCK: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_LOCK_X, GUI_UI_ICON_MINIMAP_MARK_LOCK_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_LOCK_W, GUI_UI_ICON_MINIMAP_MARK_LOCK_H); break;
-		case MAPMARK_BAG: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_BAG_X, GUI_UI_ICON_MINIMAP_MARK_BAG_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_BAG_W, GUI_UI_ICON_MINIMAP_MARK_BAG_H); break;
-		case MAPMARK_SKULL: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_SKULL_X, GUI_UI_ICON_MINIMAP_MARK_SKULL_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_SKULL_W, GUI_UI_ICON_MINIMAP_MARK_SKULL_H); break;
-		case MAPMARK_DOLLAR: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_X, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_W, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_H); break;
-		case MAPMARK_REDSOUTH: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_X, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_W, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_H); break;
-		case MAPMARK_REDWEST: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDWEST_X, GUI_UI_ICON_MINIMAP_MARK_REDWEST_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDWEST_W, GUI_UI_ICON_MINIMAP_MARK_REDWEST_H); break;
-		case MAPMARK_GREENSOUTH: renderer->drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_X, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_W, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_H); break;
+		case MAPMARK_TICK: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_TICK_X, GUI_UI_ICON_MINIMAP_MARK_TICK_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_TICK_W, GUI_UI_ICON_MINIMAP_MARK_TICK_H); break;
+		case MAPMARK_QUESTION: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_QUESTION_X, GUI_UI_ICON_MINIMAP_MARK_QUESTION_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_QUESTION_W, GUI_UI_ICON_MINIMAP_MARK_QUESTION_H); break;
+		case MAPMARK_EXCLAMATION: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_X, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_W, GUI_UI_ICON_MINIMAP_MARK_EXCLAMATION_H); break;
+		case MAPMARK_STAR: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_STAR_X, GUI_UI_ICON_MINIMAP_MARK_STAR_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_STAR_W, GUI_UI_ICON_MINIMAP_MARK_STAR_H); break;
+		case MAPMARK_CROSS: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_CROSS_X, GUI_UI_ICON_MINIMAP_MARK_CROSS_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_CROSS_W, GUI_UI_ICON_MINIMAP_MARK_CROSS_H); break;
+		case MAPMARK_TEMPLE: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_X, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_W, GUI_UI_ICON_MINIMAP_MARK_TEMPLE_H); break;
+		case MAPMARK_KISS: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_KISS_X, GUI_UI_ICON_MINIMAP_MARK_KISS_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_KISS_W, GUI_UI_ICON_MINIMAP_MARK_KISS_H); break;
+		case MAPMARK_REDNORTH: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_X, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_W, GUI_UI_ICON_MINIMAP_MARK_REDNORTH_H); break;
+		case MAPMARK_REDEAST: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDEAST_X, GUI_UI_ICON_MINIMAP_MARK_REDEAST_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDEAST_W, GUI_UI_ICON_MINIMAP_MARK_REDEAST_H); break;
+		case MAPMARK_GREENNORTH: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_X, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_W, GUI_UI_ICON_MINIMAP_MARK_GREENNORTH_H); break;
+		case MAPMARK_SHOVEL: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_X, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_W, GUI_UI_ICON_MINIMAP_MARK_SHOVEL_H); break;
+		case MAPMARK_SWORD: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_SWORD_X, GUI_UI_ICON_MINIMAP_MARK_SWORD_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_SWORD_W, GUI_UI_ICON_MINIMAP_MARK_SWORD_H); break;
+		case MAPMARK_FLAG: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_FLAG_X, GUI_UI_ICON_MINIMAP_MARK_FLAG_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_FLAG_W, GUI_UI_ICON_MINIMAP_MARK_FLAG_H); break;
+		case MAPMARK_LOCK: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_LOCK_X, GUI_UI_ICON_MINIMAP_MARK_LOCK_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_LOCK_W, GUI_UI_ICON_MINIMAP_MARK_LOCK_H); break;
+		case MAPMARK_BAG: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_BAG_X, GUI_UI_ICON_MINIMAP_MARK_BAG_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_BAG_W, GUI_UI_ICON_MINIMAP_MARK_BAG_H); break;
+		case MAPMARK_SKULL: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_SKULL_X, GUI_UI_ICON_MINIMAP_MARK_SKULL_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_SKULL_W, GUI_UI_ICON_MINIMAP_MARK_SKULL_H); break;
+		case MAPMARK_DOLLAR: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_X, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_W, GUI_UI_ICON_MINIMAP_MARK_DOLLAR_H); break;
+		case MAPMARK_REDSOUTH: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_X, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_W, GUI_UI_ICON_MINIMAP_MARK_REDSOUTH_H); break;
+		case MAPMARK_REDWEST: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_REDWEST_X, GUI_UI_ICON_MINIMAP_MARK_REDWEST_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_REDWEST_W, GUI_UI_ICON_MINIMAP_MARK_REDWEST_H); break;
+		case MAPMARK_GREENSOUTH: renderer.drawPicture(GUI_UI_IMAGE, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_X, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_Y, x, y, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_W, GUI_UI_ICON_MINIMAP_MARK_GREENSOUTH_H); break;
 		default: break;
 	}
 }
@@ -336,8 +338,8 @@ void Automap::setTileDetail(Uint16 x, Uint16 y, Uint8 z, Uint8 color, Uint8 spee
 void Automap::render(Sint32 x, Sint32 y, Sint32 w, Sint32 h)
 {
 	Sint32 zoom = m_zoom;
-	auto& renderer = g_engine.getRender();
-	renderer->setClipRect(x, y, w, h);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.setClipRect(x, y, w, h);
 
 	//Coordinates of the top-left, bottom-right minimap corner
 	Sint32 x1 = m_position.x - SDL_static_cast(Sint32, (w / 2.0f / zoom));
@@ -413,12 +415,12 @@ void Automap::render(Sint32 x, Sint32 y, Sint32 w, Sint32 h)
 	{
 		Sint32 posX = x + m_diff - 3 + (m_centerPosition.x - x1) * zoom;
 		Sint32 posY = y + m_diff - 3 + (m_centerPosition.y - y1) * zoom;
-		renderer->fillRectangle(posX + 2, posY, 2, 6, 255, 255, 255, 255);
-		renderer->fillRectangle(posX, posY + 2, 6, 2, 255, 255, 255, 255);
+		renderer.fillRectangle(posX + 2, posY, 2, 6, 255, 255, 255, 255);
+		renderer.fillRectangle(posX, posY + 2, 6, 2, 255, 255, 255, 255);
 	}
 	for(std::vector<AutomapArea*>::iterator it = cachedAreas.begin(), end = cachedAreas.end(); it != end; ++it)
 		(*it)->renderMarks(m_zoom, m_diff, x, y, x1, y1, x2, y2);
-	renderer->disableClipRect();
+	renderer.disableClipRect();
 }
 
 Uint8 Automap::getColor(const Position& pos)
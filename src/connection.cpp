@@ -23,16 +23,36 @@
 
 #include <curl/curl.h>
 
+static int CONNECTION_networkthread(void* data)
+{
+	return SDL_reinterpret_cast(Connection*, data)->networkThread();
+}
+
 Connection::Connection(const char* host, Uint16 port, const char* proxy, const char* proxyAuth, Protocol* protocol) : m_protocol(protocol)
 {
 	m_host = SDL_strdup(host);
 	m_port = port;
 	m_proxy = SDL_strdup(proxy);
 	m_proxyAuth = SDL_strdup(proxyAuth);
+
+	SDL_AtomicSet(&m_networkExiting, 0);
+	SDL_AtomicSet(&m_networkReady, 0);
+	SDL_AtomicSet(&m_eventHead, 0);
+	SDL_AtomicSet(&m_eventTail, 0);
+}
+
+Connection::Connection(std::unique_ptr<PacketReplayer> replayer, bool replayFast, Protocol* protocol) : m_protocol(protocol), m_replayer(std::move(replayer)), m_replayFast(replayFast)
+{
+	SDL_AtomicSet(&m_networkExiting, 0);
+	SDL_AtomicSet(&m_networkReady, 0);
+	SDL_AtomicSet(&m_eventHead, 0);
+	SDL_AtomicSet(&m_eventTail, 0);
 }
 
 Connection::~Connection()
 {
+	closeConnection();
+
 	if(m_host)
 		SDL_free(m_host);
 
@@ -41,24 +61,33 @@ Connection::~Connection()
 
 	if(m_proxyAuth)
 		SDL_free(m_proxyAuth);
-
-	closeConnection();
 }
 
 void Connection::closeConnection()
 {
-	if(m_curlEasyHandle)
+	if(m_networkThread)
 	{
-		curl_multi_remove_handle(SDL_reinterpret_cast(CURLM*, m_curlHandle), SDL_reinterpret_cast(CURL*, m_curlEasyHandle));
-		curl_easy_cleanup(SDL_reinterpret_cast(CURL*, m_curlEasyHandle));
-		m_curlEasyHandle = NULL;
+		if(m_connectionState == CONNECTION_STATE_CONNECTED)//Try to deliver whatever is still pending(logout packet etc.)
+			flushSendBuffer();
+
+		SDL_AtomicSet(&m_networkExiting, 1);
+		SDL_WaitThread(m_networkThread, NULL);
+		m_networkThread = NULL;
+	}
+	if(m_sendMutex)
+	{
+		SDL_DestroyMutex(m_sendMutex);
+		m_sendMutex = NULL;
 	}
-	if(m_curlHandle)
+	if(m_eventBuffer)
 	{
-		curl_multi_cleanup(SDL_reinterpret_cast(CURLM*, m_curlHandle));
-		m_curlHandle = NULL;
+		SDL_free(m_eventBuffer);
+		m_eventBuffer = NULL;
 	}
 
+	m_sendBuffer.clear();
+	m_networkSendBuffer.clear();
+	m_pendingSendBuffer.clear();
 	m_connectionState = CONNECTION_STATE_CLOSED;
 	if(m_protocol)
 	{
@@ -76,130 +105,121 @@ void Connection::closeConnectionError(ConnectionError error)
 	m_connectionState = CONNECTION_STATE_ERROR;
 }
 
+void Connection::flushSendBuffer()
+{
+	if(m_sendBuffer.empty())
+		return;
+
+	//Hand everything queued during this frame to the network thread - it'll go out as one write
+	SDL_LockMutex(m_sendMutex);
+	m_networkSendBuffer.insert(m_networkSendBuffer.end(), m_sendBuffer.begin(), m_sendBuffer.end());
+	SDL_UnlockMutex(m_sendMutex);
+	m_sendBuffer.clear();
+}
+
 void Connection::updateConnection()
 {
 	switch(m_connectionState)
 	{
 		case CONNECTION_STATE_INIT:
 		{
-			m_curlHandle = SDL_reinterpret_cast(void*, curl_multi_init());
-			CURL* curl = curl_easy_init();
-			m_curlEasyHandle = SDL_reinterpret_cast(void*, curl);
-			curl_easy_setopt(curl, CURLOPT_URL, m_host);
-			curl_easy_setopt(curl, CURLOPT_PORT, m_port);
-			curl_easy_setopt(curl, CURLOPT_PROXY, m_proxy);
-			curl_easy_setopt(curl, CURLOPT_PROXYUSERPWD, m_proxyAuth);
-			curl_easy_setopt(curl, CURLOPT_FRESH_CONNECT, 1L);
-			curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 1L);
-			curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 60L);
-			curl_easy_setopt(curl, CURLOPT_TCP_FASTOPEN, 1L);
-			curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
-			curl_multi_add_handle(SDL_reinterpret_cast(CURLM*, m_curlHandle), curl);
-			m_connectionState = CONNECTION_STATE_CONNECTING;
-		}
-		case CONNECTION_STATE_CONNECTING:
-		{
-			Sint32 still_running = 0;
-			CURLMcode code = curl_multi_perform(SDL_reinterpret_cast(CURLM*, m_curlHandle), &still_running);
-			if(code == CURLM_OK)
-			{
-				if(!still_running)
-				{
-					CURLMsg* msg = curl_multi_info_read(SDL_reinterpret_cast(CURLM*, m_curlHandle), &still_running);
-					if(msg)
-					{
-						switch(msg->data.result)
-						{
-							case CURLE_OK:
-							{
-								m_connectionState = CONNECTION_STATE_CONNECTED;
-								m_messageSize = 2;
-								m_inputMessage.reset();
-								if(m_protocol)
-									m_protocol->onConnect();
-							}
-							break;
-							case CURLE_COULDNT_RESOLVE_HOST: closeConnectionError(CONNECTION_ERROR_RESOLVE_HOST); return;
-							case CURLE_OPERATION_TIMEDOUT: closeConnectionError(CONNECTION_ERROR_TIMEOUT); return;
-							case CURLE_COULDNT_CONNECT: closeConnectionError(CONNECTION_ERROR_REFUSED_CONNECT); return;
-							default: closeConnectionError(CONNECTION_ERROR_FAIL_CONNECT); return;
-						}
-					}
-					else
-						return;
-				}
-				else
-					return;
-			}
-			else
+			m_eventBuffer = SDL_reinterpret_cast(Uint8*, SDL_malloc(CONNECTION_EVENT_BUFFER_SIZE));
+			m_sendMutex = SDL_CreateMutex();
+			if(m_eventBuffer && m_sendMutex)
+				m_networkThread = SDL_CreateThread(CONNECTION_networkthread, "NETWORK", this);
+
+			if(!m_networkThread)
 			{
 				closeConnectionError(CONNECTION_ERROR_CANNOT_CONNECT);
 				return;
 			}
+			m_connectionState = CONNECTION_STATE_CONNECTING;
 		}
+		case CONNECTION_STATE_CONNECTING:
 		case CONNECTION_STATE_CONNECTED:
 		{
-			while(m_connectionState == CONNECTION_STATE_CONNECTED)
+			//Parse everything the network thread have ready for us
+			Uint32 eventTail = SDL_static_cast(Uint32, SDL_AtomicGet(&m_eventTail));
+			while(m_connectionState == CONNECTION_STATE_CONNECTING || m_connectionState == CONNECTION_STATE_CONNECTED)
 			{
-				switch(m_readState)
+				Uint32 eventHead = SDL_static_cast(Uint32, SDL_AtomicGet(&m_eventHead));
+				if(eventHead == eventTail)
+					break;
+
+				Uint8 eventHeader[4];
+				readEvent(eventTail, eventHeader, 4);
+				Uint32 eventSize = SDL_static_cast(Uint32, eventHeader[1]) | (SDL_static_cast(Uint32, eventHeader[2]) << 8) | (SDL_static_cast(Uint32, eventHeader[3]) << 16);
+				switch(eventHeader[0])
 				{
-					case READ_SIZE:
+					case CONNECTION_EVENT_CONNECTED:
 					{
-						Sint32 ret = internalRead(m_messageSize);
-						if(ret == -1)
-						{
-							closeConnectionError(CONNECTION_ERROR_RECV_FAIL);
-							return;
-						}
-						else if(ret == 0)//Don't have any data this frame
-							return;
+						eventTail += 4;
+						SDL_AtomicSet(&m_eventTail, SDL_static_cast(int, eventTail));
 
-						m_messageSize -= SDL_static_cast(Uint16, ret);
-						if(m_messageSize == 0)
-						{
-							m_inputMessage.setReadPos(0);
-							m_messageSize = m_inputMessage.getU16();
-							if(m_messageSize == 0 || m_messageSize > INPUTMESSAGE_SIZE)
-							{
-								closeConnectionError(CONNECTION_ERROR_PROTOCOL_FAIL);
-								return;
-							}
-
-							m_readState = READ_BUFFER;
-						}
-						else//Let's wait for the incoming data
-							return;
+						m_connectionState = CONNECTION_STATE_CONNECTED;
+						if(m_protocol && !m_replayer)//Recording already contains the login sequence
+							m_protocol->onConnect();
+
+						//Let the network thread start reading only after the protocol is set up for it
+						flushSendBuffer();
+						SDL_AtomicSet(&m_networkReady, 1);
 					}
-					case READ_BUFFER:
+					break;
+					case CONNECTION_EVENT_MESSAGE:
 					{
-						Sint32 ret = internalRead(m_messageSize);
-						if(ret == -1)
+						if(!m_parseMessage.reserve(eventSize))
 						{
-							closeConnectionError(CONNECTION_ERROR_RECV_FAIL);
+							closeConnectionError(CONNECTION_ERROR_PROTOCOL_FAIL);
 							return;
 						}
-						else if(ret == 0)//Don't have any data this frame
-							return;
 
-						m_messageSize -= SDL_static_cast(Uint16, ret);
-						if(m_messageSize == 0)
+						readEvent(eventTail + 4, m_parseMessage.getBuffer(), eventSize);
+						eventTail += 4 + eventSize;
+						SDL_AtomicSet(&m_eventTail, SDL_static_cast(int, eventTail));
+
+						m_parseMessage.setReadPos(0);
+						m_parseMessage.setMessageSize(eventSize);
+						if(m_replayer)
 						{
-							m_inputMessage.setReadPos(2);
-							if(m_protocol && !m_protocol->onRecv(m_inputMessage))
-							{
-								closeConnectionError(CONNECTION_ERROR_PROTOCOL_FAIL);
-								return;
-							}
-
-							m_messageSize = 2;
-							m_inputMessage.reset();
-							m_readState = READ_SIZE;
+							#ifdef __ALLOCATION_COUNTER__
+							Uint64 allocationsStart = UTIL_getThreadAllocations();
+							#endif
+							Uint64 parseStart = SDL_GetPerformanceCounter();
+							if(m_protocol)
+								m_protocol->onParse(m_parseMessage);
+
+							m_replayStats.parseTicks += SDL_GetPerformanceCounter() - parseStart;
+							#ifdef __ALLOCATION_COUNTER__
+							m_replayStats.parseAllocations += UTIL_getThreadAllocations() - allocationsStart;
+							#endif
+							m_replayStats.parsedBytes += eventSize;
+							++m_replayStats.parsedPackets;
 						}
+						else if(m_protocol)
+							m_protocol->onParse(m_parseMessage);
 					}
 					break;
-					default: break;
+					case CONNECTION_EVENT_REPLAY_END:
+					{
+						eventTail += 4;
+						SDL_AtomicSet(&m_eventTail, SDL_static_cast(int, eventTail));
+
+						//The engine picks the statistics up and reports them
+						m_replayFinished = true;
+					}
+					break;
+					default:
+					{
+						eventTail += 4;
+						SDL_AtomicSet(&m_eventTail, SDL_static_cast(int, eventTail));
+						closeConnectionError(SDL_static_cast(ConnectionError, eventSize));
+					}
+					return;
 				}
 			}
+
+			if(m_connectionState == CONNECTION_STATE_CONNECTED)
+				flushSendBuffer();
 		}
 		break;
 		case CONNECTION_STATE_SEND_ERROR: closeConnectionError(CONNECTION_ERROR_SEND_FAIL); break;
@@ -209,17 +229,186 @@ void Connection::updateConnection()
 	}
 }
 
-Sint32 Connection::internalRead(Uint16 n)
+int Connection::networkThread()
+{
+	if(m_replayer)
+		return replayPackets();
+
+	CURLM* multiHandle = curl_multi_init();
+	CURL* curl = curl_easy_init();
+	m_curlHandle = SDL_reinterpret_cast(void*, multiHandle);
+	m_curlEasyHandle = SDL_reinterpret_cast(void*, curl);
+	curl_easy_setopt(curl, CURLOPT_URL, m_host);
+	curl_easy_setopt(curl, CURLOPT_PORT, m_port);
+	curl_easy_setopt(curl, CURLOPT_PROXY, m_proxy);
+	curl_easy_setopt(curl, CURLOPT_PROXYUSERPWD, m_proxyAuth);
+	curl_easy_setopt(curl, CURLOPT_FRESH_CONNECT, 1L);
+	curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 1L);
+	curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 60L);
+	curl_easy_setopt(curl, CURLOPT_TCP_FASTOPEN, 1L);
+	curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+	curl_multi_add_handle(multiHandle, curl);
+
+	bool connected = false;
+	while(!connected && SDL_AtomicGet(&m_networkExiting) == 0)
+	{
+		Sint32 still_running = 0;
+		CURLMcode code = curl_multi_perform(multiHandle, &still_running);
+		if(code != CURLM_OK)
+		{
+			pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_CANNOT_CONNECT);
+			goto Cleanup;
+		}
+
+		if(!still_running)
+		{
+			CURLMsg* msg = curl_multi_info_read(multiHandle, &still_running);
+			if(msg)
+			{
+				switch(msg->data.result)
+				{
+					case CURLE_OK:
+					{
+						connected = true;
+						m_recvHead = 0;
+						m_recvTail = 0;
+						pushEvent(CONNECTION_EVENT_CONNECTED, NULL, 0);
+					}
+					break;
+					case CURLE_COULDNT_RESOLVE_HOST: pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_RESOLVE_HOST); goto Cleanup;
+					case CURLE_OPERATION_TIMEDOUT: pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_TIMEOUT); goto Cleanup;
+					case CURLE_COULDNT_CONNECT: pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_REFUSED_CONNECT); goto Cleanup;
+					default: pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_FAIL_CONNECT); goto Cleanup;
+				}
+				continue;
+			}
+		}
+		curl_multi_wait(multiHandle, NULL, 0, CONNECTION_NETWORK_WAIT, NULL);
+	}
+
+	if(connected)
+	{
+		curl_socket_t activeSocket = CURL_SOCKET_BAD;
+		curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &activeSocket);
+
+		struct curl_waitfd waitSocket;
+		waitSocket.fd = activeSocket;
+		waitSocket.events = CURL_WAIT_POLLIN;
+		waitSocket.revents = 0;
+		while(SDL_AtomicGet(&m_networkExiting) == 0)
+		{
+			if(SDL_AtomicGet(&m_networkReady) == 0)
+			{
+				SDL_Delay(1);
+				continue;
+			}
+
+			SDL_LockMutex(m_sendMutex);
+			if(!m_networkSendBuffer.empty())
+			{
+				m_pendingSendBuffer.insert(m_pendingSendBuffer.end(), m_networkSendBuffer.begin(), m_networkSendBuffer.end());
+				m_networkSendBuffer.clear();
+			}
+			SDL_UnlockMutex(m_sendMutex);
+			if(m_pendingSendBuffer.size() > CONNECTION_SEND_BUFFER_LIMIT || !internalSend())
+			{
+				pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_SEND_FAIL);
+				goto Cleanup;
+			}
+
+			Sint32 ret = internalRead();
+			if(ret == -1)
+			{
+				pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_RECV_FAIL);
+				goto Cleanup;
+			}
+
+			bool recvBufferFull = (m_recvHead - m_recvTail == CONNECTION_RECV_BUFFER_SIZE);
+			if(!internalParse())
+			{
+				pushEvent(CONNECTION_EVENT_ERROR, NULL, CONNECTION_ERROR_PROTOCOL_FAIL);
+				goto Cleanup;
+			}
+
+			if(m_recvHead - m_recvTail == CONNECTION_RECV_BUFFER_SIZE)//Game thread is behind us - give it some time
+				SDL_Delay(1);
+			else if(!recvBufferFull)//Wait for the incoming data or the next frame packets
+				curl_multi_wait(multiHandle, &waitSocket, 1, CONNECTION_NETWORK_WAIT, NULL);
+		}
+
+		//Last chance to deliver the pending packets
+		SDL_LockMutex(m_sendMutex);
+		m_pendingSendBuffer.insert(m_pendingSendBuffer.end(), m_networkSendBuffer.begin(), m_networkSendBuffer.end());
+		m_networkSendBuffer.clear();
+		SDL_UnlockMutex(m_sendMutex);
+		internalSend();
+	}
+
+	Cleanup:
+	curl_multi_remove_handle(multiHandle, curl);
+	curl_easy_cleanup(curl);
+	curl_multi_cleanup(multiHandle);
+	m_curlEasyHandle = NULL;
+	m_curlHandle = NULL;
+	if(m_recorder)
+		m_recorder->close();
+
+	return 0;
+}
+
+int Connection::replayPackets()
+{
+	pushEvent(CONNECTION_EVENT_CONNECTED, NULL, 0);
+	while(SDL_AtomicGet(&m_networkReady) == 0)
+	{
+		if(SDL_AtomicGet(&m_networkExiting) != 0)
+			return 0;
+
+		SDL_Delay(1);
+	}
+
+	std::vector<Uint8> packet;
+	Uint32 startTicks = SDL_GetTicks();
+	Uint32 timestamp = 0;
+	while(SDL_AtomicGet(&m_networkExiting) == 0 && m_replayer->readPacket(timestamp, packet))
+	{
+		//Feed the packets either with their recorded timing or as fast as the game thread can parse them
+		while(!m_replayFast && SDL_GetTicks() - startTicks < timestamp)
+		{
+			if(SDL_AtomicGet(&m_networkExiting) != 0)
+				return 0;
+
+			SDL_Delay(1);
+		}
+
+		if(!pushEvent(CONNECTION_EVENT_MESSAGE, &packet[0], SDL_static_cast(Uint32, packet.size())))
+			return 0;
+
+		//There's no server to send our packets to
+		SDL_LockMutex(m_sendMutex);
+		m_networkSendBuffer.clear();
+		SDL_UnlockMutex(m_sendMutex);
+	}
+
+	pushEvent(CONNECTION_EVENT_REPLAY_END, NULL, 0);
+	return 0;
+}
+
+Sint32 Connection::internalRead()
 {
 	Sint32 len = 0;
-	while(n > 0)
+	while(m_recvHead - m_recvTail < CONNECTION_RECV_BUFFER_SIZE)
 	{
+		//Read as much as we can into the contiguous free space of the ring buffer
+		Uint32 writePos = (m_recvHead & (CONNECTION_RECV_BUFFER_SIZE - 1));
+		size_t n = SDL_static_cast(size_t, UTIL_min<Uint32>(CONNECTION_RECV_BUFFER_SIZE - (m_recvHead - m_recvTail), CONNECTION_RECV_BUFFER_SIZE - writePos));
+
 		size_t ret;
-		CURLcode result = curl_easy_recv(SDL_reinterpret_cast(CURL*, m_curlEasyHandle), SDL_reinterpret_cast(char*, m_inputMessage.getReadBuffer() + len), n, &ret);
+		CURLcode result = curl_easy_recv(SDL_reinterpret_cast(CURL*, m_curlEasyHandle), SDL_reinterpret_cast(char*, m_recvBuffer + writePos), n, &ret);
 		if(result != CURLE_OK)
 		{
 			if(result == CURLE_AGAIN)
-				goto ReturnLen;
+				break;
 			else
 				return -1;
 		}
@@ -227,38 +416,144 @@ Sint32 Connection::internalRead(Uint16 n)
 			return -1;
 
 		len += SDL_static_cast(Sint32, ret);
-		n -= SDL_static_cast(Uint16, ret);
+		m_recvHead += SDL_static_cast(Uint32, ret);
+		if(ret < n)//Socket don't have more data for us
+			break;
 	}
-
-	ReturnLen:
-	m_inputMessage.setReadPos(m_inputMessage.getReadPos() + SDL_static_cast(Uint16, len));
-	m_inputMessage.setMessageSize(m_inputMessage.getMessageSize() + SDL_static_cast(Uint16, len));
 	return len;
 }
 
-void Connection::sendMessage(OutputMessage& msg)
+bool Connection::internalParse()
 {
-	if(m_connectionState != CONNECTION_STATE_CONNECTED || msg.getMessageSize() == 0)//sillently ignore
-		return;
+	while(true)
+	{
+		Uint32 recvSize = m_recvHead - m_recvTail;
+		if(recvSize < 2)
+			return true;
+
+		Uint32 readPos = (m_recvTail & (CONNECTION_RECV_BUFFER_SIZE - 1));
+		Uint32 messageSize = SDL_static_cast(Uint32, m_recvBuffer[readPos]);
+		messageSize |= (SDL_static_cast(Uint32, m_recvBuffer[(readPos + 1) & (CONNECTION_RECV_BUFFER_SIZE - 1)]) << 8);
+		if(messageSize == 0 || messageSize > INPUTMESSAGE_SIZE - 2)
+			return false;
 
-	Sint32 msgSize = SDL_static_cast(Sint32, msg.getMessageSize());
-	Sint32 sendBytes = 0;
-	while(sendBytes < msgSize)
+		messageSize += 2;
+		if(recvSize < messageSize)//Let's wait for the incoming data
+			return true;
+
+		//Make sure the game thread have room for the decoded packet before we consume it
+		Uint32 eventFree = CONNECTION_EVENT_BUFFER_SIZE - (m_eventWriteHead - SDL_static_cast(Uint32, SDL_AtomicGet(&m_eventTail)));
+		if(eventFree < INPUTMESSAGE_MAX_SIZE + 4)
+			return true;
+
+		//Frame the packet out of the ring buffer - it might be wrapped around the end
+		if(!m_inputMessage.reserve(messageSize))
+			return false;
+
+		Uint8* buffer = m_inputMessage.getBuffer();
+		Uint32 firstPart = UTIL_min<Uint32>(messageSize, CONNECTION_RECV_BUFFER_SIZE - readPos);
+		UTIL_FastCopy(buffer, m_recvBuffer + readPos, SDL_static_cast(size_t, firstPart));
+		if(firstPart < messageSize)
+			UTIL_FastCopy(buffer + firstPart, m_recvBuffer, SDL_static_cast(size_t, messageSize - firstPart));
+
+		m_recvTail += messageSize;
+		m_inputMessage.setMessageSize(messageSize);
+		m_inputMessage.setReadPos(2);
+		if(m_protocol && !m_protocol->onRecv(m_inputMessage))
+			return false;
+
+		if(m_recorder)
+			m_recorder->record(m_inputMessage.getReadBuffer(), m_inputMessage.getUnreadSize());
+
+		pushEvent(CONNECTION_EVENT_MESSAGE, m_inputMessage.getReadBuffer(), m_inputMessage.getUnreadSize());
+	}
+}
+
+bool Connection::internalSend()
+{
+	size_t sendSize = m_pendingSendBuffer.size();
+	size_t sendBytes = 0;
+	while(sendBytes < sendSize)
 	{
 		size_t ret;
-		CURLcode result = curl_easy_send(SDL_reinterpret_cast(CURL*, m_curlEasyHandle), SDL_reinterpret_cast(char*, msg.getBuffer() + sendBytes), UTIL_min<Sint32>(msgSize - sendBytes, 1000), &ret);
+		CURLcode result = curl_easy_send(SDL_reinterpret_cast(CURL*, m_curlEasyHandle), SDL_reinterpret_cast(char*, &m_pendingSendBuffer[sendBytes]), sendSize - sendBytes, &ret);
 		if(result != CURLE_OK)
 		{
-			if(result != CURLE_AGAIN)
-			{
-				//Closing socket here is unsafe - schedule it to a safe switch
-				m_connectionState = CONNECTION_STATE_SEND_ERROR;
-				return;
-			}
+			if(result == CURLE_AGAIN)//Socket would block - keep the rest for later
+				break;
 			else
-				continue;
+				return false;
 		}
+		else if(ret == 0)
+			break;
 
-		sendBytes += SDL_static_cast(Sint32, ret);
+		sendBytes += ret;
 	}
+
+	if(sendBytes == sendSize)
+		m_pendingSendBuffer.clear();
+	else if(sendBytes > 0)
+		m_pendingSendBuffer.erase(m_pendingSendBuffer.begin(), m_pendingSendBuffer.begin() + sendBytes);
+	return true;
+}
+
+bool Connection::pushEvent(ConnectionEvent eventType, const Uint8* data, Uint32 size)
+{
+	//Non-message events carry their value in the size field
+	Uint32 dataSize = (eventType == CONNECTION_EVENT_MESSAGE ? size : 0);
+	while(CONNECTION_EVENT_BUFFER_SIZE - (m_eventWriteHead - SDL_static_cast(Uint32, SDL_AtomicGet(&m_eventTail))) < dataSize + 4)
+	{
+		if(SDL_AtomicGet(&m_networkExiting) != 0)
+			return false;
+
+		SDL_Delay(1);
+	}
+
+	Uint8 eventHeader[4];
+	eventHeader[0] = SDL_static_cast(Uint8, eventType);
+	eventHeader[1] = SDL_static_cast(Uint8, size);
+	eventHeader[2] = SDL_static_cast(Uint8, size >> 8);
+	eventHeader[3] = SDL_static_cast(Uint8, size >> 16);
+	writeEvent(m_eventWriteHead, eventHeader, 4);
+	if(dataSize > 0)
+		writeEvent(m_eventWriteHead + 4, data, dataSize);
+
+	//Publish the event only after it is fully written
+	m_eventWriteHead += dataSize + 4;
+	SDL_AtomicSet(&m_eventHead, SDL_static_cast(int, m_eventWriteHead));
+	return true;
+}
+
+void Connection::writeEvent(Uint32 pos, const Uint8* data, Uint32 size)
+{
+	pos &= (CONNECTION_EVENT_BUFFER_SIZE - 1);
+	Uint32 firstPart = UTIL_min<Uint32>(size, CONNECTION_EVENT_BUFFER_SIZE - pos);
+	UTIL_FastCopy(m_eventBuffer + pos, data, SDL_static_cast(size_t, firstPart));
+	if(firstPart < size)
+		UTIL_FastCopy(m_eventBuffer, data + firstPart, SDL_static_cast(size_t, size - firstPart));
+}
+
+void Connection::readEvent(Uint32 pos, Uint8* data, Uint32 size)
+{
+	pos &= (CONNECTION_EVENT_BUFFER_SIZE - 1);
+	Uint32 firstPart = UTIL_min<Uint32>(size, CONNECTION_EVENT_BUFFER_SIZE - pos);
+	UTIL_FastCopy(data, m_eventBuffer + pos, SDL_static_cast(size_t, firstPart));
+	if(firstPart < size)
+		UTIL_FastCopy(data + firstPart, m_eventBuffer, SDL_static_cast(size_t, size - firstPart));
+}
+
+void Connection::sendMessage(OutputMessage& msg)
+{
+	if(m_connectionState != CONNECTION_STATE_CONNECTED || (msg.getMessageSize() == 0 && !msg.hasAllocationFailed()))//sillently ignore
+		return;
+
+	if(msg.hasAllocationFailed() || m_sendBuffer.size() + msg.getMessageSize() > CONNECTION_SEND_BUFFER_LIMIT)
+	{
+		//Closing socket here is unsafe - schedule it to a safe switch
+		m_connectionState = CONNECTION_STATE_SEND_ERROR;
+		return;
+	}
+
+	//Queue the packet - it'll be handed to the network thread together with the others from updateConnection
+	m_sendBuffer.insert(m_sendBuffer.end(), msg.getBuffer(), msg.getBuffer() + msg.getMessageSize());
 }
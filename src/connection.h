@@ -24,11 +24,32 @@
 
 #include "inputMessage.h"
 #include "outputMessage.h"
+#include "packetRecorder.h"
+
+//Receive ring buffer use bitwise operation instead of modulo which means the size must be power of 2
+//It needs to be able to hold at least one full packet(2 bytes header + INPUTMESSAGE_SIZE)
+#define CONNECTION_RECV_BUFFER_SIZE 131072
+//Decoded packets handed from the network thread to the game thread - also power of 2
+#define CONNECTION_EVENT_BUFFER_SIZE 1048576
+//Pending outgoing data above this limit means the server stopped reading from us
+#define CONNECTION_SEND_BUFFER_LIMIT 1048576
+//How long the network thread sleeps on the socket before checking for outgoing data
+#define CONNECTION_NETWORK_WAIT 2
+
+enum ConnectionEvent : Uint8
+{
+	CONNECTION_EVENT_CONNECTED,
+	CONNECTION_EVENT_MESSAGE,
+	CONNECTION_EVENT_ERROR,
+	CONNECTION_EVENT_REPLAY_END
+};
 
-enum ReadState
+struct ReplayStats
 {
-	READ_SIZE,
-	READ_BUFFER
+	Uint64 parseTicks = 0;
+	Uint64 parsedBytes = 0;
+	Uint64 parseAllocations = 0;
+	Uint32 parsedPackets = 0;
 };
 
 enum ConnectionState
@@ -59,6 +80,7 @@ class Connection
 {
 	public:
 		Connection(const char* host, Uint16 port, const char* proxy, const char* proxyAuth, Protocol* protocol);
+		Connection(std::unique_ptr<PacketReplayer> replayer, bool replayFast, Protocol* protocol);
 		~Connection();
 
 		// non-copyable
@@ -71,30 +93,67 @@ class Connection
 
 		SDL_INLINE Protocol* getProtocol() {return m_protocol;}
 		SDL_INLINE ConnectionState getConnectionStatus() {return m_connectionState;}
+		SDL_INLINE void setRecorder(std::unique_ptr<PacketRecorder> recorder) {m_recorder = std::move(recorder);}
+		SDL_INLINE bool isReplaying() {return (m_replayer ? true : false);}
+		SDL_INLINE bool isReplayFinished() {return m_replayFinished;}
+		SDL_INLINE const ReplayStats& getReplayStats() {return m_replayStats;}
 		void closeConnection();
 		void updateConnection();
 
-		Sint32 internalRead(Uint16 n);
 		void sendMessage(OutputMessage& msg);
 
+		int networkThread();
+
 	protected:
 		void closeConnectionError(ConnectionError error);
+		void flushSendBuffer();
+
+		Sint32 internalRead();
+		bool internalParse();
+		bool internalSend();
+		int replayPackets();
+
+		bool pushEvent(ConnectionEvent eventType, const Uint8* data, Uint32 size);
+		void writeEvent(Uint32 pos, const Uint8* data, Uint32 size);
+		void readEvent(Uint32 pos, Uint8* data, Uint32 size);
 
 	private:
 		Protocol* m_protocol;
 		InputMessage m_inputMessage;
+		InputMessage m_parseMessage;
 
 		void* m_curlHandle = NULL;
 		void* m_curlEasyHandle = NULL;
 
-		char* m_host;
-		Uint16 m_port;
-		char* m_proxy;
-		char* m_proxyAuth;
+		char* m_host = NULL;
+		Uint16 m_port = 0;
+		char* m_proxy = NULL;
+		char* m_proxyAuth = NULL;
+
+		std::unique_ptr<PacketRecorder> m_recorder;
+		std::unique_ptr<PacketReplayer> m_replayer;
+		ReplayStats m_replayStats;
+		bool m_replayFast = false;
+		bool m_replayFinished = false;
+
+		SDL_Thread* m_networkThread = NULL;
+		SDL_mutex* m_sendMutex = NULL;
+		SDL_atomic_t m_networkExiting;
+		SDL_atomic_t m_networkReady;
+
+		//Single producer(network thread) single consumer(game thread) ring buffer
+		SDL_atomic_t m_eventHead;
+		SDL_atomic_t m_eventTail;
+		Uint32 m_eventWriteHead = 0;
+		Uint8* m_eventBuffer = NULL;
 
-		ReadState m_readState = READ_SIZE;
 		ConnectionState m_connectionState = CONNECTION_STATE_INIT;
-		Uint16 m_messageSize = 0;
+		Uint32 m_recvHead = 0;
+		Uint32 m_recvTail = 0;
+		Uint8 m_recvBuffer[CONNECTION_RECV_BUFFER_SIZE];
+		std::vector<Uint8> m_sendBuffer;
+		std::vector<Uint8> m_networkSendBuffer;
+		std::vector<Uint8> m_pendingSendBuffer;
 };
 
 #endif /* __FILE_CONNECTION_h_ */
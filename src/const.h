@@ -33,6 +33,12 @@
 //#define __ALPHA_SPRITES__
 #endif
 
+//Per-opcode parse statistics in the performance overlay and parsestats.csv
+//#define __PARSE_PROFILER__
+
+//Count operator new calls per thread so replay benchmarks can report allocations per packet
+//#define __ALLOCATION_COUNTER__
+
 const char CLIENT_ASSET_PIC[] = "Tibia.pic";
 const char CLIENT_ASSET_DAT[] = "Tibia.dat";
 const char CLIENT_ASSET_SPR[] = "Tibia.spr";
@@ -141,9 +147,13 @@ const Uint32 MAX_CANCEL_WALK_BEFORE_STOP_AUTOWALK = 10;
 #define RENDERTARGET_WIDTH ((GAME_MAP_WIDTH - 3) * 32)
 #define RENDERTARGET_HEIGHT ((GAME_MAP_HEIGHT - 3) * 32)
 
-//The circular buffer use bitwise operation instead of modulo which means the size must be power of 2
+//Sprite atlas budget is chosen at runtime from config or detected VRAM and clamped to these bounds
 //Higher value will result with better performance but will require more ram
-#define MAX_SPRITES 16384 //16384 * 32 * 32 * 4 ~ 64MB
+#define SPRITE_BUDGET_MIN 4096 //4096 * 32 * 32 * 4 ~ 16MB
+#define SPRITE_BUDGET_DEFAULT 16384 //16384 * 32 * 32 * 4 ~ 64MB
+#define SPRITE_BUDGET_MAX 131072 //131072 * 32 * 32 * 4 ~ 512MB
+
+//The circular buffer use bitwise operation instead of modulo which means the size must be power of 2
 #define MAX_AUTOMAPTILES 16 //16 * 256 * 256 * 4 ~ 4MB
 #define VULKAN_INFLIGHT_FRAMES 2
 
@@ -244,6 +244,9 @@ void Creature::update()
 	if(m_updateTime != g_frameTime)
 	{
 		m_updateTime = g_frameTime;
+		if(m_showTimedSquare && g_frameTime - m_timedSquareStartTime >= 1000)
+			removeTimedSquare();
+
 		if(m_walking)
 		{
 			float walkTicks = (m_walkTime * 0.03125f);
@@ -328,7 +331,7 @@ void Creature::render(Sint32 posX, Sint32 posY)
 	if(!m_thingType)
 		return;
 
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	update();
 
 	posX += getOffsetX();
@@ -359,10 +362,11 @@ void Creature::render(Sint32 posX, Sint32 posY)
 
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
-		Uint16* light = m_thingType->m_light;
-		if(m_light[0] > light[0])
-			light = m_light;
-
+		//Work on a copy, the outfit light is shared with every creature using the same outfit
+		Uint16 light[2];
+		Uint16* sourceLight = (m_light[0] > m_thingType->m_light[0] ? m_light : m_thingType->m_light);
+		light[0] = sourceLight[0];
+		light[1] = sourceLight[1];
 		if(m_isLocalCreature && (g_light.getLightIntensity() < 64 || m_position.z > 7))
 		{
 			if(light[0] < 2)
@@ -372,7 +376,7 @@ void Creature::render(Sint32 posX, Sint32 posY)
 		}
 
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			renderer.addLightSource(posX, posY, light);
 	}
 
 	Sint32 squareX = posX;
@@ -382,9 +386,9 @@ void Creature::render(Sint32 posX, Sint32 posY)
 	if(g_game.getAttackID() == m_id)
 	{
 		if(g_game.getSelectID() == m_id)
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 2, 248, 164, 164, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 2, 248, 164, 164, 255);
 		else
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 2, 224, 64, 64, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 2, 224, 64, 64, 255);
 
 		squareX += 2;
 		squareY += 2;
@@ -394,9 +398,9 @@ void Creature::render(Sint32 posX, Sint32 posY)
 	else if(g_game.getFollowID() == m_id)
 	{
 		if(g_game.getSelectID() == m_id)
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 2, 180, 248, 180, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 2, 180, 248, 180, 255);
 		else
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 2, 64, 224, 64, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 2, 64, 224, 64, 255);
 
 		squareX += 2;
 		squareY += 2;
@@ -405,7 +409,7 @@ void Creature::render(Sint32 posX, Sint32 posY)
 	}
 	else if(g_game.getSelectID() == m_id)
 	{
-		renderer->drawRectangle(squareX, squareY, squareW, squareH, 2, 248, 248, 248, 255);
+		renderer.drawRectangle(squareX, squareY, squareW, squareH, 2, 248, 248, 248, 255);
 		squareX += 2;
 		squareY += 2;
 		squareW -= 4;
@@ -413,19 +417,14 @@ void Creature::render(Sint32 posX, Sint32 posY)
 	}
 	if(m_showStaticSquare && g_engine.hasShowPvPFrames())
 	{
-		renderer->drawRectangle(squareX, squareY, squareW, squareH, 2, m_staticSquareRed, m_staticSquareGreen, m_staticSquareBlue, 255);
+		renderer.drawRectangle(squareX, squareY, squareW, squareH, 2, m_staticSquareRed, m_staticSquareGreen, m_staticSquareBlue, 255);
 		squareX += 2;
 		squareY += 2;
 		squareW -= 4;
 		squareH -= 4;
 	}
 	if(m_showTimedSquare)
-	{
-		if(g_frameTime - m_timedSquareStartTime >= 1000)
-			removeTimedSquare();
-		else
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 2, m_timedSquareRed, m_timedSquareGreen, m_timedSquareBlue, 255);
-	}
+		renderer.drawRectangle(squareX, squareY, squareW, squareH, 2, m_timedSquareRed, m_timedSquareGreen, m_timedSquareBlue, 255);
 
 	if(m_mountType && m_thingType->m_category == ThingCategory_Creature)
 	{
@@ -437,7 +436,7 @@ void Creature::render(Sint32 posX, Sint32 posY)
 			{
 				Uint32 sprite = m_mountType->getSprite(SDL_static_cast(ThingFrameGroup, m_currentFrame), x, y, 0, m_direction, 0, 0, m_mountAnim);
 				if(sprite != 0)
-					renderer->drawSprite(sprite, posXc, posYc);
+					renderer.drawSprite(sprite, posXc, posYc);
 				posXc -= 32;
 			}
 			posYc -= 32;
@@ -457,9 +456,9 @@ void Creature::render(Sint32 posX, Sint32 posY)
 				if(sprite != 0)
 				{
 					if(spriteMask != 0)
-						renderer->drawSpriteMask(sprite, spriteMask, posXc, posY, m_outfit);
+						renderer.drawSpriteMask(sprite, spriteMask, posXc, posY, m_outfit);
 					else
-						renderer->drawSprite(sprite, posXc, posY);
+						renderer.drawSprite(sprite, posXc, posY);
 				}
 				if(m_thingType->m_frameGroup[m_currentFrame].m_patternY > 1)
 				{
@@ -470,9 +469,9 @@ void Creature::render(Sint32 posX, Sint32 posY)
 						if(sprite != 0)
 						{
 							if(spriteMask != 0)
-								renderer->drawSpriteMask(sprite, spriteMask, posXc, posY, m_outfit);
+								renderer.drawSpriteMask(sprite, spriteMask, posXc, posY, m_outfit);
 							else
-								renderer->drawSprite(sprite, posXc, posY);
+								renderer.drawSprite(sprite, posXc, posY);
 						}
 					}
 					if(m_lookAddons & 2)//Second addon
@@ -482,9 +481,9 @@ void Creature::render(Sint32 posX, Sint32 posY)
 						if(sprite != 0)
 						{
 							if(spriteMask != 0)
-								renderer->drawSpriteMask(sprite, spriteMask, posXc, posY, m_outfit);
+								renderer.drawSpriteMask(sprite, spriteMask, posXc, posY, m_outfit);
 							else
-								renderer->drawSprite(sprite, posXc, posY);
+								renderer.drawSprite(sprite, posXc, posY);
 						}
 					}
 				}
@@ -502,20 +501,20 @@ void Creature::render(Sint32 posX, Sint32 posY)
 			{
 				Uint32 sprite = m_thingType->getSprite(SDL_static_cast(ThingFrameGroup, m_currentFrame), x, y, 0, m_direction, 0, zPattern, m_outfitAnim);
 				if(sprite != 0)
-					renderer->drawSprite(sprite, posXc, posY);
+					renderer.drawSprite(sprite, posXc, posY);
 				if(m_thingType->m_frameGroup[m_currentFrame].m_patternY > 1)
 				{
 					if(m_lookAddons & 1)//First addon
 					{
 						sprite = m_thingType->getSprite(SDL_static_cast(ThingFrameGroup, m_currentFrame), x, y, 0, m_direction, 1, zPattern, m_outfitAnim);
 						if(sprite != 0)
-							renderer->drawSprite(sprite, posXc, posY);
+							renderer.drawSprite(sprite, posXc, posY);
 					}
 					if(m_lookAddons & 2)//Second addon
 					{
 						sprite = m_thingType->getSprite(SDL_static_cast(ThingFrameGroup, m_currentFrame), x, y, 0, m_direction, 2, zPattern, m_outfitAnim);
 						if(sprite != 0)
-							renderer->drawSprite(sprite, posXc, posY);
+							renderer.drawSprite(sprite, posXc, posY);
 					}
 				}
 				posXc -= 32;
@@ -569,9 +568,9 @@ void Creature::renderInformations(Sint32 posX, Sint32 posY, Sint32 drawX, Sint32
 	posY += SDL_static_cast(Sint32, drawY * scale) - 16;
 	g_engine.drawFont(CLIENT_FONT_OUTLINED, posX - m_nameLen, posY, m_name, red, green, blue, CLIENT_FONT_ALIGN_LEFT);
 
-	auto& renderer = g_engine.getRender();
-	renderer->fillRectangle(posX - 14, posY + 12, 28, 4, 0, 0, 0, 255);
-	renderer->fillRectangle(posX - 13, posY + 13, SDL_static_cast(Sint32, m_health * 0.26f), 2, red, green, blue, 255);
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	renderer.fillRectangle(posX - 14, posY + 12, 28, 4, 0, 0, 0, 255);
+	renderer.fillRectangle(posX - 13, posY + 13, SDL_static_cast(Sint32, m_health * 0.26f), 2, red, green, blue, 255);
 
 	Sint32 POSX = posX + 9;
 	Sint32 POSY = posY + 18;
@@ -587,40 +586,40 @@ void Creature::renderInformations(Sint32 posX, Sint32 posY, Sint32 drawX, Sint32
 					m_showShield = !m_showShield;
 				}
 				if(m_showShield)
-					renderer->drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, POSX, POSY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
+					renderer.drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, POSX, POSY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
 			}
 			else
-				renderer->drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, POSX, POSY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
+				renderer.drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, POSX, POSY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
 
 			POSX += 13;
 		}
 
 		if(m_emblem != GUILDEMBLEM_NONE)
-			renderer->drawPicture(GUI_UI_IMAGE, m_emblemX, m_emblemY, POSX, POSY + 13, GUI_UI_ICON_GUILDWAR_ALLY_W, GUI_UI_ICON_GUILDWAR_ALLY_H);
+			renderer.drawPicture(GUI_UI_IMAGE, m_emblemX, m_emblemY, POSX, POSY + 13, GUI_UI_ICON_GUILDWAR_ALLY_W, GUI_UI_ICON_GUILDWAR_ALLY_H);
 
 		if(m_skull != SKULL_NONE)
 		{
-			renderer->drawPicture(GUI_UI_IMAGE, m_skullX, m_skullY, POSX, POSY, GUI_UI_ICON_YELLOWSKULL_W, GUI_UI_ICON_YELLOWSKULL_H);
+			renderer.drawPicture(GUI_UI_IMAGE, m_skullX, m_skullY, POSX, POSY, GUI_UI_ICON_YELLOWSKULL_W, GUI_UI_ICON_YELLOWSKULL_H);
 			POSX += 13;
 		}
 	}
 
 	if(m_type == CREATURETYPE_SUMMON_OWN || m_type == CREATURETYPE_SUMMON_OTHERS)
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, m_typeX, m_typeY, POSX, POSY, GUI_UI_ICON_SUMMONOWN_W, GUI_UI_ICON_SUMMONOWN_H);
+		renderer.drawPicture(GUI_UI_IMAGE, m_typeX, m_typeY, POSX, POSY, GUI_UI_ICON_SUMMONOWN_W, GUI_UI_ICON_SUMMONOWN_H);
 		POSX += 13;
 	}
 
 	if(m_icon != CREATUREICON_NONE && g_engine.hasShowIcons())
 	{
-		renderer->drawPicture(GUI_UI_IMAGE, m_iconX, m_iconY, POSX, POSY, GUI_UI_ICON_BUBBLE_SPEECH_W, GUI_UI_ICON_BUBBLE_SPEECH_H);
+		renderer.drawPicture(GUI_UI_IMAGE, m_iconX, m_iconY, POSX, POSY, GUI_UI_ICON_BUBBLE_SPEECH_W, GUI_UI_ICON_BUBBLE_SPEECH_H);
 		POSX += 20;
 	}
 }
 
 void Creature::renderOnBattle(Sint32 posX, Sint32 posY, bool renderManaBar)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType)
 	{
 		Uint8 animation;
@@ -675,14 +674,14 @@ void Creature::renderOnBattle(Sint32 posX, Sint32 posY, bool renderManaBar)
 			red = 248;
 			green = 164;
 			blue = 164;
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
 		}
 		else
 		{
 			red = 224;
 			green = 64;
 			blue = 64;
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
 		}
 
 		squareX += 1;
@@ -697,14 +696,14 @@ void Creature::renderOnBattle(Sint32 posX, Sint32 posY, bool renderManaBar)
 			red = 180;
 			green = 248;
 			blue = 180;
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
 		}
 		else
 		{
 			red = 64;
 			green = 224;
 			blue = 64;
-			renderer->drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
+			renderer.drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
 		}
 
 		squareX += 1;
@@ -717,7 +716,7 @@ void Creature::renderOnBattle(Sint32 posX, Sint32 posY, bool renderManaBar)
 		red = 248;
 		green = 248;
 		blue = 248;
-		renderer->drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
+		renderer.drawRectangle(squareX, squareY, squareW, squareH, 1, red, green, blue, 255);
 		squareX += 1;
 		squareY += 1;
 		squareW -= 2;
@@ -725,36 +724,36 @@ void Creature::renderOnBattle(Sint32 posX, Sint32 posY, bool renderManaBar)
 	}
 	if(m_showStaticSquare && g_engine.hasShowPvPFrames())
 	{
-		renderer->drawRectangle(squareX, squareY, squareW, squareH, 1, m_staticSquareRed, m_staticSquareGreen, m_staticSquareBlue, 255);
+		renderer.drawRectangle(squareX, squareY, squareW, squareH, 1, m_staticSquareRed, m_staticSquareGreen, m_staticSquareBlue, 255);
 		squareX += 1;
 		squareY += 1;
 		squareW -= 2;
 		squareH -= 2;
 	}
 	if(m_showTimedSquare)
-		renderer->drawRectangle(squareX, squareY, squareW, squareH, 1, m_timedSquareRed, m_timedSquareGreen, m_timedSquareBlue, 255);
+		renderer.drawRectangle(squareX, squareY, squareW, squareH, 1, m_timedSquareRed, m_timedSquareGreen, m_timedSquareBlue, 255);
 
 	posX += 22;
 	posY += 4;
 	g_engine.drawFont(CLIENT_FONT_NONOUTLINED, posX, posY, m_name, red, green, blue, CLIENT_FONT_ALIGN_LEFT);
 	if(m_showStatus)
 	{
-		renderer->drawRectangle(posX - 1, posY + 14, 132, 5, 1, 0, 0, 0, 255);
-		renderer->fillRectangle(posX, posY + 15, SDL_static_cast(Sint32, m_health) * 130 / 100, 3, m_red, m_green, m_blue, 255);
+		renderer.drawRectangle(posX - 1, posY + 14, 132, 5, 1, 0, 0, 0, 255);
+		renderer.fillRectangle(posX, posY + 15, SDL_static_cast(Sint32, m_health) * 130 / 100, 3, m_red, m_green, m_blue, 255);
 		if(renderManaBar)
 		{
-			renderer->drawRectangle(posX - 1, posY + 20, 132, 5, 1, 0, 0, 0, 255);
-			renderer->fillRectangle(posX, posY + 21, SDL_static_cast(Sint32, m_manaPercent) * 130 / 100, 3, 0, 0, 255, 255);
+			renderer.drawRectangle(posX - 1, posY + 20, 132, 5, 1, 0, 0, 0, 255);
+			renderer.fillRectangle(posX, posY + 21, SDL_static_cast(Sint32, m_manaPercent) * 130 / 100, 3, 0, 0, 255, 255);
 		}
 	}
 	else
 	{
-		renderer->drawRectangle(posX - 1, posY + 14, 132, 5, 1, 0, 0, 0, 255);
-		renderer->fillRectangle(posX, posY + 15, 130, 3, 112, 112, 112, 255);
+		renderer.drawRectangle(posX - 1, posY + 14, 132, 5, 1, 0, 0, 0, 255);
+		renderer.fillRectangle(posX, posY + 15, 130, 3, 112, 112, 112, 255);
 		if(renderManaBar)
 		{
-			renderer->drawRectangle(posX - 1, posY + 20, 132, 5, 1, 0, 0, 0, 255);
-			renderer->fillRectangle(posX, posY + 21, 130, 3, 112, 112, 112, 255);
+			renderer.drawRectangle(posX - 1, posY + 20, 132, 5, 1, 0, 0, 0, 255);
+			renderer.fillRectangle(posX, posY + 21, 130, 3, 112, 112, 112, 255);
 		}
 	}
 
@@ -762,7 +761,7 @@ void Creature::renderOnBattle(Sint32 posX, Sint32 posY, bool renderManaBar)
 	if(m_skull != SKULL_NONE)
 	{
 		posX -= 13;
-		renderer->drawPicture(GUI_UI_IMAGE, m_skullX, m_skullY, posX, posY, GUI_UI_ICON_YELLOWSKULL_W, GUI_UI_ICON_YELLOWSKULL_H);
+		renderer.drawPicture(GUI_UI_IMAGE, m_skullX, m_skullY, posX, posY, GUI_UI_ICON_YELLOWSKULL_W, GUI_UI_ICON_YELLOWSKULL_H);
 	}
 
 	if(m_shield != SHIELD_NONE)
@@ -776,22 +775,22 @@ void Creature::renderOnBattle(Sint32 posX, Sint32 posY, bool renderManaBar)
 				m_showShield = !m_showShield;
 			}
 			if(m_showShield)
-				renderer->drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, posX, posY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
+				renderer.drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, posX, posY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
 		}
 		else
-			renderer->drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, posX, posY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
+			renderer.drawPicture(GUI_UI_IMAGE, m_shieldX, m_shieldY, posX, posY, GUI_UI_ICON_SHIELD_BLUE_W, GUI_UI_ICON_SHIELD_BLUE_H);
 	}
 
 	if(m_emblem != GUILDEMBLEM_NONE)
 	{
 		posX -= 13;
-		renderer->drawPicture(GUI_UI_IMAGE, m_emblemX, m_emblemY, posX, posY, GUI_UI_ICON_GUILDWAR_ALLY_W, GUI_UI_ICON_GUILDWAR_ALLY_H);
+		renderer.drawPicture(GUI_UI_IMAGE, m_emblemX, m_emblemY, posX, posY, GUI_UI_ICON_GUILDWAR_ALLY_W, GUI_UI_ICON_GUILDWAR_ALLY_H);
 	}
 
 	if(m_type == CREATURETYPE_SUMMON_OWN || m_type == CREATURETYPE_SUMMON_OTHERS)
 	{
 		posX -= 13;
-		renderer->drawPicture(GUI_UI_IMAGE, m_typeX, m_typeY, posX, posY, GUI_UI_ICON_SUMMONOWN_W, GUI_UI_ICON_SUMMONOWN_H);
+		renderer.drawPicture(GUI_UI_IMAGE, m_typeX, m_typeY, posX, posY, GUI_UI_ICON_SUMMONOWN_W, GUI_UI_ICON_SUMMONOWN_H);
 	}
 }
 
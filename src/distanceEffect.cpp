@@ -27,7 +27,6 @@
 
 extern Engine g_engine;
 extern ThingManager g_thingManager;
-extern LightSystem g_light;
 extern Uint32 g_frameTime;
 
 Uint32 DistanceEffect::distanceEffectCount = 0;
@@ -179,12 +178,12 @@ bool DistanceEffect::isDelayed()
 
 void DistanceEffect::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	for(Uint8 y = 0; y < m_thingType->m_frameGroup[ThingFrameGroup_Default].m_height; ++y)
@@ -193,7 +192,7 @@ void DistanceEffect::render(Sint32 posX, Sint32 posY)
 		for(Uint8 x = 0; x < m_thingType->m_frameGroup[ThingFrameGroup_Default].m_width; ++x)
 		{
 			Uint32 sprite = m_thingType->getSprite(ThingFrameGroup_Default, x, y, 0, m_xPattern, m_yPattern, 0, 0);
-			renderer->drawSprite(sprite, posXc, posY);
+			renderer.drawSprite(sprite, posXc, posY);
 			posXc -= 32;
 		}
 		posY -= 32;
@@ -206,76 +205,76 @@ void DistanceEffect1X1::render(Sint32 posX, Sint32 posY)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_1X1Sprites;
 	if(drawSprite != 0)
-		g_engine.getRender()->drawSprite(drawSprite, posX, posY);
+		g_engine.getRenderCommands().drawSprite(drawSprite, posX, posY);
 }
 
 void DistanceEffect2X1::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_1X1Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X1Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
 
 void DistanceEffect1X2::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_1X1Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_1X2Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY - 32);
+		renderer.drawSprite(drawSprite, posX, posY - 32);
 }
 
 void DistanceEffect2X2::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_1X1Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X1Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 
 	posY -= 32;
 	drawSprite = m_1X2Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X2Sprites;
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
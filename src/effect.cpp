@@ -26,7 +26,6 @@
 
 extern Engine g_engine;
 extern ThingManager g_thingManager;
-extern LightSystem g_light;
 extern Uint32 g_frameTime;
 
 std::vector<Effect*> Effect::effects;
@@ -156,12 +155,12 @@ void Effect::update()
 
 void Effect::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	for(Uint8 y = 0; y < m_thingType->m_frameGroup[ThingFrameGroup_Default].m_height; ++y)
@@ -171,7 +170,7 @@ void Effect::render(Sint32 posX, Sint32 posY)
 		{
 			Uint32 sprite = m_thingType->getSprite(ThingFrameGroup_Default, x, y, 0, m_xPattern, m_yPattern, m_zPattern, m_currentAnim);
 			if(sprite != 0)
-				renderer->drawSprite(sprite, posXc, posY);
+				renderer.drawSprite(sprite, posXc, posY);
 
 			posXc -= 32;
 		}
@@ -196,76 +195,76 @@ void Effect1X1::render(Sint32 posX, Sint32 posY)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_1X1Sprites[m_currentAnim];
 	if(drawSprite != 0)
-		g_engine.getRender()->drawSprite(drawSprite, posX, posY);
+		g_engine.getRenderCommands().drawSprite(drawSprite, posX, posY);
 }
 
 void Effect2X1::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_2X1Sprites[m_currentAnim][0];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X1Sprites[m_currentAnim][1];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
 
 void Effect1X2::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_1X2Sprites[m_currentAnim][0];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_1X2Sprites[m_currentAnim][1];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY - 32);
+		renderer.drawSprite(drawSprite, posX, posY - 32);
 }
 
 void Effect2X2::render(Sint32 posX, Sint32 posY)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint32 drawSprite = m_2X2Sprites[m_currentAnim][0];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X2Sprites[m_currentAnim][1];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 
 	posY -= 32;
 	drawSprite = m_2X2Sprites[m_currentAnim][2];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X2Sprites[m_currentAnim][3];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
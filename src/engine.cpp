@@ -40,6 +40,7 @@
 #include "creature.h"
 #include "game.h"
 #include "config.h"
+#include "jobSystem.h"
 
 #include "GUI_Elements/GUI_Window.h"
 #include "GUI_Elements/GUI_Panel.h"
@@ -52,6 +53,7 @@
 
 extern Engine g_engine;
 extern Map g_map;
+extern JobSystem g_jobSystem;
 extern ThingManager g_thingManager;
 extern SpriteManager g_spriteManager;
 extern Connection* g_connection;
@@ -190,6 +192,12 @@ void Engine::loadCFG()
 		m_vsync = (data == "yes" ? true : false);
 		data = cfg.fetchKey("Sharpening");
 		m_sharpening = (data == "yes" ? true : false);
+		data = cfg.fetchKey("SpriteDiskCache");
+		m_spriteDiskCache = (data == "yes" ? true : false);
+		data = cfg.fetchKey("SpriteBudget");
+		m_spriteBudget = SDL_static_cast(Uint32, SDL_strtoul(data.c_str(), NULL, 10));
+		data = cfg.fetchKey("OutfitCacheMemory");
+		setOutfitCacheMemory(SDL_static_cast(Uint32, SDL_strtoul(data.c_str(), NULL, 10)));
 		data = cfg.fetchKey("Antialiasing");
 		m_antialiasing = (data == "yes" ? CLIENT_ANTIALIASING_NORMAL : data == "integer" ? CLIENT_ANTIALIASING_INTEGER : CLIENT_ANTIALIASING_NONE);
 		m_antialiasing = (m_antialiasing > CLIENT_ANTIALIASING_INTEGER ? CLIENT_ANTIALIASING_NORMAL : m_antialiasing);
@@ -468,6 +476,12 @@ void Engine::saveCFG()
 		cfg.insertKey("VerticalSync", std::string(g_buffer, SDL_static_cast(size_t, len)));
 		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "%s", (m_sharpening ? "yes" : "no"));
 		cfg.insertKey("Sharpening", std::string(g_buffer, SDL_static_cast(size_t, len)));
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "%s", (m_spriteDiskCache ? "yes" : "no"));
+		cfg.insertKey("SpriteDiskCache", std::string(g_buffer, SDL_static_cast(size_t, len)));
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "%u", m_spriteBudget);
+		cfg.insertKey("SpriteBudget", std::string(g_buffer, SDL_static_cast(size_t, len)));
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "%u", m_outfitCacheMemory);
+		cfg.insertKey("OutfitCacheMemory", std::string(g_buffer, SDL_static_cast(size_t, len)));
 		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "%s", (m_antialiasing == CLIENT_ANTIALIASING_NORMAL ? "yes" : m_antialiasing == CLIENT_ANTIALIASING_INTEGER ? "integer" : "no"));
 		cfg.insertKey("Antialiasing", std::string(g_buffer, SDL_static_cast(size_t, len)));
 
@@ -744,6 +758,11 @@ void Engine::run()
 
 void Engine::terminate()
 {
+	#ifdef __PARSE_PROFILER__
+	SDL_snprintf(g_buffer, sizeof(g_buffer), "%sparsestats.csv", g_prefPath.c_str());
+	ProtocolGame::dumpParseStats(g_buffer);
+	#endif
+
 	if(m_window && !m_fullscreen)
 	{
 		//Some disgusting "hack" to save original window parameters
@@ -792,6 +811,42 @@ void Engine::parseCommands(int argc, char* argv[])
 			m_engine = CLIENT_ENGINE_OPENGLES2;
 		else if(SDL_strcasecmp(argv[i], "-force-software") == 0)
 			m_engine = CLIENT_ENGINE_SOFTWARE;
+		else if(SDL_strcasecmp(argv[i], "-record") == 0 && i + 1 < argc)
+			m_recordFile = argv[++i];
+		else if(SDL_strcasecmp(argv[i], "-replay") == 0 && i + 1 < argc)
+			m_replayFile = argv[++i];
+		else if(SDL_strcasecmp(argv[i], "-replay-synthetic") == 0 && i + 1 < argc)
+		{
+			//Generated streams are meant for unattended runs
+			m_replaySynthetic = argv[++i];
+			m_replayFast = true;
+			m_replayBenchmark = true;
+		}
+		else if(SDL_strcasecmp(argv[i], "-replay-fast") == 0)
+			m_replayFast = true;
+		else if(SDL_strcasecmp(argv[i], "-replay-benchmark") == 0)
+		{
+			m_replayFast = true;
+			m_replayBenchmark = true;
+		}
+		else if(SDL_strcasecmp(argv[i], "-replay-headless") == 0)
+		{
+			//Headless replays only drive the protocol parsing so we don't need any hardware renderer
+			m_engine = CLIENT_ENGINE_SOFTWARE;
+			m_replayFast = true;
+			m_replayBenchmark = true;
+			m_replayHeadless = true;
+		}
+		else if((SDL_strcasecmp(argv[i], "-job-threads") == 0 || SDL_strcasecmp(argv[i], "-scene-threads") == 0) && i + 1 < argc)
+			m_jobThreads = SDL_atoi(argv[++i]);
+		else if(SDL_strcasecmp(argv[i], "-software-sdl-blit") == 0)
+			m_softwareSdlBlit = true;
+		else if(SDL_strcasecmp(argv[i], "-software-kernel-benchmark") == 0)
+			m_softwareKernelBenchmark = true;
+		else if(SDL_strcasecmp(argv[i], "-sprite-read-benchmark") == 0)
+			m_spriteReadBenchmark = true;
+		else if(SDL_strcasecmp(argv[i], "-self-test") == 0)
+			m_selfTest = true;
 	}
 }
 
@@ -921,6 +976,38 @@ bool Engine::init()
 	return true;
 }
 
+void Engine::setSpriteBudget(Uint32 spriteBudget)
+{
+	if(m_spriteBudget == spriteBudget)
+		return;
+
+	m_spriteBudget = spriteBudget;
+	if(m_surface)
+		m_surface->spriteManagerReset();
+}
+
+void Engine::setOutfitCacheMemory(Uint32 outfitCacheMemory)
+{
+	//In megabytes - 0 keeps the default limit
+	m_outfitCacheMemory = outfitCacheMemory;
+	size_t memoryLimit = (outfitCacheMemory > 0 ? SDL_static_cast(size_t, outfitCacheMemory) * 1024 * 1024 : OUTFIT_CACHE_MEMORY);
+	g_spriteManager.getOutfitCache().setMemoryLimit(memoryLimit);
+}
+
+Uint32 Engine::getSpriteBudget()
+{
+	Uint32 spriteBudget = m_spriteBudget;
+	if(spriteBudget == 0)
+	{
+		//Auto-detect - let the sprites take up to 1/8 of the video memory
+		Uint32 vram = (m_surface ? m_surface->getVRAM() : 0);
+		spriteBudget = (vram > 0 ? vram * 32 : SPRITE_BUDGET_DEFAULT);
+		spriteBudget = UTIL_min<Uint32>(spriteBudget, 65536);
+	}
+	spriteBudget = UTIL_max<Uint32>(SPRITE_BUDGET_MIN, UTIL_min<Uint32>(spriteBudget, SPRITE_BUDGET_MAX));
+	return UTIL_power_of_2(spriteBudget);
+}
+
 void Engine::initFont(Uint8 font, Sint32 width, Sint32 height, Sint16 hchars, Sint16 vchars, Sint16 maxchw, Sint16 maxchh, Sint16 spaceh)
 {
 	Uint16 picture = 0;
@@ -2848,25 +2935,35 @@ void Engine::setConsoleHeight(Sint32 height)
 
 void Engine::update()
 {
+	g_spriteManager.updateSheets();
+	if(m_replayRunning && g_connection && g_connection->isReplayFinished())
+	{
+		m_replayRunning = false;
+		finishReplay(g_connection->getReplayStats());
+	}
+
 	if(m_ingame)
 		g_map.update();
 }
 
 void Engine::redraw()
 {
+	//The interface is recorded like the game scene and handed over in one go at the end of the frame
 	m_surface->beginScene();
+	m_renderCommands.beginRecording();
+	m_renderCommands.setLayer(RENDER_LAYER_INTERFACE);
 	if(m_ingame)
 	{
 		g_map.render();
-		m_surface->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_gameBackgroundRect.x1, m_gameBackgroundRect.y1, m_gameBackgroundRect.x2, m_gameBackgroundRect.y2);
-		m_surface->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_gameWindowRect.x1 - 1, m_gameWindowRect.y1 - 1, m_gameWindowRect.x2 + 2, 1);
-		m_surface->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_gameWindowRect.x1 - 1, m_gameWindowRect.y1, 1, m_gameWindowRect.y2 + 1);
-		m_surface->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_gameWindowRect.x1, m_gameWindowRect.y1+ m_gameWindowRect.y2, m_gameWindowRect.x2 + 1, 1);
-		m_surface->drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_gameWindowRect.x1 + m_gameWindowRect.x2, m_gameWindowRect.y1, 1, m_gameWindowRect.y2);
-		m_surface->drawGameScene(0, 0, RENDERTARGET_WIDTH, RENDERTARGET_HEIGHT, m_gameWindowRect.x1, m_gameWindowRect.y1, m_gameWindowRect.x2, m_gameWindowRect.y2);
-		m_surface->setClipRect(m_gameWindowRect.x1, m_gameWindowRect.y1, m_gameWindowRect.x2, m_gameWindowRect.y2);
+		m_renderCommands.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_BACKGROUND_GREY_X, GUI_UI_BACKGROUND_GREY_Y, GUI_UI_BACKGROUND_GREY_W, GUI_UI_BACKGROUND_GREY_H, m_gameBackgroundRect.x1, m_gameBackgroundRect.y1, m_gameBackgroundRect.x2, m_gameBackgroundRect.y2);
+		m_renderCommands.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_DARK_X, GUI_UI_ICON_HORIZONTAL_LINE_DARK_Y, GUI_UI_ICON_HORIZONTAL_LINE_DARK_W, GUI_UI_ICON_HORIZONTAL_LINE_DARK_H, m_gameWindowRect.x1 - 1, m_gameWindowRect.y1 - 1, m_gameWindowRect.x2 + 2, 1);
+		m_renderCommands.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_DARK_X, GUI_UI_ICON_VERTICAL_LINE_DARK_Y, GUI_UI_ICON_VERTICAL_LINE_DARK_W, GUI_UI_ICON_VERTICAL_LINE_DARK_H, m_gameWindowRect.x1 - 1, m_gameWindowRect.y1, 1, m_gameWindowRect.y2 + 1);
+		m_renderCommands.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_X, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_Y, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_W, GUI_UI_ICON_HORIZONTAL_LINE_BRIGHT_H, m_gameWindowRect.x1, m_gameWindowRect.y1+ m_gameWindowRect.y2, m_gameWindowRect.x2 + 1, 1);
+		m_renderCommands.drawPictureRepeat(GUI_UI_IMAGE, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_X, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_Y, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_W, GUI_UI_ICON_VERTICAL_LINE_BRIGHT_H, m_gameWindowRect.x1 + m_gameWindowRect.x2, m_gameWindowRect.y1, 1, m_gameWindowRect.y2);
+		m_renderCommands.drawGameScene(0, 0, RENDERTARGET_WIDTH, RENDERTARGET_HEIGHT, m_gameWindowRect.x1, m_gameWindowRect.y1, m_gameWindowRect.x2, m_gameWindowRect.y2);
+		m_renderCommands.setClipRect(m_gameWindowRect.x1, m_gameWindowRect.y1, m_gameWindowRect.x2, m_gameWindowRect.y2);
 		g_map.renderInformations(m_gameWindowRect.x1, m_gameWindowRect.y1, m_gameWindowRect.x2, m_gameWindowRect.y2, m_scale, m_scaledSize);
-		m_surface->disableClipRect();
+		m_renderCommands.disableClipRect();
 		g_chat.render(m_chatWindowRect);
 		for(std::vector<GUI_Panel*>::iterator it = m_panels.begin(), end = m_panels.end(); it != end; ++it)
 			(*it)->render();
@@ -2879,46 +2976,46 @@ void Engine::redraw()
 			if(m_canAddLeftPanel)
 			{
 				if(m_leftAddPanel == 1)
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_ADD_DOWN_X, GUI_UI_SIDEBAR_LEFT_ADD_DOWN_Y, m_leftPanelAddRect.x1, m_leftPanelAddRect.y1, m_leftPanelAddRect.x2, m_leftPanelAddRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_ADD_DOWN_X, GUI_UI_SIDEBAR_LEFT_ADD_DOWN_Y, m_leftPanelAddRect.x1, m_leftPanelAddRect.y1, m_leftPanelAddRect.x2, m_leftPanelAddRect.y2);
 				else
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_ADD_UP_X, GUI_UI_SIDEBAR_LEFT_ADD_UP_Y, m_leftPanelAddRect.x1, m_leftPanelAddRect.y1, m_leftPanelAddRect.x2, m_leftPanelAddRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_ADD_UP_X, GUI_UI_SIDEBAR_LEFT_ADD_UP_Y, m_leftPanelAddRect.x1, m_leftPanelAddRect.y1, m_leftPanelAddRect.x2, m_leftPanelAddRect.y2);
 			}
 			else
-				m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_ADD_DISABLED_X, GUI_UI_SIDEBAR_LEFT_ADD_DISABLED_Y, m_leftPanelAddRect.x1, m_leftPanelAddRect.y1, m_leftPanelAddRect.x2, m_leftPanelAddRect.y2);
+				m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_ADD_DISABLED_X, GUI_UI_SIDEBAR_LEFT_ADD_DISABLED_Y, m_leftPanelAddRect.x1, m_leftPanelAddRect.y1, m_leftPanelAddRect.x2, m_leftPanelAddRect.y2);
 
 			m_leftPanelRemRect = iRect(m_leftPanelAddRect.x1, m_leftPanelAddRect.y1 + m_leftPanelAddRect.y2, GUI_UI_SIDEBAR_LEFT_REMOVE_UP_W, GUI_UI_SIDEBAR_LEFT_REMOVE_UP_H);
 			if(m_haveExtraLeftPanel)
 			{
 				if(m_leftRemPanel == 1)
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_REMOVE_DOWN_X, GUI_UI_SIDEBAR_LEFT_REMOVE_DOWN_Y, m_leftPanelRemRect.x1, m_leftPanelRemRect.y1, m_leftPanelRemRect.x2, m_leftPanelRemRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_REMOVE_DOWN_X, GUI_UI_SIDEBAR_LEFT_REMOVE_DOWN_Y, m_leftPanelRemRect.x1, m_leftPanelRemRect.y1, m_leftPanelRemRect.x2, m_leftPanelRemRect.y2);
 				else
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_REMOVE_UP_X, GUI_UI_SIDEBAR_LEFT_REMOVE_UP_Y, m_leftPanelRemRect.x1, m_leftPanelRemRect.y1, m_leftPanelRemRect.x2, m_leftPanelRemRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_REMOVE_UP_X, GUI_UI_SIDEBAR_LEFT_REMOVE_UP_Y, m_leftPanelRemRect.x1, m_leftPanelRemRect.y1, m_leftPanelRemRect.x2, m_leftPanelRemRect.y2);
 			}
 			else
-				m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_REMOVE_DISABLED_X, GUI_UI_SIDEBAR_LEFT_REMOVE_DISABLED_Y, m_leftPanelRemRect.x1, m_leftPanelRemRect.y1, m_leftPanelRemRect.x2, m_leftPanelRemRect.y2);
+				m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_LEFT_REMOVE_DISABLED_X, GUI_UI_SIDEBAR_LEFT_REMOVE_DISABLED_Y, m_leftPanelRemRect.x1, m_leftPanelRemRect.y1, m_leftPanelRemRect.x2, m_leftPanelRemRect.y2);
 		}
 		{
 			m_rightPanelAddRect = iRect(m_gameBackgroundRect.x1 + m_gameBackgroundRect.x2 - 7, m_gameBackgroundRect.y1, GUI_UI_SIDEBAR_RIGHT_ADD_UP_W, GUI_UI_SIDEBAR_RIGHT_ADD_UP_H);
 			if(m_canAddRightPanel)
 			{
 				if(m_rightAddPanel == 1)
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_ADD_DOWN_X, GUI_UI_SIDEBAR_RIGHT_ADD_DOWN_Y, m_rightPanelAddRect.x1, m_rightPanelAddRect.y1, m_rightPanelAddRect.x2, m_rightPanelAddRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_ADD_DOWN_X, GUI_UI_SIDEBAR_RIGHT_ADD_DOWN_Y, m_rightPanelAddRect.x1, m_rightPanelAddRect.y1, m_rightPanelAddRect.x2, m_rightPanelAddRect.y2);
 				else
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_ADD_UP_X, GUI_UI_SIDEBAR_RIGHT_ADD_UP_Y, m_rightPanelAddRect.x1, m_rightPanelAddRect.y1, m_rightPanelAddRect.x2, m_rightPanelAddRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_ADD_UP_X, GUI_UI_SIDEBAR_RIGHT_ADD_UP_Y, m_rightPanelAddRect.x1, m_rightPanelAddRect.y1, m_rightPanelAddRect.x2, m_rightPanelAddRect.y2);
 			}
 			else
-				m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_ADD_DISABLED_X, GUI_UI_SIDEBAR_RIGHT_ADD_DISABLED_Y, m_rightPanelAddRect.x1, m_rightPanelAddRect.y1, m_rightPanelAddRect.x2, m_rightPanelAddRect.y2);
+				m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_ADD_DISABLED_X, GUI_UI_SIDEBAR_RIGHT_ADD_DISABLED_Y, m_rightPanelAddRect.x1, m_rightPanelAddRect.y1, m_rightPanelAddRect.x2, m_rightPanelAddRect.y2);
 
 			m_rightPanelRemRect = iRect(m_rightPanelAddRect.x1, m_rightPanelAddRect.y1 + m_rightPanelAddRect.y2, GUI_UI_SIDEBAR_RIGHT_REMOVE_UP_W, GUI_UI_SIDEBAR_RIGHT_REMOVE_UP_H);
 			if(m_haveExtraRightPanel)
 			{
 				if(m_rightRemPanel == 1)
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_REMOVE_DOWN_X, GUI_UI_SIDEBAR_RIGHT_REMOVE_DOWN_Y, m_rightPanelRemRect.x1, m_rightPanelRemRect.y1, m_rightPanelRemRect.x2, m_rightPanelRemRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_REMOVE_DOWN_X, GUI_UI_SIDEBAR_RIGHT_REMOVE_DOWN_Y, m_rightPanelRemRect.x1, m_rightPanelRemRect.y1, m_rightPanelRemRect.x2, m_rightPanelRemRect.y2);
 				else
-					m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_REMOVE_UP_X, GUI_UI_SIDEBAR_RIGHT_REMOVE_UP_Y, m_rightPanelRemRect.x1, m_rightPanelRemRect.y1, m_rightPanelRemRect.x2, m_rightPanelRemRect.y2);
+					m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_REMOVE_UP_X, GUI_UI_SIDEBAR_RIGHT_REMOVE_UP_Y, m_rightPanelRemRect.x1, m_rightPanelRemRect.y1, m_rightPanelRemRect.x2, m_rightPanelRemRect.y2);
 			}
 			else
-				m_surface->drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_REMOVE_DISABLED_X, GUI_UI_SIDEBAR_RIGHT_REMOVE_DISABLED_Y, m_rightPanelRemRect.x1, m_rightPanelRemRect.y1, m_rightPanelRemRect.x2, m_rightPanelRemRect.y2);
+				m_renderCommands.drawPicture(GUI_UI_IMAGE, GUI_UI_SIDEBAR_RIGHT_REMOVE_DISABLED_X, GUI_UI_SIDEBAR_RIGHT_REMOVE_DISABLED_Y, m_rightPanelRemRect.x1, m_rightPanelRemRect.y1, m_rightPanelRemRect.x2, m_rightPanelRemRect.y2);
 		}
 
 		if(m_topPanel)
@@ -2926,7 +3023,7 @@ void Engine::redraw()
 	}
 	else
 	{
-		m_surface->drawBackground(GUI_BACKGROUND_IMAGE, GUI_BACKGROUND_X, GUI_BACKGROUND_Y, GUI_BACKGROUND_W, GUI_BACKGROUND_H, 0, 0, m_windowW, m_windowH);
+		m_renderCommands.drawBackground(GUI_BACKGROUND_IMAGE, GUI_BACKGROUND_X, GUI_BACKGROUND_Y, GUI_BACKGROUND_W, GUI_BACKGROUND_H, 0, 0, m_windowW, m_windowH);
 		if(g_mainWindow)
 			g_mainWindow->render();
 	}
@@ -2954,6 +3051,70 @@ void Engine::redraw()
 		drawFont(CLIENT_FONT_OUTLINED, posX, 61, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
 		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "VRAM: %u MB", m_surface->getVRAM());
 		drawFont(CLIENT_FONT_OUTLINED, posX, 75, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+
+		OutfitCache& outfitCache = g_spriteManager.getOutfitCache();
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "Outfits: %u hits, %u misses (%u KB)", outfitCache.getHits(), outfitCache.getMisses(), SDL_static_cast(Uint32, outfitCache.getMemoryUsage() / 1024));
+		drawFont(CLIENT_FONT_OUTLINED, posX, 89, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+
+		SpriteResidency& spriteResidency = m_surface->getSpriteResidency();
+		Uint32 spriteLookups = spriteResidency.getHits() + spriteResidency.getMisses();
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "Sprites: %u/%u, %u evictions (%u%% hits)", spriteResidency.getResident(), spriteResidency.getCapacity(), spriteResidency.getEvictions(), (spriteLookups > 0 ? SDL_static_cast(Uint32, SDL_static_cast(Uint64, spriteResidency.getHits()) * 100 / spriteLookups) : 100));
+		drawFont(CLIENT_FONT_OUTLINED, posX, 103, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+
+		if(g_connection && g_connection->getProtocol())
+		{
+			InflateStats inflateStats = g_connection->getProtocol()->getInflateStats();
+			double inflateRatio = (inflateStats.compressedBytes > 0 ? SDL_static_cast(double, inflateStats.inflatedBytes) / SDL_static_cast(double, inflateStats.compressedBytes) : 0.0);
+			double inflateTime = (inflateStats.packets > 0 ? SDL_static_cast(double, inflateStats.ticks) * 1000000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency()) / inflateStats.packets : 0.0);
+			len = SDL_snprintf(g_buffer, sizeof(g_buffer), "Inflate: %u packets, %.2fx ratio, %.1f us/packet", inflateStats.packets, inflateRatio, inflateTime);
+			drawFont(CLIENT_FONT_OUTLINED, posX, 117, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+		}
+
+		ItemPoolStats itemPoolStats = Item::getPoolStats();
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "Items: %u live, %u pooled, %u slabs (%" SDL_PRIu64 " allocations)", itemPoolStats.liveItems, itemPoolStats.freeItems, itemPoolStats.slabs, itemPoolStats.allocations);
+		drawFont(CLIENT_FONT_OUTLINED, posX, 131, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+
+		double sceneTime = SDL_static_cast(double, g_map.getSceneBuildTicks()) * 1000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency());
+		double drawTime = SDL_static_cast(double, g_map.getSceneDrawTicks()) * 1000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency());
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "Scene: %u draw commands, %.2f ms build, %.2f ms draw (%d threads)", m_sceneCommands.getCommandCount(), sceneTime, drawTime, g_jobSystem.getThreadCount());
+		drawFont(CLIENT_FONT_OUTLINED, posX, 145, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+
+		JobStats jobStats = g_jobSystem.getStats();
+		double jobTime = (jobStats.jobs > 0 ? SDL_static_cast(double, jobStats.ticks) * 1000000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency()) / jobStats.jobs : 0.0);
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "Jobs: %" SDL_PRIu64 " run, %" SDL_PRIu64 " stolen, %.1f us/job", jobStats.jobs, jobStats.steals, jobTime);
+		drawFont(CLIENT_FONT_OUTLINED, posX, 159, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+
+		#ifdef __PARSE_PROFILER__
+		//Show the opcodes that took most of the parse time
+		Uint8 topOpcodes[5];
+		Uint32 topCount = 0;
+		for(Uint32 i = 0; i < 256; ++i)
+		{
+			if(ProtocolGame::parseStats[i].count == 0)
+				continue;
+
+			Uint32 pos = topCount;
+			while(pos > 0 && ProtocolGame::parseStats[topOpcodes[pos - 1]].totalTicks < ProtocolGame::parseStats[i].totalTicks)
+			{
+				if(pos < 5)
+					topOpcodes[pos] = topOpcodes[pos - 1];
+				--pos;
+			}
+			if(pos < 5)
+			{
+				topOpcodes[pos] = SDL_static_cast(Uint8, i);
+				topCount = UTIL_min<Uint32>(topCount + 1, 5);
+			}
+		}
+
+		double tickToMs = 1000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency());
+		for(Uint32 i = 0; i < topCount; ++i)
+		{
+			ParseOpcodeStats& stats = ProtocolGame::parseStats[topOpcodes[i]];
+			len = SDL_snprintf(g_buffer, sizeof(g_buffer), "0x%02X: %u packets, %u KB, %.2f ms (max %.3f ms)", SDL_static_cast(Uint32, topOpcodes[i]), stats.count, SDL_static_cast(Uint32, stats.bytes / 1024), SDL_static_cast(double, stats.totalTicks) * tickToMs, SDL_static_cast(double, stats.maxTicks) * tickToMs);
+			drawFont(CLIENT_FONT_OUTLINED, posX, 173 + SDL_static_cast(Sint32, i) * 14, std::string(g_buffer, SDL_static_cast(size_t, len)), 255, 255, 255, CLIENT_FONT_ALIGN_RIGHT);
+		}
+		#endif
 	}
 
 	if(m_actWindow)
@@ -2967,7 +3128,10 @@ void Engine::redraw()
 
 	if(m_contextMenu)
 		m_contextMenu->render();
-		
+
+	m_renderCommands.endRecording();
+	m_renderCommands.submit(m_surface.get());
+	m_renderCommands.flushScene();
 	m_surface->endScene();
 }
 
@@ -2983,7 +3147,7 @@ void Engine::drawFont(Uint8 fontId, Sint32 x, Sint32 y, const std::string& text,
 	if(len > text.length())
 		len = text.length();
 
-	m_surface->drawFont(m_charPicture[fontId], x, y, text, pos, len, r, g, b, m_charx[fontId], m_chary[fontId], m_charw[fontId], m_charh[fontId]);
+	m_renderCommands.drawFont(fontId, x, y, text, pos, len, r, g, b);
 }
 
 void Engine::drawFont(Uint8 fontId, Sint32 x, Sint32 y, const std::string& text, Uint8 r, Uint8 g, Uint8 b, Sint32 align)
@@ -3005,7 +3169,7 @@ void Engine::drawFont(Uint8 fontId, Sint32 x, Sint32 y, const std::string& text,
 					break;
 				default: break;
 			}
-			m_surface->drawFont(m_charPicture[fontId], rx, ry, text, start, pos, r, g, b, m_charx[fontId], m_chary[fontId], m_charw[fontId], m_charh[fontId]);
+			m_renderCommands.drawFont(fontId, rx, ry, text, start, pos, r, g, b);
 			++pos;
 			start = pos;
 			rx = x; ry += m_charh[fontId][0];
@@ -3026,10 +3190,10 @@ void Engine::drawFont(Uint8 fontId, Sint32 x, Sint32 y, const std::string& text,
 				break;
 			default: break;
 		}
-		m_surface->drawFont(m_charPicture[fontId], rx, ry, text, start, pos, r, g, b, m_charx[fontId], m_chary[fontId], m_charw[fontId], m_charh[fontId]);
+		m_renderCommands.drawFont(fontId, rx, ry, text, start, pos, r, g, b);
 		return;
 	}
-	m_surface->drawFont(m_charPicture[fontId], x, y, text, 0, text.length(), r, g, b, m_charx[fontId], m_chary[fontId], m_charw[fontId], m_charh[fontId]);
+	m_renderCommands.drawFont(fontId, x, y, text, 0, text.length(), r, g, b);
 }
 
 void Engine::drawItem(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uint8 xPattern, Uint8 yPattern, Uint8 zPattern, Uint8 animation)
@@ -3043,7 +3207,7 @@ void Engine::drawItem(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uint8
 		{
 			Uint32 sprite = thing->getSprite(ThingFrameGroup_Default, 0, 0, l, xPattern, yPattern, zPattern, animation);
 			if(sprite != 0)
-				m_surface->drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
+				m_renderCommands.drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
 		}
 	}
 	else
@@ -3082,7 +3246,7 @@ void Engine::drawItem(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uint8
 							sy = SDL_static_cast(Sint32, SDL_static_cast(float, diff) / SDL_static_cast(float, scale) * 32.f);
 							sh -= sy;
 						}
-						m_surface->drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
+						m_renderCommands.drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
 					}
 					posXc -= scale;
 				}
@@ -3106,16 +3270,16 @@ void Engine::drawOutfit(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uin
 			if(sprite != 0)
 			{
 				if(spriteMask != 0)
-					m_surface->drawSpriteMask(sprite, spriteMask, x, y, scaled, scaled, 0, 0, 32, 32, outfitColor);
+					m_renderCommands.drawSpriteMask(sprite, spriteMask, x, y, scaled, scaled, 0, 0, 32, 32, outfitColor);
 				else
-					m_surface->drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
+					m_renderCommands.drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
 			}
 		}
 		else
 		{
 			Uint32 sprite = thing->getSprite(ThingFrameGroup_Idle, 0, 0, 0, xPattern, yPattern, zPattern, animation);
 			if(sprite != 0)
-				m_surface->drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
+				m_renderCommands.drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
 		}
 	}
 	else
@@ -3156,9 +3320,9 @@ void Engine::drawOutfit(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uin
 							sh -= sy;
 						}
 						if(spriteMask != 0)
-							m_surface->drawSpriteMask(sprite, spriteMask, dx, dy, dw, dh, sx, sy, sw, sh, outfitColor);
+							m_renderCommands.drawSpriteMask(sprite, spriteMask, dx, dy, dw, dh, sx, sy, sw, sh, outfitColor);
 						else
-							m_surface->drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
+							m_renderCommands.drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
 					}
 					posXc -= scale;
 				}
@@ -3194,7 +3358,7 @@ void Engine::drawOutfit(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uin
 							sy = SDL_static_cast(Sint32, SDL_static_cast(float, diff) / SDL_static_cast(float, scale) * 32.f);
 							sh -= sy;
 						}
-						m_surface->drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
+						m_renderCommands.drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
 					}
 					posXc -= scale;
 				}
@@ -3212,7 +3376,7 @@ void Engine::drawEffect(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uin
 	{
 		Uint32 sprite = thing->getSprite(ThingFrameGroup_Default, 0, 0, 0, xPattern, yPattern, zPattern, animation);
 		if(sprite != 0)
-			m_surface->drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
+			m_renderCommands.drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
 	}
 	else
 	{
@@ -3248,7 +3412,7 @@ void Engine::drawEffect(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uin
 						sy = SDL_static_cast(Sint32, SDL_static_cast(float, diff) / SDL_static_cast(float, scale) * 32.f);
 						sh -= sy;
 					}
-					m_surface->drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
+					m_renderCommands.drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
 				}
 				posXc -= scale;
 			}
@@ -3265,7 +3429,7 @@ void Engine::drawDistanceEffect(ThingType* thing, Sint32 x, Sint32 y, Sint32 sca
 	{
 		Uint32 sprite = thing->getSprite(ThingFrameGroup_Default, 0, 0, 0, xPattern, yPattern, zPattern, animation);
 		if(sprite != 0)
-			m_surface->drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
+			m_renderCommands.drawSprite(sprite, x, y, scaled, scaled, 0, 0, 32, 32);
 	}
 	else
 	{
@@ -3301,7 +3465,7 @@ void Engine::drawDistanceEffect(ThingType* thing, Sint32 x, Sint32 y, Sint32 sca
 						sy = SDL_static_cast(Sint32, SDL_static_cast(float, diff) / SDL_static_cast(float, scale) * 32.f);
 						sh -= sy;
 					}
-					m_surface->drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
+					m_renderCommands.drawSprite(sprite, dx, dy, dw, dh, sx, sy, sw, sh);
 				}
 				posXc -= scale;
 			}
@@ -3310,6 +3474,15 @@ void Engine::drawDistanceEffect(ThingType* thing, Sint32 x, Sint32 y, Sint32 sca
 	}
 }
 
+bool Engine::isSpriteReady(Uint32 spriteId)
+{
+	//Invalid sprites are reported as ready because LoadSprite will simply fail on them
+	if(spriteId == 0 || spriteId > g_spriteCounts)
+		return true;
+
+	return g_spriteManager.isSpriteReady(spriteId);
+}
+
 unsigned char* Engine::LoadSprite(Uint32 spriteId, bool bgra)
 {
 	if(spriteId == 0 || spriteId > g_spriteCounts)
@@ -3322,7 +3495,13 @@ unsigned char* Engine::LoadSprite(Uint32 spriteId, bool bgra)
 
 unsigned char* Engine::LoadSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Uint32 outfitColor, bool bgra)
 {
-	unsigned char* pixels = LoadSprite(spriteId, bgra);
+	OutfitCache& outfitCache = g_spriteManager.getOutfitCache();
+	OutfitCacheKey outfitKey(spriteId, maskSpriteId, outfitColor, bgra);
+	unsigned char* pixels = outfitCache.getPixels(outfitKey);
+	if(pixels)
+		return pixels;
+
+	pixels = LoadSprite(spriteId, bgra);
 	if(!pixels)
 		return NULL;
 
@@ -3333,111 +3512,8 @@ unsigned char* Engine::LoadSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Uint
 		return NULL;
 	}
 
-	float hR, hG, hB, bR, bG, bB, lR, lG, lB, fR, fG, fB;
-	getOutfitColorFloat(SDL_static_cast(Uint8, outfitColor), hR, hG, hB);
-	getOutfitColorFloat(SDL_static_cast(Uint8, outfitColor >> 8), bR, bG, bB);
-	getOutfitColorFloat(SDL_static_cast(Uint8, outfitColor >> 16), lR, lG, lB);
-	getOutfitColorFloat(SDL_static_cast(Uint8, outfitColor >> 24), fR, fG, fB);
-	if(bgra)
-	{
-		for(Uint16 i = 0; i <= 4092; i += 4)
-		{
-			if(tempPixels[i + 3] == SDL_ALPHA_OPAQUE)
-			{
-				Uint32 U32pixel = *SDL_reinterpret_cast(Uint32*, &tempPixels[i]);
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Head
-				if(U32pixel == 0xFFFFFF00)
-				#else
-				if(U32pixel == 0x00FFFFFF)
-				#endif
-				{
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * hR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * hG);
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * hB);
-				}
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Body
-				else if(U32pixel == 0xFFFF0000)
-				#else
-				else if(U32pixel == 0x0000FFFF)
-				#endif
-				{
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * bR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * bG);
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * bB);
-				}
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Legs
-				else if(U32pixel == 0xFF00FF00)
-				#else
-				else if(U32pixel == 0x00FF00FF)
-				#endif
-				{
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * lR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * lG);
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * lB);
-				}
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Feet
-				else if(U32pixel == 0xFF0000FF)
-				#else
-				else if(U32pixel == 0xFF0000FF)
-				#endif
-				{
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * fR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * fG);
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * fB);
-				}
-			}
-		}
-	}
-	else
-	{
-		for(Uint16 i = 0; i <= 4092; i += 4)
-		{
-			if(tempPixels[i + 3] == SDL_ALPHA_OPAQUE)
-			{
-				Uint32 U32pixel = *SDL_reinterpret_cast(Uint32*, &tempPixels[i]);
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Head
-				if(U32pixel == 0xFF00FFFF)
-				#else
-				if(U32pixel == 0xFFFF00FF)
-				#endif
-				{
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * hR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * hG);
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * hB);
-				}
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Body
-				else if(U32pixel == 0xFF0000FF)
-				#else
-				else if(U32pixel == 0xFF0000FF)
-				#endif
-				{
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * bR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * bG);
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * bB);
-				}
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Legs
-				else if(U32pixel == 0xFF00FF00)
-				#else
-				else if(U32pixel == 0x00FF00FF)
-				#endif
-				{
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * lR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * lG);
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * lB);
-				}
-				#if SDL_BYTEORDER == SDL_LIL_ENDIAN //Feet
-				else if(U32pixel == 0xFFFF0000)
-				#else
-				else if(U32pixel == 0x0000FFFF)
-				#endif
-				{
-					pixels[i] = SDL_static_cast(Uint8, pixels[i] * fR);
-					pixels[i + 1] = SDL_static_cast(Uint8, pixels[i + 1] * fG);
-					pixels[i + 2] = SDL_static_cast(Uint8, pixels[i + 2] * fB);
-				}
-			}
-		}
-	}
+	OUTFIT_colorize(pixels, tempPixels, outfitColor, bgra);
+	outfitCache.storePixels(outfitKey, pixels);
 	SDL_free(tempPixels);
 	return pixels;
 }
@@ -3544,6 +3620,25 @@ void Engine::issueNewConnection(bool protocolGame)
 		#else
 		g_connection = new Connection(character.worldIp.c_str(), character.worldPort, "", "", protocol);
 		#endif
+		if(!m_recordFile.empty())
+		{
+			//Every game connection gets its own numbered file so reconnecting or switching character doesn't truncate the earlier capture
+			std::string recordFile = m_recordFile;
+			if(m_recordSequence++ > 0)
+			{
+				std::string::size_type extension = recordFile.find_last_of('.');
+				std::string::size_type separator = recordFile.find_last_of("/\\");
+				if(extension == std::string::npos || (separator != std::string::npos && extension < separator))
+					extension = recordFile.size();
+
+				Sint32 len = SDL_snprintf(g_buffer, sizeof(g_buffer), "-%u", m_recordSequence);
+				recordFile.insert(extension, g_buffer, SDL_static_cast(size_t, len));
+			}
+
+			std::unique_ptr<PacketRecorder> recorder = std::make_unique<PacketRecorder>();
+			if(recorder->open(recordFile.c_str()))
+				g_connection->setRecorder(std::move(recorder));
+		}
 	}
 	else
 	{
@@ -3556,6 +3651,85 @@ void Engine::issueNewConnection(bool protocolGame)
 	}
 }
 
+void Engine::issueReplayConnection()
+{
+	if(m_replayFile.empty() && m_replaySynthetic.empty())
+		return;
+
+	std::unique_ptr<PacketReplayer> replayer = std::make_unique<PacketReplayer>();
+	if(!m_replaySynthetic.empty())
+	{
+		std::vector<Uint8> stream;
+		PacketGenerator generator;
+		if(!generator.generate(m_replaySynthetic.c_str(), stream) || !replayer->open(std::move(stream)))
+		{
+			UTIL_messageBox("Error", "Couldn't generate the synthetic replay - the scenario is unknown or the game data isn't loaded.");
+			m_replaySynthetic.clear();
+			return;
+		}
+	}
+	else if(!replayer->open(m_replayFile.c_str()))
+	{
+		UTIL_messageBox("Error", "Couldn't open the replay file.");
+		m_replayFile.clear();
+		return;
+	}
+	else if(replayer->getClientVersion() != g_clientVersion)
+	{
+		Sint32 len = SDL_snprintf(g_buffer, sizeof(g_buffer), "The replay was recorded with client version %u.", replayer->getClientVersion());
+		UTIL_messageBox("Error", std::string(g_buffer, SDL_static_cast(size_t, len)));
+		m_replayFile.clear();
+		return;
+	}
+
+	//Replay only once - after that the client behave normally
+	m_replayFile.clear();
+	m_replaySynthetic.clear();
+	releaseConnection();
+	#ifdef __PARSE_PROFILER__
+	//Only account the replayed packets in parsestats.csv
+	ProtocolGame::resetParseStats();
+	#endif
+	g_connection = new Connection(std::move(replayer), m_replayFast, new ProtocolGame());
+	m_replayRunning = true;
+}
+
+void Engine::finishReplay(const ReplayStats& replayStats)
+{
+	double parseTime = SDL_static_cast(double, replayStats.parseTicks) / SDL_static_cast(double, SDL_GetPerformanceFrequency());
+	double packetsPerSecond = (parseTime > 0.0 ? replayStats.parsedPackets / parseTime : 0.0);
+	double nsPerPacket = (replayStats.parsedPackets > 0 ? parseTime * 1000000000.0 / replayStats.parsedPackets : 0.0);
+	SDL_Log("Replay finished: %u packets(%u KB) parsed in %.2f ms - %.0f packets/sec, %.0f ns/packet", replayStats.parsedPackets, SDL_static_cast(Uint32, replayStats.parsedBytes / 1024), parseTime * 1000.0, packetsPerSecond, nsPerPacket);
+	#ifdef __ALLOCATION_COUNTER__
+	double allocationsPerPacket = (replayStats.parsedPackets > 0 ? SDL_static_cast(double, replayStats.parseAllocations) / replayStats.parsedPackets : 0.0);
+	SDL_Log("Replay allocations: %" SDL_PRIu64 " allocations while parsing - %.2f allocations/packet", replayStats.parseAllocations, allocationsPerPacket);
+	#endif
+
+	Uint32 sceneFrames = g_map.getSceneFrames();
+	double sceneTime = (sceneFrames > 0 ? SDL_static_cast(double, g_map.getSceneBuildTotalTicks()) * 1000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency()) / sceneFrames : 0.0);
+	double drawTime = (sceneFrames > 0 ? SDL_static_cast(double, g_map.getSceneDrawTotalTicks()) * 1000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency()) / sceneFrames : 0.0);
+	double sceneFloors = (sceneFrames > 0 ? SDL_static_cast(double, g_map.getSceneFloorsTotal()) / sceneFrames : 0.0);
+	SDL_Log("Replay scene: %u frames, %.3f ms/frame scene build, %.3f ms/frame scene draw with %d threads over %.1f floors/frame", sceneFrames, sceneTime, drawTime, g_jobSystem.getThreadCount(), sceneFloors);
+
+	JobStats jobStats = g_jobSystem.getStats();
+	double jobTime = (jobStats.jobs > 0 ? SDL_static_cast(double, jobStats.ticks) * 1000000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency()) / jobStats.jobs : 0.0);
+	SDL_Log("Replay jobs: %" SDL_PRIu64 " jobs run(%" SDL_PRIu64 " stolen), %.1f us/job", jobStats.jobs, jobStats.steals, jobTime);
+
+	ItemPoolStats itemPoolStats = Item::getPoolStats();
+	SDL_Log("Replay item pool: %" SDL_PRIu64 " item allocations served by %u slabs, %u items live", itemPoolStats.allocations, itemPoolStats.slabs, itemPoolStats.liveItems);
+	#ifdef __PARSE_PROFILER__
+	SDL_snprintf(g_buffer, sizeof(g_buffer), "%sparsestats.csv", g_prefPath.c_str());
+	ProtocolGame::dumpParseStats(g_buffer);
+	#endif
+
+	if(m_replayBenchmark)
+	{
+		//Benchmark runs are unattended - quit without asking
+		g_inited = false;
+		g_running = false;
+	}
+}
+
 void Engine::releaseConnection()
 {
 	if(g_connection)
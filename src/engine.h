@@ -23,6 +23,8 @@
 #define __FILE_ENGINE_h_
 
 #include "defines.h"
+#include "spriteResidency.h"
+#include "renderCommands.h"
 
 class Surface
 {
@@ -76,6 +78,24 @@ class Surface
 		virtual void drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor) = 0;
 
 		virtual void drawAutomapTile(Uint32 currentArea, bool& recreate, Uint8 color[256][256], Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh) = 0;
+
+		//Takes a whole recorded list, backends that can batch it override this
+		virtual void drawCommands(RenderCommandList& commands);
+
+		//Per floor targets keeping the ground of the map window between frames, backends without them
+		//report generation 0 and the map draws every tile itself, a new generation means the content got lost
+		virtual Uint32 getStaticLayerGeneration() {return 0;}
+		virtual void beginStaticLayer(Uint8) {}
+		virtual void endStaticLayer() {}
+		virtual void drawStaticLayer(Uint8, Sint32, Sint32, Sint32, Sint32) {}
+
+		//Cells that got drawn before their sprites were decoded, they are moved into misses
+		virtual void takeStaticLayerMisses(std::vector<Uint32>&) {}
+
+		SDL_INLINE SpriteResidency& getSpriteResidency() {return m_spriteResidency;}
+
+	protected:
+		SpriteResidency m_spriteResidency;
 };
 
 class GUI_Window;
@@ -87,6 +107,7 @@ class ThingType;
 class Creature;
 class ItemUI;
 class Item;
+struct ReplayStats;
 class Engine
 {
 	public:
@@ -116,6 +137,11 @@ class Engine
 		Uint32 calculateFontWidth(Uint8 fontId, const std::string& text);
 		SDL_INLINE Uint32 calculateFontGlyphWidth(Uint8 fontId, const Uint8 glyph) {return (m_charw[fontId][glyph] + m_charx[fontId][0]);}
 		SDL_INLINE Sint32 getFontSpace(Uint8 fontId) {return m_chary[fontId][0];}
+		SDL_INLINE Uint16 getFontPicture(Uint8 fontId) {return m_charPicture[fontId];}
+		SDL_INLINE Sint16* getFontCharX(Uint8 fontId) {return m_charx[fontId];}
+		SDL_INLINE Sint16* getFontCharY(Uint8 fontId) {return m_chary[fontId];}
+		SDL_INLINE Sint16* getFontCharW(Uint8 fontId) {return m_charw[fontId];}
+		SDL_INLINE Sint16* getFontCharH(Uint8 fontId) {return m_charh[fontId];}
 
 		void exitGame();
 		void checkReleaseQueue();
@@ -164,11 +190,14 @@ class Engine
 		void drawEffect(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uint8 xPattern, Uint8 yPattern, Uint8 zPattern, Uint8 animation);
 		void drawDistanceEffect(ThingType* thing, Sint32 x, Sint32 y, Sint32 scaled, Uint8 xPattern, Uint8 yPattern, Uint8 zPattern, Uint8 animation);
 
+		bool isSpriteReady(Uint32 spriteId);
 		unsigned char* LoadSprite(Uint32 spriteId, bool bgra);
 		unsigned char* LoadSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Uint32 outfitColor, bool bgra);
 		unsigned char* LoadPicture(Uint16 pictureId, bool bgra, Sint32& width, Sint32& height);
 
 		void issueNewConnection(bool protocolGame);
+		void issueReplayConnection();
+		void finishReplay(const ReplayStats& replayStats);
 		void releaseConnection();
 
 		void initMove(Uint16 posX, Uint16 posY, Uint8 posZ);
@@ -200,6 +229,14 @@ class Engine
 		SDL_INLINE void setEngineId(Uint8 engine) {m_engine = engine;}
 		SDL_INLINE Uint8 getEngineId() {return m_engine;}
 		SDL_INLINE std::unique_ptr<Surface>& getRender() {return m_surface;}
+		SDL_INLINE RenderCommandList& getRenderCommands() {RenderCommandList* commands = RenderCommandList::getCurrent(); return (commands ? *commands : m_renderCommands);}
+		SDL_INLINE RenderCommandList& getSceneCommands() {return m_sceneCommands;}
+		SDL_INLINE Sint32 getJobThreads() {return m_jobThreads;}
+		SDL_INLINE bool isSoftwareSdlBlit() {return m_softwareSdlBlit;}
+		SDL_INLINE bool isSoftwareKernelBenchmark() {return m_softwareKernelBenchmark;}
+		SDL_INLINE bool isSpriteReadBenchmark() {return m_spriteReadBenchmark;}
+		SDL_INLINE bool isSelfTest() {return m_selfTest;}
+		SDL_INLINE bool isReplayHeadless() {return m_replayHeadless;}
 
 		SDL_INLINE void setClientHost(std::string clientHost) {m_clientHost = std::move(clientHost);}
 		SDL_INLINE void setClientPort(std::string clientPort) {m_clientPort = std::move(clientPort);}
@@ -212,6 +249,13 @@ class Engine
 		
 		SDL_INLINE void setSharpening(bool vsync) {m_sharpening = vsync;}
 		SDL_INLINE bool isSharpening() {return m_sharpening;}
+		SDL_INLINE void setSpriteDiskCache(bool diskCache) {m_spriteDiskCache = diskCache;}
+		SDL_INLINE bool hasSpriteDiskCache() {return m_spriteDiskCache;}
+		void setSpriteBudget(Uint32 spriteBudget);
+		SDL_INLINE Uint32 getConfiguredSpriteBudget() {return m_spriteBudget;}
+		Uint32 getSpriteBudget();
+		void setOutfitCacheMemory(Uint32 outfitCacheMemory);
+		SDL_INLINE Uint32 getOutfitCacheMemory() {return m_outfitCacheMemory;}
 		SDL_INLINE void setVsync(bool vsync) {m_vsync = vsync; m_controlFPS = (!m_unlimitedFPS && !m_vsync);}
 		SDL_INLINE bool isVsync() {return m_vsync;}
 		SDL_INLINE void setAntialiasing(Uint8 antialiasing) {m_antialiasing = antialiasing;}
@@ -373,6 +417,9 @@ class Engine
 		std::string m_clientPort = "7171";
 		std::string m_clientProxy;
 		std::string m_clientProxyAuth;
+		std::string m_recordFile;
+		std::string m_replayFile;
+		std::string m_replaySynthetic;
 
 		std::string m_motdText = "No current information.";
 		std::string m_accountSessionKey;
@@ -392,6 +439,8 @@ class Engine
 		std::vector<GUI_Panel*> m_toReleasePanels;
 		std::vector<GUI_Panel*> m_panels;
 		std::unique_ptr<Surface> m_surface;
+		RenderCommandList m_renderCommands;
+		RenderCommandList m_sceneCommands;
 
 		std::map<Uint32, VipData> m_vipData;
 		std::map<Uint32, Sint32> m_parentWindows;
@@ -453,6 +502,10 @@ class Engine
 		Uint8 m_levelSeparator = 80;
 		Uint8 m_lightMode = CLIENT_LIGHT_MODE_OLD;
 		Uint8 m_engine;
+		Uint32 m_spriteBudget = 0;
+		Uint32 m_outfitCacheMemory = 0;
+		Sint32 m_jobThreads = -1;
+		Uint32 m_recordSequence = 0;
 
 		Uint8 m_leftAddPanel = 0;
 		Uint8 m_leftRemPanel = 0;
@@ -474,6 +527,15 @@ class Engine
 		bool m_unlimitedFPS = true;
 		bool m_controlFPS = false;
 		bool m_sharpening = false;
+		bool m_spriteDiskCache = false;
+		bool m_replayFast = false;
+		bool m_replayBenchmark = false;
+		bool m_replayHeadless = false;
+		bool m_replayRunning = false;
+		bool m_softwareSdlBlit = false;
+		bool m_softwareKernelBenchmark = false;
+		bool m_spriteReadBenchmark = false;
+		bool m_selfTest = false;
 
 		bool m_classicControl = true;
 		bool m_autoChaseOff = true;
@@ -21,6 +21,19 @@
 
 #include "inputMessage.h"
 
+InputMessage::InputMessage()
+{
+	//Failed allocation leaves the message empty - reserve will try again before anything gets written
+	m_networkBuffer = SDL_reinterpret_cast(Uint8*, SDL_malloc(INPUTMESSAGE_SIZE));
+	m_capacity = (m_networkBuffer ? INPUTMESSAGE_SIZE : 0);
+	reset();
+}
+
+InputMessage::~InputMessage()
+{
+	SDL_free(m_networkBuffer);
+}
+
 bool InputMessage::readAdler32()
 {
 	Uint32 receivedChecksum = getU32();
@@ -35,3 +48,25 @@ bool InputMessage::canRead(Uint32 bytes)
 
 	return true;
 }
+
+bool InputMessage::reserve(Uint32 capacity)
+{
+	if(capacity <= m_capacity)
+		return true;
+	else if(capacity > INPUTMESSAGE_MAX_SIZE)
+		return false;
+
+	Uint8* networkBuffer = SDL_reinterpret_cast(Uint8*, SDL_realloc(m_networkBuffer, capacity));
+	if(!networkBuffer)
+		return false;
+
+	m_networkBuffer = networkBuffer;
+	m_capacity = capacity;
+	return true;
+}
+
+void InputMessage::swapBuffer(InputMessage& msg)
+{
+	std::swap(m_networkBuffer, msg.m_networkBuffer);
+	std::swap(m_capacity, msg.m_capacity);
+}
@@ -24,6 +24,8 @@
 
 #include "position.h"
 #define INPUTMESSAGE_SIZE 65536
+//Decompressed packets can be bigger than anything we receive from the socket
+#define INPUTMESSAGE_MAX_SIZE 262144
 
 class Protocol;
 class ProtocolLogin;
@@ -32,7 +34,8 @@ class Connection;
 class InputMessage
 {
 	public:
-		InputMessage() {reset();}
+		InputMessage();
+		~InputMessage();
 
 		// non-copyable
 		InputMessage(const InputMessage&) = delete;
@@ -43,8 +46,8 @@ class InputMessage
 		InputMessage& operator=(InputMessage&&) = delete;
 
 		void reset() {m_readPos = 0; m_messageSize = 0;}
-		void setReadPos(Uint16 readPos) {m_readPos = readPos;}
-		void setMessageSize(Uint16 size) {m_messageSize = size;}
+		void setReadPos(Uint32 readPos) {m_readPos = readPos;}
+		void setMessageSize(Uint32 size) {m_messageSize = size;}
 		
 		Uint8 getU8()
 		{
@@ -300,7 +303,7 @@ class InputMessage
 			if(!canRead(stringLength))
 				return EmptyString;
 
-			Uint16 readPos = m_readPos;
+			Uint32 readPos = m_readPos;
 			m_readPos += stringLength;
 			return SDL_reinterpret_cast(char*, m_networkBuffer + readPos);
 		}
@@ -311,7 +314,7 @@ class InputMessage
 			if(!canRead(stringLength))
 				return std::string();
 
-			Uint16 readPos = m_readPos;
+			Uint32 readPos = m_readPos;
 			m_readPos += stringLength;
 			return std::string(SDL_reinterpret_cast(char*, m_networkBuffer + readPos), stringLength);
 		}
@@ -329,9 +332,10 @@ class InputMessage
 		Sint32 peekS32() {return static_cast<Sint32>(peekU32());}
 		Sint64 peekS64() {return static_cast<Sint64>(peekU64());}
 
-		Uint16 getReadPos() {return m_readPos;}
-		Uint16 getUnreadSize() {return m_messageSize - m_readPos;}
-		Uint16 getMessageSize() {return m_messageSize;}
+		Uint32 getReadPos() {return m_readPos;}
+		Uint32 getUnreadSize() {return m_messageSize - m_readPos;}
+		Uint32 getMessageSize() {return m_messageSize;}
+		Uint32 getCapacity() {return m_capacity;}
 		bool eof() {return m_readPos >= m_messageSize;}
 
 	protected:
@@ -339,6 +343,8 @@ class InputMessage
 		Uint8* getReadBuffer() {return m_networkBuffer + m_readPos;}
 
 		bool readAdler32();
+		bool reserve(Uint32 capacity);
+		void swapBuffer(InputMessage& msg);
 
 		friend class Protocol;
 		friend class ProtocolLogin;
@@ -348,9 +354,10 @@ class InputMessage
 	private:
 		bool canRead(Uint32 bytes);
 
-		Uint16 m_readPos;
-		Uint16 m_messageSize;
-		Uint8 m_networkBuffer[INPUTMESSAGE_SIZE];
+		Uint8* m_networkBuffer;
+		Uint32 m_capacity;
+		Uint32 m_readPos;
+		Uint32 m_messageSize;
 };
 
 #endif /* __FILE_INPUT_MESSAGE_h_ */
@@ -20,6 +20,7 @@
 */
 
 #include "item.h"
+#include "tile.h"
 #include "thingManager.h"
 #include "engine.h"
 #include "game.h"
@@ -28,9 +29,72 @@
 extern Engine g_engine;
 extern Game g_game;
 extern ThingManager g_thingManager;
-extern LightSystem g_light;
 extern Uint32 g_frameTime;
 
+struct ItemPoolBlock
+{
+	ItemPoolBlock* next;
+};
+
+static ItemPoolBlock* itemPoolFreeList[ITEM_POOL_CLASSES] = {};
+static ItemPoolStats itemPoolStats = {};
+
+void* Item::operator new(size_t size)
+{
+	++itemPoolStats.allocations;
+	++itemPoolStats.liveItems;
+
+	size_t sizeClass = (size + ITEM_POOL_GRANULARITY - 1) / ITEM_POOL_GRANULARITY;
+	if(sizeClass >= ITEM_POOL_CLASSES)
+		return ::operator new(size);
+
+	ItemPoolBlock* block = itemPoolFreeList[sizeClass];
+	if(!block)
+	{
+		//Carve a new slab into blocks of this size class, slabs are kept for the lifetime of the client
+		size_t blockSize = sizeClass * ITEM_POOL_GRANULARITY;
+		Uint8* slab = SDL_reinterpret_cast(Uint8*, ::operator new(blockSize * ITEM_POOL_SLAB_OBJECTS));
+		for(Sint32 i = ITEM_POOL_SLAB_OBJECTS; --i >= 0;)
+		{
+			ItemPoolBlock* newBlock = SDL_reinterpret_cast(ItemPoolBlock*, slab + blockSize * i);
+			newBlock->next = block;
+			block = newBlock;
+		}
+
+		itemPoolStats.freeItems += ITEM_POOL_SLAB_OBJECTS;
+		++itemPoolStats.slabs;
+	}
+
+	itemPoolFreeList[sizeClass] = block->next;
+	--itemPoolStats.freeItems;
+	return SDL_reinterpret_cast(void*, block);
+}
+
+void Item::operator delete(void* ptr, size_t size)
+{
+	if(!ptr)
+		return;
+
+	--itemPoolStats.liveItems;
+
+	size_t sizeClass = (size + ITEM_POOL_GRANULARITY - 1) / ITEM_POOL_GRANULARITY;
+	if(sizeClass >= ITEM_POOL_CLASSES)
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	ItemPoolBlock* block = SDL_reinterpret_cast(ItemPoolBlock*, ptr);
+	block->next = itemPoolFreeList[sizeClass];
+	itemPoolFreeList[sizeClass] = block;
+	++itemPoolStats.freeItems;
+}
+
+ItemPoolStats Item::getPoolStats()
+{
+	return itemPoolStats;
+}
+
 Item* Item::createItem(const Position& pos, Uint16 type, Uint16 count, Sint32 phase)
 {
 	Item* newItem = NULL;
@@ -249,6 +313,10 @@ Item* Item::createItem(const Position& pos, Uint16 type, Uint16 count, Sint32 ph
 					newItem = newItemX;
 				}
 			}
+
+			//Non-animated items of the specialised sizes never change their sprites so tiles can cache them
+			if(newItem && animCount <= 1)
+				newItem->m_staticDraw = true;
 		}
 
 		if(!newItem)
@@ -295,7 +363,7 @@ Uint8 Item::calculateAnimationPhase()
 
 void Item::render(Sint32 posX, Sint32 posY, bool)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -306,7 +374,7 @@ void Item::render(Sint32 posX, Sint32 posY, bool)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint8 animationFrame = calculateAnimationPhase();
@@ -320,7 +388,7 @@ void Item::render(Sint32 posX, Sint32 posY, bool)
 			{
 				Uint32 sprite = m_thingType->getSprite(ThingFrameGroup_Default, x, y, l, m_xPattern, m_yPattern, m_zPattern, animationFrame);
 				if(sprite != 0)
-					renderer->drawSprite(sprite, posXc, posYc);
+					renderer.drawSprite(sprite, posXc, posYc);
 				posXc -= 32;
 			}
 			posYc -= 32;
@@ -328,6 +396,37 @@ void Item::render(Sint32 posX, Sint32 posY, bool)
 	}
 }
 
+void Item::cacheSprites(std::vector<TileDrawCommand>& commands, Sint32 posX, Sint32 posY, bool visible_tile)
+{
+	if(m_thingType->hasFlag(ThingAttribute_Displacement))
+	{
+		posX -= m_thingType->m_displacement[0];
+		posY -= m_thingType->m_displacement[1];
+	}
+
+	Uint16* light = m_thingType->m_light;
+	if(light[0] > 0)
+		commands.push_back(TileDrawCommand{NULL, light, 0, posX, posY, false});
+
+	//Same order as the specialised render functions, the part on our own tile is skipped when it isn't visible
+	FrameGroup& frameGroup = m_thingType->m_frameGroup[ThingFrameGroup_Default];
+	for(Uint8 y = 0; y < frameGroup.m_height; ++y)
+	{
+		for(Uint8 x = 0; x < frameGroup.m_width; ++x)
+		{
+			if(!visible_tile && (x | y) == 0)
+				continue;
+
+			for(Uint8 l = 0; l < frameGroup.m_layers; ++l)
+			{
+				Uint32 sprite = m_thingType->getSprite(ThingFrameGroup_Default, x, y, l, m_xPattern, m_yPattern, m_zPattern, 0);
+				if(sprite != 0)
+					commands.push_back(TileDrawCommand{NULL, NULL, sprite, posX - x * 32, posY - y * 32, false});
+			}
+		}
+	}
+}
+
 void Item1X1::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
@@ -340,7 +439,7 @@ void Item1X1::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	if(!visible_tile)
@@ -349,12 +448,12 @@ void Item1X1::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	Uint8 animationFrame = calculateAnimationPhase();
 	Uint32 drawSprite = m_1X1Sprites[animationFrame];
 	if(drawSprite != 0)
-		g_engine.getRender()->drawSprite(drawSprite, posX, posY);
+		g_engine.getRenderCommands().drawSprite(drawSprite, posX, posY);
 }
 
 void Item2X1::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -365,7 +464,7 @@ void Item2X1::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint8 animationFrame = calculateAnimationPhase();
@@ -374,17 +473,17 @@ void Item2X1::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		drawSprite = m_2X1Sprites[animationFrame][0];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 	}
 
 	drawSprite = m_2X1Sprites[animationFrame][1];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
 
 void Item1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -395,7 +494,7 @@ void Item1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint8 animationFrame = calculateAnimationPhase();
@@ -404,17 +503,17 @@ void Item1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		drawSprite = m_1X2Sprites[animationFrame][0];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 	}
 
 	drawSprite = m_1X2Sprites[animationFrame][1];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY - 32);
+		renderer.drawSprite(drawSprite, posX, posY - 32);
 }
 
 void Item2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -425,7 +524,7 @@ void Item2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint8 animationFrame = calculateAnimationPhase();
@@ -434,26 +533,26 @@ void Item2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		drawSprite = m_2X2Sprites[animationFrame][0];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 	}
 
 	drawSprite = m_2X2Sprites[animationFrame][1];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 
 	posY -= 32;
 	drawSprite = m_2X2Sprites[animationFrame][2];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X2Sprites[animationFrame][3];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
 
 void Item1X1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -464,7 +563,7 @@ void Item1X1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	if(!visible_tile)
@@ -473,16 +572,16 @@ void Item1X1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	Uint8 animationFrame = calculateAnimationPhase();
 	Uint32 drawSprite = m_1X1X2Sprites[animationFrame][0];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_1X1X2Sprites[animationFrame][1];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 }
 
 void Item2X1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -493,7 +592,7 @@ void Item2X1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint8 animationFrame = calculateAnimationPhase();
@@ -502,25 +601,25 @@ void Item2X1X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		drawSprite = m_2X1X2Sprites[animationFrame][0];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 
 		drawSprite = m_2X1X2Sprites[animationFrame][1];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 	}
 
 	drawSprite = m_2X1X2Sprites[animationFrame][2];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 
 	drawSprite = m_2X1X2Sprites[animationFrame][3];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
 
 void Item1X2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -531,7 +630,7 @@ void Item1X2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint8 animationFrame = calculateAnimationPhase();
@@ -540,25 +639,25 @@ void Item1X2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		drawSprite = m_1X2X2Sprites[animationFrame][0];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 
 		drawSprite = m_1X2X2Sprites[animationFrame][1];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 	}
 
 	drawSprite = m_1X2X2Sprites[animationFrame][2];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY - 32);
+		renderer.drawSprite(drawSprite, posX, posY - 32);
 
 	drawSprite = m_1X2X2Sprites[animationFrame][3];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY - 32);
+		renderer.drawSprite(drawSprite, posX, posY - 32);
 }
 
 void Item2X2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 {
-	auto& renderer = g_engine.getRender();
+	RenderCommandList& renderer = g_engine.getRenderCommands();
 	if(m_thingType->hasFlag(ThingAttribute_Displacement))
 	{
 		posX -= m_thingType->m_displacement[0];
@@ -569,7 +668,7 @@ void Item2X2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		Uint16* light = m_thingType->m_light;
 		if(light[0] > 0)
-			g_light.addLightSource(posX, posY, light);
+			g_engine.getRenderCommands().addLightSource(posX, posY, light);
 	}
 
 	Uint8 animationFrame = calculateAnimationPhase();
@@ -578,35 +677,35 @@ void Item2X2X2::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	{
 		drawSprite = m_2X2X2Sprites[animationFrame][0];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 
 		drawSprite = m_2X2X2Sprites[animationFrame][1];
 		if(drawSprite != 0)
-			renderer->drawSprite(drawSprite, posX, posY);
+			renderer.drawSprite(drawSprite, posX, posY);
 	}
 
 	drawSprite = m_2X2X2Sprites[animationFrame][2];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 
 	drawSprite = m_2X2X2Sprites[animationFrame][3];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 
 	posY -= 32;
 	drawSprite = m_2X2X2Sprites[animationFrame][4];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X2X2Sprites[animationFrame][5];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX, posY);
+		renderer.drawSprite(drawSprite, posX, posY);
 
 	drawSprite = m_2X2X2Sprites[animationFrame][6];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 
 	drawSprite = m_2X2X2Sprites[animationFrame][7];
 	if(drawSprite != 0)
-		renderer->drawSprite(drawSprite, posX - 32, posY);
+		renderer.drawSprite(drawSprite, posX - 32, posY);
 }
@@ -25,7 +25,20 @@
 #include "thing.h"
 #include "animator.h"
 
+#define ITEM_POOL_GRANULARITY 16
+#define ITEM_POOL_CLASSES 32
+#define ITEM_POOL_SLAB_OBJECTS 256
+
+struct ItemPoolStats
+{
+	Uint64 allocations;
+	Uint32 liveItems;
+	Uint32 freeItems;
+	Uint32 slabs;
+};
+
 class ThingType;
+struct TileDrawCommand;
 class Item : public Thing
 {
 	public:
@@ -41,6 +54,11 @@ class Item : public Thing
 
 		static Item* createItem(const Position& pos, Uint16 type, Uint16 count, Sint32 phase = AnimationPhase_Automatic);
 
+		//Items are recycled through per-size free lists instead of the heap
+		static void* operator new(size_t size);
+		static void operator delete(void* ptr, size_t size);
+		static ItemPoolStats getPoolStats();
+
 		virtual Item* getItem() {return this;}
 		virtual const Item* getItem() const {return this;}
 
@@ -52,11 +70,13 @@ class Item : public Thing
 		Uint16 getID();
 		Uint8 calculateAnimationPhase();
 		virtual void render(Sint32 posX, Sint32 posY, bool visible_tile);
+		void cacheSprites(std::vector<TileDrawCommand>& commands, Sint32 posX, Sint32 posY, bool visible_tile);
 
 		SDL_INLINE Sint32 getTopOrder() {return m_topOrder;}
 		SDL_INLINE Uint8 getAnimationCount() {return m_animCount;}
 		SDL_INLINE Uint16 getElevation() {return m_elevation;}
 		SDL_INLINE bool hasElevation() {return m_hasElevation;}
+		SDL_INLINE bool isStaticDraw() {return m_staticDraw;}
 		SDL_INLINE ThingType* getThingType() {return m_thingType;}
 
 	protected:
@@ -73,6 +93,7 @@ class Item : public Thing
 		Uint8 m_yPattern = 0;
 		Uint8 m_zPattern = 0;
 		bool m_hasElevation = false;
+		bool m_staticDraw = false;
 };
 
 class ItemNULL : public Item
@@ -0,0 +1,317 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "jobSystem.h"
+
+JobSystem g_jobSystem;
+
+static thread_local Sint32 jobThreadIndex = -1;
+
+JobSystem::~JobSystem()
+{
+	shutdown();
+}
+
+static int JOB_workerthread(void* data)
+{
+	g_jobSystem.workerThread(SDL_static_cast(Sint32, SDL_reinterpret_cast(intptr_t, data)));
+	return 0;
+}
+
+void JobSystem::init(Sint32 threads)
+{
+	if(m_queues)
+		return;
+
+	//By default every core except the one of the main thread gets a worker
+	if(threads < 0)
+		threads = SDL_GetCPUCount() - 1;
+
+	threads = UTIL_max<Sint32>(0, UTIL_min<Sint32>(threads, JOB_SYSTEM_MAX_THREADS));
+	m_queues = new JobQueue[threads + 1];
+	m_queueCount = threads + 1;
+	m_stats = new JobStats[threads + 1];
+	SDL_memset(m_stats, 0, sizeof(JobStats) * (threads + 1));
+	m_wakeup = SDL_CreateSemaphore(0);
+	SDL_AtomicSet(&m_sleeping, 0);
+	SDL_AtomicSet(&m_signaled, 0);
+	SDL_AtomicSet(&m_exiting, 0);
+	if(!m_wakeup)
+		return;
+
+	for(Sint32 i = 0; i <= threads; ++i)
+	{
+		m_queues[i].finished = SDL_CreateSemaphore(0);
+		if(!m_queues[i].finished)
+			return;
+	}
+
+	//The workers are only started once all of them have their queues
+	m_threadCount = threads;
+	for(Sint32 i = 0; i < threads; ++i)
+	{
+		m_threads[i] = SDL_CreateThread(JOB_workerthread, "JOB WORKER", SDL_reinterpret_cast(void*, SDL_static_cast(intptr_t, i)));
+		if(!m_threads[i])
+		{
+			SDL_AtomicSet(&m_exiting, 1);
+			for(Sint32 j = 0; j < i; ++j)
+				SDL_SemPost(m_wakeup);
+
+			for(Sint32 j = 0; j < i; ++j)
+			{
+				SDL_WaitThread(m_threads[j], NULL);
+				m_threads[j] = NULL;
+			}
+
+			//Fall back to running everything on the submitting thread
+			SDL_AtomicSet(&m_exiting, 0);
+			m_threadCount = 0;
+			break;
+		}
+	}
+}
+
+void JobSystem::shutdown()
+{
+	if(!m_queues)
+		return;
+
+	SDL_AtomicSet(&m_exiting, 1);
+	for(Sint32 i = 0; i < m_threadCount; ++i)
+		SDL_SemPost(m_wakeup);
+
+	for(Sint32 i = 0; i < m_threadCount; ++i)
+	{
+		SDL_WaitThread(m_threads[i], NULL);
+		m_threads[i] = NULL;
+	}
+
+	if(m_wakeup)
+	{
+		SDL_DestroySemaphore(m_wakeup);
+		m_wakeup = NULL;
+	}
+
+	for(Sint32 i = 0; i < m_queueCount; ++i)
+	{
+		if(m_queues[i].finished)
+			SDL_DestroySemaphore(m_queues[i].finished);
+	}
+
+	delete[] m_queues;
+	delete[] m_stats;
+	m_queues = NULL;
+	m_stats = NULL;
+	m_threadCount = 0;
+	m_queueCount = 0;
+}
+
+void JobSystem::submit(JobGroup& group, JobFunction function, void* data)
+{
+	if(m_threadCount == 0)
+	{
+		//Nothing to hand the job over to so it runs right away
+		Job job = {function, data, &group};
+		SDL_AtomicIncRef(&group.pending);
+		runJob(m_threadCount, job);
+		return;
+	}
+
+	Sint32 index = (jobThreadIndex >= 0 ? jobThreadIndex : m_threadCount);
+	JobQueue& queue = m_queues[index];
+	SDL_AtomicIncRef(&group.pending);
+	SDL_AtomicLock(&queue.lock);
+	if(queue.tail - queue.head >= JOB_QUEUE_SIZE)
+	{
+		SDL_AtomicUnlock(&queue.lock);
+		Job job = {function, data, &group};
+		runJob(index, job);
+		return;
+	}
+
+	Job& job = queue.jobs[queue.tail++ & (JOB_QUEUE_SIZE - 1)];
+	job.function = function;
+	job.data = data;
+	job.group = &group;
+	SDL_AtomicUnlock(&queue.lock);
+	wakeWorker();
+}
+
+void JobSystem::wait(JobGroup& group)
+{
+	//The waiting thread keeps executing jobs as long as there are any
+	Sint32 index = (jobThreadIndex >= 0 ? jobThreadIndex : m_threadCount);
+	Sint32 spins = 0;
+	while(SDL_AtomicGet(&group.pending) > 0)
+	{
+		Job job;
+		if(findJob(index, job))
+		{
+			runJob(index, job);
+			spins = 0;
+			continue;
+		}
+
+		if(++spins < JOB_WAIT_SPINS || hasJobs())
+			continue;
+
+		//The rest of the group is running on the workers so sleep until the last of them finishes
+		group.waiter = index;
+		if(SDL_AtomicAdd(&group.pending, JOB_GROUP_WAITING) > 0)
+			SDL_SemWait(m_queues[index].finished);
+
+		SDL_AtomicSet(&group.pending, 0);
+		break;
+	}
+}
+
+void JobSystem::workerThread(Sint32 index)
+{
+	jobThreadIndex = index;
+	SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+	while(SDL_AtomicGet(&m_exiting) == 0)
+	{
+		Job job;
+		if(findJob(index, job))
+		{
+			runJob(index, job);
+			continue;
+		}
+
+		//Announce the sleep first and look again so that a job submitted in between isn't missed
+		SDL_AtomicIncRef(&m_sleeping);
+		if(!hasJobs() && SDL_AtomicGet(&m_exiting) == 0)
+		{
+			SDL_SemWait(m_wakeup);
+			SDL_AtomicAdd(&m_signaled, -1);
+		}
+		SDL_AtomicDecRef(&m_sleeping);
+	}
+}
+
+JobStats JobSystem::getStats()
+{
+	JobStats stats = {0, 0, 0};
+	if(!m_stats)
+		return stats;
+
+	for(Sint32 i = 0; i <= m_threadCount; ++i)
+	{
+		stats.jobs += m_stats[i].jobs;
+		stats.steals += m_stats[i].steals;
+		stats.ticks += m_stats[i].ticks;
+	}
+	return stats;
+}
+
+bool JobSystem::popJob(Sint32 index, Job& job)
+{
+	JobQueue& queue = m_queues[index];
+	SDL_AtomicLock(&queue.lock);
+	if(queue.tail == queue.head)
+	{
+		SDL_AtomicUnlock(&queue.lock);
+		return false;
+	}
+
+	job = queue.jobs[--queue.tail & (JOB_QUEUE_SIZE - 1)];
+	SDL_AtomicUnlock(&queue.lock);
+	return true;
+}
+
+bool JobSystem::stealJob(Sint32 index, Job& job)
+{
+	Sint32 queues = m_threadCount + 1;
+	for(Sint32 i = 1; i < queues; ++i)
+	{
+		//A busy victim is skipped rather than waited for, the caller looks again anyway
+		JobQueue& queue = m_queues[(index + i) % queues];
+		if(!SDL_AtomicTryLock(&queue.lock))
+			continue;
+
+		if(queue.tail != queue.head)
+		{
+			job = queue.jobs[queue.head++ & (JOB_QUEUE_SIZE - 1)];
+			SDL_AtomicUnlock(&queue.lock);
+			++m_stats[index].steals;
+			return true;
+		}
+		SDL_AtomicUnlock(&queue.lock);
+	}
+	return false;
+}
+
+bool JobSystem::findJob(Sint32 index, Job& job)
+{
+	return (popJob(index, job) || stealJob(index, job));
+}
+
+void JobSystem::runJob(Sint32 index, Job& job)
+{
+	Uint64 start = SDL_GetPerformanceCounter();
+	job.function(job.data);
+
+	Uint64 ticks = SDL_GetPerformanceCounter() - start;
+	JobStats& stats = m_stats[index];
+	++stats.jobs;
+	stats.ticks += ticks;
+
+	//The group may be gone as soon as the last job is counted down so it goes last
+	//only a blocked waiter keeps it alive until we post its semaphore
+	JobGroup* group = job.group;
+	SDL_AtomicLock(&group->statsLock);
+	group->ticks += ticks;
+	++group->jobs;
+	SDL_AtomicUnlock(&group->statsLock);
+	if(SDL_AtomicAdd(&group->pending, -1) == JOB_GROUP_WAITING + 1)
+		SDL_SemPost(m_queues[group->waiter].finished);
+}
+
+bool JobSystem::hasJobs()
+{
+	for(Sint32 i = 0; i <= m_threadCount; ++i)
+	{
+		JobQueue& queue = m_queues[i];
+		SDL_AtomicLock(&queue.lock);
+		bool empty = (queue.tail == queue.head);
+		SDL_AtomicUnlock(&queue.lock);
+		if(!empty)
+			return true;
+	}
+	return false;
+}
+
+void JobSystem::wakeWorker()
+{
+	//Every sleeping worker gets at most one outstanding post
+	for(;;)
+	{
+		int signaled = SDL_AtomicGet(&m_signaled);
+		if(signaled >= SDL_AtomicGet(&m_sleeping))
+			return;
+
+		if(SDL_AtomicCAS(&m_signaled, signaled, signaled + 1))
+		{
+			SDL_SemPost(m_wakeup);
+			return;
+		}
+	}
+}
@@ -0,0 +1,114 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __FILE_JOBSYSTEM_h_
+#define __FILE_JOBSYSTEM_h_
+
+#include "defines.h"
+
+#define JOB_SYSTEM_MAX_THREADS 64
+#define JOB_QUEUE_SIZE 1024
+#define JOB_WAIT_SPINS 64
+#define JOB_GROUP_WAITING 0x40000000
+
+typedef void (*JobFunction)(void* data);
+
+//Jobs submitted together are joined together, the group also collects how long its jobs took
+//A thread that has to block on the group adds JOB_GROUP_WAITING to pending and the last job wakes it
+struct JobGroup
+{
+	SDL_atomic_t pending = {};
+	Sint32 waiter = 0;
+	SDL_SpinLock statsLock = 0;
+	Uint64 ticks = 0;
+	Uint32 jobs = 0;
+};
+
+struct Job
+{
+	JobFunction function;
+	void* data;
+	JobGroup* group;
+};
+
+//Every worker owns one queue, the owner takes the newest job and thieves take the oldest one
+struct JobQueue
+{
+	Job jobs[JOB_QUEUE_SIZE];
+	Uint32 head = 0;
+	Uint32 tail = 0;
+	SDL_SpinLock lock = 0;
+	SDL_sem* finished = NULL;
+};
+
+struct JobStats
+{
+	Uint64 jobs;
+	Uint64 steals;
+	Uint64 ticks;
+};
+
+class JobSystem
+{
+	public:
+		JobSystem() = default;
+		~JobSystem();
+
+		// non-copyable
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		// non-moveable
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+		void init(Sint32 threads);
+		void shutdown();
+
+		void submit(JobGroup& group, JobFunction function, void* data);
+		void wait(JobGroup& group);
+
+		void workerThread(Sint32 index);
+
+		//Workers plus the submitting thread which helps while it waits
+		SDL_INLINE Sint32 getThreadCount() {return m_threadCount + 1;}
+		JobStats getStats();
+
+	protected:
+		bool popJob(Sint32 index, Job& job);
+		bool stealJob(Sint32 index, Job& job);
+		bool findJob(Sint32 index, Job& job);
+		void runJob(Sint32 index, Job& job);
+		bool hasJobs();
+		void wakeWorker();
+
+		JobQueue* m_queues = NULL;
+		JobStats* m_stats = NULL;
+		SDL_Thread* m_threads[JOB_SYSTEM_MAX_THREADS] = {};
+		SDL_sem* m_wakeup = NULL;
+		SDL_atomic_t m_sleeping = {};
+		SDL_atomic_t m_signaled = {};
+		SDL_atomic_t m_exiting = {};
+		Sint32 m_threadCount = 0;
+		Sint32 m_queueCount = 0;
+};
+
+#endif /* __FILE_JOBSYSTEM_h_ */
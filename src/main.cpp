@@ -23,6 +23,8 @@
 #include "cursors.h"
 #include "connection.h"
 #include "http.h"
+#include "jobSystem.h"
+#include "spriteResidency.h"
 
 #include <curl/curl.h>
 
@@ -33,6 +35,7 @@ SDL_Cursor* g_cursors[CLIENT_CURSOR_LAST];
 Connection* g_connection = NULL;
 Engine g_engine;
 extern Http g_http;
+extern JobSystem g_jobSystem;
 
 KeyRepeat g_keyRepeat;
 FPSmanager g_fpsmanager;
@@ -243,6 +246,13 @@ extern "C"
 int main(int argc, char* argv[])
 {
 	SDL_initFramerate(&g_fpsmanager);
+	for(int i = 1; i < argc; ++i)
+	{
+		//Headless replays have to pick the video driver before SDL gets initialized
+		if(SDL_strcasecmp(argv[i], "-replay-headless") == 0)
+			SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+	}
+
 	if(SDL_Init(SDL_INIT_VIDEO|SDL_INIT_TIMER) < 0)
 	{
 		SDL_snprintf(g_buffer, sizeof(g_buffer), "Couldn't initialize SDL: %s", SDL_GetError());
@@ -300,13 +310,26 @@ int main(int argc, char* argv[])
 	UTIL_initSubsystem();
 	g_engine.run();
 	g_engine.parseCommands(argc, argv);
+	if(g_engine.isSelfTest())
+	{
+		//Check the vectorized kernels against the scalar ones and quit so it can run unattended
+		Sint32 failures = UTIL_selfTestKernels();
+		failures += SpriteResidency::selfTest();
+		curl_global_cleanup();
+		SDL_Quit();
+		return (failures == 0 ? 0 : -1);
+	}
+	g_jobSystem.init(g_engine.getJobThreads());
 	SDL_setKeyRepeat(200, 50);
 
 	SDL_Event event;
 	while(g_running)
 	{
 		if(g_engine.init())
+		{
 			g_inited = true;
+			g_engine.issueReplayConnection();
+		}
 
 		while(g_inited)
 		{
@@ -564,7 +587,11 @@ int main(int argc, char* argv[])
 			if(g_connection)
 				g_connection->updateConnection();
 
-			if(!g_active)
+			if(g_engine.isReplayHeadless())
+			{
+				//Headless replays only parse the packets - nothing to draw
+			}
+			else if(!g_active)
 			{
 				//Let's maintain a little CPU usage to check for events(maybe we will be restored?)
 				//100ms Sleep should maintain ~10FPS - should be enough for "instant" unsleep
@@ -581,6 +608,7 @@ int main(int argc, char* argv[])
 		delete g_connection;
 
 	g_engine.terminate();
+	g_jobSystem.shutdown();
 	curl_global_cleanup();
 	SDL_Quit();
 	return 0;
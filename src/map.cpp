@@ -29,6 +29,7 @@
 #include "animatedText.h"
 #include "staticText.h"
 #include "light.h"
+#include "jobSystem.h"
 
 #include <algorithm>
 
@@ -36,10 +37,9 @@ Map g_map;
 extern Automap g_automap;
 extern Engine g_engine;
 extern LightSystem g_light;
+extern JobSystem g_jobSystem;
 extern Uint32 g_frameTime;
 
-std::vector<Effect*> g_effects;
-
 AStarNodes::AStarNodes(const Position& startPos) : openNodes(MAX_NODES_COMPLEXITY)
 {
 	nodesTable.resize(MAX_NODES_GRIDSIZE, -1);
@@ -109,7 +109,7 @@ AStarNode* AStarNodes::getNodeByPosition(Uint32 xy)
 
 Map::Map()
 {
-	g_effects.reserve(EFFECT_MAX_INGAME_EFFECTS);
+	rotateWindow(0, 0);
 }
 
 Map::~Map()
@@ -135,6 +135,10 @@ Map::~Map()
 		} while(++y < GAME_MAP_HEIGHT);
 	} while(++z <= GAME_MAP_FLOORS);
 
+	for(std::vector<Tile*>::iterator it = m_freeTiles.begin(), end = m_freeTiles.end(); it != end; ++it)
+		delete (*it);
+
+	m_freeTiles.clear();
 	for(knownCreatures::iterator it = m_knownCreatures.begin(), end = m_knownCreatures.end(); it != end; ++it)
 		delete it->second;
 
@@ -157,7 +161,7 @@ Tile* Map::getTile(const Position& position)
 	if(SDL_static_cast(Uint32, posX) >= GAME_MAP_WIDTH || SDL_static_cast(Uint32, posY) >= GAME_MAP_HEIGHT)
 		return NULL;
 
-	return m_tiles[position.z][posY][posX];
+	return getWindowTile(position.z, posY, posX);
 }
 
 Tile* Map::getTileOrCreate(const Position& position)
@@ -168,9 +172,9 @@ Tile* Map::getTileOrCreate(const Position& position)
 	if(SDL_static_cast(Uint32, posX) >= GAME_MAP_WIDTH || SDL_static_cast(Uint32, posY) >= GAME_MAP_HEIGHT)
 		return NULL;
 
-	Tile*& tile = m_tiles[position.z][posY][posX];
+	Tile*& tile = getWindowTile(position.z, posY, posX);
 	if(!tile)
-		tile = new Tile(position);
+		tile = acquireTile(position);
 
 	return tile;
 }
@@ -186,12 +190,12 @@ Tile* Map::resetTile(const Position& position, Sint32 offset)
 		return NULL;
 	}
 
-	Tile*& tile = m_tiles[position.z][posY][posX];
+	Tile*& tile = getWindowTile(position.z, posY, posX);
 	if(tile)
 		tile->reset();
 	else
 	{
-		tile = new Tile(position);
+		tile = acquireTile(position);
 		return tile;
 	}
 	
@@ -205,12 +209,7 @@ void Map::cleanTile(const Position& position, Sint32 offset)
 	if(SDL_static_cast(Uint32, posX) >= GAME_MAP_WIDTH || SDL_static_cast(Uint32, posY) >= GAME_MAP_HEIGHT)
 		return;
 
-	Tile*& tile = m_tiles[position.z][posY][posX];
-	if(tile)
-	{
-		delete tile;
-		tile = NULL;
-	}
+	releaseTile(getWindowTile(position.z, posY, posX));
 }
 
 void Map::update()
@@ -227,7 +226,6 @@ void Map::render()
 	if(!m_localCreature) //If somehow we don't have localcreature avoid crashing
 		return;
 
-	g_effects.clear();
 	if(m_needUpdateCache)
 		updateCacheMap();
 
@@ -238,8 +236,48 @@ void Map::render()
 
 	auto& renderer = g_engine.getRender();
 	renderer->beginGameScene();
+
+	//Creatures are updated up front so the floor jobs only read them
+	m_localCreature->update();
+	for(knownCreatures::iterator it = m_knownCreatures.begin(), end = m_knownCreatures.end(); it != end; ++it)
+		it->second->update();
+
+	//A new generation means the backend lost the static layers, otherwise redraw the cells that missed sprites
+	Uint32 staticGeneration = renderer->getStaticLayerGeneration();
+	m_sceneStaticLayers = (staticGeneration != 0);
+	if(m_sceneStaticLayers)
+	{
+		renderer->takeStaticLayerMisses(m_staticMisses);
+		Tile** staticTiles = &m_staticTiles[0][0][0];
+		for(std::vector<Uint32>::iterator it = m_staticMisses.begin(), end = m_staticMisses.end(); it != end; ++it)
+			staticTiles[(*it)] = NULL;
+
+		m_staticMisses.clear();
+	}
+	if(staticGeneration != m_staticGeneration)
+	{
+		m_staticGeneration = staticGeneration;
+		for(Sint32 i = 0; i <= GAME_MAP_FLOORS; ++i)
+			m_staticReset[i] = true;
+	}
+
+	Uint64 sceneStart = SDL_GetPerformanceCounter();
+	m_sceneOffsetX = offsetX;
+	m_sceneOffsetY = offsetY;
+	m_sceneFloorCount = 0;
 	Sint32 z = m_cachedLastVisibleFloor;
 	do
+	{
+		m_sceneFloors[m_sceneFloorCount++] = z;
+	} while(--z >= m_cachedFirstVisibleFloor);
+	m_sceneFloorsTotal += SDL_static_cast(Uint64, m_sceneFloorCount);
+	buildScene();
+
+	//Merge the floors in painter's order and hand the whole scene to the backend in one pass
+	RenderCommandList& renderCommands = g_engine.getSceneCommands();
+	renderCommands.beginRecording();
+	z = m_cachedLastVisibleFloor;
+	do
 	{
 		if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE && z != m_cachedLastVisibleFloor)
 		{
@@ -270,97 +308,25 @@ void Map::render()
 			} while(++y < GAME_MAP_HEIGHT);
 		}
 
-		Sint32 posY = -32 + offsetY, y = 0;
-		do
-		{
-			Sint32 posX = -32 + offsetX, x = 0;
-			do
-			{
-				Tile* tile = m_tiles[z][y][x];
-				if(tile)
-				{
-					tile->render(posX, posY, (m_cachedFirstFullGrounds[y][x] >= z));
-					if(tile->isCreatureLying())//Redraw tiles in <^ directions
-					{
-						Sint32 y2 = 1;
-						do
-						{
-							Sint32 x2 = 1;
-							do
-							{
-								if((x2 | y2) == 0)
-									continue;
-
-								Sint32 indexX = x - x2;
-								Sint32 indexY = y - y2;
-								if(indexX >= 0 && indexY >= 0)
-								{
-									tile = m_tiles[z][indexY][indexX];
-									if(tile)
-										tile->reRenderTile(posX - x2 * 32, posY - y2 * 32);
-								}
-							} while(--x2 >= 0);
-						} while(--y2 >= 0);
-					}
-					if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE && z == GAME_PLAYER_FLOOR + 1)
-					{
-						//Check for translucent on sea floor so if needed we draw small light source
-						Tile* seaTile = m_tiles[GAME_PLAYER_FLOOR][y][x];
-						if(seaTile && seaTile->hasTranslucentLight())
-						{
-							Uint16 translucentLight[2];
-							translucentLight[0] = 1;
-							translucentLight[1] = 215;
-							g_light.addLightSource(posX, posY, translucentLight);
-						}
-					}
-				}
-				posX += 32;
-			} while(++x < GAME_MAP_WIDTH);
-			posY += 32;
-		} while(++y < GAME_MAP_HEIGHT);
-
-		for(std::vector<Effect*>::iterator it = g_effects.begin(), end = g_effects.end(); it != end; ++it)
-		{
-			Effect* effect = (*it);
-			effect->render(effect->getCachedX(), effect->getCachedY());
-		}
-		g_effects.clear();
-
-		Sint32 offsetZ = (z - SDL_static_cast(Sint32, m_centerPosition.z));
-		std::vector<DistanceEffect*>& distanceEffects = m_distanceEffects[z];
-		for(std::vector<DistanceEffect*>::iterator it = distanceEffects.begin(); it != distanceEffects.end();)
+		if(m_sceneStaticLayers)
 		{
-			DistanceEffect* distanceEffect = (*it);
-			if(distanceEffect->isDelayed())
-			{
-				++it;
-				continue;
-			}
-
-			float flightProgress = distanceEffect->getFlightProgress();
-			if(flightProgress > 1.f)
-			{
-				delete (*it);
-				it = distanceEffects.erase(it);
-			}
-			else
+			//Changed cells are cleared before anything gets drawn into the layer so the clears share one batch
+			RenderCommandList& staticClears = m_staticClears[z];
+			RenderCommandList& staticCommands = m_staticCommands[z];
+			renderCommands.setLayer(SDL_static_cast(Uint8, z));
+			if(staticClears.getCommandCount() > 0 || staticCommands.getCommandCount() > 0)
 			{
-				const Position& fromPos = distanceEffect->getFromPos();
-				const Position& toPos = distanceEffect->getToPos();
-
-				Sint32 screenxFrom = ((Position::getOffsetX(fromPos, m_centerPosition) + (MAP_WIDTH_OFFSET - 2) + offsetZ) * 32) + offsetX;
-				Sint32 screenyFrom = ((Position::getOffsetY(fromPos, m_centerPosition) + (MAP_HEIGHT_OFFSET - 2) + offsetZ) * 32) + offsetY;
-
-				Sint32 screenxTo = ((Position::getOffsetX(toPos, m_centerPosition) + (MAP_WIDTH_OFFSET - 2) + offsetZ) * 32) + offsetX;
-				Sint32 screenyTo = ((Position::getOffsetY(toPos, m_centerPosition) + (MAP_HEIGHT_OFFSET - 2) + offsetZ) * 32) + offsetY;
-
-				Sint32 screenx = screenxFrom + SDL_static_cast(Sint32, (screenxTo - screenxFrom) * flightProgress);
-				Sint32 screeny = screenyFrom + SDL_static_cast(Sint32, (screenyTo - screenyFrom) * flightProgress);
-				distanceEffect->render(screenx, screeny);
-				++it;
+				renderCommands.beginStaticLayer();
+				renderCommands.append(staticClears);
+				renderCommands.append(staticCommands);
+				renderCommands.endStaticLayer();
 			}
+			renderCommands.drawStaticLayer(m_windowOriginX * 32, m_windowOriginY * 32, -32 + offsetX, -32 + offsetY);
 		}
+
+		RenderCommandList& floorCommands = m_floorCommands[z];
+		floorCommands.flushScene();
+		renderCommands.append(floorCommands);
 	} while(--z >= m_cachedFirstVisibleFloor);
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
@@ -392,7 +358,183 @@ void Map::render()
 			} while(++y < GAME_MAP_HEIGHT);
 		}
 	}
+	renderCommands.endRecording();
+	m_sceneBuildTicks = SDL_GetPerformanceCounter() - sceneStart;
+	m_sceneBuildTotalTicks += m_sceneBuildTicks;
+	++m_sceneFrames;
+
+	//Backend time to draw the recorded scene, what the software blitter spends is measured here
+	Uint64 drawStart = SDL_GetPerformanceCounter();
+	renderCommands.submit(renderer.get());
 	renderer->endGameScene();
+	m_sceneDrawTicks = SDL_GetPerformanceCounter() - drawStart;
+	m_sceneDrawTotalTicks += m_sceneDrawTicks;
+}
+
+void Map::renderFloor(Sint32 z)
+{
+	RenderCommandList& floorCommands = m_floorCommands[z];
+	RenderCommandList::setCurrent(&floorCommands);
+	floorCommands.beginRecording();
+	floorCommands.setLayer(SDL_static_cast(Uint8, z));
+	if(m_sceneStaticLayers)
+	{
+		RenderCommandList& staticClears = m_staticClears[z];
+		staticClears.beginRecording();
+		staticClears.setLayer(SDL_static_cast(Uint8, z));
+		staticClears.setBlend(RENDER_BLEND_REPLACE);
+		m_staticCommands[z].beginRecording();
+		m_staticCommands[z].setLayer(SDL_static_cast(Uint8, z));
+		if(m_staticReset[z])
+		{
+			staticClears.fillRectangle(0, 0, GAME_MAP_WIDTH * 32, GAME_MAP_HEIGHT * 32, 0, 0, 0, 0);
+			SDL_memset(m_staticTiles[z], 0, sizeof(m_staticTiles[z]));
+			m_staticReset[z] = false;
+		}
+	}
+
+	Sint32 offsetX = m_sceneOffsetX;
+	Sint32 offsetY = m_sceneOffsetY;
+	Sint32 posY = -32 + offsetY, y = 0;
+	do
+	{
+		Sint32 posX = -32 + offsetX, x = 0;
+		do
+		{
+			Tile* tile = getWindowTile(z, y, x);
+			bool visible_tile = (m_cachedFirstFullGrounds[y][x] >= z);
+			if(m_sceneStaticLayers)
+				updateStaticLayer(z, y, x, tile, visible_tile);
+
+			if(tile)
+			{
+				tile->render(posX, posY, visible_tile, m_sceneStaticLayers);
+				if(tile->isCreatureLying())//Redraw tiles in <^ directions
+				{
+					Sint32 y2 = 1;
+					do
+					{
+						Sint32 x2 = 1;
+						do
+						{
+							if((x2 | y2) == 0)
+								continue;
+
+							Sint32 indexX = x - x2;
+							Sint32 indexY = y - y2;
+							if(indexX >= 0 && indexY >= 0)
+							{
+								tile = getWindowTile(z, indexY, indexX);
+								if(tile)
+									tile->reRenderTile(posX - x2 * 32, posY - y2 * 32);
+							}
+						} while(--x2 >= 0);
+					} while(--y2 >= 0);
+				}
+				if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE && z == GAME_PLAYER_FLOOR + 1)
+				{
+					//Check for translucent on sea floor so if needed we draw small light source
+					Tile* seaTile = getWindowTile(GAME_PLAYER_FLOOR, y, x);
+					if(seaTile && seaTile->hasTranslucentLight())
+					{
+						Uint16 translucentLight[2];
+						translucentLight[0] = 1;
+						translucentLight[1] = 215;
+						floorCommands.addLightSource(posX, posY, translucentLight);
+					}
+				}
+			}
+			posX += 32;
+		} while(++x < GAME_MAP_WIDTH);
+		posY += 32;
+	} while(++y < GAME_MAP_HEIGHT);
+
+	std::vector<Effect*>& effects = floorCommands.getQueuedEffects();
+	for(std::vector<Effect*>::iterator it = effects.begin(), end = effects.end(); it != end; ++it)
+	{
+		Effect* effect = (*it);
+		effect->render(effect->getCachedX(), effect->getCachedY());
+	}
+
+	Sint32 offsetZ = (z - SDL_static_cast(Sint32, m_centerPosition.z));
+	std::vector<DistanceEffect*>& distanceEffects = m_distanceEffects[z];
+	for(std::vector<DistanceEffect*>::iterator it = distanceEffects.begin(); it != distanceEffects.end();)
+	{
+		DistanceEffect* distanceEffect = (*it);
+		if(distanceEffect->isDelayed())
+		{
+			++it;
+			continue;
+		}
+
+		float flightProgress = distanceEffect->getFlightProgress();
+		if(flightProgress > 1.f)
+		{
+			floorCommands.retireDistanceEffect(distanceEffect);
+			it = distanceEffects.erase(it);
+		}
+		else
+		{
+			const Position& fromPos = distanceEffect->getFromPos();
+			const Position& toPos = distanceEffect->getToPos();
+
+			Sint32 screenxFrom = ((Position::getOffsetX(fromPos, m_centerPosition) + (MAP_WIDTH_OFFSET - 2) + offsetZ) * 32) + offsetX;
+			Sint32 screenyFrom = ((Position::getOffsetY(fromPos, m_centerPosition) + (MAP_HEIGHT_OFFSET - 2) + offsetZ) * 32) + offsetY;
+
+			Sint32 screenxTo = ((Position::getOffsetX(toPos, m_centerPosition) + (MAP_WIDTH_OFFSET - 2) + offsetZ) * 32) + offsetX;
+			Sint32 screenyTo = ((Position::getOffsetY(toPos, m_centerPosition) + (MAP_HEIGHT_OFFSET - 2) + offsetZ) * 32) + offsetY;
+
+			Sint32 screenx = screenxFrom + SDL_static_cast(Sint32, (screenxTo - screenxFrom) * flightProgress);
+			Sint32 screeny = screenyFrom + SDL_static_cast(Sint32, (screenyTo - screenyFrom) * flightProgress);
+			distanceEffect->render(screenx, screeny);
+			++it;
+		}
+	}
+
+	if(m_sceneStaticLayers)
+	{
+		m_staticClears[z].endRecording();
+		m_staticCommands[z].endRecording();
+	}
+
+	floorCommands.endRecording();
+	RenderCommandList::setCurrent(NULL);
+}
+
+void Map::updateStaticLayer(Sint32 z, Sint32 y, Sint32 x, Tile* tile, bool visible_tile)
+{
+	//The stack functions and the recycling in changeMap mark the tile dirty, a cell that now
+	//holds another tile or lost its tile is dirty as well - only those get drawn again
+	Sint32 slotY = m_windowRows[y];
+	Sint32 slotX = m_windowColumns[x];
+	Tile*& staticTile = m_staticTiles[z][slotY][slotX];
+	bool dirty = (tile ? tile->updateDrawCache(visible_tile) : false);
+	if(!dirty && staticTile == tile)
+		return;
+
+	m_staticClears[z].fillRectangle(slotX * 32, slotY * 32, 32, 32, 0, 0, 0, 0);
+	if(tile)
+		tile->renderStatic(m_staticCommands[z], slotX * 32, slotY * 32);
+
+	staticTile = tile;
+}
+
+static void MAP_floorJob(void* data)
+{
+	g_map.renderFloor(*SDL_reinterpret_cast(Sint32*, data));
+}
+
+void Map::buildScene()
+{
+	//Every floor is a job of its own, the main thread takes floors as well while it waits
+	//so no more threads than visible floors help - up to 8 above ground, 5 underground and a roof
+	//over the player cuts it down to the floors below the roof
+	//Floors aren't split into rows because a lying creature redraws the row above it
+	//and the effects of a floor have to come after all of its tiles
+	JobGroup group;
+	for(Sint32 i = 0; i < m_sceneFloorCount; ++i)
+		g_jobSystem.submit(group, MAP_floorJob, SDL_reinterpret_cast(void*, &m_sceneFloors[i]));
+	g_jobSystem.wait(group);
 }
 
 void Map::renderInformations(Sint32 px, Sint32 py, Sint32 pw, Sint32 ph, float scale, Sint32 scaledSize)
@@ -542,19 +684,19 @@ void Map::renderInformations(Sint32 px, Sint32 py, Sint32 pw, Sint32 ph, float s
 		#if ((GAME_MAP_WIDTH % 4) == 0)//Check if we can unroll it by 4
 		do
 		{
-			Tile* tile = m_tiles[z][y][x + 0];
+			Tile* tile = getWindowTile(z, y, x + 0);
 			if(tile)
 				tile->renderInformations(px, py, posX + 0, posY, scale, (m_cachedFirstVisibleGround[y][x + 0] >= z));
 
-			tile = m_tiles[z][y][x + 1];
+			tile = getWindowTile(z, y, x + 1);
 			if(tile)
 				tile->renderInformations(px, py, posX + 32, posY, scale, (m_cachedFirstVisibleGround[y][x + 1] >= z));
 
-			tile = m_tiles[z][y][x + 2];
+			tile = getWindowTile(z, y, x + 2);
 			if(tile)
 				tile->renderInformations(px, py, posX + 64, posY, scale, (m_cachedFirstVisibleGround[y][x + 2] >= z));
 
-			tile = m_tiles[z][y][x + 3];
+			tile = getWindowTile(z, y, x + 3);
 			if(tile)
 				tile->renderInformations(px, py, posX + 96, posY, scale, (m_cachedFirstVisibleGround[y][x + 3] >= z));
 
@@ -564,15 +706,15 @@ void Map::renderInformations(Sint32 px, Sint32 py, Sint32 pw, Sint32 ph, float s
 		#elif ((GAME_MAP_WIDTH % 3) == 0)//Check if we can unroll it by 3
 		do
 		{
-			Tile* tile = m_tiles[z][y][x + 0];
+			Tile* tile = getWindowTile(z, y, x + 0);
 			if(tile)
 				tile->renderInformations(px, py, posX + 0, posY, scale, (m_cachedFirstVisibleGround[y][x + 0] >= z));
 
-			tile = m_tiles[z][y][x + 1];
+			tile = getWindowTile(z, y, x + 1);
 			if(tile)
 				tile->renderInformations(px, py, posX + 32, posY, scale, (m_cachedFirstVisibleGround[y][x + 1] >= z));
 
-			tile = m_tiles[z][y][x + 2];
+			tile = getWindowTile(z, y, x + 2);
 			if(tile)
 				tile->renderInformations(px, py, posX + 64, posY, scale, (m_cachedFirstVisibleGround[y][x + 2] >= z));
 
@@ -582,11 +724,11 @@ void Map::renderInformations(Sint32 px, Sint32 py, Sint32 pw, Sint32 ph, float s
 		#elif ((GAME_MAP_WIDTH % 2) == 0)//Check if we can unroll it by 2
 		do
 		{
-			Tile* tile = m_tiles[z][y][x + 0];
+			Tile* tile = getWindowTile(z, y, x + 0);
 			if(tile)
 				tile->renderInformations(px, py, posX + 0, posY, scale, (m_cachedFirstVisibleGround[y][x + 0] >= z));
 
-			tile = m_tiles[z][y][x + 1];
+			tile = getWindowTile(z, y, x + 1);
 			if(tile)
 				tile->renderInformations(px, py, posX + 32, posY, scale, (m_cachedFirstVisibleGround[y][x + 1] >= z));
 
@@ -596,7 +738,7 @@ void Map::renderInformations(Sint32 px, Sint32 py, Sint32 pw, Sint32 ph, float s
 		#else
 		do
 		{
-			Tile* tile = m_tiles[z][y][x];
+			Tile* tile = getWindowTile(z, y, x);
 			if(tile)
 				tile->renderInformations(px, py, posX, posY, scale, (m_cachedFirstVisibleGround[y][x] >= z));
 
@@ -608,6 +750,8 @@ void Map::renderInformations(Sint32 px, Sint32 py, Sint32 pw, Sint32 ph, float s
 
 	if(g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE)
 	{
+		//The backends draw light maps right away so everything recorded before has to go first
+		g_engine.getRenderCommands().flush();
 		if(g_engine.getLightMode() == CLIENT_LIGHT_MODE_OLD)
 			g_engine.getRender()->drawLightMap_old(g_light.getLightMap(), px + SDL_static_cast(Sint32, offsetX * scale), py + SDL_static_cast(Sint32, offsetY * scale), scaledSize, GAME_MAP_WIDTH, GAME_MAP_HEIGHT);
 		else
@@ -720,27 +864,12 @@ void Map::changeMap(Direction direction)
 				Sint32 x = 0;
 				do
 				{
-					Tile* tile = m_tiles[z][GAME_MAP_HEIGHT - 1][x];
-					delete tile;
-				} while(++x < GAME_MAP_WIDTH);
-
-				Sint32 y = GAME_MAP_HEIGHT - 2;
-				do
-				{
-					x = 0;
-					do
-					{
-						m_tiles[z][y + 1][x] = m_tiles[z][y][x];
-					} while(++x < GAME_MAP_WIDTH);
-				} while(--y >= 0);
-
-				x = 0;
-				do
-				{
-					//Reset the tiles that we get later
-					m_tiles[z][0][x] = NULL;
+					releaseTile(getWindowTile(z, GAME_MAP_HEIGHT - 1, x));
 				} while(++x < GAME_MAP_WIDTH);
 			} while(++z <= GAME_MAP_FLOORS);
+
+			//The released bottom row becomes the top row that we get later
+			rotateWindow(0, -1);
 		}
 		break;
 		case DIRECTION_EAST:
@@ -751,27 +880,12 @@ void Map::changeMap(Direction direction)
 				Sint32 y = 0;
 				do
 				{
-					Tile* tile = m_tiles[z][y][0];
-					delete tile;
-				} while(++y < GAME_MAP_HEIGHT);
-
-				y = 0;
-				do
-				{
-					Sint32 x = 0;
-					do
-					{
-						m_tiles[z][y][x] = m_tiles[z][y][x + 1];
-					} while(++x < GAME_MAP_WIDTH - 1);
-				} while(++y < GAME_MAP_HEIGHT);
-
-				y = 0;
-				do
-				{
-					//Reset the tiles that we get later
-					m_tiles[z][y][GAME_MAP_WIDTH - 1] = NULL;
+					releaseTile(getWindowTile(z, y, 0));
 				} while(++y < GAME_MAP_HEIGHT);
 			} while(++z <= GAME_MAP_FLOORS);
+
+			//The released left column becomes the right column that we get later
+			rotateWindow(1, 0);
 		}
 		break;
 		case DIRECTION_SOUTH:
@@ -782,27 +896,12 @@ void Map::changeMap(Direction direction)
 				Sint32 x = 0;
 				do
 				{
-					Tile* tile = m_tiles[z][0][x];
-					delete tile;
-				} while(++x < GAME_MAP_WIDTH);
-
-				Sint32 y = 0;
-				do
-				{
-					x = 0;
-					do
-					{
-						m_tiles[z][y][x] = m_tiles[z][y + 1][x];
-					} while(++x < GAME_MAP_WIDTH);
-				} while(++y < GAME_MAP_HEIGHT - 1);
-
-				x = 0;
-				do
-				{
-					//Reset the tiles that we get later
-					m_tiles[z][GAME_MAP_HEIGHT - 1][x] = NULL;
+					releaseTile(getWindowTile(z, 0, x));
 				} while(++x < GAME_MAP_WIDTH);
 			} while(++z <= GAME_MAP_FLOORS);
+
+			//The released top row becomes the bottom row that we get later
+			rotateWindow(0, 1);
 		}
 		break;
 		case DIRECTION_WEST:
@@ -813,27 +912,12 @@ void Map::changeMap(Direction direction)
 				Sint32 y = 0;
 				do
 				{
-					Tile* tile = m_tiles[z][y][GAME_MAP_WIDTH - 1];
-					delete tile;
-				} while(++y < GAME_MAP_HEIGHT);
-
-				y = 0;
-				do
-				{
-					Sint32 x = GAME_MAP_WIDTH - 2;
-					do
-					{
-						m_tiles[z][y][x + 1] = m_tiles[z][y][x];
-					} while(--x >= 0);
-				} while(++y < GAME_MAP_HEIGHT);
-
-				y = 0;
-				do
-				{
-					//Reset the tiles that we get later
-					m_tiles[z][y][0] = NULL;
+					releaseTile(getWindowTile(z, y, GAME_MAP_WIDTH - 1));
 				} while(++y < GAME_MAP_HEIGHT);
 			} while(++z <= GAME_MAP_FLOORS);
+
+			//The released right column becomes the left column that we get later
+			rotateWindow(-1, 0);
 		}
 		break;
 		default:
@@ -852,8 +936,7 @@ void Map::changeMap(Direction direction)
 					Sint32 x = 0;
 					do
 					{
-						Tile*& tile = m_tiles[z][y][x];
-						delete tile; tile = NULL;
+						releaseTile(m_tiles[z][y][x]);
 					} while(++x < GAME_MAP_WIDTH);
 				} while(++y < GAME_MAP_HEIGHT);
 			} while(++z <= GAME_MAP_FLOORS);
@@ -862,6 +945,38 @@ void Map::changeMap(Direction direction)
 	}
 }
 
+void Map::rotateWindow(Sint32 offsetX, Sint32 offsetY)
+{
+	m_windowOriginX = (m_windowOriginX + offsetX + GAME_MAP_WIDTH) % GAME_MAP_WIDTH;
+	m_windowOriginY = (m_windowOriginY + offsetY + GAME_MAP_HEIGHT) % GAME_MAP_HEIGHT;
+	for(Sint32 y = 0; y < GAME_MAP_HEIGHT; ++y)
+		m_windowRows[y] = (m_windowOriginY + y) % GAME_MAP_HEIGHT;
+
+	for(Sint32 x = 0; x < GAME_MAP_WIDTH; ++x)
+		m_windowColumns[x] = (m_windowOriginX + x) % GAME_MAP_WIDTH;
+}
+
+Tile* Map::acquireTile(const Position& position)
+{
+	if(m_freeTiles.empty())
+		return new Tile(position);
+
+	Tile* tile = m_freeTiles.back();
+	m_freeTiles.pop_back();
+	tile->setPosition(position);
+	return tile;
+}
+
+void Map::releaseTile(Tile*& tile)
+{
+	if(!tile)
+		return;
+
+	tile->recycle();
+	m_freeTiles.push_back(tile);
+	tile = NULL;
+}
+
 void Map::checkMagicEffects()
 {
 	if(g_frameTime == m_magicEffectsTime)
@@ -1207,7 +1322,7 @@ Tile* Map::findTile(Sint32 x, Sint32 y, iRect& gameWindow, Sint32 scaledSize, fl
 					Sint32 indexY = posY + y2;
 					if(SDL_static_cast(Uint32, indexX) < GAME_MAP_WIDTH && SDL_static_cast(Uint32, indexY) < GAME_MAP_HEIGHT)
 					{
-						Tile* tile = m_tiles[z][indexY][indexX];
+						Tile* tile = getWindowTile(z, indexY, indexX);
 						if(tile)
 						{
 							Sint32 elevationSize = SDL_static_cast(Sint32, tile->getTileElevation() * scale);
@@ -1226,7 +1341,7 @@ Tile* Map::findTile(Sint32 x, Sint32 y, iRect& gameWindow, Sint32 scaledSize, fl
 		Sint32 indexY = posY;
 		if(SDL_static_cast(Uint32, indexX) < GAME_MAP_WIDTH && SDL_static_cast(Uint32, indexY) < GAME_MAP_HEIGHT)
 		{
-			Tile* tile = m_tiles[z][indexY][indexX];
+			Tile* tile = getWindowTile(z, indexY, indexX);
 			if(tile)
 			{
 				iRect irect = iRect(gameWindow.x1 + ((indexX - 1) * scaledSize) - xOffset, gameWindow.y1 + ((indexY - 1) * scaledSize) - yOffset, scaledSize, scaledSize);
@@ -1354,7 +1469,7 @@ void Map::updateCacheMap()
 			Sint32 z = m_cachedFirstVisibleFloor;
 			do
 			{
-				Tile* tile = m_tiles[z][y][x];
+				Tile* tile = getWindowTile(z, y, x);
 				if(tile)
 				{
 					if(!haveFirstVisibleGround && tile->limitsFloorsView(false))
@@ -1385,4 +1500,19 @@ void Map::updateCacheMap()
 				m_cachedFirstFullGrounds[y][x] = m_cachedLastVisibleFloor;
 		} while(++x < GAME_MAP_WIDTH);
 	} while(++y < GAME_MAP_HEIGHT);
+
+	//Queue the sprite sheets of everything we know about so the decoders can work ahead of the renderer
+	Sint32 z = m_cachedLastVisibleFloor;
+	do
+	{
+		for(y = 0; y < GAME_MAP_HEIGHT; ++y)
+		{
+			for(Sint32 x = 0; x < GAME_MAP_WIDTH; ++x)
+			{
+				Tile* tile = getWindowTile(z, y, x);
+				if(tile)
+					tile->prefetchSprites();
+			}
+		}
+	} while(--z >= m_cachedFirstVisibleFloor);
 }
@@ -24,6 +24,7 @@
 
 #include "position.h"
 #include "screenText.h"
+#include "renderCommands.h"
 
 #include <queue>
 
@@ -112,6 +113,13 @@ class Map
 
 		void update();
 		void render();
+		void renderFloor(Sint32 z);
+		SDL_INLINE Uint64 getSceneBuildTicks() {return m_sceneBuildTicks;}
+		SDL_INLINE Uint64 getSceneBuildTotalTicks() {return m_sceneBuildTotalTicks;}
+		SDL_INLINE Uint64 getSceneDrawTicks() {return m_sceneDrawTicks;}
+		SDL_INLINE Uint64 getSceneDrawTotalTicks() {return m_sceneDrawTotalTicks;}
+		SDL_INLINE Uint32 getSceneFrames() {return m_sceneFrames;}
+		SDL_INLINE Uint64 getSceneFloorsTotal() {return m_sceneFloorsTotal;}
 		void renderInformations(Sint32 px, Sint32 py, Sint32 pw, Sint32 ph, float scale, Sint32 scaledSize);
 
 		void addOnscreenText(OnscreenMessages position, MessageMode mode, const std::string& text);
@@ -143,11 +151,47 @@ class Map
 		void updateCacheMap();
 
 	protected:
+		//The tiles are stored as a toroidal window so a step only has to recycle the leaving edge
+		SDL_INLINE Tile*& getWindowTile(Sint32 z, Sint32 y, Sint32 x) {return m_tiles[z][m_windowRows[y]][m_windowColumns[x]];}
+		void rotateWindow(Sint32 offsetX, Sint32 offsetY);
+		void updateStaticLayer(Sint32 z, Sint32 y, Sint32 x, Tile* tile, bool visible_tile);
+		void buildScene();
+		Tile* acquireTile(const Position& position);
+		void releaseTile(Tile*& tile);
+
 		knownCreatures m_knownCreatures;
 		std::vector<DistanceEffect*> m_distanceEffects[GAME_MAP_FLOORS + 1];
 		std::vector<AnimatedText*> m_animatedTexts;
 		std::vector<StaticText*> m_staticTexts;
+		std::vector<Tile*> m_freeTiles;
 		Tile* m_tiles[GAME_MAP_FLOORS + 1][GAME_MAP_HEIGHT][GAME_MAP_WIDTH] = {};
+		Sint32 m_windowRows[GAME_MAP_HEIGHT];
+		Sint32 m_windowColumns[GAME_MAP_WIDTH];
+		Sint32 m_windowOriginX = 0;
+		Sint32 m_windowOriginY = 0;
+
+		//Every visible floor is recorded as its own job and merged back in painter's order
+		RenderCommandList m_floorCommands[GAME_MAP_FLOORS + 1];
+		Uint64 m_sceneBuildTicks = 0;
+		Uint64 m_sceneBuildTotalTicks = 0;
+		Uint64 m_sceneDrawTicks = 0;
+		Uint64 m_sceneDrawTotalTicks = 0;
+		Uint32 m_sceneFrames = 0;
+		Uint64 m_sceneFloorsTotal = 0;
+		Sint32 m_sceneFloors[GAME_MAP_FLOORS + 1];
+		Sint32 m_sceneFloorCount = 0;
+		Sint32 m_sceneOffsetX = 0;
+		Sint32 m_sceneOffsetY = 0;
+
+		//Ground of every floor kept by the backend between frames, the cells are indexed like m_tiles
+		//so a step only redraws the recycled edge and m_staticTiles tells which tile a cell holds
+		RenderCommandList m_staticClears[GAME_MAP_FLOORS + 1];
+		RenderCommandList m_staticCommands[GAME_MAP_FLOORS + 1];
+		Tile* m_staticTiles[GAME_MAP_FLOORS + 1][GAME_MAP_HEIGHT][GAME_MAP_WIDTH] = {};
+		std::vector<Uint32> m_staticMisses;
+		Uint32 m_staticGeneration = 0;
+		bool m_staticReset[GAME_MAP_FLOORS + 1] = {};
+		bool m_sceneStaticLayers = false;
 
 		Creature* m_localCreature = NULL;
 		Position m_centerPosition;
@@ -21,17 +21,91 @@
 
 #include "outputMessage.h"
 
+//Most of the packets are just few bytes so start small and grow only when needed
+static const Uint32 outputMessageCapacities[OUTPUTMESSAGE_POOL_CLASSES] = {256, 4096, OUTPUTMESSAGE_SIZE};
+
+OutputMessagePool g_outputMessagePool;
+
+OutputMessage::OutputMessage(Uint16 headerPos)
+{
+	m_capacityClass = 0;
+	m_networkBuffer = g_outputMessagePool.acquire(m_capacityClass);
+	reset(headerPos);
+}
+
+OutputMessage::~OutputMessage()
+{
+	g_outputMessagePool.release(m_networkBuffer, m_capacityClass);
+}
+
 void OutputMessage::reset(Uint16 headerPos)
 {
 	m_messageSize = 0;
 	m_writePos = headerPos;
+	m_allocationFailed = (m_networkBuffer == NULL);
 }
 
 bool OutputMessage::canWrite(Uint32 bytes)
 {
-	if(m_writePos + bytes >= OUTPUTMESSAGE_SIZE - 8)
+	if(m_allocationFailed)
+		return false;
+
+	Uint32 requiredSize = m_writePos + bytes + 8;
+	if(requiredSize < outputMessageCapacities[m_capacityClass])
+		return true;
+	else if(requiredSize >= OUTPUTMESSAGE_SIZE)
 		return false;
 
+	Uint8 capacityClass = m_capacityClass;
+	while(requiredSize >= outputMessageCapacities[capacityClass])
+		++capacityClass;
+
+	//Move what we already have to the bigger buffer
+	Uint8* networkBuffer = g_outputMessagePool.acquire(capacityClass);
+	if(!networkBuffer)
+	{
+		//Rest of the message would be lost so don't let anything be written anymore
+		m_allocationFailed = true;
+		return false;
+	}
+
+	SDL_memcpy(networkBuffer, m_networkBuffer, outputMessageCapacities[m_capacityClass]);
+	g_outputMessagePool.release(m_networkBuffer, m_capacityClass);
+	m_networkBuffer = networkBuffer;
+	m_capacityClass = capacityClass;
 	return true;
 }
 
+OutputMessagePool::~OutputMessagePool()
+{
+	for(Uint8 i = 0; i < OUTPUTMESSAGE_POOL_CLASSES; ++i)
+	{
+		for(std::vector<Uint8*>::iterator it = m_freeBuffers[i].begin(), end = m_freeBuffers[i].end(); it != end; ++it)
+			SDL_free((*it));
+
+		m_freeBuffers[i].clear();
+	}
+}
+
+Uint32 OutputMessagePool::getCapacity(Uint8 capacityClass)
+{
+	return outputMessageCapacities[capacityClass];
+}
+
+Uint8* OutputMessagePool::acquire(Uint8 capacityClass)
+{
+	std::vector<Uint8*>& freeBuffers = m_freeBuffers[capacityClass];
+	if(freeBuffers.empty())
+		return SDL_reinterpret_cast(Uint8*, SDL_malloc(outputMessageCapacities[capacityClass]));
+
+	Uint8* buffer = freeBuffers.back();
+	freeBuffers.pop_back();
+	return buffer;
+}
+
+void OutputMessagePool::release(Uint8* buffer, Uint8 capacityClass)
+{
+	if(buffer)
+		m_freeBuffers[capacityClass].push_back(buffer);
+}
+
@@ -24,6 +24,7 @@
 
 #include "position.h"
 #define OUTPUTMESSAGE_SIZE 65536
+#define OUTPUTMESSAGE_POOL_CLASSES 3
 
 class Protocol;
 class ProtocolLogin;
@@ -32,7 +33,8 @@ class Connection;
 class OutputMessage
 {
 	public:
-		OutputMessage(Uint16 headerPos) {reset(headerPos);}
+		OutputMessage(Uint16 headerPos);
+		~OutputMessage();
 
 		// non-copyable
 		OutputMessage(const OutputMessage&) = delete;
@@ -43,6 +45,7 @@ class OutputMessage
 		OutputMessage& operator=(OutputMessage&&) = delete;
 
 		void reset(Uint16 headerPos);
+		bool hasAllocationFailed() {return m_allocationFailed;}
 
 		void addU8(Uint8 v)
 		{
@@ -269,9 +272,34 @@ class OutputMessage
 	private:
 		bool canWrite(Uint32 bytes);
 
+		Uint8* m_networkBuffer;
 		Uint16 m_writePos;
 		Uint16 m_messageSize;
-		Uint8 m_networkBuffer[OUTPUTMESSAGE_SIZE];
+		Uint8 m_capacityClass;
+		bool m_allocationFailed;
+};
+
+class OutputMessagePool
+{
+	public:
+		OutputMessagePool() = default;
+		~OutputMessagePool();
+
+		// non-copyable
+		OutputMessagePool(const OutputMessagePool&) = delete;
+		OutputMessagePool& operator=(const OutputMessagePool&) = delete;
+
+		// non-moveable
+		OutputMessagePool(OutputMessagePool&&) = delete;
+		OutputMessagePool& operator=(OutputMessagePool&&) = delete;
+
+		static Uint32 getCapacity(Uint8 capacityClass);
+
+		Uint8* acquire(Uint8 capacityClass);
+		void release(Uint8* buffer, Uint8 capacityClass);
+
+	private:
+		std::vector<Uint8*> m_freeBuffers[OUTPUTMESSAGE_POOL_CLASSES];
 };
 
 #endif /* __FILE_OUTPUT_MESSAGE_h_ */
@@ -0,0 +1,525 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "packetRecorder.h"
+#include "inputMessage.h"
+#include "protocolgame.h"
+#include "map.h"
+#include "thingManager.h"
+#include "game.h"
+
+extern ThingManager g_thingManager;
+extern Game g_game;
+extern Uint32 g_clientVersion;
+
+PacketRecorder::~PacketRecorder()
+{
+	close();
+}
+
+bool PacketRecorder::open(const char* fileName)
+{
+	close();
+	m_file = SDL_RWFromFile(fileName, "wb");
+	if(!m_file)
+		return false;
+
+	SDL_WriteLE32(m_file, PACKET_RECORDER_MAGIC);
+	SDL_WriteLE32(m_file, PACKET_RECORDER_VERSION);
+	SDL_WriteLE32(m_file, g_clientVersion);
+	m_buffer.reserve(PACKET_RECORDER_BUFFER_SIZE);
+	m_startTicks = SDL_GetTicks();
+	return true;
+}
+
+void PacketRecorder::close()
+{
+	if(m_file)
+	{
+		flush();
+		SDL_RWclose(m_file);
+		m_file = NULL;
+	}
+	m_buffer.clear();
+}
+
+void PacketRecorder::record(const Uint8* data, Uint32 size)
+{
+	if(!m_file)
+		return;
+
+	Uint32 timestamp = SDL_GetTicks() - m_startTicks;
+	Uint8 packetHeader[8];
+	packetHeader[0] = SDL_static_cast(Uint8, timestamp);
+	packetHeader[1] = SDL_static_cast(Uint8, timestamp >> 8);
+	packetHeader[2] = SDL_static_cast(Uint8, timestamp >> 16);
+	packetHeader[3] = SDL_static_cast(Uint8, timestamp >> 24);
+	packetHeader[4] = SDL_static_cast(Uint8, size);
+	packetHeader[5] = SDL_static_cast(Uint8, size >> 8);
+	packetHeader[6] = SDL_static_cast(Uint8, size >> 16);
+	packetHeader[7] = SDL_static_cast(Uint8, size >> 24);
+	m_buffer.insert(m_buffer.end(), packetHeader, packetHeader + 8);
+	m_buffer.insert(m_buffer.end(), data, data + size);
+	if(m_buffer.size() >= PACKET_RECORDER_BUFFER_SIZE)
+		flush();
+}
+
+void PacketRecorder::flush()
+{
+	if(!m_buffer.empty())
+	{
+		SDL_RWwrite(m_file, &m_buffer[0], 1, m_buffer.size());
+		m_buffer.clear();
+	}
+}
+
+PacketReplayer::~PacketReplayer()
+{
+	close();
+}
+
+bool PacketReplayer::open(const char* fileName)
+{
+	close();
+	m_file = SDL_RWFromFile(fileName, "rb");
+	if(!m_file)
+		return false;
+
+	return readHeader();
+}
+
+bool PacketReplayer::open(std::vector<Uint8> stream)
+{
+	close();
+	if(stream.empty())
+		return false;
+
+	m_stream = std::move(stream);
+	m_file = SDL_RWFromConstMem(&m_stream[0], SDL_static_cast(int, m_stream.size()));
+	if(!m_file)
+		return false;
+
+	return readHeader();
+}
+
+bool PacketReplayer::readHeader()
+{
+	if(SDL_ReadLE32(m_file) != PACKET_RECORDER_MAGIC || SDL_ReadLE32(m_file) != PACKET_RECORDER_VERSION)
+	{
+		close();
+		return false;
+	}
+
+	m_clientVersion = SDL_ReadLE32(m_file);
+	return true;
+}
+
+void PacketReplayer::close()
+{
+	if(m_file)
+	{
+		SDL_RWclose(m_file);
+		m_file = NULL;
+	}
+	m_stream.clear();
+}
+
+bool PacketReplayer::readPacket(Uint32& timestamp, std::vector<Uint8>& packet)
+{
+	if(!m_file)
+		return false;
+
+	Uint8 packetHeader[8];
+	if(SDL_RWread(m_file, packetHeader, 1, 8) != 8)
+		return false;
+
+	timestamp = SDL_static_cast(Uint32, packetHeader[0]) | (SDL_static_cast(Uint32, packetHeader[1]) << 8) | (SDL_static_cast(Uint32, packetHeader[2]) << 16) | (SDL_static_cast(Uint32, packetHeader[3]) << 24);
+	Uint32 size = SDL_static_cast(Uint32, packetHeader[4]) | (SDL_static_cast(Uint32, packetHeader[5]) << 8) | (SDL_static_cast(Uint32, packetHeader[6]) << 16) | (SDL_static_cast(Uint32, packetHeader[7]) << 24);
+	if(size == 0 || size > INPUTMESSAGE_MAX_SIZE)
+		return false;
+
+	packet.resize(SDL_static_cast(size_t, size));
+	return (SDL_RWread(m_file, &packet[0], 1, packet.size()) == packet.size());
+}
+
+bool PacketGenerator::generate(const char* scenario, std::vector<Uint8>& stream)
+{
+	if(!collectThings())
+		return false;
+
+	bool mapStorm = (SDL_strcasecmp(scenario, "map") == 0);
+	bool moveStorm = (SDL_strcasecmp(scenario, "move") == 0);
+	bool effectStorm = (SDL_strcasecmp(scenario, "effects") == 0);
+	bool mixed = (SDL_strcasecmp(scenario, "mixed") == 0);
+	if(!mapStorm && !moveStorm && !effectStorm && !mixed)
+		return false;
+
+	m_stream.clear();
+	m_stream.reserve(PACKET_GENERATOR_STREAM_SIZE);
+	m_timestamp = 0;
+	m_nextCreature = 0;
+	m_nextEffect = 0;
+	m_creaturesKnown = false;
+	m_centralPosition = Position(32000, 32000, GAME_PLAYER_FLOOR);
+
+	//Creatures stand on every other column so they can step east and back without bumping into each other
+	m_creatureHomes.clear();
+	for(Sint32 y = -(MAP_HEIGHT_OFFSET - 1); y <= MAP_HEIGHT_OFFSET && m_creatureHomes.size() < PACKET_GENERATOR_CREATURES; ++y)
+	{
+		for(Sint32 x = -(MAP_WIDTH_OFFSET - 1); x < MAP_WIDTH_OFFSET && m_creatureHomes.size() < PACKET_GENERATOR_CREATURES; x += 2)
+		{
+			if(x != 0 || y != 0)
+				m_creatureHomes.emplace_back(SDL_static_cast(Uint16, m_centralPosition.x + x), SDL_static_cast(Uint16, m_centralPosition.y + y), m_centralPosition.z);
+		}
+	}
+	m_creatureSteps.assign(m_creatureHomes.size(), false);
+
+	addU32(PACKET_RECORDER_MAGIC);
+	addU32(PACKET_RECORDER_VERSION);
+	addU32(g_clientVersion);
+
+	//Same order as the server login - the session dump handshake then the map around the player
+	beginPacket();
+	addSessionStart();
+	addMapDescription();
+	endPacket();
+	for(Uint32 i = 0; i < PACKET_GENERATOR_PACKETS; ++i)
+	{
+		beginPacket();
+		if(mapStorm || (mixed && (i % 16) == 0))
+			addMapDescription();
+		else if(moveStorm || (mixed && (i & 1) == 0))
+			addCreatureMoves(PACKET_GENERATOR_BATCH);
+		else
+		{
+			//Effects only expire with time so a fresh map keeps the burst from piling up on the tiles
+			if((i % 64) == 63)
+				addMapDescription();
+			else
+				addMagicEffects(PACKET_GENERATOR_BATCH);
+		}
+		endPacket();
+	}
+
+	stream = std::move(m_stream);
+	return true;
+}
+
+bool PacketGenerator::collectThings()
+{
+	m_groundIds.clear();
+	m_itemIds.clear();
+	m_effectIds.clear();
+	if(!g_thingManager.isDatLoaded())
+		return false;
+
+	for(Uint16 id = 100; g_thingManager.isValidDatId(ThingCategory_Item, id); ++id)
+	{
+		ThingType* ttype = g_thingManager.getThingType(ThingCategory_Item, id);
+		if(ttype->hasFlag(ThingAttribute_Ground))
+		{
+			if(m_groundIds.size() < 8)
+				m_groundIds.push_back(id);
+		}
+		else if(!ttype->hasFlag(ThingAttribute_GroundBorder) && !ttype->hasFlag(ThingAttribute_OnTop) && m_itemIds.size() < 8)
+			m_itemIds.push_back(id);
+
+		if(m_groundIds.size() >= 8 && m_itemIds.size() >= 8)
+			break;
+	}
+
+	for(Uint16 id = 1; g_thingManager.isValidDatId(ThingCategory_Effect, id) && m_effectIds.size() < 16; ++id)
+		m_effectIds.push_back(id);
+
+	return (!m_groundIds.empty() && !m_itemIds.empty() && !m_effectIds.empty() && g_thingManager.isValidDatId(ThingCategory_Creature, PACKET_GENERATOR_LOOKTYPE));
+}
+
+void PacketGenerator::beginPacket()
+{
+	m_packetStart = m_stream.size();
+	addU32(m_timestamp);
+	addU32(0);
+	m_timestamp += 50;
+}
+
+void PacketGenerator::endPacket()
+{
+	Uint32 size = SDL_static_cast(Uint32, m_stream.size() - m_packetStart - 8);
+	m_stream[m_packetStart + 4] = SDL_static_cast(Uint8, size);
+	m_stream[m_packetStart + 5] = SDL_static_cast(Uint8, size >> 8);
+	m_stream[m_packetStart + 6] = SDL_static_cast(Uint8, size >> 16);
+	m_stream[m_packetStart + 7] = SDL_static_cast(Uint8, size >> 24);
+}
+
+void PacketGenerator::addU16(Uint16 value)
+{
+	m_stream.push_back(SDL_static_cast(Uint8, value));
+	m_stream.push_back(SDL_static_cast(Uint8, value >> 8));
+}
+
+void PacketGenerator::addU32(Uint32 value)
+{
+	m_stream.push_back(SDL_static_cast(Uint8, value));
+	m_stream.push_back(SDL_static_cast(Uint8, value >> 8));
+	m_stream.push_back(SDL_static_cast(Uint8, value >> 16));
+	m_stream.push_back(SDL_static_cast(Uint8, value >> 24));
+}
+
+void PacketGenerator::addDouble(double value, Uint8 precision)
+{
+	//Inverse of InputMessage::getDouble
+	double scaled = value * SDL_pow(10.0, SDL_static_cast(double, precision));
+	Sint32 fixedValue = SDL_static_cast(Sint32, scaled + (scaled < 0.0 ? -0.5 : 0.5));
+	addU8(precision);
+	addU32(SDL_static_cast(Uint32, fixedValue) + SDL_static_cast(Uint32, SDL_MAX_SINT32));
+}
+
+void PacketGenerator::addString(const char* value)
+{
+	size_t len = SDL_strlen(value);
+	addU16(SDL_static_cast(Uint16, len));
+	m_stream.insert(m_stream.end(), SDL_reinterpret_cast(const Uint8*, value), SDL_reinterpret_cast(const Uint8*, value) + len);
+}
+
+void PacketGenerator::addPosition(const Position& position)
+{
+	addU16(position.x);
+	addU16(position.y);
+	addU8(position.z);
+}
+
+void PacketGenerator::addItem(Uint16 itemId)
+{
+	//Mirrors ProtocolGame::getItem
+	addU16(itemId);
+	if(g_game.hasGameFeature(GAME_FEATURE_ITEM_MARK))
+		addU8(0xFF);
+
+	ThingType* ttype = g_thingManager.getThingType(ThingCategory_Item, itemId);
+	if(ttype->hasFlag(ThingAttribute_Stackable) || ttype->hasFlag(ThingAttribute_Chargeable))
+	{
+		if(g_game.hasGameFeature(GAME_FEATURE_ITEMS_U16))
+			addU16(1);
+		else
+			addU8(1);
+	}
+	else if(ttype->hasFlag(ThingAttribute_Splash) || ttype->hasFlag(ThingAttribute_FluidContainer))
+		addU8(0);
+
+	if(g_game.hasGameFeature(GAME_FEATURE_QUICK_LOOT) && ttype->hasFlag(ThingAttribute_Container))
+		addU8(0);
+
+	if(g_game.hasGameFeature(GAME_FEATURE_ITEM_ANIMATION_PHASES) && ttype->m_frameGroup[ThingFrameGroup_Default].m_animCount > 1)
+		addU8(0xFE);
+}
+
+void PacketGenerator::addCreature(Uint32 creatureId, Uint8 creatureType)
+{
+	//Mirrors ProtocolGame::getCreature - the first map description introduces the creatures and later ones refer to them
+	if(m_creaturesKnown)
+	{
+		addU16(0x62);
+		addU32(creatureId);
+	}
+	else
+	{
+		addU16(0x61);
+		addU32(0);//Nothing to remove
+		addU32(creatureId);
+		if(g_clientVersion >= 910)
+			addU8(creatureType);
+
+		addString(creatureType == CREATURETYPE_PLAYER ? "Synthetic Player" : "Synthetic Monster");
+	}
+
+	addU8(100);//Health
+	addU8(DIRECTION_SOUTH);
+	if(g_game.hasGameFeature(GAME_FEATURE_LOOKTYPE_U16))
+		addU16(PACKET_GENERATOR_LOOKTYPE);
+	else
+		addU8(PACKET_GENERATOR_LOOKTYPE);
+
+	addU8(78);
+	addU8(69);
+	addU8(58);
+	addU8(76);
+	if(g_game.hasGameFeature(GAME_FEATURE_ADDONS))
+		addU8(0);
+
+	if(g_game.hasGameFeature(GAME_FEATURE_MOUNTS))
+		addU16(0);
+
+	addU8(0);//Light intensity
+	addU8(0);//Light color
+	addU16(220);//Speed
+	if(g_clientVersion >= 1240)
+		addU8(0);//Icons
+
+	addU8(0);//Skull
+	addU8(0);//Shield
+	if(g_game.hasGameFeature(GAME_FEATURE_CREATURE_EMBLEM) && !m_creaturesKnown)
+		addU8(0);
+
+	if(g_game.hasGameFeature(GAME_FEATURE_CREATURE_TYPE))
+	{
+		addU8(creatureType);
+		if(g_clientVersion >= 1220 && creatureType == CREATURETYPE_PLAYER)
+			addU8(0);//Vocation
+	}
+
+	if(g_game.hasGameFeature(GAME_FEATURE_CREATURE_ICONS))
+		addU8(0);
+
+	if(g_game.hasGameFeature(GAME_FEATURE_CREATURE_MARK))
+		addU8(0xFF);
+
+	if(g_game.hasGameFeature(GAME_FEATURE_INSPECTION))
+		addU8(0);
+
+	if(g_clientVersion >= 1000 && g_clientVersion < 1185)
+		addU16(0);//Helpers
+
+	if(g_clientVersion >= 854)
+		addU8(1);//Unpassable
+}
+
+void PacketGenerator::addSessionStart()
+{
+	addU8(RecvSessionDumpStartOpcode);
+	addU32(PACKET_GENERATOR_PLAYER_ID);
+	addU16(50);//Server beat
+	addDouble(857.36, 3);
+	addDouble(261.29, 3);
+	addDouble(-4795.01, 3);
+}
+
+void PacketGenerator::addMapDescription()
+{
+	addU8(RecvMapDescriptionOpcode);
+	addPosition(m_centralPosition);
+
+	//Same traversal and skip encoding as ProtocolGame::setMapDescription reads it - only the player floor has anything on it
+	Sint32 startX = m_centralPosition.x - (MAP_WIDTH_OFFSET - 1);
+	Sint32 startY = m_centralPosition.y - (MAP_HEIGHT_OFFSET - 1);
+	Sint32 skip = -1;
+	for(Sint32 nz = GAME_PLAYER_FLOOR; nz >= 0; --nz)
+	{
+		for(Sint32 nx = 0; nx < GAME_MAP_WIDTH; ++nx)
+		{
+			for(Sint32 ny = 0; ny < GAME_MAP_HEIGHT; ++ny)
+			{
+				if(nz != m_centralPosition.z)
+				{
+					if(skip == 0xFE)
+					{
+						addU16(0xFFFF);
+						skip = -1;
+					}
+					else
+						++skip;
+					continue;
+				}
+
+				if(skip >= 0)
+					addU16(SDL_static_cast(Uint16, 0xFF00 | skip));
+
+				skip = 0;
+				if(g_game.hasGameFeature(GAME_FEATURE_ENVIRONMENT_EFFECTS))
+					addU16(0);
+
+				Position position(SDL_static_cast(Uint16, startX + nx), SDL_static_cast(Uint16, startY + ny), SDL_static_cast(Uint8, nz));
+				addItem(m_groundIds[SDL_static_cast(size_t, nx + ny) % m_groundIds.size()]);
+				if(((nx + ny * GAME_MAP_WIDTH) % 3) == 0)
+					addItem(m_itemIds[SDL_static_cast(size_t, nx * ny) % m_itemIds.size()]);
+
+				if(position == m_centralPosition)
+					addCreature(PACKET_GENERATOR_PLAYER_ID, CREATURETYPE_PLAYER);
+
+				for(size_t i = 0, end = m_creatureHomes.size(); i < end; ++i)
+				{
+					if(m_creatureHomes[i] == position)
+					{
+						addCreature(PACKET_GENERATOR_CREATURE_ID + SDL_static_cast(Uint32, i), CREATURETYPE_MONSTER);
+						m_creatureSteps[i] = false;
+					}
+				}
+			}
+		}
+	}
+	if(skip >= 0)
+		addU16(SDL_static_cast(Uint16, 0xFF00 | skip));
+
+	m_creaturesKnown = true;
+}
+
+void PacketGenerator::addCreatureMoves(Uint32 moves)
+{
+	for(Uint32 i = 0; i < moves; ++i)
+	{
+		size_t creature = SDL_static_cast(size_t, m_nextCreature++ % m_creatureHomes.size());
+		Position toPosition = m_creatureHomes[creature];
+		if(!m_creatureSteps[creature])
+			++toPosition.x;
+
+		m_creatureSteps[creature] = !m_creatureSteps[creature];
+		addU8(RecvTileMoveCreatureOpcode);
+		addU16(0xFFFF);
+		addU32(PACKET_GENERATOR_CREATURE_ID + SDL_static_cast(Uint32, creature));
+		addPosition(toPosition);
+	}
+}
+
+void PacketGenerator::addMagicEffects(Uint32 effects)
+{
+	Position topLeft(SDL_static_cast(Uint16, m_centralPosition.x - (MAP_WIDTH_OFFSET - 1)), SDL_static_cast(Uint16, m_centralPosition.y - (MAP_HEIGHT_OFFSET - 1)), m_centralPosition.z);
+	if(g_clientVersion >= 1203)
+	{
+		//One looped packet - every effect is a delta from the previous one
+		addU8(RecvMagicEffectOpcode);
+		addPosition(topLeft);
+		for(Uint32 i = 0; i < effects; ++i)
+		{
+			addU8(MAGIC_EFFECTS_DELTA);
+			addU8(SDL_static_cast(Uint8, (GAME_MAP_WIDTH * GAME_MAP_HEIGHT - 1) / effects));
+			addU8(MAGIC_EFFECTS_CREATE_EFFECT);
+			Uint16 effectId = m_effectIds[m_nextEffect++ % m_effectIds.size()];
+			if(g_game.hasGameFeature(GAME_FEATURE_EFFECTS_U16))
+				addU16(effectId);
+			else
+				addU8(SDL_static_cast(Uint8, effectId));
+		}
+		addU8(MAGIC_EFFECTS_END_LOOP);
+	}
+	else
+	{
+		for(Uint32 i = 0; i < effects; ++i)
+		{
+			Uint32 tile = (i * 7) % (GAME_MAP_WIDTH * GAME_MAP_HEIGHT);
+			addU8(RecvMagicEffectOpcode);
+			addPosition(Position(SDL_static_cast(Uint16, topLeft.x + tile % GAME_MAP_WIDTH), SDL_static_cast(Uint16, topLeft.y + tile / GAME_MAP_WIDTH), topLeft.z));
+			Uint16 effectId = m_effectIds[m_nextEffect++ % m_effectIds.size()];
+			if(g_game.hasGameFeature(GAME_FEATURE_EFFECTS_U16))
+				addU16(effectId);
+			else
+				addU8(SDL_static_cast(Uint8, effectId));
+		}
+	}
+}
@@ -0,0 +1,154 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __FILE_PACKETRECORDER_h_
+#define __FILE_PACKETRECORDER_h_
+
+#include "defines.h"
+#include "position.h"
+
+#define PACKET_RECORDER_MAGIC 0x52434654 //"TFCR"
+#define PACKET_RECORDER_VERSION 1
+#define PACKET_RECORDER_BUFFER_SIZE 65536
+
+#define PACKET_GENERATOR_STREAM_SIZE (16 * 1024 * 1024)
+#define PACKET_GENERATOR_PACKETS 4096
+#define PACKET_GENERATOR_BATCH 16
+#define PACKET_GENERATOR_CREATURES 64
+#define PACKET_GENERATOR_PLAYER_ID 0x10000001
+#define PACKET_GENERATOR_CREATURE_ID 0x40000001
+#define PACKET_GENERATOR_LOOKTYPE 128
+
+//Recording file layout(little endian):
+//header: magic(4), version(4), client version(4)
+//packet: receive time in ms since the start(4), size(4), decrypted and decompressed payload(size)
+class PacketRecorder
+{
+	public:
+		PacketRecorder() = default;
+		~PacketRecorder();
+
+		// non-copyable
+		PacketRecorder(const PacketRecorder&) = delete;
+		PacketRecorder& operator=(const PacketRecorder&) = delete;
+
+		// non-moveable
+		PacketRecorder(PacketRecorder&&) = delete;
+		PacketRecorder& operator=(PacketRecorder&&) = delete;
+
+		bool open(const char* fileName);
+		void close();
+
+		void record(const Uint8* data, Uint32 size);
+
+	protected:
+		void flush();
+
+	private:
+		SDL_RWops* m_file = NULL;
+		std::vector<Uint8> m_buffer;
+		Uint32 m_startTicks = 0;
+};
+
+class PacketReplayer
+{
+	public:
+		PacketReplayer() = default;
+		~PacketReplayer();
+
+		// non-copyable
+		PacketReplayer(const PacketReplayer&) = delete;
+		PacketReplayer& operator=(const PacketReplayer&) = delete;
+
+		// non-moveable
+		PacketReplayer(PacketReplayer&&) = delete;
+		PacketReplayer& operator=(PacketReplayer&&) = delete;
+
+		bool open(const char* fileName);
+		bool open(std::vector<Uint8> stream);
+		void close();
+
+		bool readPacket(Uint32& timestamp, std::vector<Uint8>& packet);
+
+		SDL_INLINE Uint32 getClientVersion() {return m_clientVersion;}
+
+	protected:
+		bool readHeader();
+
+	private:
+		SDL_RWops* m_file = NULL;
+		std::vector<Uint8> m_stream;
+		Uint32 m_clientVersion = 0;
+};
+
+//Builds synthetic recordings in the layout above so parsing can be benchmarked without a captured session
+//scenarios: "map" - full map descriptions, "move" - creature move storms, "effects" - magic effect bursts, "mixed" - all of them
+class PacketGenerator
+{
+	public:
+		PacketGenerator() = default;
+
+		// non-copyable
+		PacketGenerator(const PacketGenerator&) = delete;
+		PacketGenerator& operator=(const PacketGenerator&) = delete;
+
+		// non-moveable
+		PacketGenerator(PacketGenerator&&) = delete;
+		PacketGenerator& operator=(PacketGenerator&&) = delete;
+
+		bool generate(const char* scenario, std::vector<Uint8>& stream);
+
+	protected:
+		bool collectThings();
+
+		void beginPacket();
+		void endPacket();
+
+		void addU8(Uint8 value) {m_stream.push_back(value);}
+		void addU16(Uint16 value);
+		void addU32(Uint32 value);
+		void addDouble(double value, Uint8 precision);
+		void addString(const char* value);
+		void addPosition(const Position& position);
+		void addItem(Uint16 itemId);
+		void addCreature(Uint32 creatureId, Uint8 creatureType);
+
+		void addSessionStart();
+		void addMapDescription();
+		void addCreatureMoves(Uint32 moves);
+		void addMagicEffects(Uint32 effects);
+
+	private:
+		std::vector<Uint8> m_stream;
+		std::vector<Uint16> m_groundIds;
+		std::vector<Uint16> m_itemIds;
+		std::vector<Uint16> m_effectIds;
+		std::vector<Position> m_creatureHomes;
+		std::vector<bool> m_creatureSteps;
+		Position m_centralPosition;
+		size_t m_packetStart = 0;
+		Uint32 m_timestamp = 0;
+		Uint32 m_nextCreature = 0;
+		Uint32 m_nextEffect = 0;
+		bool m_creaturesKnown = false;
+};
+
+#endif /* __FILE_PACKETRECORDER_h_ */
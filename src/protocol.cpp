@@ -93,29 +93,61 @@ bool Protocol::onRecv(InputMessage& msg)
 			inflateInit2(m_inflateStream.get(), -15);
 		}
 
-		static Uint8 infBuffer[65536];
+		Uint64 inflateStart = SDL_GetPerformanceCounter();
+		Uint32 compressedSize = msg.getUnreadSize();
 		m_inflateStream->next_in = msg.getReadBuffer();
-		m_inflateStream->avail_in = SDL_static_cast(Uint32, msg.getUnreadSize());
-		m_inflateStream->next_out = infBuffer;
-		m_inflateStream->avail_out = 65536;
+		m_inflateStream->avail_in = SDL_static_cast(Uint32, compressedSize);
+		while(true)
+		{
+			//Inflate straight into the spare message and grow it if the output don't fit
+			Uint32 inflatedSize = SDL_static_cast(Uint32, m_inflateStream->total_out);
+			if(inflatedSize == m_inflateMessage.getCapacity() && !m_inflateMessage.reserve(UTIL_max<Uint32>(inflatedSize * 2, INPUTMESSAGE_SIZE)))
+			{
+				inflateReset(m_inflateStream.get());
+				return false;
+			}
 
-		Sint32 ret = inflate(m_inflateStream.get(), Z_FINISH);
-		if(ret != Z_OK && ret != Z_STREAM_END)
-			return false;
+			m_inflateStream->next_out = m_inflateMessage.getBuffer() + inflatedSize;
+			m_inflateStream->avail_out = m_inflateMessage.getCapacity() - inflatedSize;
 
+			Sint32 ret = inflate(m_inflateStream.get(), Z_SYNC_FLUSH);
+			if(ret == Z_STREAM_END || (ret == Z_OK && m_inflateStream->avail_out > 0))
+				break;
+			else if(ret == Z_BUF_ERROR && m_inflateStream->avail_in == 0)//Nothing more to inflate
+				break;
+			else if(ret != Z_OK)
+			{
+				inflateReset(m_inflateStream.get());
+				return false;
+			}
+		}
+
+		//Every packet is compressed as a separate stream
 		Uint32 totalSize = SDL_static_cast(Uint32, m_inflateStream->total_out);
 		inflateReset(m_inflateStream.get());
 		if(totalSize == 0)
 			return false;
 
-		UTIL_FastCopy(msg.getReadBuffer(), infBuffer, SDL_static_cast(size_t, totalSize));
-		msg.setMessageSize(SDL_static_cast(Uint16, totalSize) + msg.getReadPos());
+		//Swap the buffers instead of copying the inflated data back
+		msg.swapBuffer(m_inflateMessage);
+		msg.setReadPos(0);
+		msg.setMessageSize(totalSize);
+
+		Uint64 inflateTicks = SDL_GetPerformanceCounter() - inflateStart;
+		SDL_AtomicLock(&m_inflateStatsLock);
+		m_inflateStats.compressedBytes += compressedSize;
+		m_inflateStats.inflatedBytes += totalSize;
+		m_inflateStats.ticks += inflateTicks;
+		++m_inflateStats.packets;
+		SDL_AtomicUnlock(&m_inflateStatsLock);
 	}
+	return true;
+}
 
+void Protocol::onParse(InputMessage& msg)
+{
 	while(!msg.eof())
 		parseMessage(msg);
-
-	return true;
 }
 
 bool Protocol::onSend(OutputMessage& msg)
@@ -123,12 +155,24 @@ bool Protocol::onSend(OutputMessage& msg)
 	if(!g_connection) //WTF?
 		return false;
 
+	if(msg.hasAllocationFailed())
+	{
+		//Part of the message is missing - let the connection drop it
+		g_connection->sendMessage(msg);
+		return false;
+	}
+
 	if(m_encryption)
 	{
 		Uint16 msgSize = msg.getMessageSize();
 		Uint16 paddingBytes = ((msgSize + 2) & 7);
 		if(paddingBytes != 0)
 			msg.addPaddingBytes(8 - paddingBytes);
+		if(msg.hasAllocationFailed())
+		{
+			g_connection->sendMessage(msg);
+			return false;
+		}
 
 		msg.setWritePos(m_checksumMethod != CHECKSUM_METHOD_NONE ? 6 : 2);
 		msg.addU16(msgSize);
@@ -158,6 +202,14 @@ bool Protocol::onSend(OutputMessage& msg)
 	return true;
 }
 
+InflateStats Protocol::getInflateStats()
+{
+	SDL_AtomicLock(&m_inflateStatsLock);
+	InflateStats inflateStats = m_inflateStats;
+	SDL_AtomicUnlock(&m_inflateStatsLock);
+	return inflateStats;
+}
+
 Uint16 Protocol::getHeaderPos()
 {
 	return 2 + (m_encryption ? 2 : 0) + (m_checksumMethod != CHECKSUM_METHOD_NONE ? 4 : 0);
@@ -53,6 +53,14 @@ enum ChecksumMethods : Uint8
 	CHECKSUM_METHOD_CHALLENGE
 };
 
+struct InflateStats
+{
+	Uint64 compressedBytes = 0;
+	Uint64 inflatedBytes = 0;
+	Uint64 ticks = 0;
+	Uint32 packets = 0;
+};
+
 class ProtocolGame;
 class Protocol
 {
@@ -76,13 +84,16 @@ class Protocol
 		virtual void onConnectionError(ConnectionError error) = 0;
 		virtual void onDisconnect() = 0;
 
+		//onRecv runs on the network thread(checksum, decryption, decompression) and onParse on the game thread
 		bool onRecv(InputMessage& msg);
+		void onParse(InputMessage& msg);
 		bool onSend(OutputMessage& msg);
 
 		SDL_INLINE void setEncryption(bool encrypt) {m_encryption = encrypt;}
 		SDL_INLINE void setChecksumMethod(Uint8 checksumMethod) {m_checksumMethod = checksumMethod;}
 		SDL_INLINE void setEncryptionKeys(Uint32 keys[4]) {m_encryptionKeys[0] = keys[0]; m_encryptionKeys[1] = keys[1]; m_encryptionKeys[2] = keys[2]; m_encryptionKeys[3] = keys[3];}
 
+		InflateStats getInflateStats();
 		Uint16 getHeaderPos();
 
 		static Uint8 getOS();
@@ -91,6 +102,9 @@ class Protocol
 
 	private:
 		std::unique_ptr<z_stream> m_inflateStream;
+		InputMessage m_inflateMessage;
+		InflateStats m_inflateStats;
+		SDL_SpinLock m_inflateStatsLock = 0;
 		Uint32 m_encryptionKeys[4];
 		Uint32 m_clientSequence = 0;
 		Uint32 m_serverSequence = 0;
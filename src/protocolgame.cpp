@@ -48,9 +48,58 @@ extern Connection* g_connection;
 extern Uint32 g_datRevision;
 extern Uint16 g_ping;
 
+#ifdef __PARSE_PROFILER__
+ParseOpcodeStats ProtocolGame::parseStats[256];
+
+ParseProfilerScope::~ParseProfilerScope()
+{
+	Uint64 parseTicks = SDL_GetPerformanceCounter() - m_startTicks;
+	ParseOpcodeStats& stats = ProtocolGame::parseStats[m_header];
+	stats.totalTicks += parseTicks;
+	stats.maxTicks = UTIL_max<Uint64>(stats.maxTicks, parseTicks);
+	stats.bytes += m_msg.getReadPos() - m_startPos;
+	++stats.count;
+}
+
+void ProtocolGame::resetParseStats()
+{
+	for(Uint32 i = 0; i < 256; ++i)
+		parseStats[i] = ParseOpcodeStats();
+}
+
+bool ProtocolGame::dumpParseStats(const char* fileName)
+{
+	SDL_RWops* csvFile = SDL_RWFromFile(fileName, "wb");
+	if(!csvFile)
+		return false;
+
+	double tickToMs = 1000.0 / SDL_static_cast(double, SDL_GetPerformanceFrequency());
+	Sint32 len = SDL_snprintf(g_buffer, sizeof(g_buffer), "opcode,count,bytes,total_ms,max_ms,avg_us\n");
+	SDL_RWwrite(csvFile, g_buffer, 1, SDL_static_cast(size_t, len));
+	for(Uint32 i = 0; i < 256; ++i)
+	{
+		ParseOpcodeStats& stats = parseStats[i];
+		if(stats.count == 0)
+			continue;
+
+		double totalMs = SDL_static_cast(double, stats.totalTicks) * tickToMs;
+		len = SDL_snprintf(g_buffer, sizeof(g_buffer), "0x%02X,%u,%llu,%.3f,%.3f,%.3f\n", i, stats.count, SDL_static_cast(unsigned long long, stats.bytes), totalMs, SDL_static_cast(double, stats.maxTicks) * tickToMs, totalMs * 1000.0 / stats.count);
+		SDL_RWwrite(csvFile, g_buffer, 1, SDL_static_cast(size_t, len));
+	}
+	SDL_RWclose(csvFile);
+	return true;
+}
+#endif
+
 void ProtocolGame::parseMessage(InputMessage& msg)
 {
+	#ifdef __PARSE_PROFILER__
+	Uint32 startPos = msg.getReadPos();
 	Uint8 header = msg.getU8();
+	ParseProfilerScope parseScope(msg, header, startPos);
+	#else
+	Uint8 header = msg.getU8();
+	#endif
 	switch(header)
 	{
 		case RecvCreatureDataOpcode: parseCreatureData(msg); break;
@@ -6055,6 +6104,9 @@ void ProtocolGame::sendServerName(const std::string& serverName)
 
 void ProtocolGame::sendLogin(Uint32 challengeTimestamp, Uint8 challengeRandom)
 {
+	if(!g_connection || g_connection->isReplaying())
+		return;
+
 	bool checksumFeature = (g_game.hasGameFeature(GAME_FEATURE_CHECKSUM) || g_game.hasGameFeature(GAME_FEATURE_PROTOCOLSEQUENCE));
 	bool xteaFeature = g_game.hasGameFeature(GAME_FEATURE_XTEA);
 	bool rsa1024Feature = g_game.hasGameFeature(GAME_FEATURE_RSA1024);
@@ -6140,6 +6192,9 @@ void ProtocolGame::sendLogin(Uint32 challengeTimestamp, Uint8 challengeRandom)
 
 void ProtocolGame::sendSecondaryLogin()
 {
+	if(!g_connection || g_connection->isReplaying())
+		return;
+
 	OutputMessage msg(getHeaderPos());
 	msg.addU8(GameSecondaryLoginOpcode);
 
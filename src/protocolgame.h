@@ -690,6 +690,37 @@ enum GameOpcodes : Uint8
 	{0xFE, "protobuf.protocol.GameserverMessageStoreSuccess"},							base+4AC3A0
 */
 
+#ifdef __PARSE_PROFILER__
+struct ParseOpcodeStats
+{
+	Uint64 totalTicks = 0;
+	Uint64 maxTicks = 0;
+	Uint64 bytes = 0;
+	Uint32 count = 0;
+};
+
+class ParseProfilerScope
+{
+	public:
+		ParseProfilerScope(InputMessage& msg, Uint8 header, Uint32 startPos) : m_msg(msg), m_startTicks(SDL_GetPerformanceCounter()), m_startPos(startPos), m_header(header) {}
+		~ParseProfilerScope();
+
+		// non-copyable
+		ParseProfilerScope(const ParseProfilerScope&) = delete;
+		ParseProfilerScope& operator=(const ParseProfilerScope&) = delete;
+
+		// non-moveable
+		ParseProfilerScope(ParseProfilerScope&&) = delete;
+		ParseProfilerScope& operator=(ParseProfilerScope&&) = delete;
+
+	private:
+		InputMessage& m_msg;
+		Uint64 m_startTicks;
+		Uint32 m_startPos;
+		Uint8 m_header;
+};
+#endif
+
 class Thing;
 class Creature;
 class Item;
@@ -718,6 +749,12 @@ class ProtocolGame : public Protocol
 		virtual void onConnectionError(ConnectionError error);
 		virtual void onDisconnect();
 
+		#ifdef __PARSE_PROFILER__
+		static ParseOpcodeStats parseStats[256];
+		static void resetParseStats();
+		static bool dumpParseStats(const char* fileName);
+		#endif
+
 		//Main Functions
 		void sendServerName(const std::string& serverName);
 		void sendLogin(Uint32 challengeTimestamp, Uint8 challengeRandom);
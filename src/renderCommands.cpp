@@ -0,0 +1,372 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "renderCommands.h"
+#include "engine.h"
+#include "light.h"
+#include "effect.h"
+#include "distanceEffect.h"
+
+extern Engine g_engine;
+extern LightSystem g_light;
+
+static thread_local RenderCommandList* currentRenderCommands = NULL;
+
+void RenderCommandList::setCurrent(RenderCommandList* commands)
+{
+	currentRenderCommands = commands;
+}
+
+RenderCommandList* RenderCommandList::getCurrent()
+{
+	return currentRenderCommands;
+}
+
+void RenderCommandList::beginRecording()
+{
+	m_commands.clear();
+	m_lights.clear();
+	m_queuedEffects.clear();
+	m_text.clear();
+	m_tint = RENDER_TINT_NONE;
+	m_layer = 0;
+	m_blend = RENDER_BLEND_NORMAL;
+	m_recording = true;
+}
+
+void RenderCommandList::endRecording()
+{
+	m_recording = false;
+}
+
+void RenderCommandList::submit(Surface* surface)
+{
+	//The recorded list stays intact so the same frame can be submitted again
+	surface->drawCommands(*this);
+}
+
+void RenderCommandList::append(const RenderCommandList& commands)
+{
+	size_t first = m_commands.size();
+	Sint32 textOffset = SDL_static_cast(Sint32, m_text.length());
+	m_commands.insert(m_commands.end(), commands.m_commands.begin(), commands.m_commands.end());
+	if(commands.m_text.empty())
+		return;
+
+	m_text.append(commands.m_text);
+	for(std::vector<RenderCommand>::iterator it = m_commands.begin() + first, end = m_commands.end(); it != end; ++it)
+	{
+		RenderCommand& command = (*it);
+		if(command.type == RENDER_COMMAND_FONT)
+			command.sx += textOffset;
+	}
+}
+
+void RenderCommandList::flush()
+{
+	//Draws that can't be recorded go straight to the backend so what we have so far has to go first
+	if(!m_recording || m_commands.empty())
+		return;
+
+	g_engine.getRender()->drawCommands(*this);
+	m_commands.clear();
+	m_text.clear();
+}
+
+void RenderCommandList::drawCommand(Surface* surface, const RenderCommand& command)
+{
+	switch(command.type)
+	{
+		case RENDER_COMMAND_SPRITE: surface->drawSprite(command.spriteId, command.x, command.y); break;
+		case RENDER_COMMAND_SPRITE_PART: surface->drawSprite(command.spriteId, command.x, command.y, command.w, command.h, command.sx, command.sy, command.sw, command.sh); break;
+		case RENDER_COMMAND_SPRITE_MASK: surface->drawSpriteMask(command.spriteId, command.maskSpriteId, command.x, command.y, command.color); break;
+		case RENDER_COMMAND_SPRITE_MASK_PART: surface->drawSpriteMask(command.spriteId, command.maskSpriteId, command.x, command.y, command.w, command.h, command.sx, command.sy, command.sw, command.sh, command.color); break;
+		case RENDER_COMMAND_RECTANGLE: surface->drawRectangle(command.x, command.y, command.w, command.h, command.sx, SDL_static_cast(Uint8, command.color), SDL_static_cast(Uint8, command.color >> 8), SDL_static_cast(Uint8, command.color >> 16), SDL_static_cast(Uint8, command.color >> 24)); break;
+		case RENDER_COMMAND_FILL_RECTANGLE: surface->fillRectangle(command.x, command.y, command.w, command.h, SDL_static_cast(Uint8, command.color), SDL_static_cast(Uint8, command.color >> 8), SDL_static_cast(Uint8, command.color >> 16), SDL_static_cast(Uint8, command.color >> 24)); break;
+		case RENDER_COMMAND_PICTURE: surface->drawPicture(SDL_static_cast(Uint16, command.spriteId), command.sx, command.sy, command.x, command.y, command.w, command.h); break;
+		case RENDER_COMMAND_PICTURE_REPEAT: surface->drawPictureRepeat(SDL_static_cast(Uint16, command.spriteId), command.sx, command.sy, command.sw, command.sh, command.x, command.y, command.w, command.h); break;
+		case RENDER_COMMAND_BACKGROUND: surface->drawBackground(SDL_static_cast(Uint16, command.spriteId), command.sx, command.sy, command.sw, command.sh, command.x, command.y, command.w, command.h); break;
+		case RENDER_COMMAND_FONT:
+		{
+			//The text lives in the list, sx and sw are its offset and length
+			Uint8 fontId = SDL_static_cast(Uint8, command.maskSpriteId);
+			surface->drawFont(SDL_static_cast(Uint16, command.spriteId), command.x, command.y, m_text, SDL_static_cast(size_t, command.sx), SDL_static_cast(size_t, command.sx + command.sw),
+				SDL_static_cast(Uint8, command.tint), SDL_static_cast(Uint8, command.tint >> 8), SDL_static_cast(Uint8, command.tint >> 16),
+				g_engine.getFontCharX(fontId), g_engine.getFontCharY(fontId), g_engine.getFontCharW(fontId), g_engine.getFontCharH(fontId));
+		}
+		break;
+		case RENDER_COMMAND_CLIP_RECT: surface->setClipRect(command.x, command.y, command.w, command.h); break;
+		case RENDER_COMMAND_DISABLE_CLIP_RECT: surface->disableClipRect(); break;
+		case RENDER_COMMAND_GAME_SCENE: surface->drawGameScene(command.sx, command.sy, command.sw, command.sh, command.x, command.y, command.w, command.h); break;
+		case RENDER_COMMAND_BEGIN_STATIC_LAYER: surface->beginStaticLayer(command.layer); break;
+		case RENDER_COMMAND_END_STATIC_LAYER: surface->endStaticLayer(); break;
+		case RENDER_COMMAND_STATIC_LAYER: surface->drawStaticLayer(command.layer, command.sx, command.sy, command.x, command.y); break;
+	}
+}
+
+void RenderCommandList::addLightSource(Sint32 x, Sint32 y, Uint16 light[2])
+{
+	if(!m_recording)
+	{
+		g_light.addLightSource(x, y, light);
+		return;
+	}
+
+	m_lights.push_back(RenderLight{x, y, {light[0], light[1]}});
+}
+
+void RenderCommandList::queueEffect(Effect* effect)
+{
+	m_queuedEffects.push_back(effect);
+}
+
+void RenderCommandList::retireEffect(Effect* effect)
+{
+	if(!m_recording)
+	{
+		delete effect;
+		return;
+	}
+
+	m_retiredEffects.push_back(effect);
+}
+
+void RenderCommandList::retireDistanceEffect(DistanceEffect* distanceEffect)
+{
+	if(!m_recording)
+	{
+		delete distanceEffect;
+		return;
+	}
+
+	m_retiredDistanceEffects.push_back(distanceEffect);
+}
+
+void RenderCommandList::flushScene()
+{
+	//Apply what the recording job gathered, must be called from the main thread in painter's order
+	for(std::vector<RenderLight>::iterator it = m_lights.begin(), end = m_lights.end(); it != end; ++it)
+		g_light.addLightSource((*it).x, (*it).y, (*it).light);
+
+	for(std::vector<Effect*>::iterator it = m_retiredEffects.begin(), end = m_retiredEffects.end(); it != end; ++it)
+		delete (*it);
+
+	for(std::vector<DistanceEffect*>::iterator it = m_retiredDistanceEffects.begin(), end = m_retiredDistanceEffects.end(); it != end; ++it)
+		delete (*it);
+
+	m_lights.clear();
+	m_retiredEffects.clear();
+	m_retiredDistanceEffects.clear();
+}
+
+void RenderCommandList::setClipRect(Sint32 x, Sint32 y, Sint32 w, Sint32 h)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->setClipRect(x, y, w, h);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{0, 0, 0, m_tint, x, y, w, h, 0, 0, 0, 0, RENDER_COMMAND_CLIP_RECT, m_layer, m_blend});
+}
+
+void RenderCommandList::disableClipRect()
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->disableClipRect();
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{0, 0, 0, m_tint, 0, 0, 0, 0, 0, 0, 0, 0, RENDER_COMMAND_DISABLE_CLIP_RECT, m_layer, m_blend});
+}
+
+void RenderCommandList::drawGameScene(Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawGameScene(sx, sy, sw, sh, x, y, w, h);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{0, 0, 0, m_tint, x, y, w, h, sx, sy, sw, sh, RENDER_COMMAND_GAME_SCENE, m_layer, m_blend});
+}
+
+void RenderCommandList::beginStaticLayer()
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->beginStaticLayer(m_layer);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{0, 0, 0, m_tint, 0, 0, 0, 0, 0, 0, 0, 0, RENDER_COMMAND_BEGIN_STATIC_LAYER, m_layer, m_blend});
+}
+
+void RenderCommandList::endStaticLayer()
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->endStaticLayer();
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{0, 0, 0, m_tint, 0, 0, 0, 0, 0, 0, 0, 0, RENDER_COMMAND_END_STATIC_LAYER, m_layer, m_blend});
+}
+
+void RenderCommandList::drawStaticLayer(Sint32 sx, Sint32 sy, Sint32 x, Sint32 y)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawStaticLayer(m_layer, sx, sy, x, y);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{0, 0, 0, m_tint, x, y, 0, 0, sx, sy, 0, 0, RENDER_COMMAND_STATIC_LAYER, m_layer, m_blend});
+}
+
+void RenderCommandList::drawFont(Uint8 fontId, Sint32 x, Sint32 y, const std::string& text, size_t pos, size_t len, Uint8 r, Uint8 g, Uint8 b)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawFont(g_engine.getFontPicture(fontId), x, y, text, pos, len, r, g, b, g_engine.getFontCharX(fontId), g_engine.getFontCharY(fontId), g_engine.getFontCharW(fontId), g_engine.getFontCharH(fontId));
+		return;
+	}
+
+	//Like the backends len is where the text ends, not how long it is
+	if(len <= pos)
+		return;
+
+	Sint32 textOffset = SDL_static_cast(Sint32, m_text.length());
+	m_text.append(text, pos, len - pos);
+
+	Uint32 color = (SDL_static_cast(Uint32, r) | (SDL_static_cast(Uint32, g) << 8) | (SDL_static_cast(Uint32, b) << 16) | 0xFF000000);
+	m_commands.push_back(RenderCommand{g_engine.getFontPicture(fontId), fontId, 0, color, x, y, 0, 0, textOffset, 0, SDL_static_cast(Sint32, len - pos), 0, RENDER_COMMAND_FONT, m_layer, m_blend});
+}
+
+void RenderCommandList::drawBackground(Uint16 pictureId, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawBackground(pictureId, sx, sy, sw, sh, x, y, w, h);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{pictureId, 0, 0, m_tint, x, y, w, h, sx, sy, sw, sh, RENDER_COMMAND_BACKGROUND, m_layer, m_blend});
+}
+
+void RenderCommandList::drawPictureRepeat(Uint16 pictureId, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawPictureRepeat(pictureId, sx, sy, sw, sh, x, y, w, h);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{pictureId, 0, 0, m_tint, x, y, w, h, sx, sy, sw, sh, RENDER_COMMAND_PICTURE_REPEAT, m_layer, m_blend});
+}
+
+void RenderCommandList::drawPicture(Uint16 pictureId, Sint32 sx, Sint32 sy, Sint32 x, Sint32 y, Sint32 w, Sint32 h)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawPicture(pictureId, sx, sy, x, y, w, h);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{pictureId, 0, 0, m_tint, x, y, w, h, sx, sy, w, h, RENDER_COMMAND_PICTURE, m_layer, m_blend});
+}
+
+void RenderCommandList::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawSprite(spriteId, x, y);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{spriteId, 0, 0, m_tint, x, y, 32, 32, 0, 0, 32, 32, RENDER_COMMAND_SPRITE, m_layer, m_blend});
+}
+
+void RenderCommandList::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawSprite(spriteId, x, y, w, h, sx, sy, sw, sh);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{spriteId, 0, 0, m_tint, x, y, w, h, sx, sy, sw, sh, RENDER_COMMAND_SPRITE_PART, m_layer, m_blend});
+}
+
+void RenderCommandList::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Uint32 outfitColor)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawSpriteMask(spriteId, maskSpriteId, x, y, outfitColor);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{spriteId, maskSpriteId, outfitColor, m_tint, x, y, 32, 32, 0, 0, 32, 32, RENDER_COMMAND_SPRITE_MASK, m_layer, m_blend});
+}
+
+void RenderCommandList::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawSpriteMask(spriteId, maskSpriteId, x, y, w, h, sx, sy, sw, sh, outfitColor);
+		return;
+	}
+
+	m_commands.push_back(RenderCommand{spriteId, maskSpriteId, outfitColor, m_tint, x, y, w, h, sx, sy, sw, sh, RENDER_COMMAND_SPRITE_MASK_PART, m_layer, m_blend});
+}
+
+void RenderCommandList::drawRectangle(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 lineWidth, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->drawRectangle(x, y, w, h, lineWidth, r, g, b, a);
+		return;
+	}
+
+	Uint32 color = (SDL_static_cast(Uint32, r) | (SDL_static_cast(Uint32, g) << 8) | (SDL_static_cast(Uint32, b) << 16) | (SDL_static_cast(Uint32, a) << 24));
+	m_commands.push_back(RenderCommand{0, 0, color, m_tint, x, y, w, h, lineWidth, 0, 0, 0, RENDER_COMMAND_RECTANGLE, m_layer, m_blend});
+}
+
+void RenderCommandList::fillRectangle(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	if(!m_recording)
+	{
+		g_engine.getRender()->fillRectangle(x, y, w, h, r, g, b, a);
+		return;
+	}
+
+	Uint32 color = (SDL_static_cast(Uint32, r) | (SDL_static_cast(Uint32, g) << 8) | (SDL_static_cast(Uint32, b) << 16) | (SDL_static_cast(Uint32, a) << 24));
+	m_commands.push_back(RenderCommand{0, 0, color, m_tint, x, y, w, h, 0, 0, 0, 0, RENDER_COMMAND_FILL_RECTANGLE, m_layer, m_blend});
+}
+
+void Surface::drawCommands(RenderCommandList& commands)
+{
+	//Backends without a batched path replay the list draw by draw, tint and blend don't apply there
+	std::vector<RenderCommand>& list = commands.getCommands();
+	for(std::vector<RenderCommand>::iterator it = list.begin(), end = list.end(); it != end; ++it)
+		commands.drawCommand(this, (*it));
+}
@@ -0,0 +1,170 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __FILE_RENDERCOMMANDS_h_
+#define __FILE_RENDERCOMMANDS_h_
+
+#include "defines.h"
+
+#define RENDER_TINT_NONE 0xFFFFFFFF
+#define RENDER_LAYER_INTERFACE 0xFF
+
+//Static layer cells are addressed by floor and by the storage slot of the map window
+#define RENDER_STATIC_CELL(z, y, x) ((((z) * GAME_MAP_HEIGHT) + (y)) * GAME_MAP_WIDTH + (x))
+
+enum RenderCommandType : Uint8
+{
+	RENDER_COMMAND_SPRITE,
+	RENDER_COMMAND_SPRITE_PART,
+	RENDER_COMMAND_SPRITE_MASK,
+	RENDER_COMMAND_SPRITE_MASK_PART,
+	RENDER_COMMAND_RECTANGLE,
+	RENDER_COMMAND_FILL_RECTANGLE,
+	RENDER_COMMAND_PICTURE,
+	RENDER_COMMAND_PICTURE_REPEAT,
+	RENDER_COMMAND_BACKGROUND,
+	RENDER_COMMAND_FONT,
+	RENDER_COMMAND_CLIP_RECT,
+	RENDER_COMMAND_DISABLE_CLIP_RECT,
+	RENDER_COMMAND_GAME_SCENE,
+	RENDER_COMMAND_BEGIN_STATIC_LAYER,
+	RENDER_COMMAND_END_STATIC_LAYER,
+	RENDER_COMMAND_STATIC_LAYER
+};
+
+enum RenderBlendMode : Uint8
+{
+	RENDER_BLEND_NORMAL,
+	RENDER_BLEND_ADDITIVE,
+	RENDER_BLEND_MODULATE,
+	RENDER_BLEND_REPLACE
+};
+
+//Colors are packed as r | g << 8 | b << 16 | a << 24, fonts carry their text color in the tint
+//The layer tells which floor a scene command comes from, the interface uses RENDER_LAYER_INTERFACE
+struct RenderCommand
+{
+	Uint32 spriteId;
+	Uint32 maskSpriteId;
+	Uint32 color;
+	Uint32 tint;
+	Sint32 x;
+	Sint32 y;
+	Sint32 w;
+	Sint32 h;
+	Sint32 sx;
+	Sint32 sy;
+	Sint32 sw;
+	Sint32 sh;
+	RenderCommandType type;
+	Uint8 layer;
+	RenderBlendMode blend;
+};
+
+struct RenderLight
+{
+	Sint32 x;
+	Sint32 y;
+	Uint16 light[2];
+};
+
+class Surface;
+class Effect;
+class DistanceEffect;
+class RenderCommandList
+{
+	public:
+		RenderCommandList() = default;
+
+		// non-copyable
+		RenderCommandList(const RenderCommandList&) = delete;
+		RenderCommandList& operator=(const RenderCommandList&) = delete;
+
+		// non-moveable
+		RenderCommandList(RenderCommandList&&) = delete;
+		RenderCommandList& operator=(RenderCommandList&&) = delete;
+
+		//While recording the draws are stored, otherwise they go straight to the current backend
+		void beginRecording();
+		void endRecording();
+		void submit(Surface* surface);
+		void append(const RenderCommandList& commands);
+		void flush();
+
+		//Replays one command through the plain Surface interface
+		void drawCommand(Surface* surface, const RenderCommand& command);
+
+		//Scene state gathered while recording so that recording jobs never touch shared systems
+		void addLightSource(Sint32 x, Sint32 y, Uint16 light[2]);
+		void queueEffect(Effect* effect);
+		void retireEffect(Effect* effect);
+		void retireDistanceEffect(DistanceEffect* distanceEffect);
+		void flushScene();
+
+		SDL_INLINE std::vector<RenderCommand>& getCommands() {return m_commands;}
+		SDL_INLINE std::vector<Effect*>& getQueuedEffects() {return m_queuedEffects;}
+		SDL_INLINE bool isRecording() {return m_recording;}
+		SDL_INLINE Uint32 getCommandCount() {return SDL_static_cast(Uint32, m_commands.size());}
+
+		//State applied to the commands recorded after it, beginRecording resets it
+		SDL_INLINE void setTint(Uint32 tint) {m_tint = tint;}
+		SDL_INLINE void setLayer(Uint8 layer) {m_layer = layer;}
+		SDL_INLINE void setBlend(RenderBlendMode blend) {m_blend = blend;}
+
+		//Every thread records into its own list, the draws go to the engine list when none is set
+		static void setCurrent(RenderCommandList* commands);
+		static RenderCommandList* getCurrent();
+
+		void setClipRect(Sint32 x, Sint32 y, Sint32 w, Sint32 h);
+		void disableClipRect();
+		void drawGameScene(Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h);
+
+		//The static layer of the current layer floor, sx/sy is the origin of the toroidal window
+		void beginStaticLayer();
+		void endStaticLayer();
+		void drawStaticLayer(Sint32 sx, Sint32 sy, Sint32 x, Sint32 y);
+
+		void drawFont(Uint8 fontId, Sint32 x, Sint32 y, const std::string& text, size_t pos, size_t len, Uint8 r, Uint8 g, Uint8 b);
+		void drawBackground(Uint16 pictureId, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h);
+		void drawPictureRepeat(Uint16 pictureId, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h);
+		void drawPicture(Uint16 pictureId, Sint32 sx, Sint32 sy, Sint32 x, Sint32 y, Sint32 w, Sint32 h);
+
+		void drawSprite(Uint32 spriteId, Sint32 x, Sint32 y);
+		void drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh);
+		void drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Uint32 outfitColor);
+		void drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor);
+		void drawRectangle(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 lineWidth, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+		void fillRectangle(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+	protected:
+		std::vector<RenderCommand> m_commands;
+		std::vector<RenderLight> m_lights;
+		std::vector<Effect*> m_queuedEffects;
+		std::vector<Effect*> m_retiredEffects;
+		std::vector<DistanceEffect*> m_retiredDistanceEffects;
+		std::string m_text;
+		Uint32 m_tint = RENDER_TINT_NONE;
+		Uint8 m_layer = 0;
+		RenderBlendMode m_blend = RENDER_BLEND_NORMAL;
+		bool m_recording = false;
+};
+
+#endif /* __FILE_RENDERCOMMANDS_h_ */
@@ -20,29 +20,31 @@
 */
 
 #include "softwareDrawning.h"
+#include "jobSystem.h"
 
 static const float inv255f = (1.0f / 255.0f);
 
 LPSDL_DrawTriangle_MOD SDL_DrawTriangle_MOD;
-LPSDL_SmoothStretch SDL_SmoothStretch;
+LPSDL_SmoothStretchRows SDL_SmoothStretchRows;
+LPSDL_BlendSprite SDL_BlendSprite;
+LPSDL_BlendSpriteTinted SDL_BlendSpriteTinted;
+LPSDL_BlendFill SDL_BlendFill;
+LPSDL_ModFill SDL_ModFill;
 
-struct SOFTWARE_threadData {
-	SDL_Thread* thread;
-	SDL_mutex* drawMutex;
-	SDL_cond* drawCond;
-	SDL_cond* waitCond;
+#define SOFTWARE_MAX_JOBS 128
+#define SOFTWARE_JOBS_PER_THREAD 4
+
+struct SOFTWARE_jobData {
 	SDL_Surface* src;
-	SDL_Surface* dst;
+	void* dst;
 	SDL_Rect sr;
 	SDL_Rect dr;
-	bool waiting;
-	bool drawning;
-	bool exiting;
-	Uint8 lightning;
+	Sint32 startRow;
+	Sint32 endRow;
 };
 
-SOFTWARE_threadData threadDatas[4];
-Sint32 threadCores = 1;
+SOFTWARE_jobData jobDatas[SOFTWARE_MAX_JOBS];
+extern JobSystem g_jobSystem;
 
 typedef struct tColorRGBA {
 	Uint8 r;
@@ -651,198 +653,467 @@ void DrawTriangle_Scalar(SDL_Surface* dst, const float colors[3][3], Sint32 vert
 	DrawSpansBetweenEdges_Scalar(dst, &clip_rect, edges[longEdge], edges[shortEdge2]);
 }
 
-Sint32 SDL_FillRect_BLEND(SDL_Surface* dst, SDL_Rect* dstrect, Uint32 RGBA, Uint32 A)
+static bool SOFTWARE_clipFillRect(SDL_Surface* dst, SDL_Rect* dstrect, SDL_Rect& rect)
 {
+	SDL_Rect clip_rect;
+	SDL_GetClipRect(dst, &clip_rect);
 	if(!dstrect)
 	{
-		SDL_Rect dstr = {0,0,dst->w,dst->h};
-		dstrect = &dstr;
+		rect = clip_rect;
+		return (rect.w > 0 && rect.h > 0);
 	}
-	else
+
+	rect = *dstrect;
+	Sint32 dx, dy;
+	dx = clip_rect.x - rect.x;
+	if(dx > 0)
 	{
-		SDL_Rect clip_rect;
-		SDL_GetClipRect(dst, &clip_rect);
+		rect.w -= dx;
+		rect.x += dx;
+	}
 
-		Sint32 dx, dy;
-		dx = clip_rect.x - dstrect->x;
-		if(dx > 0)
-		{
-			dstrect->w -= dx;
-			dstrect->x += dx;
-		}
+	dx = rect.x + rect.w - clip_rect.x - clip_rect.w;
+	if(dx > 0)
+		rect.w -= dx;
+
+	dy = clip_rect.y - rect.y;
+	if(dy > 0)
+	{
+		rect.h -= dy;
+		rect.y += dy;
+	}
 
-		dx = dstrect->x + dstrect->w - clip_rect.x - clip_rect.w;
-		if(dx > 0)
-			dstrect->w -= dx;
+	dy = rect.y + rect.h - clip_rect.y - clip_rect.h;
+	if(dy > 0)
+		rect.h -= dy;
 
-		dy = clip_rect.y - dstrect->y;
-		if(dy > 0)
-		{
-			dstrect->h -= dy;
-			dstrect->y += dy;
-		}
+	return (rect.w > 0 && rect.h > 0);
+}
+
+//All the blending kernels scale alpha to 0-256 so the division by 255 turns into a shift
+SDL_FORCE_INLINE Uint32 LerpPixel_Scalar(Uint32 s, Uint32 d, Uint32 a)
+{
+	Uint32 ia = 256 - a;
+	Uint32 rb = ((((s & 0x00FF00FF) * a) + ((d & 0x00FF00FF) * ia)) >> 8) & 0x00FF00FF;
+	Uint32 ag = ((((s >> 8) & 0x00FF00FF) * a) + (((d >> 8) & 0x00FF00FF) * ia)) & 0xFF00FF00;
+	return rb | ag;
+}
+
+SDL_FORCE_INLINE Uint32 ModulatePixel_Scalar(Uint32 s, Uint32 color, Uint32 bias)
+{
+	Uint32 c0 = ((((s & 0xFF) * (color & 0xFF)) + bias) >> 8);
+	Uint32 c1 = (((((s >> 8) & 0xFF) * ((color >> 8) & 0xFF)) + bias) >> 8);
+	Uint32 c2 = (((((s >> 16) & 0xFF) * ((color >> 16) & 0xFF)) + bias) >> 8);
+	Uint32 c3 = ((((s >> 24) * (color >> 24)) + bias) >> 8);
+	return c0 | (c1 << 8) | (c2 << 16) | (c3 << 24);
+}
+
+SDL_FORCE_INLINE Uint32 BlendPremultiplied_Scalar(Uint32 s, Uint32 d, Uint32 ashift)
+{
+	Uint32 a = ((s >> ashift) & 0xFF);
+	if(a == 255)
+		return s;
+	else if(a == 0)
+		return d;
+
+	//Premultiplied source can't overflow the channels so we only need to scale the destination
+	a = 256 - (a + (a >> 7));
+	return s + (((((d & 0x00FF00FF) * a) >> 8) & 0x00FF00FF) | ((((d >> 8) & 0x00FF00FF) * a) & 0xFF00FF00));
+}
+
+SDL_FORCE_INLINE Uint32 BlendTinted_Scalar(Uint32 s, Uint32 d, Uint32 color, Uint32 ashift)
+{
+	Uint32 a = ((s >> ashift) & 0xFF);
+	if(a == 0)
+		return d;
+
+	s = ModulatePixel_Scalar(s, color, 255) | (0xFF << ashift);
+	return LerpPixel_Scalar(s, d, a + (a >> 7));
+}
+
+void SOFTWARE_premultiplyAlpha(Uint32* pixels, Sint32 count, Uint32 ashift)
+{
+	Uint32 amask = (0xFF << ashift);
+	for(Sint32 i = 0; i < count; ++i)
+	{
+		Uint32 s = pixels[i];
+		Uint32 a = ((s >> ashift) & 0xFF);
+		if(a == 255)
+			continue;
+
+		//Alpha gets multiplied by 255 which keeps it as it is
+		pixels[i] = ModulatePixel_Scalar(s, (a * 0x01010101) | amask, 255);
+	}
+}
 
-		dy = dstrect->y + dstrect->h - clip_rect.y - clip_rect.h;
-		if(dy > 0)
-			dstrect->h -= dy;
+void SDL_BlendSprite_scalar(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 ashift)
+{
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		for(Sint32 x = 0; x < w; ++x)
+			dst[x] = BlendPremultiplied_Scalar(src[x], dst[x], ashift);
 
-		if(dstrect->w <= 0 || dstrect->h <= 0)
-			return 0;
+		dst += dstPitch;
+		src += srcPitch;
 	}
+}
 
-	SDL_PixelFormat* dpf = dst->format;
-	Uint32* dp = SDL_reinterpret_cast(Uint32*, SDL_reinterpret_cast(Uint8*, dst->pixels) + (dstrect->y * dst->w + dstrect->x) * 4);
-	Sint32 dgap = (dst->pitch / 4) - dstrect->w;
+void SDL_BlendSpriteTinted_scalar(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 ashift)
+{
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		for(Sint32 x = 0; x < w; ++x)
+			dst[x] = BlendTinted_Scalar(src[x], dst[x], color, ashift);
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
 
-	Sint32 xEnd = dstrect->w, yEnd = dstrect->h;
-	if((dpf->Rmask|dpf->Gmask|dpf->Bmask) == 0x00FFFFFF)//We can go faster patch
+void SDL_BlendFill_scalar(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 A, Uint32 amask)
+{
+	for(Sint32 y = 0; y < h; ++y)
 	{
-		if(A == 128)//Greatly optimized 50% semi-transparency
+		for(Sint32 x = 0; x < w; ++x)
+			dst[x] = LerpPixel_Scalar(color, dst[x], A) | amask;
+
+		dst += dstPitch;
+	}
+}
+
+void SDL_ModFill_scalar(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 amask)
+{
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		for(Sint32 x = 0; x < w; ++x)
+			dst[x] = ModulatePixel_Scalar(dst[x], color, 0) | amask;
+
+		dst += dstPitch;
+	}
+}
+
+#ifdef __USE_SSE2__
+void SDL_BlendSprite_SSE2(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 ashift)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	const __m128i scale = _mm_set1_epi32(256);
+	const __m128i shift = _mm_cvtsi32_si128(SDL_static_cast(int, ashift));
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		Sint32 x = 0;
+		for(; x + 4 <= w; x += 4)
 		{
-			for(Sint32 y = 0; y < yEnd; ++y)
+			__m128i s = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, src + x));
+			__m128i a = _mm_and_si128(_mm_srl_epi32(s, shift), byteMask);
+
+			//Most of the sprite pixels are either fully transparent or fully opaque
+			Sint32 transparent = _mm_movemask_epi8(_mm_cmpeq_epi32(a, zero));
+			if(transparent == 0xFFFF)
+				continue;
+			else if(transparent == 0 && _mm_movemask_epi8(_mm_cmpeq_epi32(a, byteMask)) == 0xFFFF)
 			{
-				for(Sint32 x = 0; x < xEnd; ++x)
-				{
-					Uint32 d = *dp;
-					*dp++ = (((RGBA & 0x00fefefe) + (d & 0x00fefefe)) >> 1) + (RGBA & d & 0x00010101);
-				}
-				dp += dgap;
+				_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst + x), s);
+				continue;
 			}
+
+			__m128i d = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, dst + x));
+			a = _mm_sub_epi32(scale, _mm_add_epi32(a, _mm_srli_epi32(a, 7)));
+			a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+
+			__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi32(a, a)), 8);
+			__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi32(a, a)), 8);
+			_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst + x), _mm_add_epi8(s, _mm_packus_epi16(lo, hi)));
 		}
-		else
+		for(; x < w; ++x)
+			dst[x] = BlendPremultiplied_Scalar(src[x], dst[x], ashift);
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+#endif
+
+#ifdef __USE_SSE4_1__
+void SDL_BlendSprite_SSE41(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 ashift)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(SDL_static_cast(int, 0xFF << ashift));
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	const __m128i scale = _mm_set1_epi32(256);
+	const __m128i shift = _mm_cvtsi32_si128(SDL_static_cast(int, ashift));
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		Sint32 x = 0;
+		for(; x + 4 <= w; x += 4)
 		{
-			for(Sint32 y = 0; y < yEnd; ++y)
+			//_mm_testz_si128/_mm_testc_si128 - to check the alpha of all four pixels at once
+			__m128i s = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, src + x));
+			if(_mm_testz_si128(s, alphaMask))
+				continue;
+			else if(_mm_testc_si128(s, alphaMask))
 			{
-				for(Sint32 x = 0; x < xEnd; ++x)
-				{
-					Uint32 s = RGBA;
-					Uint32 d = *dp;
-					Uint32 s1 = s & 0xff00ff;
-					Uint32 d1 = d & 0xff00ff;
-					d1 = (d1 + ((s1 - d1) * A >> 8)) & 0xff00ff;
-					s &= 0xff00;
-					d &= 0xff00;
-					d = (d + ((s - d) * A >> 8)) & 0xff00;
-					*dp++ = d1 | d;
-				}
-				dp += dgap;
+				_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst + x), s);
+				continue;
 			}
+
+			__m128i d = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, dst + x));
+			__m128i a = _mm_and_si128(_mm_srl_epi32(s, shift), byteMask);
+			a = _mm_sub_epi32(scale, _mm_add_epi32(a, _mm_srli_epi32(a, 7)));
+			a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+
+			__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(d), _mm_unpacklo_epi32(a, a)), 8);
+			__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi32(a, a)), 8);
+			_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst + x), _mm_add_epi8(s, _mm_packus_epi16(lo, hi)));
 		}
+		for(; x < w; ++x)
+			dst[x] = BlendPremultiplied_Scalar(src[x], dst[x], ashift);
+
+		dst += dstPitch;
+		src += srcPitch;
 	}
-	else
-	{
-		if(dpf->Amask)
+}
+
+void SDL_BlendSpriteTinted_SSE41(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 ashift)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(SDL_static_cast(int, 0xFF << ashift));
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	const __m128i scale = _mm_set1_epi16(256);
+	const __m128i bias = _mm_set1_epi16(255);
+	const __m128i tint = _mm_cvtepu8_epi16(_mm_set1_epi32(SDL_static_cast(int, color)));
+	const __m128i shift = _mm_cvtsi32_si128(SDL_static_cast(int, ashift));
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		Sint32 x = 0;
+		for(; x + 4 <= w; x += 4)
 		{
-			for(Sint32 y = 0; y < yEnd; ++y)
-			{
-				for(Sint32 x = 0; x < xEnd; ++x)
-				{
-					Uint32 dstR = ((*dp >> dpf->Rshift) & 0xFF);
-					Uint32 dstG = ((*dp >> dpf->Gshift) & 0xFF);
-					Uint32 dstB = ((*dp >> dpf->Bshift) & 0xFF);
-					dstR += (((RGBA >> dpf->Rshift) & 0xFF) - dstR) * A >> 8;
-					dstG += (((RGBA >> dpf->Gshift) & 0xFF) - dstG) * A >> 8;
-					dstB += (((RGBA >> dpf->Bshift) & 0xFF) - dstB) * A >> 8;
-					*dp++ = (dstR << dpf->Rshift) | (dstG << dpf->Gshift) | (dstB << dpf->Bshift) | (0xFF << dpf->Ashift);
-				}
-				dp += dgap;
-			}
+			__m128i s = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, src + x));
+			if(_mm_testz_si128(s, alphaMask))
+				continue;
+
+			__m128i d = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, dst + x));
+			__m128i a = _mm_and_si128(_mm_srl_epi32(s, shift), byteMask);
+			a = _mm_add_epi32(a, _mm_srli_epi32(a, 7));
+			a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+
+			__m128i alo = _mm_unpacklo_epi32(a, a);
+			__m128i ahi = _mm_unpackhi_epi32(a, a);
+			__m128i slo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(s), tint), bias), 8);
+			__m128i shi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), tint), bias), 8);
+			s = _mm_or_si128(_mm_packus_epi16(slo, shi), alphaMask);
+
+			__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(s), alo), _mm_mullo_epi16(_mm_cvtepu8_epi16(d), _mm_sub_epi16(scale, alo)));
+			__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), ahi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(scale, ahi)));
+			_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst + x), _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
 		}
-		else
+		for(; x < w; ++x)
+			dst[x] = BlendTinted_Scalar(src[x], dst[x], color, ashift);
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+void SDL_BlendFill_SSE41(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 A, Uint32 amask)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(SDL_static_cast(int, amask));
+	const __m128i inverse = _mm_set1_epi16(SDL_static_cast(short, 256 - A));
+	const __m128i source = _mm_mullo_epi16(_mm_cvtepu8_epi16(_mm_set1_epi32(SDL_static_cast(int, color))), _mm_set1_epi16(SDL_static_cast(short, A)));
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		Sint32 x = 0;
+		for(; x + 4 <= w; x += 4)
 		{
-			for(Sint32 y = 0; y < yEnd; ++y)
-			{
-				for(Sint32 x = 0; x < xEnd; ++x)
-				{
-					Uint32 dstR = ((*dp >> dpf->Rshift) & 0xFF);
-					Uint32 dstG = ((*dp >> dpf->Gshift) & 0xFF);
-					Uint32 dstB = ((*dp >> dpf->Bshift) & 0xFF);
-					dstR += (((RGBA >> dpf->Rshift) & 0xFF) - dstR) * A >> 8;
-					dstG += (((RGBA >> dpf->Gshift) & 0xFF) - dstG) * A >> 8;
-					dstB += (((RGBA >> dpf->Bshift) & 0xFF) - dstB) * A >> 8;
-					*dp++ = (dstR << dpf->Rshift) | (dstG << dpf->Gshift) | (dstB << dpf->Bshift);
-				}
-				dp += dgap;
-			}
+			__m128i d = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, dst + x));
+			__m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(d), inverse), source), 8);
+			__m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverse), source), 8);
+			_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst + x), _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask));
 		}
+		for(; x < w; ++x)
+			dst[x] = LerpPixel_Scalar(color, dst[x], A) | amask;
+
+		dst += dstPitch;
 	}
-	return 0;
 }
 
-Sint32 SDL_FillRect_MOD(SDL_Surface* dst, SDL_Rect* dstrect, Uint32 R, Uint32 G, Uint32 B)
+void SDL_ModFill_SSE41(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 amask)
 {
-	if((R & G & B) == 255)
-		return 0;
-	if(!dstrect)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(SDL_static_cast(int, amask));
+	const __m128i factor = _mm_cvtepu8_epi16(_mm_set1_epi32(SDL_static_cast(int, color)));
+	for(Sint32 y = 0; y < h; ++y)
 	{
-		SDL_Rect dstr = {0,0,dst->w,dst->h};
-		dstrect = &dstr;
+		Sint32 x = 0;
+		for(; x + 4 <= w; x += 4)
+		{
+			__m128i d = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, dst + x));
+			__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(d), factor), 8);
+			__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), factor), 8);
+			_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst + x), _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask));
+		}
+		for(; x < w; ++x)
+			dst[x] = ModulatePixel_Scalar(dst[x], color, 0) | amask;
+
+		dst += dstPitch;
 	}
-	else
-	{
-		SDL_Rect clip_rect;
-		SDL_GetClipRect(dst, &clip_rect);
+}
+#endif
 
-		Sint32 dx, dy;
-		dx = clip_rect.x - dstrect->x;
-		if(dx > 0)
+#ifdef __USE_AVX2__
+//The 256-bit unpacks work within 128-bit lanes, packing back restores the pixel order
+void SDL_BlendSprite_AVX2(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 ashift)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i alphaMask = _mm256_set1_epi32(SDL_static_cast(int, 0xFF << ashift));
+	const __m256i byteMask = _mm256_set1_epi32(0xFF);
+	const __m256i scale = _mm256_set1_epi32(256);
+	const __m128i shift = _mm_cvtsi32_si128(SDL_static_cast(int, ashift));
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		Sint32 x = 0;
+		for(; x + 8 <= w; x += 8)
 		{
-			dstrect->w -= dx;
-			dstrect->x += dx;
+			__m256i s = _mm256_loadu_si256(SDL_reinterpret_cast(const __m256i*, src + x));
+			if(_mm256_testz_si256(s, alphaMask))
+				continue;
+			else if(_mm256_testc_si256(s, alphaMask))
+			{
+				_mm256_storeu_si256(SDL_reinterpret_cast(__m256i*, dst + x), s);
+				continue;
+			}
+
+			__m256i d = _mm256_loadu_si256(SDL_reinterpret_cast(const __m256i*, dst + x));
+			__m256i a = _mm256_and_si256(_mm256_srl_epi32(s, shift), byteMask);
+			a = _mm256_sub_epi32(scale, _mm256_add_epi32(a, _mm256_srli_epi32(a, 7)));
+			a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+
+			__m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi32(a, a)), 8);
+			__m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi32(a, a)), 8);
+			_mm256_storeu_si256(SDL_reinterpret_cast(__m256i*, dst + x), _mm256_add_epi8(s, _mm256_packus_epi16(lo, hi)));
 		}
+		for(; x < w; ++x)
+			dst[x] = BlendPremultiplied_Scalar(src[x], dst[x], ashift);
 
-		dx = dstrect->x + dstrect->w - clip_rect.x - clip_rect.w;
-		if(dx > 0)
-			dstrect->w -= dx;
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
 
-		dy = clip_rect.y - dstrect->y;
-		if(dy > 0)
+void SDL_BlendSpriteTinted_AVX2(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 ashift)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i alphaMask = _mm256_set1_epi32(SDL_static_cast(int, 0xFF << ashift));
+	const __m256i byteMask = _mm256_set1_epi32(0xFF);
+	const __m256i scale = _mm256_set1_epi16(256);
+	const __m256i bias = _mm256_set1_epi16(255);
+	const __m256i tint = _mm256_unpacklo_epi8(_mm256_set1_epi32(SDL_static_cast(int, color)), zero);
+	const __m128i shift = _mm_cvtsi32_si128(SDL_static_cast(int, ashift));
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		Sint32 x = 0;
+		for(; x + 8 <= w; x += 8)
 		{
-			dstrect->h -= dy;
-			dstrect->y += dy;
+			__m256i s = _mm256_loadu_si256(SDL_reinterpret_cast(const __m256i*, src + x));
+			if(_mm256_testz_si256(s, alphaMask))
+				continue;
+
+			__m256i d = _mm256_loadu_si256(SDL_reinterpret_cast(const __m256i*, dst + x));
+			__m256i a = _mm256_and_si256(_mm256_srl_epi32(s, shift), byteMask);
+			a = _mm256_add_epi32(a, _mm256_srli_epi32(a, 7));
+			a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+
+			__m256i alo = _mm256_unpacklo_epi32(a, a);
+			__m256i ahi = _mm256_unpackhi_epi32(a, a);
+			__m256i slo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), tint), bias), 8);
+			__m256i shi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), tint), bias), 8);
+			s = _mm256_or_si256(_mm256_packus_epi16(slo, shi), alphaMask);
+
+			__m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), alo), _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), _mm256_sub_epi16(scale, alo)));
+			__m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), ahi), _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), _mm256_sub_epi16(scale, ahi)));
+			_mm256_storeu_si256(SDL_reinterpret_cast(__m256i*, dst + x), _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8)));
 		}
+		for(; x < w; ++x)
+			dst[x] = BlendTinted_Scalar(src[x], dst[x], color, ashift);
 
-		dy = dstrect->y + dstrect->h - clip_rect.y - clip_rect.h;
-		if(dy > 0)
-			dstrect->h -= dy;
-
-		if(dstrect->w <= 0 || dstrect->h <= 0)
-			return 0;
+		dst += dstPitch;
+		src += srcPitch;
 	}
+}
 
-	SDL_PixelFormat* dpf = dst->format;
-	Uint32* dp = SDL_reinterpret_cast(Uint32*, SDL_reinterpret_cast(Uint8*, dst->pixels) + (dstrect->y * dst->w + dstrect->x) * 4);
-	Sint32 dgap = (dst->pitch / 4) - dstrect->w;
-
-	Sint32 xEnd = dstrect->w, yEnd = dstrect->h;
-	if(dpf->Amask)
-	{
-		for(Sint32 y = 0; y < yEnd; ++y)
+void SDL_BlendFill_AVX2(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 A, Uint32 amask)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i alphaMask = _mm256_set1_epi32(SDL_static_cast(int, amask));
+	const __m256i inverse = _mm256_set1_epi16(SDL_static_cast(short, 256 - A));
+	const __m256i source = _mm256_mullo_epi16(_mm256_unpacklo_epi8(_mm256_set1_epi32(SDL_static_cast(int, color)), zero), _mm256_set1_epi16(SDL_static_cast(short, A)));
+	for(Sint32 y = 0; y < h; ++y)
+	{
+		Sint32 x = 0;
+		for(; x + 8 <= w; x += 8)
 		{
-			for(Sint32 x = 0; x < xEnd; ++x)
-			{
-				Uint32 dstR = R * ((*dp >> dpf->Rshift) & 0xFF) >> 8;
-				Uint32 dstG = G * ((*dp >> dpf->Gshift) & 0xFF) >> 8;
-				Uint32 dstB = B * ((*dp >> dpf->Bshift) & 0xFF) >> 8;
-				*dp++ = (dstR << dpf->Rshift) | (dstG << dpf->Gshift) | (dstB << dpf->Bshift) | (0xFF << dpf->Ashift);
-			}
-			dp += dgap;
+			__m256i d = _mm256_loadu_si256(SDL_reinterpret_cast(const __m256i*, dst + x));
+			__m256i lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inverse), source), 8);
+			__m256i hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inverse), source), 8);
+			_mm256_storeu_si256(SDL_reinterpret_cast(__m256i*, dst + x), _mm256_or_si256(_mm256_packus_epi16(lo, hi), alphaMask));
 		}
+		for(; x < w; ++x)
+			dst[x] = LerpPixel_Scalar(color, dst[x], A) | amask;
+
+		dst += dstPitch;
 	}
-	else
+}
+
+void SDL_ModFill_AVX2(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 amask)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i alphaMask = _mm256_set1_epi32(SDL_static_cast(int, amask));
+	const __m256i factor = _mm256_unpacklo_epi8(_mm256_set1_epi32(SDL_static_cast(int, color)), zero);
+	for(Sint32 y = 0; y < h; ++y)
 	{
-		for(Sint32 y = 0; y < yEnd; ++y)
+		Sint32 x = 0;
+		for(; x + 8 <= w; x += 8)
 		{
-			for(Sint32 x = 0; x < xEnd; ++x)
-			{
-				Uint32 dstR = R * ((*dp >> dpf->Rshift) & 0xFF) >> 8;
-				Uint32 dstG = G * ((*dp >> dpf->Gshift) & 0xFF) >> 8;
-				Uint32 dstB = B * ((*dp >> dpf->Bshift) & 0xFF) >> 8;
-				*dp++ = (dstR << dpf->Rshift) | (dstG << dpf->Gshift) | (dstB << dpf->Bshift);
-			}
-			dp += dgap;
+			__m256i d = _mm256_loadu_si256(SDL_reinterpret_cast(const __m256i*, dst + x));
+			__m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), factor), 8);
+			__m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), factor), 8);
+			_mm256_storeu_si256(SDL_reinterpret_cast(__m256i*, dst + x), _mm256_or_si256(_mm256_packus_epi16(lo, hi), alphaMask));
 		}
+		for(; x < w; ++x)
+			dst[x] = ModulatePixel_Scalar(dst[x], color, 0) | amask;
+
+		dst += dstPitch;
 	}
+}
+#endif
+
+Sint32 SDL_FillRect_BLEND(SDL_Surface* dst, SDL_Rect* dstrect, Uint32 RGBA, Uint32 A)
+{
+	SDL_Rect rect;
+	if(!SOFTWARE_clipFillRect(dst, dstrect, rect))
+		return 0;
+
+	SDL_PixelFormat* dpf = dst->format;
+	Sint32 pitch = dst->pitch / 4;
+	SDL_BlendFill(SDL_reinterpret_cast(Uint32*, dst->pixels) + (rect.y * pitch) + rect.x, pitch, rect.w, rect.h, RGBA, A, dpf->Amask);
+	return 0;
+}
+
+Sint32 SDL_FillRect_MOD(SDL_Surface* dst, SDL_Rect* dstrect, Uint32 R, Uint32 G, Uint32 B)
+{
+	if((R & G & B) == 255)
+		return 0;
+
+	SDL_Rect rect;
+	if(!SOFTWARE_clipFillRect(dst, dstrect, rect))
+		return 0;
+
+	//The alpha channel gets multiplied by zero and is then set back by the mask
+	SDL_PixelFormat* dpf = dst->format;
+	Sint32 pitch = dst->pitch / 4;
+	Uint32 color = (R << dpf->Rshift) | (G << dpf->Gshift) | (B << dpf->Bshift);
+	SDL_ModFill(SDL_reinterpret_cast(Uint32*, dst->pixels) + (rect.y * pitch) + rect.x, pitch, rect.w, rect.h, color, dpf->Amask);
 	return 0;
 }
 
@@ -854,7 +1125,7 @@ SDL_FORCE_INLINE __m128i _sym_mm_mullo_epu32(__m128i a, __m128i b)
 	return _mm_unpacklo_epi32(_mm_shuffle_epi32(dest02, 0xD8), _mm_shuffle_epi32(dest13, 0xD8));
 }
 
-Sint32 SDL_SmoothStretch_SSE2(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect)
+Sint32 SDL_SmoothStretch_SSE2(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect, Sint32 startRow, Sint32 endRow)
 {
 	if(!srcrect)
 	{
@@ -895,9 +1166,13 @@ Sint32 SDL_SmoothStretch_SSE2(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface*
 	Sint32 dgap = dst->pitch / 4;
 	Sint32 spixelgap = src->pitch / 4;
 
-	Sint32 csay = 0;
-	Sint32 xEnd = dstrect->w, yEnd = dstrect->h;
-	for(Sint32 y = 0; y < yEnd; ++y)
+	//Start at the same fixed-point position the full stretch would reach on this row
+	Sint32 csay = SDL_static_cast(Sint32, UTIL_min<Sint64>(SDL_static_cast(Sint64, sy) * startRow, ssy));
+	sp += (csay >> 16) * spixelgap;
+	dp += startRow * dgap;
+
+	Sint32 xEnd = dstrect->w, yEnd = endRow;
+	for(Sint32 y = startRow; y < yEnd; ++y)
 	{
 		Sint32* cdp = dp;
 		Uint32* csp = sp;
@@ -943,7 +1218,7 @@ Sint32 SDL_SmoothStretch_SSE2(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface*
 #endif
 
 #ifdef __USE_SSSE3__
-Sint32 SDL_SmoothStretch_SSSE3(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect)
+Sint32 SDL_SmoothStretch_SSSE3(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect, Sint32 startRow, Sint32 endRow)
 {
 	if(!srcrect)
 	{
@@ -986,9 +1261,13 @@ Sint32 SDL_SmoothStretch_SSSE3(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface*
 	Sint32 dgap = dst->pitch / 4;
 	Sint32 spixelgap = src->pitch / 4;
 
-	Sint32 csay = 0;
-	Sint32 xEnd = dstrect->w, yEnd = dstrect->h;
-	for(Sint32 y = 0; y < yEnd; ++y)
+	//Start at the same fixed-point position the full stretch would reach on this row
+	Sint32 csay = SDL_static_cast(Sint32, UTIL_min<Sint64>(SDL_static_cast(Sint64, sy) * startRow, ssy));
+	sp += (csay >> 16) * spixelgap;
+	dp += startRow * dgap;
+
+	Sint32 xEnd = dstrect->w, yEnd = endRow;
+	for(Sint32 y = startRow; y < yEnd; ++y)
 	{
 		Sint32* cdp = dp;
 		Uint32* csp = sp;
@@ -1033,7 +1312,7 @@ Sint32 SDL_SmoothStretch_SSSE3(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface*
 #endif
 
 #ifdef __USE_SSE4_1__
-Sint32 SDL_SmoothStretch_SSE41(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect)
+Sint32 SDL_SmoothStretch_SSE41(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect, Sint32 startRow, Sint32 endRow)
 {
 	if(!srcrect)
 	{
@@ -1075,9 +1354,13 @@ Sint32 SDL_SmoothStretch_SSE41(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface*
 	Sint32 dgap = dst->pitch / 4;
 	Sint32 spixelgap = src->pitch / 4;
 
-	Sint32 csay = 0;
-	Sint32 xEnd = dstrect->w, yEnd = dstrect->h;
-	for(Sint32 y = 0; y < yEnd; ++y)
+	//Start at the same fixed-point position the full stretch would reach on this row
+	Sint32 csay = SDL_static_cast(Sint32, UTIL_min<Sint64>(SDL_static_cast(Sint64, sy) * startRow, ssy));
+	sp += (csay >> 16) * spixelgap;
+	dp += startRow * dgap;
+
+	Sint32 xEnd = dstrect->w, yEnd = endRow;
+	for(Sint32 y = startRow; y < yEnd; ++y)
 	{
 		Sint32* cdp = dp;
 		Uint32* csp = sp;
@@ -1121,7 +1404,7 @@ Sint32 SDL_SmoothStretch_SSE41(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface*
 }
 #endif
 
-Sint32 SDL_SmoothStretch_scalar(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect)
+Sint32 SDL_SmoothStretch_scalar(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect, Sint32 startRow, Sint32 endRow)
 {
 	if(!srcrect)
 	{
@@ -1160,9 +1443,13 @@ Sint32 SDL_SmoothStretch_scalar(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface
 	Sint32 dgap = dst->pitch / 4;
 	Sint32 spixelgap = src->pitch / 4;
 
-	Sint32 csay = 0;
-	Sint32 xEnd = dstrect->w, yEnd = dstrect->h;
-	for(Sint32 y = 0; y < yEnd; ++y)
+	//Start at the same fixed-point position the full stretch would reach on this row
+	Sint32 csay = SDL_static_cast(Sint32, UTIL_min<Sint64>(SDL_static_cast(Sint64, sy) * startRow, ssy));
+	sp += (csay >> 16) * spixelgap;
+	dp += startRow * dgap;
+
+	Sint32 xEnd = dstrect->w, yEnd = endRow;
+	for(Sint32 y = startRow; y < yEnd; ++y)
 	{
 		tColorRGBA* cdp = dp;
 		tColorRGBA* csp = sp;
@@ -1404,164 +1691,65 @@ void SDL_DrawLightMap_new(SDL_Surface* src, LightMap* lightmap, Sint32 x, Sint32
 	}
 }
 
-static int SOFTWARE_drawthread(void* data)
+static void SOFTWARE_lightmapOldJob(void* data)
 {
-	SOFTWARE_threadData* thread = SDL_reinterpret_cast(SOFTWARE_threadData*, data);
-	SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
-	while(true)
-	{
-		SDL_LockMutex(thread->drawMutex);
-		if(!thread->drawning) SDL_CondWait(thread->drawCond, thread->drawMutex);
-		if(thread->exiting)
-		{
-			SDL_UnlockMutex(thread->drawMutex);
-			return 0;
-		}
+	SOFTWARE_jobData* job = SDL_reinterpret_cast(SOFTWARE_jobData*, data);
+	SDL_DrawLightMap_old(job->src, SDL_reinterpret_cast(LightMap*, job->dst), job->sr.x, job->sr.y, job->sr.w, job->dr.x, job->dr.w, job->dr.h);
+}
 
-		if(thread->lightning == 2)
-			SDL_DrawLightMap_new(thread->src, SDL_reinterpret_cast(LightMap*, thread->dst), thread->sr.x, thread->sr.y, thread->sr.w, thread->dr.x, thread->dr.w, thread->dr.h);
-		else if(thread->lightning == 1)
-			SDL_DrawLightMap_old(thread->src, SDL_reinterpret_cast(LightMap*, thread->dst), thread->sr.x, thread->sr.y, thread->sr.w, thread->dr.x, thread->dr.w, thread->dr.h);
-		else
-			SDL_SmoothStretch(thread->src, &thread->sr, thread->dst, &thread->dr);
+static void SOFTWARE_lightmapNewJob(void* data)
+{
+	SOFTWARE_jobData* job = SDL_reinterpret_cast(SOFTWARE_jobData*, data);
+	SDL_DrawLightMap_new(job->src, SDL_reinterpret_cast(LightMap*, job->dst), job->sr.x, job->sr.y, job->sr.w, job->dr.x, job->dr.w, job->dr.h);
+}
 
-		thread->drawning = false;
-		SDL_UnlockMutex(thread->drawMutex);
-		if(thread->waiting) SDL_CondSignal(thread->waitCond);
-	}
-	return 0;
+static void SOFTWARE_stretchJob(void* data)
+{
+	SOFTWARE_jobData* job = SDL_reinterpret_cast(SOFTWARE_jobData*, data);
+	SDL_SmoothStretchRows(job->src, &job->sr, SDL_reinterpret_cast(SDL_Surface*, job->dst), &job->dr, job->startRow, job->endRow);
+}
+
+static void SOFTWARE_drawLightMapJobs(JobFunction function, SDL_Surface* src, LightMap* lightmap, Sint32 x, Sint32 y, Sint32 scale, Sint32 width, Sint32 height)
+{
+	//Every light map row is a job of its own so the idle workers can steal them
+	JobGroup group;
+	Sint32 jobs = UTIL_min<Sint32>(height, SOFTWARE_MAX_JOBS);
+	for(Sint32 i = 0; i < jobs; ++i)
+	{
+		Sint32 start = ((height * i) / jobs) - 1;
+		Sint32 end = ((height * (i + 1)) / jobs) - 1;
+		SOFTWARE_jobData& job = jobDatas[i];
+		job.src = src;
+		job.dst = SDL_reinterpret_cast(void*, lightmap);
+		job.sr = {x, y + (start * scale), scale, scale};
+		job.dr = {width, height, start, end};
+		g_jobSystem.submit(group, function, SDL_reinterpret_cast(void*, &job));
+	}
+	g_jobSystem.wait(group);
 }
 
 void SDL_DrawLightMap_old_MT(SDL_Surface* src, LightMap* lightmap, Sint32 x, Sint32 y, Sint32 scale, Sint32 width, Sint32 height)
 {
-	if(threadCores == 1)
+	if(g_jobSystem.getThreadCount() == 1)
 		return SDL_DrawLightMap_old(src, lightmap, x, y, scale, width, 0, height - 1);
 
-	#define QUEUE_WORK(tr, start, end)									\
-		do {															\
-			thread = &threadDatas[tr];									\
-			thread->src = src;											\
-			thread->dst = SDL_reinterpret_cast(SDL_Surface*, lightmap);	\
-			thread->lightning = 1;										\
-			thread->drawning = true;									\
-			thread->sr = {x, y + (start * scale), scale, scale};		\
-			thread->dr = {width, height, start, end};					\
-			SDL_CondSignal(thread->drawCond);							\
-		} while(0)
-
-	SOFTWARE_threadData* thread;
-	if(threadCores == 4)
-	{
-		Sint32 trHeight = (height + 3) / 4;
-		Sint32 firstStart = -1;
-		Sint32 firstEnd = firstStart + trHeight;
-		Sint32 secondStart = firstStart + trHeight;
-		Sint32 secondEnd = secondStart + trHeight;
-		Sint32 thirdStart = secondStart + trHeight;
-		Sint32 thirdEnd = thirdStart + trHeight;
-		Sint32 fourthStart = thirdStart + trHeight;
-		Sint32 fourthEnd = height - 1;
-		QUEUE_WORK(0, firstStart, firstEnd);
-		QUEUE_WORK(1, secondStart, secondEnd);
-		QUEUE_WORK(2, thirdStart, thirdEnd);
-		QUEUE_WORK(3, fourthStart, fourthEnd);
-	}
-	else
-	{
-		Sint32 trHeight = (height + 1) / 2;
-		Sint32 firstStart = -1;
-		Sint32 firstEnd = firstStart + trHeight;
-		Sint32 secondStart = firstStart + trHeight;
-		Sint32 secondEnd = height - 1;
-		QUEUE_WORK(0, firstStart, firstEnd);
-		QUEUE_WORK(1, secondStart, secondEnd);
-	}
-
-	for(Sint32 i = 0; i < threadCores; ++i)
-	{
-		thread = &threadDatas[i];
-		SDL_LockMutex(thread->drawMutex);
-		if(thread->drawning)
-		{
-			thread->waiting = true;
-			SDL_CondWait(thread->waitCond, thread->drawMutex);
-			thread->waiting = false;
-		}
-		SDL_UnlockMutex(thread->drawMutex);
-	}
-	#undef QUEUE_WORK
+	SOFTWARE_drawLightMapJobs(SOFTWARE_lightmapOldJob, src, lightmap, x, y, scale, width, height);
 }
 
 void SDL_DrawLightMap_new_MT(SDL_Surface* src, LightMap* lightmap, Sint32 x, Sint32 y, Sint32 scale, Sint32 width, Sint32 height)
 {
-	if(threadCores == 1)
+	if(g_jobSystem.getThreadCount() == 1)
 		return SDL_DrawLightMap_new(src, lightmap, x, y, scale, width, 0, height - 1);
 
-	#define QUEUE_WORK(tr, start, end)									\
-		do {															\
-			thread = &threadDatas[tr];									\
-			thread->src = src;											\
-			thread->dst = SDL_reinterpret_cast(SDL_Surface*, lightmap);	\
-			thread->lightning = 2;										\
-			thread->drawning = true;									\
-			thread->sr = {x, y + (start * scale), scale, scale};		\
-			thread->dr = {width, height, start, end};					\
-			SDL_CondSignal(thread->drawCond);							\
-		} while(0)
-
-	SOFTWARE_threadData* thread;
-	if(threadCores == 4)
-	{
-		Sint32 trHeight = (height + 3) / 4;
-		Sint32 firstStart = -1;
-		Sint32 firstEnd = firstStart + trHeight;
-		Sint32 secondStart = firstStart + trHeight;
-		Sint32 secondEnd = secondStart + trHeight;
-		Sint32 thirdStart = secondStart + trHeight;
-		Sint32 thirdEnd = thirdStart + trHeight;
-		Sint32 fourthStart = thirdStart + trHeight;
-		Sint32 fourthEnd = height - 1;
-		QUEUE_WORK(0, firstStart, firstEnd);
-		QUEUE_WORK(1, secondStart, secondEnd);
-		QUEUE_WORK(2, thirdStart, thirdEnd);
-		QUEUE_WORK(3, fourthStart, fourthEnd);
-	}
-	else
-	{
-		Sint32 trHeight = (height + 1) / 2;
-		Sint32 firstStart = -1;
-		Sint32 firstEnd = firstStart + trHeight;
-		Sint32 secondStart = firstStart + trHeight;
-		Sint32 secondEnd = height - 1;
-		QUEUE_WORK(0, firstStart, firstEnd);
-		QUEUE_WORK(1, secondStart, secondEnd);
-	}
-
-	for(Sint32 i = 0; i < threadCores; ++i)
-	{
-		thread = &threadDatas[i];
-		SDL_LockMutex(thread->drawMutex);
-		if(thread->drawning)
-		{
-			thread->waiting = true;
-			SDL_CondWait(thread->waitCond, thread->drawMutex);
-			thread->waiting = false;
-		}
-		SDL_UnlockMutex(thread->drawMutex);
-	}
-	#undef QUEUE_WORK
+	SOFTWARE_drawLightMapJobs(SOFTWARE_lightmapNewJob, src, lightmap, x, y, scale, width, height);
 }
 
 Sint32 SDL_SmoothStretch_MT(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect)
 {
-	if(threadCores == 1)
-		return SDL_SmoothStretch(src, srcrect, dst, dstrect);
-
+	SDL_Rect srcr = {0,0,src->w,src->h};
+	SDL_Rect dstr = {0,0,dst->w,dst->h};
 	if(!srcrect)
-	{
-		SDL_Rect srcr = {0,0,src->w,src->h};
 		srcrect = &srcr;
-	}
 	else
 	{
 		if(srcrect->x < 0 || srcrect->y < 0 || srcrect->x + srcrect->w > src->w || srcrect->y + srcrect->h > src->h)
@@ -1569,87 +1757,43 @@ Sint32 SDL_SmoothStretch_MT(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* ds
 	}
 
 	if(!dstrect)
-	{
-		SDL_Rect dstr = {0,0,dst->w,dst->h};
 		dstrect = &dstr;
-	}
 	else
 	{
 		if(dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > dst->w || dstrect->y + dstrect->h > dst->h)
 			return -1;
 	}
 
-	#define QUEUE_WORK(tr, sx, sy, sw, sh, dx, dy, dw, dh)	\
-		do {												\
-			thread = &threadDatas[tr];						\
-			thread->src = src;								\
-			thread->dst = dst;								\
-			thread->lightning = 0;							\
-			thread->drawning = true;						\
-			thread->sr = {sx, sy, sw, sh};				    \
-			thread->dr = {dx, dy, dw, dh};				    \
-			SDL_CondSignal(thread->drawCond);				\
-		} while(0)
-	
-	SOFTWARE_threadData* thread;
-	if(threadCores == 4)
-	{
-		Sint32 halfSrcWidth = srcrect->w / 2;
-		Sint32 halfSrcHeight = srcrect->h / 2;
-		Sint32 halfDstWidth = dstrect->w / 2;
-		Sint32 halfDstHeight = dstrect->h / 2;
-		QUEUE_WORK(0, srcrect->x, srcrect->y, halfSrcWidth + 1, halfSrcHeight + 1, dstrect->x, dstrect->y, halfDstWidth, halfDstHeight);
-		QUEUE_WORK(1, srcrect->x + halfSrcWidth, srcrect->y, srcrect->w - halfSrcWidth, halfSrcHeight + 1, dstrect->x + halfDstWidth, dstrect->y, dstrect->w - halfDstWidth, halfDstHeight);
-		QUEUE_WORK(2, srcrect->x, srcrect->y + halfSrcHeight, halfSrcWidth + 1, srcrect->h - halfSrcHeight, dstrect->x, dstrect->y + halfDstHeight, halfDstWidth, dstrect->h - halfDstHeight);
-		QUEUE_WORK(3, threadDatas[1].sr.x, threadDatas[2].sr.y, threadDatas[1].sr.w, threadDatas[2].sr.h, threadDatas[1].dr.x, threadDatas[2].dr.y, threadDatas[1].dr.w, threadDatas[2].dr.h);
-	}
-	else
-	{
-		Sint32 halfSrcHeight = srcrect->h / 2;
-		Sint32 halfDstHeight = dstrect->h / 2;
-		QUEUE_WORK(0, srcrect->x, srcrect->y, srcrect->w, halfSrcHeight + 1, dstrect->x, dstrect->y, dstrect->w, halfDstHeight);
-		QUEUE_WORK(1, srcrect->x, srcrect->y + halfSrcHeight, srcrect->w, srcrect->h - halfSrcHeight, dstrect->x, dstrect->y + halfDstHeight, dstrect->w, dstrect->h - halfDstHeight);
-	}
+	//Split into row bands, a few per thread so the faster threads can steal the remaining ones
+	//every band gets the whole rects and only its destination rows so it uses the same mapping as a single pass
+	Sint32 jobs = UTIL_min<Sint32>(g_jobSystem.getThreadCount() * SOFTWARE_JOBS_PER_THREAD, SOFTWARE_MAX_JOBS);
+	jobs = UTIL_min<Sint32>(jobs, dstrect->h);
+	if(g_jobSystem.getThreadCount() == 1 || jobs <= 1)
+		return SDL_SmoothStretch(src, srcrect, dst, dstrect);
 
-	for(Sint32 i = 0; i < threadCores; ++i)
+	JobGroup group;
+	for(Sint32 i = 0; i < jobs; ++i)
 	{
-		thread = &threadDatas[i];
-		SDL_LockMutex(thread->drawMutex);
-		if(thread->drawning)
-		{
-			thread->waiting = true;
-			SDL_CondWait(thread->waitCond, thread->drawMutex);
-			thread->waiting = false;
-		}
-		SDL_UnlockMutex(thread->drawMutex);
+		SOFTWARE_jobData& job = jobDatas[i];
+		job.src = src;
+		job.dst = SDL_reinterpret_cast(void*, dst);
+		job.sr = *srcrect;
+		job.dr = *dstrect;
+		job.startRow = (dstrect->h * i) / jobs;
+		job.endRow = (dstrect->h * (i + 1)) / jobs;
+		g_jobSystem.submit(group, SOFTWARE_stretchJob, SDL_reinterpret_cast(void*, &job));
 	}
-	#undef QUEUE_WORK
+	g_jobSystem.wait(group);
 	return 0;
 }
 
-void SDL_SmoothStretch_init()
+Sint32 SDL_SmoothStretch(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect)
 {
-	Sint32 cores = SDL_GetCPUCount();
-	if(cores >= 4)
-		threadCores = 4;
-	else if(cores >= 2)
-		threadCores = 2;
-	else
-		threadCores = 1;
-
-	SOFTWARE_threadData* thread;
-	for(Sint32 i = 0; i < threadCores; ++i)
-	{
-		thread = &threadDatas[i];
-		thread->waiting = false;
-		thread->drawning = false;
-		thread->exiting = false;
-		thread->drawMutex = SDL_CreateMutex();
-		thread->drawCond = SDL_CreateCond();
-		thread->waitCond = SDL_CreateCond();
-		thread->thread = SDL_CreateThread(SOFTWARE_drawthread, "SOFTWARE RASTERIZER", thread);
-	}
+	return SDL_SmoothStretchRows(src, srcrect, dst, dstrect, 0, (dstrect ? dstrect->h : dst->h));
+}
 
+void SDL_SmoothStretch_init()
+{
 	SDL_DrawTriangle_MOD = SDL_reinterpret_cast(LPSDL_DrawTriangle_MOD, DrawTriangle_Scalar);
 	#ifdef __USE_SSE__
 	//need to test if fma4 is faster on amd processors to determine proper check order
@@ -1676,11 +1820,40 @@ void SDL_SmoothStretch_init()
 	#endif
 	#endif
 	
+	SDL_BlendSprite = SDL_reinterpret_cast(LPSDL_BlendSprite, SDL_BlendSprite_scalar);
+	SDL_BlendSpriteTinted = SDL_reinterpret_cast(LPSDL_BlendSpriteTinted, SDL_BlendSpriteTinted_scalar);
+	SDL_BlendFill = SDL_reinterpret_cast(LPSDL_BlendFill, SDL_BlendFill_scalar);
+	SDL_ModFill = SDL_reinterpret_cast(LPSDL_ModFill, SDL_ModFill_scalar);
+	#ifdef __USE_SSE2__
+	if(SDL_HasSSE2())
+		SDL_BlendSprite = SDL_reinterpret_cast(LPSDL_BlendSprite, SDL_BlendSprite_SSE2);
+	#endif
+	#ifdef __USE_SSE4_1__
+	if(SDL_HasSSE41())
+	{
+		//_mm_testz_si128 - to skip the transparent parts of the sprites without unpacking them
+		SDL_BlendSprite = SDL_reinterpret_cast(LPSDL_BlendSprite, SDL_BlendSprite_SSE41);
+		SDL_BlendSpriteTinted = SDL_reinterpret_cast(LPSDL_BlendSpriteTinted, SDL_BlendSpriteTinted_SSE41);
+		SDL_BlendFill = SDL_reinterpret_cast(LPSDL_BlendFill, SDL_BlendFill_SSE41);
+		SDL_ModFill = SDL_reinterpret_cast(LPSDL_ModFill, SDL_ModFill_SSE41);
+	}
+	#endif
+	#ifdef __USE_AVX2__
+	if(SDL_HasAVX2())
+	{
+		//Eight pixels at once
+		SDL_BlendSprite = SDL_reinterpret_cast(LPSDL_BlendSprite, SDL_BlendSprite_AVX2);
+		SDL_BlendSpriteTinted = SDL_reinterpret_cast(LPSDL_BlendSpriteTinted, SDL_BlendSpriteTinted_AVX2);
+		SDL_BlendFill = SDL_reinterpret_cast(LPSDL_BlendFill, SDL_BlendFill_AVX2);
+		SDL_ModFill = SDL_reinterpret_cast(LPSDL_ModFill, SDL_ModFill_AVX2);
+	}
+	#endif
+
 	#ifdef __USE_SSE4_1__
 	if(SDL_HasSSE41())
 	{
 		//_mm_mullo_epi32 - to make calculations a bit faster
-		SDL_SmoothStretch = SDL_reinterpret_cast(LPSDL_SmoothStretch, SDL_SmoothStretch_SSE41);
+		SDL_SmoothStretchRows = SDL_reinterpret_cast(LPSDL_SmoothStretchRows, SDL_SmoothStretch_SSE41);
 	}
 	else
 	#endif
@@ -1688,7 +1861,7 @@ void SDL_SmoothStretch_init()
 	if(SDL_HasSSSE3())
 	{
 		//_mm_shuffle_epi8 - to avoid unnecesary packing/unpacking
-		SDL_SmoothStretch = SDL_reinterpret_cast(LPSDL_SmoothStretch, SDL_SmoothStretch_SSSE3);
+		SDL_SmoothStretchRows = SDL_reinterpret_cast(LPSDL_SmoothStretchRows, SDL_SmoothStretch_SSSE3);
 	}
 	else
 	#endif
@@ -1696,27 +1869,94 @@ void SDL_SmoothStretch_init()
 	if(SDL_HasSSE2())
 	{
 		//Use sse2 to vectorize most calculations
-		SDL_SmoothStretch = SDL_reinterpret_cast(LPSDL_SmoothStretch, SDL_SmoothStretch_SSE2);
+		SDL_SmoothStretchRows = SDL_reinterpret_cast(LPSDL_SmoothStretchRows, SDL_SmoothStretch_SSE2);
 	}
 	else
 	#endif
 	{
 		//Standard scalar function - the slowest approach
-		SDL_SmoothStretch = SDL_reinterpret_cast(LPSDL_SmoothStretch, SDL_SmoothStretch_scalar);
+		SDL_SmoothStretchRows = SDL_reinterpret_cast(LPSDL_SmoothStretchRows, SDL_SmoothStretch_scalar);
 	}
 }
 
-void SDL_SmoothStretch_shutdown()
+void SDL_SoftwareKernels_benchmark()
 {
-	SOFTWARE_threadData* thread;
-	for(Sint32 i = 0; i < threadCores; ++i)
+	const Sint32 size = 256;
+	const Sint32 iterations = 100;
+	Uint32* src = SDL_reinterpret_cast(Uint32*, SDL_malloc(size * size * sizeof(Uint32)));
+	Uint32* dst = SDL_reinterpret_cast(Uint32*, SDL_malloc(size * size * sizeof(Uint32)));
+	if(!src || !dst)
+	{
+		SDL_free(src);
+		SDL_free(dst);
+		return;
+	}
+
+	//Mix of transparent, opaque and translucent pixels like in the real sprites
+	for(Sint32 i = 0; i < size * size; ++i)
 	{
-		thread = &threadDatas[i];
-		thread->exiting = true;
-		SDL_CondSignal(thread->drawCond);
-		SDL_WaitThread(thread->thread, NULL);
-		SDL_DestroyCond(thread->waitCond);
-		SDL_DestroyCond(thread->drawCond);
-		SDL_DestroyMutex(thread->drawMutex);
+		Uint32 a = ((SDL_static_cast(Uint32, i) * 2654435761U) >> 24);
+		a = (a < 96 ? 0 : (a >= 192 ? 255 : a));
+		src[i] = (a << 24) | ((SDL_static_cast(Uint32, i) * 0x00010203) & 0x00FFFFFF);
+		dst[i] = 0xFF000000 | ((SDL_static_cast(Uint32, i) * 0x00030201) & 0x00FFFFFF);
 	}
+
+	double frequency = SDL_static_cast(double, SDL_GetPerformanceFrequency());
+	#define BENCHMARK_KERNEL(name, call)																		\
+		do {																									\
+			Uint64 start = SDL_GetPerformanceCounter();															\
+			for(Sint32 i = 0; i < iterations; ++i)																\
+				call;																							\
+			double ns = SDL_static_cast(double, SDL_GetPerformanceCounter() - start) * 1000000000.0 / frequency;	\
+			SDL_Log("Kernel %s: %.3f pixels/ns", name, (ns > 0.0 ? SDL_static_cast(double, size * size) * iterations / ns : 0.0));	\
+		} while(0)
+
+	BENCHMARK_KERNEL("BlendTinted scalar", SDL_BlendSpriteTinted_scalar(dst, size, src, size, size, size, 0xFFC08040, 24));
+	#ifdef __USE_SSE4_1__
+	if(SDL_HasSSE41())
+		BENCHMARK_KERNEL("BlendTinted SSE4.1", SDL_BlendSpriteTinted_SSE41(dst, size, src, size, size, size, 0xFFC08040, 24));
+	#endif
+	#ifdef __USE_AVX2__
+	if(SDL_HasAVX2())
+		BENCHMARK_KERNEL("BlendTinted AVX2", SDL_BlendSpriteTinted_AVX2(dst, size, src, size, size, size, 0xFFC08040, 24));
+	#endif
+
+	BENCHMARK_KERNEL("BlendFill scalar", SDL_BlendFill_scalar(dst, size, size, size, 0xFF204060, 100, 0xFF000000));
+	#ifdef __USE_SSE4_1__
+	if(SDL_HasSSE41())
+		BENCHMARK_KERNEL("BlendFill SSE4.1", SDL_BlendFill_SSE41(dst, size, size, size, 0xFF204060, 100, 0xFF000000));
+	#endif
+	#ifdef __USE_AVX2__
+	if(SDL_HasAVX2())
+		BENCHMARK_KERNEL("BlendFill AVX2", SDL_BlendFill_AVX2(dst, size, size, size, 0xFF204060, 100, 0xFF000000));
+	#endif
+
+	BENCHMARK_KERNEL("ModFill scalar", SDL_ModFill_scalar(dst, size, size, size, 0x00FFF0E0, 0xFF000000));
+	#ifdef __USE_SSE4_1__
+	if(SDL_HasSSE41())
+		BENCHMARK_KERNEL("ModFill SSE4.1", SDL_ModFill_SSE41(dst, size, size, size, 0x00FFF0E0, 0xFF000000));
+	#endif
+	#ifdef __USE_AVX2__
+	if(SDL_HasAVX2())
+		BENCHMARK_KERNEL("ModFill AVX2", SDL_ModFill_AVX2(dst, size, size, size, 0x00FFF0E0, 0xFF000000));
+	#endif
+
+	SOFTWARE_premultiplyAlpha(src, size * size, 24);
+	BENCHMARK_KERNEL("BlendSprite scalar", SDL_BlendSprite_scalar(dst, size, src, size, size, size, 24));
+	#ifdef __USE_SSE2__
+	if(SDL_HasSSE2())
+		BENCHMARK_KERNEL("BlendSprite SSE2", SDL_BlendSprite_SSE2(dst, size, src, size, size, size, 24));
+	#endif
+	#ifdef __USE_SSE4_1__
+	if(SDL_HasSSE41())
+		BENCHMARK_KERNEL("BlendSprite SSE4.1", SDL_BlendSprite_SSE41(dst, size, src, size, size, size, 24));
+	#endif
+	#ifdef __USE_AVX2__
+	if(SDL_HasAVX2())
+		BENCHMARK_KERNEL("BlendSprite AVX2", SDL_BlendSprite_AVX2(dst, size, src, size, size, size, 24));
+	#endif
+	#undef BENCHMARK_KERNEL
+
+	SDL_free(src);
+	SDL_free(dst);
 }
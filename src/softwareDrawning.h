@@ -32,14 +32,28 @@ typedef void (*LPSDL_DrawTriangle_MOD)(SDL_Surface* dst, const float colors[3][3
 extern LPSDL_DrawTriangle_MOD SDL_DrawTriangle_MOD;
 
 //BiLinear Interpolation
-typedef Sint32 (*LPSDL_SmoothStretch)(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect);
-extern LPSDL_SmoothStretch SDL_SmoothStretch;
+//the rows variant only writes the destination rows [startRow, endRow) but keeps the mapping of the whole rects
+typedef Sint32 (*LPSDL_SmoothStretchRows)(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect, Sint32 startRow, Sint32 endRow);
+extern LPSDL_SmoothStretchRows SDL_SmoothStretchRows;
+Sint32 SDL_SmoothStretch(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect);
+
+//Blending of 32-bit pixels, pitches are in pixels
+//sprites are expected with premultiplied alpha and tinted blits with straight alpha
+typedef void (*LPSDL_BlendSprite)(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 ashift);
+typedef void (*LPSDL_BlendSpriteTinted)(Uint32* dst, Sint32 dstPitch, const Uint32* src, Sint32 srcPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 ashift);
+typedef void (*LPSDL_BlendFill)(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 A, Uint32 amask);
+typedef void (*LPSDL_ModFill)(Uint32* dst, Sint32 dstPitch, Sint32 w, Sint32 h, Uint32 color, Uint32 amask);
+extern LPSDL_BlendSprite SDL_BlendSprite;
+extern LPSDL_BlendSpriteTinted SDL_BlendSpriteTinted;
+extern LPSDL_BlendFill SDL_BlendFill;
+extern LPSDL_ModFill SDL_ModFill;
+void SOFTWARE_premultiplyAlpha(Uint32* pixels, Sint32 count, Uint32 ashift);
 
 void SDL_DrawLightMap_old_MT(SDL_Surface* src, LightMap* lightmap, Sint32 x, Sint32 y, Sint32 scale, Sint32 width, Sint32 height);
 void SDL_DrawLightMap_new_MT(SDL_Surface* src, LightMap* lightmap, Sint32 x, Sint32 y, Sint32 scale, Sint32 width, Sint32 height);
 Sint32 SDL_SmoothStretch_MT(SDL_Surface* src, SDL_Rect* srcrect, SDL_Surface* dst, SDL_Rect* dstrect);
 
 void SDL_SmoothStretch_init();
-void SDL_SmoothStretch_shutdown();
+void SDL_SoftwareKernels_benchmark();
 
 #endif /* __FILE_SURFACE_SOFTWARE_h_ */
@@ -20,16 +20,19 @@
 */
 
 #include "spriteManager.h"
+#include "engine.h"
 #include "game.h"
 #include "json/json.h"
 #include "lzma/LzmaLib.h"
 
 SpriteManager g_spriteManager;
 
+extern Engine g_engine;
 extern Game g_game;
 extern Uint32 g_datRevision;
 extern Uint32 g_sprRevision;
 extern Uint32 g_spriteCounts;
+extern Uint32 g_frameTime;
 
 SpriteManager::~SpriteManager()
 {
@@ -38,16 +41,27 @@ SpriteManager::~SpriteManager()
 
 void SpriteManager::unloadSprites()
 {
-	if(m_cachedSprites && m_sprCached)
+	if(m_cachedSprites)
 	{
-		SDL_free(m_cachedSprites->hidden.mem.base);//Our pointer saved in rwops - let's free it
 		SDL_RWclose(m_cachedSprites);
 		m_cachedSprites = NULL;
 	}
+	if(m_sprMapping)
+	{
+		UTIL_UnmapFile(m_sprMapping, m_sprMappingSize);
+		m_sprMapping = NULL;
+		m_sprMappingSize = 0;
+	}
 
-	m_spriteData.clear();
+	shutdownDecoders();
+	closeDiskCache();
 	m_spriteSheets.clear();
 	m_spriteOffsets.clear();
+	m_spriteSheetIndex.clear();
+	m_spriteLocations.clear();
+	m_outfitCache.clear();
+	m_residentSheets = 0;
+	m_residentSprites = 0;
 	m_sprLoaded = false;
 }
 
@@ -129,25 +143,27 @@ void SpriteManager::manageSprites(std::vector<Uint32>& fromSprites, std::vector<
 
 unsigned char* SpriteManager::LoadSpriteSheet_BMP(const std::string& spriteFile, size_t& outputSize)
 {
+	//This function can be called from the decoder threads so don't use g_buffer here
+	char sheetPath[1024];
 	size_t fileSize = spriteFile.size();
 	if(spriteFile[fileSize - 1] != 'a' || spriteFile[fileSize - 2] != 'm' || spriteFile[fileSize - 3] != 'z' || spriteFile[fileSize - 4] != 'l' || spriteFile[fileSize - 5] != '.')
 	{
 		#if CLIENT_OVVERIDE_VERSION > 0
-		SDL_snprintf(g_buffer, sizeof(g_buffer), "%s%s%c%s.lzma", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, spriteFile.c_str());
+		SDL_snprintf(sheetPath, sizeof(sheetPath), "%s%s%c%s.lzma", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, spriteFile.c_str());
 		#else
-		SDL_snprintf(g_buffer, sizeof(g_buffer), "%s%s%c%u%c%s.lzma", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, g_clientVersion, PATH_PLATFORM_SLASH, spriteFile.c_str());
+		SDL_snprintf(sheetPath, sizeof(sheetPath), "%s%s%c%u%c%s.lzma", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, g_clientVersion, PATH_PLATFORM_SLASH, spriteFile.c_str());
 		#endif
 	}
 	else
 	{
 		#if CLIENT_OVVERIDE_VERSION > 0
-		SDL_snprintf(g_buffer, sizeof(g_buffer), "%s%s%c%s", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, spriteFile.c_str());
+		SDL_snprintf(sheetPath, sizeof(sheetPath), "%s%s%c%s", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, spriteFile.c_str());
 		#else
-		SDL_snprintf(g_buffer, sizeof(g_buffer), "%s%s%c%u%c%s", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, g_clientVersion, PATH_PLATFORM_SLASH, spriteFile.c_str());
+		SDL_snprintf(sheetPath, sizeof(sheetPath), "%s%s%c%u%c%s", g_basePath.c_str(), ASSETS_CATALOG, PATH_PLATFORM_SLASH, g_clientVersion, PATH_PLATFORM_SLASH, spriteFile.c_str());
 		#endif
 	}
 	
-	SDL_RWops* fp = SDL_RWFromFile(g_buffer, "rb");
+	SDL_RWops* fp = SDL_RWFromFile(sheetPath, "rb");
 	if(!fp)
 		return NULL;
 
@@ -209,153 +225,536 @@ void SpriteManager::SplitSpriteSheet(SDL_Surface* sheet, unsigned char* destData
 	}
 }
 
-bool SpriteManager::LoadSpriteSheet(Uint32 spriteId, bool bgra)
+SpriteSheet* SpriteManager::getSpriteSheet(Uint32 spriteId)
 {
-	for(std::vector<SpriteSheet>::iterator it = m_spriteSheets.begin(), end = m_spriteSheets.end(); it != end; ++it)
+	if(spriteId >= m_spriteSheetIndex.size())
+		return NULL;
+
+	Uint32 sheetIndex = m_spriteSheetIndex[spriteId];
+	if(sheetIndex >= m_spriteSheets.size())
+		return NULL;
+
+	return &m_spriteSheets[sheetIndex];
+}
+
+SpriteData* SpriteManager::DecodeSpriteSheet(const std::string& spriteFile, Uint32 spriteType, Uint32 sheetSprites, bool bgra)
+{
+	size_t bmpSize = 0;
+	unsigned char* bmpData = LoadSpriteSheet_BMP(spriteFile, bmpSize);
+	if(!bmpData)
+		return NULL;
+
+	SDL_Surface* bmpSurface = SDL_LoadBMP_RW(SDL_RWFromMem(bmpData, SDL_static_cast(Sint32, bmpSize)), 1);
+	SDL_free(bmpData);
+	if(!bmpSurface)
+		return NULL;
+
+	Uint32 wantedFormat = (bgra ? SDL_PIXELFORMAT_BGRA32 : SDL_PIXELFORMAT_RGBA32);
+	if(wantedFormat != bmpSurface->format->format)
 	{
-		SpriteSheet& spriteSheet = (*it);
-		if(spriteId >= spriteSheet.firstSpriteId && spriteId <= spriteSheet.lastSpriteId)
-		{
-			size_t bmpSize = 0;
-			unsigned char* bmpData = LoadSpriteSheet_BMP(spriteSheet.spriteFile, bmpSize);
-			if(!bmpData)
-				return false;
+		SDL_Surface* s = SDL_ConvertSurfaceFormat(bmpSurface, wantedFormat, SDL_SWSURFACE);
+		SDL_FreeSurface(bmpSurface);
+		if(!s)
+			return NULL;
 
-			SDL_Surface* bmpSurface = SDL_LoadBMP_RW(SDL_RWFromMem(bmpData, SDL_static_cast(Sint32, bmpSize)), 1);
-			SDL_free(bmpData);
-			if(!bmpSurface)
-				return false;
+		bmpSurface = s;
+	}
 
-			Uint32 wantedFormat = (bgra ? SDL_PIXELFORMAT_BGRA32 : SDL_PIXELFORMAT_RGBA32);
-			if(wantedFormat != bmpSurface->format->format)
+	std::unique_ptr<SpriteData[]> spriteData(new SpriteData[sheetSprites]);
+	for(Uint32 i = 0; i < sheetSprites; ++i)
+		spriteData[i].bgra = bgra;
+
+	//Sprites are stored in the slab in the same order as they're numbered in the catalog
+	Uint32 currentSprite = 0;
+	Uint32 spriteCount = sheetSprites - 1;
+	switch(spriteType)
+	{
+		case 0://1x1
+		{
+			for(Sint32 y = 0; y < 12; ++y)
 			{
-				SDL_Surface* s = SDL_ConvertSurfaceFormat(bmpSurface, wantedFormat, SDL_SWSURFACE);
-				SDL_FreeSurface(bmpSurface);
-				if(!s)
-					return false;
+				for(Sint32 x = 0; x < 12; ++x)
+				{
+					if(currentSprite > spriteCount)
+						goto Exit_Nest_Loop;
 
-				bmpSurface = s;
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, x * 32, y * 32);
+				}
 			}
-
-			Uint32 currentSprite = spriteSheet.firstSpriteId;
-			Uint32 spriteCount = currentSprite + (spriteSheet.lastSpriteId - spriteSheet.firstSpriteId);
-			switch(spriteSheet.spriteType)
+		}
+		break;
+		case 1://1x2
+		{
+			for(Sint32 y = 0; y < 12; y += 2)
 			{
-				case 0://1x1
+				for(Sint32 x = 0; x < 12; ++x)
 				{
-					for(Sint32 y = 0; y < 12; ++y)
-					{
-						for(Sint32 x = 0; x < 12; ++x)
-						{
-							if(currentSprite > spriteCount)
-								goto Exit_Nest_Loop;
+					if(currentSprite + 1 > spriteCount)
+						goto Exit_Nest_Loop;
 
-							SpriteData& newSpriteData0 = m_spriteData[currentSprite++];
-							newSpriteData0.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData0.data, x * 32, y * 32);
-						}
-					}
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, x * 32, (y + 1) * 32);
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, x * 32, y * 32);
 				}
-				break;
-				case 1://1x2
+			}
+		}
+		break;
+		case 2://2x1
+		{
+			for(Sint32 y = 0; y < 12; ++y)
+			{
+				for(Sint32 x = 0; x < 12; x += 2)
 				{
-					for(Sint32 y = 0; y < 12; y += 2)
-					{
-						for(Sint32 x = 0; x < 12; ++x)
-						{
-							if(currentSprite > spriteCount)
-								goto Exit_Nest_Loop;
-
-							SpriteData& newSpriteData0 = m_spriteData[currentSprite++];
-							newSpriteData0.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData0.data, x * 32, (y + 1) * 32);
+					if(currentSprite + 1 > spriteCount)
+						goto Exit_Nest_Loop;
 
-							SpriteData& newSpriteData1 = m_spriteData[currentSprite++];
-							newSpriteData1.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData1.data, x * 32, y * 32);
-						}
-					}
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, (x + 1) * 32, y * 32);
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, x * 32, y * 32);
 				}
-				break;
-				case 2://2x1
+			}
+		}
+		break;
+		case 3://2x2
+		{
+			for(Sint32 y = 0; y < 12; y += 2)
+			{
+				for(Sint32 x = 0; x < 12; x += 2)
 				{
-					for(Sint32 y = 0; y < 12; ++y)
-					{
-						for(Sint32 x = 0; x < 12; x += 2)
-						{
-							if(currentSprite > spriteCount)
-								goto Exit_Nest_Loop;
-
-							SpriteData& newSpriteData0 = m_spriteData[currentSprite++];
-							newSpriteData0.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData0.data, (x + 1) * 32, y * 32);
+					if(currentSprite + 3 > spriteCount)
+						goto Exit_Nest_Loop;
 
-							SpriteData& newSpriteData1 = m_spriteData[currentSprite++];
-							newSpriteData1.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData1.data, x * 32, y * 32);
-						}
-					}
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, (x + 1) * 32, (y + 1) * 32);
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, x * 32, (y + 1) * 32);
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, (x + 1) * 32, y * 32);
+					SplitSpriteSheet(bmpSurface, spriteData[currentSprite++].data, x * 32, y * 32);
 				}
+			}
+		}
+		break;
+		default:
+		{
+			SDL_FreeSurface(bmpSurface);
+			return NULL;
+		}
+	}
+	Exit_Nest_Loop:
+	SDL_FreeSurface(bmpSurface);
+	return spriteData.release();
+}
+
+bool SpriteManager::LoadSpriteSheet(Uint32 spriteId, bool bgra)
+{
+	SpriteSheet* spriteSheet = getSpriteSheet(spriteId);
+	if(!spriteSheet || spriteSheet->state == SPRITESHEET_STATE_FAILED || spriteSheet->isRetryPending(g_frameTime))
+		return false;
+	else if(spriteSheet->isResident())
+		return true;
+
+	Uint32 sheetSprites = spriteSheet->getSpriteCount();
+	spriteSheet->spriteData.reset(DecodeSpriteSheet(spriteSheet->spriteFile, spriteSheet->spriteType, sheetSprites, bgra));
+	if(!spriteSheet->spriteData)
+	{
+		failSpriteSheet(*spriteSheet);
+		return false;
+	}
+
+	storeSpriteSheet(spriteSheet->spriteFile, spriteSheet->spriteType, sheetSprites, spriteSheet->spriteData.get());
+	spriteSheet->state = SPRITESHEET_STATE_RESIDENT;
+	m_residentSprites += sheetSprites;
+	++m_residentSheets;
+	return true;
+}
+
+static int SPRITEMANAGER_decodethread(void* data)
+{
+	SDL_SetThreadPriority(SDL_THREAD_PRIORITY_LOW);
+	return SDL_reinterpret_cast(SpriteManager*, data)->decodeSheets();
+}
+
+void SpriteManager::initDecoders()
+{
+	if(!m_decodeThreads.empty())
+		return;
+
+	Sint32 threads = UTIL_max<Sint32>(1, UTIL_min<Sint32>(SDL_GetCPUCount() - 1, SPRITE_DECODE_MAX_THREADS));
+	m_decodeMutex = SDL_CreateMutex();
+	m_decodeCond = SDL_CreateCond();
+	if(!m_decodeMutex || !m_decodeCond)
+	{
+		shutdownDecoders();
+		return;
+	}
+
+	m_decodeExiting = false;
+	for(Sint32 i = 0; i < threads; ++i)
+	{
+		SDL_Thread* thread = SDL_CreateThread(SPRITEMANAGER_decodethread, "SPRITE DECODER", this);
+		if(thread)
+			m_decodeThreads.push_back(thread);
+	}
+}
+
+void SpriteManager::shutdownDecoders()
+{
+	if(m_decodeMutex)
+	{
+		SDL_LockMutex(m_decodeMutex);
+		m_decodeExiting = true;
+		SDL_CondBroadcast(m_decodeCond);
+		SDL_UnlockMutex(m_decodeMutex);
+	}
+
+	for(std::vector<SDL_Thread*>::iterator it = m_decodeThreads.begin(), end = m_decodeThreads.end(); it != end; ++it)
+		SDL_WaitThread((*it), NULL);
+
+	m_decodeThreads.clear();
+	m_decodeQueue.clear();
+	m_decodedSheets.clear();
+	if(m_decodeCond)
+	{
+		SDL_DestroyCond(m_decodeCond);
+		m_decodeCond = NULL;
+	}
+	if(m_decodeMutex)
+	{
+		SDL_DestroyMutex(m_decodeMutex);
+		m_decodeMutex = NULL;
+	}
+}
+
+int SpriteManager::decodeSheets()
+{
+	SDL_LockMutex(m_decodeMutex);
+	while(true)
+	{
+		while(m_decodeQueue.empty() && !m_decodeExiting)
+			SDL_CondWait(m_decodeCond, m_decodeMutex);
+
+		if(m_decodeExiting)
+			break;
+
+		SpriteSheetJob job = std::move(m_decodeQueue.front());
+		m_decodeQueue.pop_front();
+		SDL_UnlockMutex(m_decodeMutex);
+
+		SpriteData* spriteData = DecodeSpriteSheet(job.spriteFile, job.spriteType, job.sheetSprites, job.bgra);
+		if(spriteData)
+			storeSpriteSheet(job.spriteFile, job.spriteType, job.sheetSprites, spriteData);
+
+		SDL_LockMutex(m_decodeMutex);
+		m_decodedSheets.emplace_back(job.sheetIndex, spriteData);
+	}
+	SDL_UnlockMutex(m_decodeMutex);
+	return 0;
+}
+
+void SpriteManager::queueSpriteSheet(Uint32 sheetIndex, bool urgent)
+{
+	SpriteSheet& spriteSheet = m_spriteSheets[sheetIndex];
+	if(spriteSheet.state == SPRITESHEET_STATE_UNLOADED)
+	{
+		if(spriteSheet.isRetryPending(g_frameTime))
+			return;
+
+		spriteSheet.state = SPRITESHEET_STATE_QUEUED;
+		spriteSheet.urgent = urgent;
+		SDL_LockMutex(m_decodeMutex);
+		if(urgent)
+			m_decodeQueue.emplace_front(spriteSheet, sheetIndex, m_decodeBGRA);
+		else
+			m_decodeQueue.emplace_back(spriteSheet, sheetIndex, m_decodeBGRA);
+		SDL_CondSignal(m_decodeCond);
+		SDL_UnlockMutex(m_decodeMutex);
+	}
+	else if(spriteSheet.state == SPRITESHEET_STATE_QUEUED && urgent && !spriteSheet.urgent)
+	{
+		//Sprite is needed on screen now - move it before the prefetched sheets
+		spriteSheet.urgent = true;
+		SDL_LockMutex(m_decodeMutex);
+		for(std::deque<SpriteSheetJob>::iterator it = m_decodeQueue.begin(), end = m_decodeQueue.end(); it != end; ++it)
+		{
+			if((*it).sheetIndex == sheetIndex)
+			{
+				SpriteSheetJob job = std::move(*it);
+				m_decodeQueue.erase(it);
+				m_decodeQueue.push_front(std::move(job));
 				break;
-				case 3://2x2
-				{
-					for(Sint32 y = 0; y < 12; y += 2)
-					{
-						for(Sint32 x = 0; x < 12; x += 2)
-						{
-							if(currentSprite > spriteCount)
-								goto Exit_Nest_Loop;
+			}
+		}
+		SDL_UnlockMutex(m_decodeMutex);
+	}
+}
 
-							SpriteData& newSpriteData0 = m_spriteData[currentSprite++];
-							newSpriteData0.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData0.data, (x + 1) * 32, (y + 1) * 32);
+void SpriteManager::updateSheets()
+{
+	if(m_decodeThreads.empty())
+		return;
 
-							SpriteData& newSpriteData1 = m_spriteData[currentSprite++];
-							newSpriteData1.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData1.data, x * 32, (y + 1) * 32);
+	std::vector<SpriteSheetResult> decodedSheets;
+	SDL_LockMutex(m_decodeMutex);
+	decodedSheets.swap(m_decodedSheets);
+	SDL_UnlockMutex(m_decodeMutex);
+	for(std::vector<SpriteSheetResult>::iterator it = decodedSheets.begin(), end = decodedSheets.end(); it != end; ++it)
+	{
+		SpriteSheetResult& result = (*it);
+		SpriteSheet& spriteSheet = m_spriteSheets[result.sheetIndex];
+		if(spriteSheet.state != SPRITESHEET_STATE_QUEUED)
+			continue;
 
-							SpriteData& newSpriteData2 = m_spriteData[currentSprite++];
-							newSpriteData2.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData2.data, (x + 1) * 32, y * 32);
+		if(result.spriteData)
+		{
+			spriteSheet.spriteData = std::move(result.spriteData);
+			spriteSheet.state = SPRITESHEET_STATE_RESIDENT;
+			m_residentSprites += spriteSheet.getSpriteCount();
+			++m_residentSheets;
+		}
+		else
+			failSpriteSheet(spriteSheet);
+	}
+}
 
-							SpriteData& newSpriteData3 = m_spriteData[currentSprite++];
-							newSpriteData3.bgra = bgra;
-							SplitSpriteSheet(bmpSurface, newSpriteData3.data, x * 32, y * 32);
-						}
-					}
+void SpriteManager::failSpriteSheet(SpriteSheet& spriteSheet)
+{
+	//Decoding can fail for transient reasons(out of memory, file locked by antivirus)
+	//so retry with an exponential backoff and only give up after a few attempts
+	if(++spriteSheet.failures >= SPRITESHEET_MAX_RETRIES)
+	{
+		spriteSheet.state = SPRITESHEET_STATE_FAILED;
+		return;
+	}
+
+	spriteSheet.state = SPRITESHEET_STATE_UNLOADED;
+	spriteSheet.urgent = false;
+	spriteSheet.retryTicks = g_frameTime + (SPRITESHEET_RETRY_DELAY << (spriteSheet.failures - 1));
+}
+
+void SpriteManager::prefetchSprites(const std::vector<Uint32>& sprites)
+{
+	if(m_decodeThreads.empty())
+		return;
+
+	Uint32 lastSheetIndex = SDL_MAX_UINT32;
+	for(std::vector<Uint32>::const_iterator it = sprites.begin(), end = sprites.end(); it != end; ++it)
+	{
+		Uint32 spriteId = (*it);
+		if(spriteId >= m_spriteSheetIndex.size())
+			continue;
+
+		//Sprites of the same thing usually sit in the same sheet
+		Uint32 sheetIndex = m_spriteSheetIndex[spriteId];
+		if(sheetIndex == lastSheetIndex || sheetIndex >= m_spriteSheets.size())
+			continue;
+
+		lastSheetIndex = sheetIndex;
+		queueSpriteSheet(sheetIndex, false);
+	}
+}
+
+bool SpriteManager::isSpriteReady(Uint32 spriteId)
+{
+	if(m_decodeThreads.empty() || spriteId >= m_spriteSheetIndex.size())
+		return true;
+
+	Uint32 sheetIndex = m_spriteSheetIndex[spriteId];
+	if(sheetIndex >= m_spriteSheets.size())
+		return true;
+
+	switch(m_spriteSheets[sheetIndex].state)
+	{
+		case SPRITESHEET_STATE_UNLOADED:
+		case SPRITESHEET_STATE_QUEUED:
+		{
+			queueSpriteSheet(sheetIndex, true);
+			return false;
+		}
+		default: return true;
+	}
+}
+
+void SpriteManager::openDiskCache()
+{
+	closeDiskCache();
+	if(!g_engine.hasSpriteDiskCache() || m_spriteSheets.empty())
+		return;
+
+	char indexPath[1024];
+	char dataPath[1024];
+	SDL_snprintf(indexPath, sizeof(indexPath), "%ssprites.idx", g_prefPath.c_str());
+	SDL_snprintf(dataPath, sizeof(dataPath), "%ssprites.cache", g_prefPath.c_str());
+
+	bool validCache = false;
+	SDL_RWops* index = SDL_RWFromFile(indexPath, "rb");
+	if(index)
+	{
+		Uint32 signature = SDL_ReadLE32(index);
+		Uint32 version = SDL_ReadLE32(index);
+		Uint32 catalogKey = SDL_ReadLE32(index);
+		Uint32 spriteDataSize = SDL_ReadLE32(index);
+		if(signature == SPRITE_CACHE_SIGNATURE && version == SPRITE_CACHE_VERSION && catalogKey == m_catalogKey && spriteDataSize == sizeof(SpriteData))
+			m_cacheMapping = UTIL_MapFile(dataPath, m_cacheMappingSize);
+
+		if(m_cacheMapping)
+		{
+			robin_hood::unordered_map<std::string, Uint32> sheetFiles;
+			for(size_t i = 0, end = m_spriteSheets.size(); i < end; ++i)
+				sheetFiles[m_spriteSheets[i].spriteFile] = SDL_static_cast(Uint32, i);
+
+			validCache = true;
+			Sint64 indexSize = SDL_RWsize(index);
+			while(SDL_RWtell(index) < indexSize)
+			{
+				std::string spriteFile = SDL_ReadLEString(index);
+				Uint32 spriteType = SDL_ReadLE32(index);
+				Uint32 sheetSprites = SDL_ReadLE32(index);
+				Uint64 offset = SDL_ReadLE64(index);
+
+				robin_hood::unordered_map<std::string, Uint32>::iterator it = sheetFiles.find(spriteFile);
+				if(it == sheetFiles.end() || offset + SDL_static_cast(Uint64, sheetSprites) * sizeof(SpriteData) > m_cacheMappingSize)
+				{
+					//Index got out of sync with the data(e.g. client crashed during write) - start from scratch
+					validCache = false;
+					break;
 				}
-				break;
-				default:
+
+				SpriteSheet& spriteSheet = m_spriteSheets[it->second];
+				if(spriteSheet.spriteType != spriteType || spriteSheet.getSpriteCount() != sheetSprites)
 				{
-					SDL_FreeSurface(bmpSurface);
-					return false;
+					validCache = false;
+					break;
+				}
+
+				if(spriteSheet.state == SPRITESHEET_STATE_UNLOADED)
+				{
+					spriteSheet.mappedData = SDL_reinterpret_cast(SpriteData*, m_cacheMapping + offset);
+					spriteSheet.state = SPRITESHEET_STATE_RESIDENT;
+					++m_residentSheets;
 				}
 			}
-			Exit_Nest_Loop:
-			SDL_FreeSurface(bmpSurface);
-			return true;
+		}
+		SDL_RWclose(index);
+	}
+
+	if(validCache)
+	{
+		m_cacheIndex = SDL_RWFromFile(indexPath, "ab");
+		m_cacheData = SDL_RWFromFile(dataPath, "ab");
+	}
+	else
+	{
+		for(std::vector<SpriteSheet>::iterator it = m_spriteSheets.begin(), end = m_spriteSheets.end(); it != end; ++it)
+		{
+			SpriteSheet& spriteSheet = (*it);
+			if(spriteSheet.mappedData)
+			{
+				spriteSheet.mappedData = NULL;
+				spriteSheet.state = SPRITESHEET_STATE_UNLOADED;
+				--m_residentSheets;
+			}
+		}
+		UTIL_UnmapFile(m_cacheMapping, m_cacheMappingSize);
+		m_cacheMapping = NULL;
+		m_cacheMappingSize = 0;
+
+		m_cacheIndex = SDL_RWFromFile(indexPath, "wb");
+		m_cacheData = SDL_RWFromFile(dataPath, "wb");
+		if(m_cacheIndex)
+		{
+			SDL_WriteLE32(m_cacheIndex, SPRITE_CACHE_SIGNATURE);
+			SDL_WriteLE32(m_cacheIndex, SPRITE_CACHE_VERSION);
+			SDL_WriteLE32(m_cacheIndex, m_catalogKey);
+			SDL_WriteLE32(m_cacheIndex, SDL_static_cast(Uint32, sizeof(SpriteData)));
 		}
 	}
-	return false;
+
+	if(!m_cacheIndex || !m_cacheData)
+	{
+		if(m_cacheIndex)
+		{
+			SDL_RWclose(m_cacheIndex);
+			m_cacheIndex = NULL;
+		}
+		if(m_cacheData)
+		{
+			SDL_RWclose(m_cacheData);
+			m_cacheData = NULL;
+		}
+		return;
+	}
+	m_cacheMutex = SDL_CreateMutex();
 }
 
-unsigned char* SpriteManager::LoadSprite_NEW(Uint32 spriteId, bool bgra)
+void SpriteManager::closeDiskCache()
 {
-	//Not the best solution - let's think of better way of caching later
-	std::map<Uint32, SpriteData>::iterator it = m_spriteData.find(spriteId);
-	if(it == m_spriteData.end())
+	if(m_cacheIndex)
 	{
-		if(!LoadSpriteSheet(spriteId, bgra))
-			return false;
+		SDL_RWclose(m_cacheIndex);
+		m_cacheIndex = NULL;
+	}
+	if(m_cacheData)
+	{
+		SDL_RWclose(m_cacheData);
+		m_cacheData = NULL;
+	}
+	if(m_cacheMutex)
+	{
+		SDL_DestroyMutex(m_cacheMutex);
+		m_cacheMutex = NULL;
+	}
+	UTIL_UnmapFile(m_cacheMapping, m_cacheMappingSize);
+	m_cacheMapping = NULL;
+	m_cacheMappingSize = 0;
+}
+
+void SpriteManager::storeSpriteSheet(const std::string& spriteFile, Uint32 spriteType, Uint32 sheetSprites, SpriteData* spriteData)
+{
+	if(!m_cacheMutex)
+		return;
 
-		it = m_spriteData.find(spriteId);
+	//Data goes first so the index never points past the end of the cache file
+	SDL_LockMutex(m_cacheMutex);
+	Sint64 offset = SDL_RWseek(m_cacheData, 0, RW_SEEK_END);
+	size_t dataSize = SDL_static_cast(size_t, sheetSprites) * sizeof(SpriteData);
+	if(offset >= 0 && SDL_RWwrite(m_cacheData, spriteData, 1, dataSize) == dataSize)
+	{
+		SDL_WriteLEString(m_cacheIndex, spriteFile);
+		SDL_WriteLE32(m_cacheIndex, spriteType);
+		SDL_WriteLE32(m_cacheIndex, sheetSprites);
+		SDL_WriteLE64(m_cacheIndex, SDL_static_cast(Uint64, offset));
 	}
+	SDL_UnlockMutex(m_cacheMutex);
+}
 
-	SpriteData& spriteData = it->second;
-	if(!spriteData.data)
+unsigned char* SpriteManager::LoadSprite_NEW(Uint32 spriteId, bool bgra)
+{
+	SpriteSheet* spriteSheet = getSpriteSheet(spriteId);
+	if(!spriteSheet)
 		return NULL;
 
-	if(spriteData.bgra != bgra)
+	m_decodeBGRA = bgra;
+	if(!spriteSheet->isResident())
+	{
+		//Don't stall the frame when the sheet is already being decoded in the background
+		if(spriteSheet->state == SPRITESHEET_STATE_QUEUED || !LoadSpriteSheet(spriteId, bgra))
+			return NULL;
+	}
+
+	SpriteData& spriteData = spriteSheet->getSprites()[spriteId - spriteSheet->firstSpriteId];
+	if(spriteData.bgra != bgra && spriteSheet->mappedData)
+	{
+		//Disk cache mapping is read-only so swap the channels while copying
+		unsigned char* newSpriteData = SDL_reinterpret_cast(unsigned char*, SDL_malloc(4096));
+		if(!newSpriteData)
+			return NULL;
+
+		for(Sint32 i = 0; i < 4096; i += 4)
+		{
+			newSpriteData[i + 0] = spriteData.data[i + 2];
+			newSpriteData[i + 1] = spriteData.data[i + 1];
+			newSpriteData[i + 2] = spriteData.data[i + 0];
+			newSpriteData[i + 3] = spriteData.data[i + 3];
+		}
+		return newSpriteData;
+	}
+	else if(spriteData.bgra != bgra)
 	{
 		for(Sint32 i = 0; i < 4096; i += 4)
 		{
@@ -376,20 +775,32 @@ unsigned char* SpriteManager::LoadSprite_NEW(Uint32 spriteId, bool bgra)
 	return NULL;
 }
 
-unsigned char* SpriteManager::LoadSprite_RGBA(Uint32 spriteId)
+unsigned char* SpriteManager::LoadSprite_SPR(Uint32 spriteId, bool bgra)
 {
-	SDL_RWops* sprites = m_cachedSprites;
-	if(!sprites)
-		return LoadSprite_NEW(spriteId, false);
+	if(spriteId == 0 || spriteId > g_spriteCounts)
+		return NULL;
 
 	unsigned char* pixels = SDL_reinterpret_cast(unsigned char*, SDL_calloc(4096, sizeof(unsigned char)));
 	if(!pixels)
 		return NULL;
 
+	if(m_sprMapping)
+	{
+		//Zero-copy path - decode straight from the mapped file
+		SpriteLocation& location = m_spriteLocations[spriteId - 1];
+		if(location.size > 0)
+			SPRITE_decodeRLE(pixels, m_sprMapping + location.offset, SDL_static_cast(size_t, location.size), bgra);
+		return pixels;
+	}
+
+	SDL_RWops* sprites = m_cachedSprites;
 	Sint64 offset = (g_game.hasGameFeature(GAME_FEATURE_EXTENDED_SPRITES) ? 8 : 6);
 	SDL_RWseek(sprites, (spriteId - 1) * 4 + offset, RW_SEEK_SET);
 
 	Uint32 sprLoc = SDL_ReadLE32(sprites);
+	if(sprLoc == 0)
+		return pixels;
+
 	SDL_RWseek(sprites, sprLoc, RW_SEEK_SET);
 	SDL_RWseek(sprites, 3, RW_SEEK_CUR);//ignore colorkey
 
@@ -397,113 +808,123 @@ unsigned char* SpriteManager::LoadSprite_RGBA(Uint32 spriteId)
 	if(sprSize == 0)
 		return pixels;
 
-	Uint32 writeData = 0, readData = 0;
-	Uint16 numPix;
-	while(readData < sprSize)
-	{
-		numPix = SDL_ReadLE16(sprites);
-		writeData += numPix * 4;
-		numPix = SDL_ReadLE16(sprites);
-		readData += 4;
-		for(Uint16 i = 0; i < numPix && writeData <= 4092; ++i)
-		{
-			pixels[writeData] = SDL_ReadU8(sprites);
-			pixels[writeData + 1] = SDL_ReadU8(sprites);
-			pixels[writeData + 2] = SDL_ReadU8(sprites);
-			#if defined(__ALPHA_SPRITES__)
-			pixels[writeData + 3] = SDL_ReadU8(sprites);
-			readData += 4;
-			#else
-			pixels[writeData + 3] = SDL_ALPHA_OPAQUE;
-			readData += 3;
-			#endif
-			writeData += 4;
-		}
-	}
+	unsigned char* data = SDL_reinterpret_cast(unsigned char*, SDL_malloc(sprSize));
+	if(!data)
+		return pixels;
+
+	size_t readSize = SDL_RWread(sprites, data, 1, sprSize);
+	SPRITE_decodeRLE(pixels, data, readSize, bgra);
+	SDL_free(data);
 	return pixels;
 }
 
-unsigned char* SpriteManager::LoadSprite_BGRA(Uint32 spriteId)
+unsigned char* SpriteManager::LoadSprite_RGBA(Uint32 spriteId)
 {
-	SDL_RWops* sprites = m_cachedSprites;
-	if(!sprites)
-		return LoadSprite_NEW(spriteId, true);
-
-	unsigned char* pixels = SDL_reinterpret_cast(unsigned char*, SDL_calloc(4096, sizeof(unsigned char)));
-	if(!pixels)
-		return NULL;
-
-	Sint64 offset = (g_game.hasGameFeature(GAME_FEATURE_EXTENDED_SPRITES) ? 8 : 6);
-	SDL_RWseek(sprites, (spriteId - 1) * 4 + offset, RW_SEEK_SET);
+	if(!m_cachedSprites && !m_sprMapping)
+		return LoadSprite_NEW(spriteId, false);
 
-	Uint32 sprLoc = SDL_ReadLE32(sprites);
-	SDL_RWseek(sprites, sprLoc, RW_SEEK_SET);
-	SDL_RWseek(sprites, 3, RW_SEEK_CUR);//ignore colorkey
+	return LoadSprite_SPR(spriteId, false);
+}
 
-	Uint16 sprSize = SDL_ReadLE16(sprites);
-	if(sprSize == 0)
-		return pixels;
+unsigned char* SpriteManager::LoadSprite_BGRA(Uint32 spriteId)
+{
+	if(!m_cachedSprites && !m_sprMapping)
+		return LoadSprite_NEW(spriteId, true);
 
-	Uint32 writeData = 0, readData = 0;
-	Uint16 numPix;
-	while(readData < sprSize)
-	{
-		numPix = SDL_ReadLE16(sprites);
-		writeData += numPix * 4;
-		numPix = SDL_ReadLE16(sprites);
-		readData += 4;
-		for(Uint16 i = 0; i < numPix && writeData <= 4092; ++i)
-		{
-			pixels[writeData + 2] = SDL_ReadU8(sprites);
-			pixels[writeData + 1] = SDL_ReadU8(sprites);
-			pixels[writeData] = SDL_ReadU8(sprites);
-			#if defined(__ALPHA_SPRITES__)
-			pixels[writeData + 3] = SDL_ReadU8(sprites);
-			readData += 4;
-			#else
-			pixels[writeData + 3] = SDL_ALPHA_OPAQUE;
-			readData += 3;
-			#endif
-			writeData += 4;
-		}
-	}
-	return pixels;
+	return LoadSprite_SPR(spriteId, true);
 }
 
 bool SpriteManager::loadSprites(const char* filename)
 {
-	SDL_RWops* sprites = SDL_RWFromFile(filename, "rb");
-	if(!sprites)
+	size_t headerSize = (g_game.hasGameFeature(GAME_FEATURE_EXTENDED_SPRITES) ? 8 : 6);
+	m_sprMapping = UTIL_MapFile(filename, m_sprMappingSize);
+	if(m_sprMapping && m_sprMappingSize < headerSize)
+	{
+		UTIL_UnmapFile(m_sprMapping, m_sprMappingSize);
+		m_sprMapping = NULL;
+		m_sprMappingSize = 0;
 		return false;
-
-	size_t sizeSprites = SDL_static_cast(size_t, SDL_RWsize(sprites));
-	unsigned char* data = SDL_reinterpret_cast(unsigned char*, SDL_malloc(sizeSprites));
-	if(!data)
+	}
+	if(!m_sprMapping)
 	{
-		m_cachedSprites = sprites;
+		//Fallback to streaming the sprites from the file
+		m_cachedSprites = SDL_RWFromFile(filename, "rb");
+		if(!m_cachedSprites)
+			return false;
+
 		g_sprRevision = SDL_ReadLE32(m_cachedSprites);
 		g_spriteCounts = (g_game.hasGameFeature(GAME_FEATURE_EXTENDED_SPRITES) ? SDL_ReadLE32(m_cachedSprites) : SDL_static_cast(Uint32, SDL_ReadLE16(m_cachedSprites)));
 		m_sprLoaded = true;
-		m_sprCached = false;
 		return true;
 	}
 
-	SDL_RWread(sprites, data, 1, sizeSprites);
-	SDL_RWclose(sprites);
-	
-	m_cachedSprites = SDL_RWFromMem(data, SDL_static_cast(Sint32, sizeSprites));
-	if(!m_cachedSprites)
+	const unsigned char* data = m_sprMapping;
+	g_sprRevision = SDL_static_cast(Uint32, data[0]) | (SDL_static_cast(Uint32, data[1]) << 8) | (SDL_static_cast(Uint32, data[2]) << 16) | (SDL_static_cast(Uint32, data[3]) << 24);
+	if(headerSize == 8)
+		g_spriteCounts = SDL_static_cast(Uint32, data[4]) | (SDL_static_cast(Uint32, data[5]) << 8) | (SDL_static_cast(Uint32, data[6]) << 16) | (SDL_static_cast(Uint32, data[7]) << 24);
+	else
+		g_spriteCounts = SDL_static_cast(Uint32, data[4]) | (SDL_static_cast(Uint32, data[5]) << 8);
+
+	//Build the sprite index once so that every decode is a single lookup
+	g_spriteCounts = UTIL_min<Uint32>(g_spriteCounts, SDL_static_cast(Uint32, (m_sprMappingSize - headerSize) / 4));
+	m_spriteLocations.resize(SDL_static_cast(size_t, g_spriteCounts));
+	for(Uint32 i = 0; i < g_spriteCounts; ++i)
 	{
-		SDL_free(data);
-		return false;
+		SpriteLocation& location = m_spriteLocations[i];
+		location.offset = 0;
+		location.size = 0;
+
+		const unsigned char* entry = data + headerSize + i * 4;
+		size_t sprLoc = SDL_static_cast(size_t, SDL_static_cast(Uint32, entry[0]) | (SDL_static_cast(Uint32, entry[1]) << 8) | (SDL_static_cast(Uint32, entry[2]) << 16) | (SDL_static_cast(Uint32, entry[3]) << 24));
+		if(sprLoc == 0 || sprLoc + 5 > m_sprMappingSize)
+			continue;
+
+		//ignore colorkey
+		size_t sprSize = SDL_static_cast(size_t, SDL_static_cast(Uint32, data[sprLoc + 3]) | (SDL_static_cast(Uint32, data[sprLoc + 4]) << 8));
+		location.offset = SDL_static_cast(Uint32, sprLoc + 5);
+		location.size = SDL_static_cast(Uint32, UTIL_min<size_t>(sprSize, m_sprMappingSize - location.offset));
 	}
-	g_sprRevision = SDL_ReadLE32(m_cachedSprites);
-	g_spriteCounts = (g_game.hasGameFeature(GAME_FEATURE_EXTENDED_SPRITES) ? SDL_ReadLE32(m_cachedSprites) : SDL_static_cast(Uint32, SDL_ReadLE16(m_cachedSprites)));
 	m_sprLoaded = true;
-	m_sprCached = true;
+	if(g_engine.isSpriteReadBenchmark())
+		benchmarkSprites(filename);
 	return true;
 }
 
+void SpriteManager::benchmarkSprites(const char* filename)
+{
+	SDL_RWops* sprites = SDL_RWFromFile(filename, "rb");
+	if(!sprites)
+		return;
+
+	size_t readBytes = 0;
+	for(std::vector<SpriteLocation>::iterator it = m_spriteLocations.begin(), end = m_spriteLocations.end(); it != end; ++it)
+		readBytes += SDL_static_cast(size_t, (*it).size);
+
+	//Decode every sprite from the mapping first and then through the streaming fallback
+	unsigned char* sprMapping = m_sprMapping;
+	for(Sint32 pass = 0; pass < 2; ++pass)
+	{
+		if(pass == 1)
+		{
+			m_sprMapping = NULL;
+			m_cachedSprites = sprites;
+		}
+
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for(Uint32 spriteId = 1; spriteId <= g_spriteCounts; ++spriteId)
+			SDL_free(LoadSprite_SPR(spriteId, true));
+
+		double readTime = SDL_static_cast(double, SDL_GetPerformanceCounter() - startTicks) / SDL_GetPerformanceFrequency();
+		double nsPerSprite = (g_spriteCounts > 0 ? readTime * 1000000000.0 / g_spriteCounts : 0.0);
+		double megabytesPerSecond = (readTime > 0.0 ? SDL_static_cast(double, readBytes) / (readTime * 1024.0 * 1024.0) : 0.0);
+		SDL_Log("Sprite read %s: %u sprites(%u KB) decoded in %.2f ms - %.0f ns/sprite, %.1f MB/s", (pass == 0 ? "mmap" : "rwops"), g_spriteCounts, SDL_static_cast(Uint32, readBytes / 1024), readTime * 1000.0, nsPerSprite, megabytesPerSecond);
+	}
+
+	m_sprMapping = sprMapping;
+	m_cachedSprites = NULL;
+	SDL_RWclose(sprites);
+}
+
 bool SpriteManager::loadCatalog(const char* filename)
 {
 	Uint32 startSpriteIndex = 1;
@@ -582,7 +1003,17 @@ bool SpriteManager::loadCatalog(const char* filename)
 								}
 							}
 
-							m_spriteSheets.emplace_back(fileName->AsString(), spriteIndex, startSpriteIndex - 1, spriteType);
+							if(startSpriteIndex > spriteIndex)
+							{
+								if(startSpriteIndex > m_spriteSheetIndex.size())
+									m_spriteSheetIndex.resize(startSpriteIndex, SDL_MAX_UINT32);
+
+								Uint32 sheetIndex = SDL_static_cast(Uint32, m_spriteSheets.size());
+								for(Uint32 j = spriteIndex; j < startSpriteIndex; ++j)
+									m_spriteSheetIndex[j] = sheetIndex;
+
+								m_spriteSheets.emplace_back(fileName->AsString(), spriteIndex, startSpriteIndex - 1, spriteType);
+							}
 						}
 					}
 				}
@@ -598,9 +1029,83 @@ bool SpriteManager::loadCatalog(const char* filename)
 
 	m_spriteSheets.shrink_to_fit();
 	m_spriteOffsets.shrink_to_fit();
+	m_spriteSheetIndex.shrink_to_fit();
+
+	//FNV-1a over the sheet list - any change to the catalog invalidates the disk cache
+	m_catalogKey = 0x811C9DC5;
+	for(std::vector<SpriteSheet>::iterator it = m_spriteSheets.begin(), end = m_spriteSheets.end(); it != end; ++it)
+	{
+		SpriteSheet& spriteSheet = (*it);
+		Uint32 sheetValues[3] = {spriteSheet.firstSpriteId, spriteSheet.lastSpriteId, spriteSheet.spriteType};
+		const Uint8* keyData = SDL_reinterpret_cast(const Uint8*, spriteSheet.spriteFile.c_str());
+		for(size_t i = 0, size = spriteSheet.spriteFile.size(); i < size; ++i)
+			m_catalogKey = (m_catalogKey ^ keyData[i]) * 0x01000193;
+
+		keyData = SDL_reinterpret_cast(const Uint8*, sheetValues);
+		for(size_t i = 0; i < sizeof(sheetValues); ++i)
+			m_catalogKey = (m_catalogKey ^ keyData[i]) * 0x01000193;
+	}
 
 	g_sprRevision = 0x73434654;
 	g_spriteCounts = startSpriteIndex - 1;
 	m_sprLoaded = true;
+	openDiskCache();
+	initDecoders();
 	return true;
 }
+
+void OutfitCache::clear()
+{
+	m_entries.clear();
+	m_index.clear();
+	m_hits = 0;
+	m_misses = 0;
+}
+
+void OutfitCache::setMemoryLimit(size_t memoryLimit)
+{
+	m_memoryLimit = memoryLimit;
+	while(!m_entries.empty() && getMemoryUsage() > m_memoryLimit)
+	{
+		m_index.erase(m_entries.back().key);
+		m_entries.pop_back();
+	}
+}
+
+unsigned char* OutfitCache::getPixels(const OutfitCacheKey& key)
+{
+	auto it = m_index.find(key);
+	if(it == m_index.end())
+	{
+		++m_misses;
+		return NULL;
+	}
+
+	unsigned char* pixels = SDL_reinterpret_cast(unsigned char*, SDL_malloc(4096));
+	if(!pixels)
+		return NULL;
+
+	++m_hits;
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+	UTIL_FastCopy(SDL_reinterpret_cast(Uint8*, pixels), SDL_reinterpret_cast(const Uint8*, it->second->pixels), 4096);
+	return pixels;
+}
+
+void OutfitCache::storePixels(const OutfitCacheKey& key, const unsigned char* pixels)
+{
+	if(m_memoryLimit < sizeof(OutfitCacheEntry) || m_index.find(key) != m_index.end())
+		return;
+
+	if(getMemoryUsage() + sizeof(OutfitCacheEntry) > m_memoryLimit)
+	{
+		//Reuse the least recently used entry instead of allocating a new one
+		m_index.erase(m_entries.back().key);
+		m_entries.splice(m_entries.begin(), m_entries, std::prev(m_entries.end()));
+		m_entries.front().key = key;
+	}
+	else
+		m_entries.emplace_front(key);
+
+	UTIL_FastCopy(SDL_reinterpret_cast(Uint8*, m_entries.front().pixels), SDL_reinterpret_cast(const Uint8*, pixels), 4096);
+	m_index[key] = m_entries.begin();
+}
@@ -24,6 +24,23 @@
 
 #include "defines.h"
 
+#include <deque>
+
+#define SPRITE_DECODE_MAX_THREADS 4
+#define SPRITE_CACHE_SIGNATURE 0x53434654
+#define SPRITE_CACHE_VERSION 1
+#define SPRITESHEET_MAX_RETRIES 5
+#define SPRITESHEET_RETRY_DELAY 250
+#define OUTFIT_CACHE_MEMORY (16 * 1024 * 1024)
+
+enum SpriteSheetState : Uint8
+{
+	SPRITESHEET_STATE_UNLOADED = 0,
+	SPRITESHEET_STATE_QUEUED = 1,
+	SPRITESHEET_STATE_RESIDENT = 2,
+	SPRITESHEET_STATE_FAILED = 3
+};
+
 struct SpriteData
 {
 	unsigned char data[4096];
@@ -40,13 +57,51 @@ struct SpriteSheet
 	SpriteSheet& operator=(const SpriteSheet&) = delete;
 
 	// move-constructible
-	SpriteSheet(SpriteSheet&& rhs) noexcept : spriteFile(std::move(rhs.spriteFile)), firstSpriteId(rhs.firstSpriteId), lastSpriteId(rhs.lastSpriteId), spriteType(rhs.spriteType) {}
+	SpriteSheet(SpriteSheet&& rhs) noexcept : spriteFile(std::move(rhs.spriteFile)), spriteData(std::move(rhs.spriteData)), mappedData(rhs.mappedData),
+		firstSpriteId(rhs.firstSpriteId), lastSpriteId(rhs.lastSpriteId), spriteType(rhs.spriteType), retryTicks(rhs.retryTicks), state(rhs.state), failures(rhs.failures), urgent(rhs.urgent) {}
 	SpriteSheet& operator=(SpriteSheet&&) = delete;
 
+	SDL_INLINE bool isResident() {return (state == SPRITESHEET_STATE_RESIDENT);}
+	SDL_INLINE bool isRetryPending(Uint32 ticks) {return (state == SPRITESHEET_STATE_UNLOADED && failures > 0 && SDL_static_cast(Sint32, retryTicks - ticks) > 0);}
+	SDL_INLINE Uint32 getSpriteCount() {return (lastSpriteId - firstSpriteId + 1);}
+	SDL_INLINE SpriteData* getSprites() {return (spriteData ? spriteData.get() : mappedData);}
+
 	std::string spriteFile;
+	std::unique_ptr<SpriteData[]> spriteData;//Decoded sprites slab - [spriteId - firstSpriteId]
+	SpriteData* mappedData = NULL;//Read-only slab inside the disk cache mapping
 	Uint32 firstSpriteId;
 	Uint32 lastSpriteId;
 	Uint32 spriteType;
+	Uint32 retryTicks = 0;//Failed decodes aren't retried before this time
+	SpriteSheetState state = SPRITESHEET_STATE_UNLOADED;
+	Uint8 failures = 0;
+	bool urgent = false;
+};
+
+struct SpriteSheetJob
+{
+	SpriteSheetJob(const SpriteSheet& sheet, Uint32 sheetIndex, bool bgra) :
+		spriteFile(sheet.spriteFile), sheetIndex(sheetIndex), sheetSprites(sheet.lastSpriteId - sheet.firstSpriteId + 1), spriteType(sheet.spriteType), bgra(bgra) {}
+
+	std::string spriteFile;
+	Uint32 sheetIndex;
+	Uint32 sheetSprites;
+	Uint32 spriteType;
+	bool bgra;
+};
+
+struct SpriteSheetResult
+{
+	SpriteSheetResult(Uint32 sheetIndex, SpriteData* spriteData) : spriteData(spriteData), sheetIndex(sheetIndex) {}
+
+	std::unique_ptr<SpriteData[]> spriteData;
+	Uint32 sheetIndex;
+};
+
+struct SpriteLocation
+{
+	Uint32 offset;//Offset to the RLE pixel runs inside the .spr mapping
+	Uint32 size;//Size of the RLE pixel runs - 0 for empty sprites
 };
 
 struct SpriteOffset
@@ -55,6 +110,72 @@ struct SpriteOffset
 	Uint32 spriteType;
 };
 
+struct OutfitCacheKey
+{
+	OutfitCacheKey(Uint32 spriteId, Uint32 maskSpriteId, Uint32 outfitColor, bool bgra) :
+		spriteId(spriteId), maskSpriteId(maskSpriteId), outfitColor(outfitColor), bgra(bgra) {}
+
+	bool operator==(const OutfitCacheKey& rhs) const
+	{
+		return (spriteId == rhs.spriteId && maskSpriteId == rhs.maskSpriteId && outfitColor == rhs.outfitColor && bgra == rhs.bgra);
+	}
+
+	Uint32 spriteId;
+	Uint32 maskSpriteId;
+	Uint32 outfitColor;
+	bool bgra;
+};
+
+struct OutfitCacheKeyHash
+{
+	size_t operator()(const OutfitCacheKey& key) const
+	{
+		Uint64 sprites = SDL_static_cast(Uint64, key.spriteId) | (SDL_static_cast(Uint64, key.maskSpriteId) << 32);
+		Uint64 colors = SDL_static_cast(Uint64, key.outfitColor) | (SDL_static_cast(Uint64, key.bgra) << 32);
+		return robin_hood::hash_int(sprites ^ (colors * 0x9E3779B97F4A7C15ULL));
+	}
+};
+
+struct OutfitCacheEntry
+{
+	OutfitCacheEntry(const OutfitCacheKey& key) : key(key) {}
+
+	OutfitCacheKey key;
+	unsigned char pixels[4096];
+};
+
+class OutfitCache
+{
+	public:
+		OutfitCache() = default;
+
+		// non-copyable
+		OutfitCache(const OutfitCache&) = delete;
+		OutfitCache& operator=(const OutfitCache&) = delete;
+
+		// non-moveable
+		OutfitCache(OutfitCache&&) = delete;
+		OutfitCache& operator=(OutfitCache&&) = delete;
+
+		void clear();
+		void setMemoryLimit(size_t memoryLimit);
+
+		unsigned char* getPixels(const OutfitCacheKey& key);
+		void storePixels(const OutfitCacheKey& key, const unsigned char* pixels);
+
+		SDL_INLINE size_t getMemoryLimit() {return m_memoryLimit;}
+		SDL_INLINE size_t getMemoryUsage() {return m_entries.size() * sizeof(OutfitCacheEntry);}
+		SDL_INLINE Uint32 getHits() {return m_hits;}
+		SDL_INLINE Uint32 getMisses() {return m_misses;}
+
+	private:
+		std::list<OutfitCacheEntry> m_entries;//Most recently used first
+		robin_hood::unordered_map<OutfitCacheKey, std::list<OutfitCacheEntry>::iterator, OutfitCacheKeyHash> m_index;
+		size_t m_memoryLimit = OUTFIT_CACHE_MEMORY;
+		Uint32 m_hits = 0;
+		Uint32 m_misses = 0;
+};
+
 class SpriteManager
 {
 	public:
@@ -75,23 +196,68 @@ class SpriteManager
 
 		unsigned char* LoadSpriteSheet_BMP(const std::string& spriteFile, size_t& outputSize);
 		void SplitSpriteSheet(SDL_Surface* sheet, unsigned char* destData, Sint32 x, Sint32 y);
+		SpriteData* DecodeSpriteSheet(const std::string& spriteFile, Uint32 spriteType, Uint32 sheetSprites, bool bgra);
 		bool LoadSpriteSheet(Uint32 spriteId, bool bgra);
 		unsigned char* LoadSprite_NEW(Uint32 spriteId, bool bgra);
 
+		unsigned char* LoadSprite_SPR(Uint32 spriteId, bool bgra);
 		unsigned char* LoadSprite_RGBA(Uint32 spriteId);
 		unsigned char* LoadSprite_BGRA(Uint32 spriteId);
 
 		bool loadSprites(const char* filename);
+		void benchmarkSprites(const char* filename);
 		bool loadCatalog(const char* filename);
 
+		SDL_INLINE OutfitCache& getOutfitCache() {return m_outfitCache;}
+		SDL_INLINE Uint32 getResidentSheets() {return m_residentSheets;}
+		SDL_INLINE size_t getResidentMemory() {return m_residentSprites * sizeof(SpriteData);}
+
+		void initDecoders();
+		void shutdownDecoders();
+		void updateSheets();
+		void prefetchSprites(const std::vector<Uint32>& sprites);
+		bool isSpriteReady(Uint32 spriteId);
+		int decodeSheets();
+
+		void openDiskCache();
+		void closeDiskCache();
+		void storeSpriteSheet(const std::string& spriteFile, Uint32 spriteType, Uint32 sheetSprites, SpriteData* spriteData);
+
+	protected:
+		SpriteSheet* getSpriteSheet(Uint32 spriteId);
+		void queueSpriteSheet(Uint32 sheetIndex, bool urgent);
+		void failSpriteSheet(SpriteSheet& spriteSheet);
+
 	private:
-		std::map<Uint32, SpriteData> m_spriteData;
 		std::vector<SpriteSheet> m_spriteSheets;
 		std::vector<SpriteOffset> m_spriteOffsets;
+		std::vector<Uint32> m_spriteSheetIndex;//spriteId -> index to m_spriteSheets
+		std::vector<SpriteLocation> m_spriteLocations;//spriteId - 1 -> RLE pixel runs inside m_sprMapping
 		SDL_RWops* m_cachedSprites = NULL;
+		unsigned char* m_sprMapping = NULL;
+		size_t m_sprMappingSize = 0;
+
+		std::vector<SDL_Thread*> m_decodeThreads;
+		std::deque<SpriteSheetJob> m_decodeQueue;
+		std::vector<SpriteSheetResult> m_decodedSheets;
+		SDL_mutex* m_decodeMutex = NULL;
+		SDL_cond* m_decodeCond = NULL;
+
+		OutfitCache m_outfitCache;
+
+		SDL_RWops* m_cacheData = NULL;
+		SDL_RWops* m_cacheIndex = NULL;
+		SDL_mutex* m_cacheMutex = NULL;
+		unsigned char* m_cacheMapping = NULL;
+		size_t m_cacheMappingSize = 0;
+		Uint32 m_catalogKey = 0;
+
+		Uint32 m_residentSheets = 0;
+		Uint32 m_residentSprites = 0;
+		bool m_decodeBGRA = true;
+		bool m_decodeExiting = false;
 
 		bool m_sprLoaded = false;
-		bool m_sprCached = false;
 };
 
 #endif /* __FILE_SPRITEMANAGER_h_ */
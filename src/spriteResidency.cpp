@@ -0,0 +1,224 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "spriteResidency.h"
+
+void SpriteResidency::init(Uint32 capacity)
+{
+	m_slots.assign(SDL_static_cast(size_t, capacity), SpriteResidencySlot());
+	m_index.clear();
+	m_index.reserve(SDL_static_cast(size_t, capacity));
+	clear();
+	m_hits = 0;
+	m_misses = 0;
+	m_evictions = 0;
+}
+
+void SpriteResidency::clear()
+{
+	//Hand out the slots in order so that atlases get filled from the start
+	Uint32 capacity = getCapacity();
+	m_freeSlots.resize(SDL_static_cast(size_t, capacity));
+	for(Uint32 i = 0; i < capacity; ++i)
+	{
+		m_slots[i] = SpriteResidencySlot();
+		m_freeSlots[i] = capacity - i - 1;
+	}
+
+	m_index.clear();
+	m_clockHand = 0;
+	m_clockScans = 0;
+}
+
+void SpriteResidency::release()
+{
+	std::vector<SpriteResidencySlot>().swap(m_slots);
+	std::vector<Uint32>().swap(m_freeSlots);
+	m_index.clear();
+	m_clockHand = 0;
+	m_clockScans = 0;
+}
+
+void SpriteResidency::nextFrame()
+{
+	++m_currentFrame;
+	m_clockScans = 0;
+}
+
+Uint32 SpriteResidency::touch(Uint64 key)
+{
+	auto it = m_index.find(key);
+	if(it == m_index.end())
+		return SPRITE_RESIDENCY_NONE;
+
+	SpriteResidencySlot& slot = m_slots[it->second];
+	slot.lastUsage = m_currentFrame;
+	slot.referenced = true;
+	++m_hits;
+	return it->second;
+}
+
+Uint32 SpriteResidency::insert(Uint64 key, bool& inUse)
+{
+	inUse = false;
+	auto it = m_index.find(key);
+	if(it != m_index.end())
+		return it->second;
+
+	Uint32 capacity = getCapacity();
+	if(capacity == 0)
+		return SPRITE_RESIDENCY_NONE;
+
+	++m_misses;
+	Uint32 slotIndex;
+	if(!m_freeSlots.empty())
+	{
+		slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		//Every slot gets at most two looks per frame - once we run out of them we take whatever
+		//the hand points to and let the caller know it might still be needed for this frame
+		while(true)
+		{
+			slotIndex = m_clockHand;
+			if(++m_clockHand >= capacity)
+				m_clockHand = 0;
+
+			SpriteResidencySlot& slot = m_slots[slotIndex];
+			if(m_clockScans < capacity * 2)
+			{
+				++m_clockScans;
+				if(slot.lastUsage == m_currentFrame)
+					continue;
+				else if(slot.referenced)
+				{
+					slot.referenced = false;
+					continue;
+				}
+			}
+
+			inUse = (slot.lastUsage == m_currentFrame);
+			m_index.erase(slot.key);
+			++m_evictions;
+			break;
+		}
+	}
+
+	SpriteResidencySlot& slot = m_slots[slotIndex];
+	slot.key = key;
+	slot.lastUsage = m_currentFrame;
+	slot.referenced = false;
+	m_index[key] = slotIndex;
+	return slotIndex;
+}
+
+void SpriteResidency::erase(Uint64 key)
+{
+	auto it = m_index.find(key);
+	if(it == m_index.end())
+		return;
+
+	SpriteResidencySlot& slot = m_slots[it->second];
+	slot = SpriteResidencySlot();
+	m_freeSlots.push_back(it->second);
+	m_index.erase(it);
+}
+
+static Sint32 SPRITERESIDENCY_check(const char* name, bool passed)
+{
+	SDL_Log("Self-test SpriteResidency %s: %s", name, (passed ? "passed" : "FAILED"));
+	return (passed ? 0 : 1);
+}
+
+Sint32 SpriteResidency::selfTest()
+{
+	Sint32 failures = 0;
+	bool inUse;
+
+	//Free slots are handed out in order and the hand then evicts them in the same order
+	{
+		SpriteResidency residency;
+		residency.init(4);
+		bool ordered = true;
+		for(Uint64 key = 1; key <= 4; ++key)
+			ordered = (ordered && residency.insert(key, inUse) == SDL_static_cast(Uint32, key - 1) && !inUse);
+
+		residency.nextFrame();
+		ordered = (ordered && residency.insert(5, inUse) == 0 && !inUse);
+		ordered = (ordered && residency.insert(6, inUse) == 1 && !inUse);
+		ordered = (ordered && residency.touch(1) == SPRITE_RESIDENCY_NONE && residency.touch(2) == SPRITE_RESIDENCY_NONE);
+		ordered = (ordered && residency.touch(3) == 2 && residency.getEvictions() == 2);
+		failures += SPRITERESIDENCY_check("eviction order", ordered);
+	}
+
+	//Sprite referenced in an earlier frame survives one pass of the hand
+	{
+		SpriteResidency residency;
+		residency.init(4);
+		for(Uint64 key = 1; key <= 4; ++key)
+			residency.insert(key, inUse);
+
+		residency.nextFrame();
+		residency.touch(1);
+		residency.nextFrame();
+		bool secondChance = (residency.insert(5, inUse) == 1 && !inUse);
+		secondChance = (secondChance && residency.touch(2) == SPRITE_RESIDENCY_NONE && residency.touch(1) == 0);
+		failures += SPRITERESIDENCY_check("second chance", secondChance);
+	}
+
+	//Sprites used in the current frame are pinned while anything else can be evicted
+	{
+		SpriteResidency residency;
+		residency.init(4);
+		for(Uint64 key = 1; key <= 4; ++key)
+			residency.insert(key, inUse);
+
+		residency.nextFrame();
+		residency.touch(1);
+		residency.touch(2);
+		bool pinned = (residency.insert(5, inUse) == 2 && !inUse);
+		pinned = (pinned && residency.touch(1) == 0 && residency.touch(2) == 1 && residency.touch(3) == SPRITE_RESIDENCY_NONE);
+		failures += SPRITERESIDENCY_check("pinning", pinned);
+	}
+
+	//Frame that needs more sprites than the budget reuses a pinned slot and reports it
+	{
+		SpriteResidency residency;
+		residency.init(4);
+		for(Uint64 key = 1; key <= 4; ++key)
+			residency.insert(key, inUse);
+
+		Uint32 slotIndex = residency.insert(5, inUse);
+		bool budget = (slotIndex < 4 && inUse && residency.getResident() == 4 && residency.getEvictions() == 1);
+		budget = (budget && residency.touch(SDL_static_cast(Uint64, slotIndex) + 1) == SPRITE_RESIDENCY_NONE && residency.touch(5) == slotIndex);
+
+		//Erased sprite gives its slot back without evicting anything
+		residency.erase(5);
+		budget = (budget && residency.insert(6, inUse) == slotIndex && !inUse && residency.getEvictions() == 1);
+
+		residency.init(0);
+		budget = (budget && residency.insert(7, inUse) == SPRITE_RESIDENCY_NONE);
+		failures += SPRITERESIDENCY_check("budget boundary", budget);
+	}
+	return failures;
+}
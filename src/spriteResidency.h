@@ -0,0 +1,80 @@
+/*
+  The Forgotten Client
+  Copyright (C) 2020 Saiyans King
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __FILE_SPRITERESIDENCY_h_
+#define __FILE_SPRITERESIDENCY_h_
+
+#include "defines.h"
+
+#define SPRITE_RESIDENCY_NONE SDL_MAX_UINT32
+
+struct SpriteResidencySlot
+{
+	Uint64 key = 0;
+	Uint32 lastUsage = 0;
+	bool referenced = false;
+};
+
+//Maps sprites to a fixed number of renderer slots(atlas cells, surfaces etc.)
+//and picks which slot to reuse with the CLOCK(second chance) policy
+class SpriteResidency
+{
+	public:
+		SpriteResidency() = default;
+
+		// non-copyable
+		SpriteResidency(const SpriteResidency&) = delete;
+		SpriteResidency& operator=(const SpriteResidency&) = delete;
+
+		// non-moveable
+		SpriteResidency(SpriteResidency&&) = delete;
+		SpriteResidency& operator=(SpriteResidency&&) = delete;
+
+		void init(Uint32 capacity);
+		void clear();
+		void release();
+		void nextFrame();
+
+		Uint32 touch(Uint64 key);
+		Uint32 insert(Uint64 key, bool& inUse);
+		void erase(Uint64 key);
+
+		SDL_INLINE Uint32 getCapacity() {return SDL_static_cast(Uint32, m_slots.size());}
+		SDL_INLINE Uint32 getResident() {return SDL_static_cast(Uint32, m_index.size());}
+		SDL_INLINE Uint32 getHits() {return m_hits;}
+		SDL_INLINE Uint32 getMisses() {return m_misses;}
+		SDL_INLINE Uint32 getEvictions() {return m_evictions;}
+
+		static Sint32 selfTest();
+
+	private:
+		std::vector<SpriteResidencySlot> m_slots;
+		std::vector<Uint32> m_freeSlots;
+		robin_hood::unordered_map<Uint64, Uint32> m_index;
+		Uint32 m_clockHand = 0;
+		Uint32 m_clockScans = 0;
+		Uint32 m_currentFrame = 0;
+		Uint32 m_hits = 0;
+		Uint32 m_misses = 0;
+		Uint32 m_evictions = 0;
+};
+
+#endif /* __FILE_SPRITERESIDENCY_h_ */
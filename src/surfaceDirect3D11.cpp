@@ -182,7 +182,6 @@ SurfaceDirect3D11::SurfaceDirect3D11()
 	#endif
 
 	m_vertices.reserve(DIRECT3D11_MAX_VERTICES);
-	m_sprites.reserve(MAX_SPRITES);
 	m_automapTiles.reserve(MAX_AUTOMAPTILES);
 }
 
@@ -208,9 +207,9 @@ SurfaceDirect3D11::~SurfaceDirect3D11()
 	for(std::vector<Direct3D11Texture>::iterator it = m_spritesAtlas.begin(), end = m_spritesAtlas.end(); it != end; ++it)
 		releaseDirect3DTexture((*it));
 
-	m_sprites.clear();
 	m_spritesAtlas.clear();
-	m_spritesIds.clear();
+	m_spriteSlots.clear();
+	m_spriteResidency.release();
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
 	ID3D11Buffer* indexBuffer = SDL_reinterpret_cast(ID3D11Buffer*, m_indexBuffer);
@@ -1300,27 +1299,28 @@ void SurfaceDirect3D11::doResize(Sint32, Sint32)
 
 void SurfaceDirect3D11::generateSpriteAtlases()
 {
-	if(m_maxTextureSize >= 16384 && MAX_SPRITES > 65536)
+	Uint32 maxSprites = g_engine.getSpriteBudget();
+	if(m_maxTextureSize >= 16384 && maxSprites > 65536)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 262143) / 262144;
+		m_spriteAtlases = (maxSprites + 262143) / 262144;
 		m_spritesPerAtlas = 262144;
 		m_spritesPerModulo = 16384;
 	}
-	else if(m_maxTextureSize >= 8192 && MAX_SPRITES > 16384)
+	else if(m_maxTextureSize >= 8192 && maxSprites > 16384)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 65535) / 65536;
+		m_spriteAtlases = (maxSprites + 65535) / 65536;
 		m_spritesPerAtlas = 65536;
 		m_spritesPerModulo = 8192;
 	}
-	else if(m_maxTextureSize >= 4096 && MAX_SPRITES > 4096)
+	else if(m_maxTextureSize >= 4096 && maxSprites > 4096)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 16383) / 16384;
+		m_spriteAtlases = (maxSprites + 16383) / 16384;
 		m_spritesPerAtlas = 16384;
 		m_spritesPerModulo = 4096;
 	}
 	else
 	{
-		m_spriteAtlases = (MAX_SPRITES + 4095) / 4096;
+		m_spriteAtlases = (maxSprites + 4095) / 4096;
 		m_spritesPerAtlas = 4096;
 		m_spritesPerModulo = 2048;
 	}
@@ -1334,6 +1334,17 @@ void SurfaceDirect3D11::generateSpriteAtlases()
 			exit(-1);
 		}
 	}
+
+	m_spriteSlots.resize(maxSprites);
+	for(Uint32 i = 0; i < maxSprites; ++i)
+	{
+		Uint32 spriteIndex = (i % m_spritesPerAtlas) * 32;
+		Direct3D11SpriteData& sprData = m_spriteSlots[i];
+		sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
+		sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
+		sprData.m_surface = i / m_spritesPerAtlas;
+	}
+	m_spriteResidency.init(maxSprites);
 }
 
 void SurfaceDirect3D11::spriteManagerReset()
@@ -1344,9 +1355,9 @@ void SurfaceDirect3D11::spriteManagerReset()
 	for(std::vector<Direct3D11Texture>::iterator it = m_spritesAtlas.begin(), end = m_spritesAtlas.end(); it != end; ++it)
 		releaseDirect3DTexture((*it));
 
-	m_sprites.clear();
 	m_spritesAtlas.clear();
-	m_spritesIds.clear();
+	m_spriteSlots.clear();
+	m_spriteResidency.release();
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
 	generateSpriteAtlases();
@@ -1452,8 +1463,7 @@ unsigned char* SurfaceDirect3D11::getScreenPixels(Sint32& width, Sint32& height,
 
 void SurfaceDirect3D11::beginScene()
 {
-	m_spriteChecker = 0;
-	++m_currentFrame;
+	m_spriteResidency.nextFrame();
 	if(m_needReset)
 	{
 		m_currentRenderTargetView = NULL;
@@ -2451,81 +2461,35 @@ void SurfaceDirect3D11::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w
 	Uint32 xOffset;
 	Uint32 yOffset;
 	Direct3D11Texture* tex;
-	U64BD3D11Textures::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
-		if(m_sprites.size() >= MAX_SPRITES)
-		{
-			while(++m_spriteChecker < MAX_SPRITES)
-			{
-				Uint64 oldSpriteId = m_spritesIds.front();
-				it = m_sprites.find(oldSpriteId);
-				if(it == m_sprites.end())
-				{
-					UTIL_MessageBox(true, "Direct3D11: Sprite Manager failure.");
-					exit(-1);
-				}
+		if(!g_engine.isSpriteReady(spriteId))
+			return;//Still decoding in background
 
-				m_spritesIds.pop_front();
-				if(it->second.m_lastUsage == m_currentFrame)
-					m_spritesIds.push_back(oldSpriteId);
-				else
-					goto Skip_Search;
-			}
-			scheduleBatch();
+		bool slotInUse;
+		spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+		if(spriteSlot == SPRITE_RESIDENCY_NONE)
+			return;
+		else if(slotInUse)
+			scheduleBatch();//Pending draws still use the sprite we replace
 
-			it = m_sprites.find(m_spritesIds.front());
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "Direct3D11: Sprite Manager failure.");
-				exit(-1);
-			}
-			m_spritesIds.pop_front();
-
-			Skip_Search:
-			Direct3D11SpriteData sprData = it->second;
-			sprData.m_lastUsage = m_currentFrame;
-			m_sprites.erase(it);
-			m_sprites[tempPos] = sprData;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
-		else
-		{
-			Uint32 spriteIndex = SDL_static_cast(Uint32, m_sprites.size());
-			Uint32 spriteAtlas = spriteIndex / m_spritesPerAtlas;
-			spriteIndex = (spriteIndex % m_spritesPerAtlas) * 32;
-			if(spriteAtlas >= m_spritesAtlas.size())
-				return;
-
-			Direct3D11SpriteData& sprData = m_sprites[tempPos];
-			sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
-			sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
-			sprData.m_surface = spriteAtlas;
-			sprData.m_lastUsage = m_currentFrame;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
+		Direct3D11SpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 		if(!loadSprite(spriteId, tex, xOffset, yOffset))
+		{
+			m_spriteResidency.erase(tempPos);
 			return;//load failed
+		}
 	}
 	else
 	{
-		xOffset = it->second.m_xOffset;
-		yOffset = it->second.m_yOffset;
-		tex = &m_spritesAtlas[it->second.m_surface];
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
+		Direct3D11SpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 	}
 
 	float minx = SDL_static_cast(float, x);
@@ -2576,81 +2540,37 @@ void SurfaceDirect3D11::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sin
 	Uint32 xOffset;
 	Uint32 yOffset;
 	Direct3D11Texture* tex;
-	U64BD3D11Textures::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
-		if(m_sprites.size() >= MAX_SPRITES)
-		{
-			while(++m_spriteChecker < MAX_SPRITES)
-			{
-				Uint64 oldSpriteId = m_spritesIds.front();
-				it = m_sprites.find(oldSpriteId);
-				if(it == m_sprites.end())
-				{
-					UTIL_MessageBox(true, "Direct3D11: Sprite Manager failure.");
-					exit(-1);
-				}
+		//Wait for both sprites to be decoded before we reserve the cache slot
+		bool spriteReady = g_engine.isSpriteReady(spriteId);
+		if(!g_engine.isSpriteReady(maskSpriteId) || !spriteReady)
+			return;
 
-				m_spritesIds.pop_front();
-				if(it->second.m_lastUsage == m_currentFrame)
-					m_spritesIds.push_back(oldSpriteId);
-				else
-					goto Skip_Search;
-			}
-			scheduleBatch();
+		bool slotInUse;
+		spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+		if(spriteSlot == SPRITE_RESIDENCY_NONE)
+			return;
+		else if(slotInUse)
+			scheduleBatch();//Pending draws still use the sprite we replace
 
-			it = m_sprites.find(m_spritesIds.front());
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "Direct3D11: Sprite Manager failure.");
-				exit(-1);
-			}
-			m_spritesIds.pop_front();
-
-			Skip_Search:
-			Direct3D11SpriteData sprData = it->second;
-			sprData.m_lastUsage = m_currentFrame;
-			m_sprites.erase(it);
-			m_sprites[tempPos] = sprData;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
-		else
-		{
-			Uint32 spriteIndex = SDL_static_cast(Uint32, m_sprites.size());
-			Uint32 spriteAtlas = spriteIndex / m_spritesPerAtlas;
-			spriteIndex = (spriteIndex % m_spritesPerAtlas) * 32;
-			if(spriteAtlas >= m_spritesAtlas.size())
-				return;
-
-			Direct3D11SpriteData& sprData = m_sprites[tempPos];
-			sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
-			sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
-			sprData.m_surface = spriteAtlas;
-			sprData.m_lastUsage = m_currentFrame;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
+		Direct3D11SpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 		if(!loadSpriteMask(spriteId, maskSpriteId, outfitColor, tex, xOffset, yOffset))
+		{
+			m_spriteResidency.erase(tempPos);
 			return;//load failed
+		}
 	}
 	else
 	{
-		xOffset = it->second.m_xOffset;
-		yOffset = it->second.m_yOffset;
-		tex = &m_spritesAtlas[it->second.m_surface];
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
+		Direct3D11SpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 	}
 
 	float minx = SDL_static_cast(float, x);
@@ -101,16 +101,14 @@ struct Direct3D11Texture
 
 struct Direct3D11SpriteData
 {
-	Direct3D11SpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	Direct3D11SpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 typedef robin_hood::unordered_map<Uint32, Direct3D11Texture> U32BD3D11Textures;
-typedef robin_hood::unordered_map<Uint64, Direct3D11SpriteData> U64BD3D11Textures;
 
 class SurfaceDirect3D11 : public Surface
 {
@@ -193,9 +191,8 @@ class SurfaceDirect3D11 : public Surface
 		std::vector<VertexD3D11> m_vertices;
 		std::vector<Direct3D11Texture> m_spritesAtlas;
 		U32BD3D11Textures m_automapTiles;
-		U64BD3D11Textures m_sprites;
+		std::vector<Direct3D11SpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		Direct3D11Texture* m_pictures = NULL;
 		char* m_software = "Direct3D";
@@ -245,8 +242,6 @@ class SurfaceDirect3D11 : public Surface
 		Sint32 m_integer_scaling_height = 0;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedVertices = 0;
 
 		Uint32 m_spriteAtlases = 0;
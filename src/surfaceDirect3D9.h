@@ -86,16 +86,14 @@ struct Direct3D9Texture
 
 struct Direct3D9SpriteData
 {
-	Direct3D9SpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	Direct3D9SpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 typedef robin_hood::unordered_map<Uint32, Direct3D9Texture> U32BD3D9Textures;
-typedef robin_hood::unordered_map<Uint64, Direct3D9SpriteData> U64BD3D9Textures;
 
 typedef struct IDirect3D9 IDirect3D9;
 typedef struct IDirect3D9Ex IDirect3D9Ex;
@@ -187,9 +185,8 @@ class SurfaceDirect3D9 : public Surface
 		#endif
 		std::vector<Direct3D9Texture> m_spritesAtlas;
 		U32BD3D9Textures m_automapTiles;
-		U64BD3D9Textures m_sprites;
+		std::vector<Direct3D9SpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		Direct3D9Texture* m_pictures = NULL;
 		char* m_software = "Direct3D 9.0";
@@ -221,8 +218,6 @@ class SurfaceDirect3D9 : public Surface
 		Uint32 m_viewPortH = 0;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedVertices = 0;
 
 		Uint32 m_spriteAtlases = 0;
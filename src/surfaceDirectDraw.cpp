@@ -59,7 +59,6 @@ SurfaceDirectDraw::SurfaceDirectDraw()
 	}
 
 	m_vertices.reserve(DIRECTDRAW_MAX_VERTICES);
-	m_sprites.reserve(MAX_SPRITES);
 	m_automapTiles.reserve(MAX_AUTOMAPTILES);
 }
 
@@ -88,9 +87,9 @@ SurfaceDirectDraw::~SurfaceDirectDraw()
 	for(std::vector<DirectDrawTexture>::iterator it = m_spritesAtlas.begin(), end = m_spritesAtlas.end(); it != end; ++it)
 		releaseDirectDrawTexture((*it));
 
-	m_sprites.clear();
 	m_spritesAtlas.clear();
-	m_spritesIds.clear();
+	m_spriteSlots.clear();
+	m_spriteResidency.release();
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
 	if(m_scaled_gameWindow)
@@ -669,33 +668,34 @@ void SurfaceDirectDraw::renderTargetsRecreate()
 
 void SurfaceDirectDraw::generateSpriteAtlases()
 {
-	if(m_maxTextureSize >= 16384 && MAX_SPRITES > 65536)
+	Uint32 maxSprites = g_engine.getSpriteBudget();
+	if(m_maxTextureSize >= 16384 && maxSprites > 65536)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 262143) / 262144;
+		m_spriteAtlases = (maxSprites + 262143) / 262144;
 		m_spritesPerAtlas = 262144;
 		m_spritesPerModulo = 16384;
 	}
-	else if(m_maxTextureSize >= 8192 && MAX_SPRITES > 16384)
+	else if(m_maxTextureSize >= 8192 && maxSprites > 16384)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 65535) / 65536;
+		m_spriteAtlases = (maxSprites + 65535) / 65536;
 		m_spritesPerAtlas = 65536;
 		m_spritesPerModulo = 8192;
 	}
-	else if(m_maxTextureSize >= 4096 && MAX_SPRITES > 4096)
+	else if(m_maxTextureSize >= 4096 && maxSprites > 4096)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 16383) / 16384;
+		m_spriteAtlases = (maxSprites + 16383) / 16384;
 		m_spritesPerAtlas = 16384;
 		m_spritesPerModulo = 4096;
 	}
-	else if(m_maxTextureSize >= 2048 && MAX_SPRITES > 1024)
+	else if(m_maxTextureSize >= 2048 && maxSprites > 1024)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 4095) / 4096;
+		m_spriteAtlases = (maxSprites + 4095) / 4096;
 		m_spritesPerAtlas = 4096;
 		m_spritesPerModulo = 2048;
 	}
 	else
 	{
-		m_spriteAtlases = (MAX_SPRITES + 1023) / 1024;
+		m_spriteAtlases = (maxSprites + 1023) / 1024;
 		m_spritesPerAtlas = 1024;
 		m_spritesPerModulo = 1024;
 	}
@@ -709,6 +709,17 @@ void SurfaceDirectDraw::generateSpriteAtlases()
 			exit(-1);
 		}
 	}
+
+	m_spriteSlots.resize(maxSprites);
+	for(Uint32 i = 0; i < maxSprites; ++i)
+	{
+		Uint32 spriteIndex = (i % m_spritesPerAtlas) * 32;
+		DirectDrawSpriteData& sprData = m_spriteSlots[i];
+		sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
+		sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
+		sprData.m_surface = i / m_spritesPerAtlas;
+	}
+	m_spriteResidency.init(maxSprites);
 }
 
 void SurfaceDirectDraw::init()
@@ -751,9 +762,9 @@ void SurfaceDirectDraw::spriteManagerReset()
 	for(std::vector<DirectDrawTexture>::iterator it = m_spritesAtlas.begin(), end = m_spritesAtlas.end(); it != end; ++it)
 		releaseDirectDrawTexture((*it));
 
-	m_sprites.clear();
 	m_spritesAtlas.clear();
-	m_spritesIds.clear();
+	m_spriteSlots.clear();
+	m_spriteResidency.release();
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
 	generateSpriteAtlases();
@@ -788,8 +799,7 @@ unsigned char* SurfaceDirectDraw::getScreenPixels(Sint32& width, Sint32& height,
 
 void SurfaceDirectDraw::beginScene()
 {
-	m_spriteChecker = 0;
-	++m_currentFrame;
+	m_spriteResidency.nextFrame();
 	if(m_needReset)
 	{
 		resetRenderer();
@@ -1729,81 +1739,35 @@ void SurfaceDirectDraw::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w
 	Uint32 xOffset;
 	Uint32 yOffset;
 	DirectDrawTexture* tex;
-	U64BDDRAWTextures::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
-		if(m_sprites.size() >= MAX_SPRITES)
-		{
-			while(++m_spriteChecker < MAX_SPRITES)
-			{
-				Uint64 oldSpriteId = m_spritesIds.front();
-				it = m_sprites.find(oldSpriteId);
-				if(it == m_sprites.end())
-				{
-					UTIL_MessageBox(true, "DirectDraw: Sprite Manager failure.");
-					exit(-1);
-				}
+		if(!g_engine.isSpriteReady(spriteId))
+			return;//Still decoding in background
 
-				m_spritesIds.pop_front();
-				if(it->second.m_lastUsage == m_currentFrame)
-					m_spritesIds.push_back(oldSpriteId);
-				else
-					goto Skip_Search;
-			}
-			scheduleBatch();
+		bool slotInUse;
+		spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+		if(spriteSlot == SPRITE_RESIDENCY_NONE)
+			return;
+		else if(slotInUse)
+			scheduleBatch();//Pending draws still use the sprite we replace
 
-			it = m_sprites.find(m_spritesIds.front());
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "DirectDraw: Sprite Manager failure.");
-				exit(-1);
-			}
-			m_spritesIds.pop_front();
-
-			Skip_Search:
-			DirectDrawSpriteData sprData = it->second;
-			sprData.m_lastUsage = m_currentFrame;
-			m_sprites.erase(it);
-			m_sprites[tempPos] = sprData;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
-		else
-		{
-			Uint32 spriteIndex = SDL_static_cast(Uint32, m_sprites.size());
-			Uint32 spriteAtlas = spriteIndex / m_spritesPerAtlas;
-			spriteIndex = (spriteIndex % m_spritesPerAtlas) * 32;
-			if(spriteAtlas >= m_spritesAtlas.size())
-				return;
-
-			DirectDrawSpriteData& sprData = m_sprites[tempPos];
-			sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
-			sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
-			sprData.m_surface = spriteAtlas;
-			sprData.m_lastUsage = m_currentFrame;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
+		DirectDrawSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 		if(!loadSprite(spriteId, tex, xOffset, yOffset))
+		{
+			m_spriteResidency.erase(tempPos);
 			return;//load failed
+		}
 	}
 	else
 	{
-		xOffset = it->second.m_xOffset;
-		yOffset = it->second.m_yOffset;
-		tex = &m_spritesAtlas[it->second.m_surface];
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
+		DirectDrawSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 	}
 
 	float minx = SDL_static_cast(float, x);
@@ -1857,81 +1821,37 @@ void SurfaceDirectDraw::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sin
 	Uint32 xOffset;
 	Uint32 yOffset;
 	DirectDrawTexture* tex;
-	U64BDDRAWTextures::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
-		if(m_sprites.size() >= MAX_SPRITES)
-		{
-			while(++m_spriteChecker < MAX_SPRITES)
-			{
-				Uint64 oldSpriteId = m_spritesIds.front();
-				it = m_sprites.find(oldSpriteId);
-				if(it == m_sprites.end())
-				{
-					UTIL_MessageBox(true, "DirectDraw: Sprite Manager failure.");
-					exit(-1);
-				}
+		//Wait for both sprites to be decoded before we reserve the cache slot
+		bool spriteReady = g_engine.isSpriteReady(spriteId);
+		if(!g_engine.isSpriteReady(maskSpriteId) || !spriteReady)
+			return;
 
-				m_spritesIds.pop_front();
-				if(it->second.m_lastUsage == m_currentFrame)
-					m_spritesIds.push_back(oldSpriteId);
-				else
-					goto Skip_Search;
-			}
-			scheduleBatch();
+		bool slotInUse;
+		spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+		if(spriteSlot == SPRITE_RESIDENCY_NONE)
+			return;
+		else if(slotInUse)
+			scheduleBatch();//Pending draws still use the sprite we replace
 
-			it = m_sprites.find(m_spritesIds.front());
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "DirectDraw: Sprite Manager failure.");
-				exit(-1);
-			}
-			m_spritesIds.pop_front();
-
-			Skip_Search:
-			DirectDrawSpriteData sprData = it->second;
-			sprData.m_lastUsage = m_currentFrame;
-			m_sprites.erase(it);
-			m_sprites[tempPos] = sprData;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
-		else
-		{
-			Uint32 spriteIndex = SDL_static_cast(Uint32, m_sprites.size());
-			Uint32 spriteAtlas = spriteIndex / m_spritesPerAtlas;
-			spriteIndex = (spriteIndex % m_spritesPerAtlas) * 32;
-			if(spriteAtlas >= m_spritesAtlas.size())
-				return;
-
-			DirectDrawSpriteData& sprData = m_sprites[tempPos];
-			sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
-			sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
-			sprData.m_surface = spriteAtlas;
-			sprData.m_lastUsage = m_currentFrame;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
+		DirectDrawSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 		if(!loadSpriteMask(spriteId, maskSpriteId, outfitColor, tex, xOffset, yOffset))
+		{
+			m_spriteResidency.erase(tempPos);
 			return;//load failed
+		}
 	}
 	else
 	{
-		xOffset = it->second.m_xOffset;
-		yOffset = it->second.m_yOffset;
-		tex = &m_spritesAtlas[it->second.m_surface];
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
+		DirectDrawSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 	}
 
 	float minx = SDL_static_cast(float, x);
@@ -84,16 +84,14 @@ struct DirectDrawTexture
 
 struct DirectDrawSpriteData
 {
-	DirectDrawSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	DirectDrawSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 typedef robin_hood::unordered_map<Uint32, DirectDrawTexture> U32BDDRAWTextures;
-typedef robin_hood::unordered_map<Uint64, DirectDrawSpriteData> U64BDDRAWTextures;
 
 typedef struct IDirectDraw IDirectDraw;
 typedef struct IDirectDraw7 IDirectDraw7;
@@ -182,9 +180,8 @@ class SurfaceDirectDraw : public Surface
 		std::vector<Uint16> m_indices;
 		std::vector<DirectDrawTexture> m_spritesAtlas;
 		U32BDDRAWTextures m_automapTiles;
-		U64BDDRAWTextures m_sprites;
+		std::vector<DirectDrawSpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		DirectDrawTexture m_stagging;
 		DirectDrawTexture* m_pictures = NULL;
@@ -217,8 +214,6 @@ class SurfaceDirectDraw : public Surface
 		Uint32 m_viewPortH = 0;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedVertices = 0;
 
 		Uint32 m_spriteAtlases = 0;
@@ -155,16 +155,14 @@ struct OpenglTexture
 
 struct OpenglSpriteData
 {
-	OpenglSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	OpenglSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 typedef robin_hood::unordered_map<Uint32, OpenglTexture> U32BGLTextures;
-typedef robin_hood::unordered_map<Uint64, OpenglSpriteData> U64BGLTextures;
 
 class SurfaceOpengl : public Surface
 {
@@ -252,9 +250,8 @@ class SurfaceOpengl : public Surface
 		#endif
 		std::vector<OpenglTexture> m_spritesAtlas;
 		U32BGLTextures m_automapTiles;
-		U64BGLTextures m_sprites;
+		std::vector<OpenglSpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		OpenglTexture* m_pictures = NULL;
 		char* m_software = NULL;
@@ -329,8 +326,6 @@ class SurfaceOpengl : public Surface
 		Sint32 m_integer_scaling_height = 0;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedVertices = 0;
 
 		Uint32 m_spriteAtlases = 0;
@@ -139,7 +139,6 @@ SurfaceOpenglCore::SurfaceOpenglCore()
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 
 	m_vertices.reserve(OPENGL_CORE_MAX_VERTICES);
-	m_sprites.reserve(MAX_SPRITES);
 	m_automapTiles.reserve(MAX_AUTOMAPTILES);
 }
 
@@ -182,9 +181,9 @@ SurfaceOpenglCore::~SurfaceOpenglCore()
 	for(std::vector<OpenglCoreTexture>::iterator it = m_spritesAtlas.begin(), end = m_spritesAtlas.end(); it != end; ++it)
 		releaseOpenGLCoreTexture((*it));
 
-	m_sprites.clear();
 	m_spritesAtlas.clear();
-	m_spritesIds.clear();
+	m_spriteSlots.clear();
+	m_spriteResidency.release();
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
 	if(m_scaled_gameWindow)
@@ -196,6 +195,12 @@ SurfaceOpenglCore::~SurfaceOpenglCore()
 	if(m_colorTexture)
 		releaseOpenGLCoreTexture(m_colorTexture);
 
+	for(Sint32 i = 0; i <= GAME_MAP_FLOORS; ++i)
+	{
+		if(m_staticLayers[i])
+			releaseOpenGLCoreTexture(m_staticLayers[i]);
+	}
+
 	SDL_GL_DeleteContext(m_oglContext);
 }
 
@@ -668,33 +673,34 @@ bool SurfaceOpenglCore::isSupported()
 
 void SurfaceOpenglCore::generateSpriteAtlases()
 {
-	if(m_maxTextureSize >= 16384 && MAX_SPRITES > 65536)
+	Uint32 maxSprites = g_engine.getSpriteBudget();
+	if(m_maxTextureSize >= 16384 && maxSprites > 65536)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 262143) / 262144;
+		m_spriteAtlases = (maxSprites + 262143) / 262144;
 		m_spritesPerAtlas = 262144;
 		m_spritesPerModulo = 16384;
 	}
-	else if(m_maxTextureSize >= 8192 && MAX_SPRITES > 16384)
+	else if(m_maxTextureSize >= 8192 && maxSprites > 16384)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 65535) / 65536;
+		m_spriteAtlases = (maxSprites + 65535) / 65536;
 		m_spritesPerAtlas = 65536;
 		m_spritesPerModulo = 8192;
 	}
-	else if(m_maxTextureSize >= 4096 && MAX_SPRITES > 4096)
+	else if(m_maxTextureSize >= 4096 && maxSprites > 4096)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 16383) / 16384;
+		m_spriteAtlases = (maxSprites + 16383) / 16384;
 		m_spritesPerAtlas = 16384;
 		m_spritesPerModulo = 4096;
 	}
-	else if(m_maxTextureSize >= 2048 && MAX_SPRITES > 1024)
+	else if(m_maxTextureSize >= 2048 && maxSprites > 1024)
 	{
-		m_spriteAtlases = (MAX_SPRITES + 4095) / 4096;
+		m_spriteAtlases = (maxSprites + 4095) / 4096;
 		m_spritesPerAtlas = 4096;
 		m_spritesPerModulo = 2048;
 	}
 	else
 	{
-		m_spriteAtlases = (MAX_SPRITES + 1023) / 1024;
+		m_spriteAtlases = (maxSprites + 1023) / 1024;
 		m_spritesPerAtlas = 1024;
 		m_spritesPerModulo = 1024;
 	}
@@ -708,6 +714,17 @@ void SurfaceOpenglCore::generateSpriteAtlases()
 			exit(-1);
 		}
 	}
+
+	m_spriteSlots.resize(maxSprites);
+	for(Uint32 i = 0; i < maxSprites; ++i)
+	{
+		Uint32 spriteIndex = (i % m_spritesPerAtlas) * 32;
+		OpenglCoreSpriteData& sprData = m_spriteSlots[i];
+		sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
+		sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
+		sprData.m_surface = i / m_spritesPerAtlas;
+	}
+	m_spriteResidency.init(maxSprites);
 }
 
 void SurfaceOpenglCore::init()
@@ -789,9 +806,9 @@ void SurfaceOpenglCore::spriteManagerReset()
 	for(std::vector<OpenglCoreTexture>::iterator it = m_spritesAtlas.begin(), end = m_spritesAtlas.end(); it != end; ++it)
 		releaseOpenGLCoreTexture((*it));
 
-	m_sprites.clear();
 	m_spritesAtlas.clear();
-	m_spritesIds.clear();
+	m_spriteSlots.clear();
+	m_spriteResidency.release();
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
 	generateSpriteAtlases();
@@ -841,8 +858,7 @@ unsigned char* SurfaceOpenglCore::getScreenPixels(Sint32& width, Sint32& height,
 
 void SurfaceOpenglCore::beginScene()
 {
-	m_spriteChecker = 0;
-	++m_currentFrame;
+	m_spriteResidency.nextFrame();
 	if(SDL_GL_GetCurrentContext() != m_oglContext)
 	{
 		SDL_GL_MakeCurrent(g_engine.m_window, m_oglContext);
@@ -1637,6 +1653,11 @@ void SurfaceOpenglCore::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y)
 }
 
 void SurfaceOpenglCore::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh)
+{
+	drawTintedSprite(spriteId, x, y, w, h, sx, sy, sw, sh, 0xFFFFFFFF);
+}
+
+void SurfaceOpenglCore::drawTintedSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, DWORD color)
 {
 	if(spriteId > g_spriteCounts)
 		return;
@@ -1652,81 +1673,35 @@ void SurfaceOpenglCore::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w
 	Uint32 xOffset;
 	Uint32 yOffset;
 	OpenglCoreTexture* tex;
-	U64BGLCoreTextures::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
-		if(m_sprites.size() >= MAX_SPRITES)
-		{
-			while(++m_spriteChecker < MAX_SPRITES)
-			{
-				Uint64 oldSpriteId = m_spritesIds.front();
-				it = m_sprites.find(oldSpriteId);
-				if(it == m_sprites.end())
-				{
-					UTIL_MessageBox(true, "OpenGL Core: Sprite Manager failure.");
-					exit(-1);
-				}
+		if(!g_engine.isSpriteReady(spriteId))
+			return;//Still decoding in background
 
-				m_spritesIds.pop_front();
-				if(it->second.m_lastUsage == m_currentFrame)
-					m_spritesIds.push_back(oldSpriteId);
-				else
-					goto Skip_Search;
-			}
-			scheduleBatch();
+		bool slotInUse;
+		spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+		if(spriteSlot == SPRITE_RESIDENCY_NONE)
+			return;
+		else if(slotInUse)
+			scheduleBatch();//Pending draws still use the sprite we replace
 
-			it = m_sprites.find(m_spritesIds.front());
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "OpenGL Core: Sprite Manager failure.");
-				exit(-1);
-			}
-			m_spritesIds.pop_front();
-
-			Skip_Search:
-			OpenglCoreSpriteData sprData = it->second;
-			sprData.m_lastUsage = m_currentFrame;
-			m_sprites.erase(it);
-			m_sprites[tempPos] = sprData;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
-		else
-		{
-			Uint32 spriteIndex = SDL_static_cast(Uint32, m_sprites.size());
-			Uint32 spriteAtlas = spriteIndex / m_spritesPerAtlas;
-			spriteIndex = (spriteIndex % m_spritesPerAtlas) * 32;
-			if(spriteAtlas >= m_spritesAtlas.size())
-				return;
-
-			OpenglCoreSpriteData& sprData = m_sprites[tempPos];
-			sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
-			sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
-			sprData.m_surface = spriteAtlas;
-			sprData.m_lastUsage = m_currentFrame;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
+		OpenglCoreSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 		if(!loadSprite(spriteId, tex, xOffset, yOffset))
+		{
+			m_spriteResidency.erase(tempPos);
 			return;//load failed
+		}
 	}
 	else
 	{
-		xOffset = it->second.m_xOffset;
-		yOffset = it->second.m_yOffset;
-		tex = &m_spritesAtlas[it->second.m_surface];
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
+		OpenglCoreSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 	}
 
 	float minx = SDL_static_cast(float, x);
@@ -1753,7 +1728,7 @@ void SurfaceOpenglCore::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w
 	texcoords[2] = minu; texcoords[3] = maxv;
 	texcoords[4] = maxu; texcoords[5] = minv;
 	texcoords[6] = maxu; texcoords[7] = maxv;
-	drawQuad(getTextureIndex(tex), vertices, texcoords);
+	drawQuad(getTextureIndex(tex), vertices, texcoords, color);
 }
 
 void SurfaceOpenglCore::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Uint32 outfitColor)
@@ -1762,6 +1737,11 @@ void SurfaceOpenglCore::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sin
 }
 
 void SurfaceOpenglCore::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor)
+{
+	drawTintedSpriteMask(spriteId, maskSpriteId, x, y, w, h, sx, sy, sw, sh, outfitColor, 0xFFFFFFFF);
+}
+
+void SurfaceOpenglCore::drawTintedSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor, DWORD color)
 {
 	if(spriteId > g_spriteCounts || maskSpriteId > g_spriteCounts)
 		return;
@@ -1777,81 +1757,37 @@ void SurfaceOpenglCore::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sin
 	Uint32 xOffset;
 	Uint32 yOffset;
 	OpenglCoreTexture* tex;
-	U64BGLCoreTextures::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
-		if(m_sprites.size() >= MAX_SPRITES)
-		{
-			while(++m_spriteChecker < MAX_SPRITES)
-			{
-				Uint64 oldSpriteId = m_spritesIds.front();
-				it = m_sprites.find(oldSpriteId);
-				if(it == m_sprites.end())
-				{
-					UTIL_MessageBox(true, "OpenGL Core: Sprite Manager failure.");
-					exit(-1);
-				}
+		//Wait for both sprites to be decoded before we reserve the cache slot
+		bool spriteReady = g_engine.isSpriteReady(spriteId);
+		if(!g_engine.isSpriteReady(maskSpriteId) || !spriteReady)
+			return;
 
-				m_spritesIds.pop_front();
-				if(it->second.m_lastUsage == m_currentFrame)
-					m_spritesIds.push_back(oldSpriteId);
-				else
-					goto Skip_Search;
-			}
-			scheduleBatch();
+		bool slotInUse;
+		spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+		if(spriteSlot == SPRITE_RESIDENCY_NONE)
+			return;
+		else if(slotInUse)
+			scheduleBatch();//Pending draws still use the sprite we replace
 
-			it = m_sprites.find(m_spritesIds.front());
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "OpenGL Core: Sprite Manager failure.");
-				exit(-1);
-			}
-			m_spritesIds.pop_front();
-
-			Skip_Search:
-			OpenglCoreSpriteData sprData = it->second;
-			sprData.m_lastUsage = m_currentFrame;
-			m_sprites.erase(it);
-			m_sprites[tempPos] = sprData;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
-		else
-		{
-			Uint32 spriteIndex = SDL_static_cast(Uint32, m_sprites.size());
-			Uint32 spriteAtlas = spriteIndex / m_spritesPerAtlas;
-			spriteIndex = (spriteIndex % m_spritesPerAtlas) * 32;
-			if(spriteAtlas >= m_spritesAtlas.size())
-				return;
-
-			OpenglCoreSpriteData& sprData = m_sprites[tempPos];
-			sprData.m_xOffset = spriteIndex % m_spritesPerModulo;
-			sprData.m_yOffset = (spriteIndex / m_spritesPerModulo) * 32;
-			sprData.m_surface = spriteAtlas;
-			sprData.m_lastUsage = m_currentFrame;
-			m_spritesIds.push_back(tempPos);
-
-			xOffset = sprData.m_xOffset;
-			yOffset = sprData.m_yOffset;
-			tex = &m_spritesAtlas[sprData.m_surface];
-		}
+		OpenglCoreSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 		if(!loadSpriteMask(spriteId, maskSpriteId, outfitColor, tex, xOffset, yOffset))
+		{
+			m_spriteResidency.erase(tempPos);
 			return;//load failed
+		}
 	}
 	else
 	{
-		xOffset = it->second.m_xOffset;
-		yOffset = it->second.m_yOffset;
-		tex = &m_spritesAtlas[it->second.m_surface];
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
+		OpenglCoreSpriteData& sprData = m_spriteSlots[spriteSlot];
+		xOffset = sprData.m_xOffset;
+		yOffset = sprData.m_yOffset;
+		tex = &m_spritesAtlas[sprData.m_surface];
 	}
 
 	float minx = SDL_static_cast(float, x);
@@ -1878,7 +1814,7 @@ void SurfaceOpenglCore::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sin
 	texcoords[2] = minu; texcoords[3] = maxv;
 	texcoords[4] = maxu; texcoords[5] = minv;
 	texcoords[6] = maxu; texcoords[7] = maxv;
-	drawQuad(getTextureIndex(tex), vertices, texcoords);
+	drawQuad(getTextureIndex(tex), vertices, texcoords, color);
 }
 
 OpenglCoreTexture* SurfaceOpenglCore::createAutomapTile(Uint32 currentArea)
@@ -1986,4 +1922,178 @@ void SurfaceOpenglCore::drawAutomapTile(Uint32 currentArea, bool& recreate, Uint
 	texcoords[6] = maxu; texcoords[7] = maxv;
 	drawQuad(getTextureIndex(tex), vertices, texcoords);
 }
+
+void SurfaceOpenglCore::setBlendMode(RenderBlendMode blend)
+{
+	switch(blend)
+	{
+		case RENDER_BLEND_ADDITIVE: OglBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE); break;
+		case RENDER_BLEND_MODULATE: OglBlendFuncSeparate(GL_ZERO, GL_SRC_COLOR, GL_ZERO, GL_ONE); break;
+		case RENDER_BLEND_REPLACE: OglBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO); break;
+		default: OglBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+	}
+}
+
+void SurfaceOpenglCore::beginStaticLayer(Uint8 floor)
+{
+	scheduleBatch();
+	OpenglCoreTexture& staticLayer = m_staticLayers[floor];
+	if(!staticLayer)
+	{
+		//The map clears a floor the first time it draws into it so the new texture doesn't need it
+		if(!createOpenGLCoreTexture(staticLayer, GAME_MAP_WIDTH * 32, GAME_MAP_HEIGHT * 32, false, true))
+		{
+			//Generation 0 makes the map draw every tile itself from the next frame on
+			m_staticLayerGeneration = 0;
+			m_staticLayer = -1;
+			OglBindFramebuffer(GL_FRAMEBUFFER, m_gameWindow.m_framebuffer);
+			return;
+		}
+	}
+
+	OglBindFramebuffer(GL_FRAMEBUFFER, staticLayer.m_framebuffer);
+	m_renderTarget = &staticLayer;
+	m_viewPortX = 0;
+	m_viewPortY = 0;
+	m_viewPortW = staticLayer.m_width;
+	m_viewPortH = staticLayer.m_height;
+	updateViewport();
+	m_staticLayer = SDL_static_cast(Sint32, floor);
+}
+
+void SurfaceOpenglCore::endStaticLayer()
+{
+	if(m_staticLayer < 0)
+		return;
+
+	//Static layers are only updated inside the game scene so that is where we go back to
+	scheduleBatch();
+	m_staticLayer = -1;
+	OglBindFramebuffer(GL_FRAMEBUFFER, m_gameWindow.m_framebuffer);
+	m_renderTarget = &m_gameWindow;
+	m_viewPortX = 0;
+	m_viewPortY = 0;
+	m_viewPortW = m_gameWindow.m_width;
+	m_viewPortH = m_gameWindow.m_height;
+	updateViewport();
+}
+
+void SurfaceOpenglCore::drawStaticLayer(Uint8 floor, Sint32 sx, Sint32 sy, Sint32 x, Sint32 y)
+{
+	OpenglCoreTexture& staticLayer = m_staticLayers[floor];
+	if(!staticLayer)
+		return;
+
+	//The layer wraps around like the map window so the origin cell goes to the top-left corner
+	//and the layer is split into up to four parts, the content is already premultiplied by its alpha
+	scheduleBatch();
+	OglBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	float texIndex = getTextureIndex(&staticLayer);
+	Sint32 layerW = SDL_static_cast(Sint32, staticLayer.m_width);
+	Sint32 layerH = SDL_static_cast(Sint32, staticLayer.m_height);
+	for(Sint32 j = 0; j < 2; ++j)
+	{
+		Sint32 partY = (j == 0 ? sy : 0);
+		Sint32 partH = (j == 0 ? layerH - sy : sy);
+		if(partH <= 0)
+			continue;
+
+		Sint32 drawY = (j == 0 ? y : y + layerH - sy);
+		for(Sint32 i = 0; i < 2; ++i)
+		{
+			Sint32 partX = (i == 0 ? sx : 0);
+			Sint32 partW = (i == 0 ? layerW - sx : sx);
+			if(partW <= 0)
+				continue;
+
+			Sint32 drawX = (i == 0 ? x : x + layerW - sx);
+			float minx = SDL_static_cast(float, drawX);
+			float maxx = SDL_static_cast(float, drawX + partW);
+			float miny = SDL_static_cast(float, drawY);
+			float maxy = SDL_static_cast(float, drawY + partH);
+
+			float minu = partX * staticLayer.m_scaleW;
+			float maxu = (partX + partW) * staticLayer.m_scaleW;
+			float minv = partY * staticLayer.m_scaleH;
+			float maxv = (partY + partH) * staticLayer.m_scaleH;
+
+			float vertices[8];
+			vertices[0] = minx; vertices[1] = miny;
+			vertices[2] = minx; vertices[3] = maxy;
+			vertices[4] = maxx; vertices[5] = miny;
+			vertices[6] = maxx; vertices[7] = maxy;
+
+			float texcoords[8];
+			texcoords[0] = minu; texcoords[1] = minv;
+			texcoords[2] = minu; texcoords[3] = maxv;
+			texcoords[4] = maxu; texcoords[5] = minv;
+			texcoords[6] = maxu; texcoords[7] = maxv;
+			drawQuad(texIndex, vertices, texcoords);
+		}
+	}
+
+	scheduleBatch();
+	OglBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void SurfaceOpenglCore::takeStaticLayerMisses(std::vector<Uint32>& misses)
+{
+	misses.swap(m_staticLayerMisses);
+	m_staticLayerMisses.clear();
+}
+
+void SurfaceOpenglCore::drawCommands(RenderCommandList& commands)
+{
+	//Sprites and rectangles go straight into the vertex batch with their tint
+	//the batch is only cut when the blending changes or we run out of texture units
+	std::vector<RenderCommand>& list = commands.getCommands();
+	m_vertices.reserve(m_vertices.size() + list.size() * 4);
+
+	RenderBlendMode blend = RENDER_BLEND_NORMAL;
+	for(std::vector<RenderCommand>::iterator it = list.begin(), end = list.end(); it != end; ++it)
+	{
+		RenderCommand& command = (*it);
+		if(command.blend != blend)
+		{
+			scheduleBatch();
+			setBlendMode(command.blend);
+			blend = command.blend;
+		}
+
+		DWORD tint = MAKE_RGBA_COLOR(command.tint & 0xFF, (command.tint >> 8) & 0xFF, (command.tint >> 16) & 0xFF, command.tint >> 24);
+		switch(command.type)
+		{
+			case RENDER_COMMAND_SPRITE:
+			{
+				//A cell drawn before its sprite got decoded has to be drawn again by the map
+				if(m_staticLayer >= 0 && !g_engine.isSpriteReady(command.spriteId))
+					m_staticLayerMisses.push_back(RENDER_STATIC_CELL(m_staticLayer, command.y / 32, command.x / 32));
+
+				drawTintedSprite(command.spriteId, command.x, command.y, command.w, command.h, command.sx, command.sy, command.sw, command.sh, tint);
+			}
+			break;
+			case RENDER_COMMAND_SPRITE_PART: drawTintedSprite(command.spriteId, command.x, command.y, command.w, command.h, command.sx, command.sy, command.sw, command.sh, tint); break;
+			case RENDER_COMMAND_SPRITE_MASK:
+			case RENDER_COMMAND_SPRITE_MASK_PART: drawTintedSpriteMask(command.spriteId, command.maskSpriteId, command.x, command.y, command.w, command.h, command.sx, command.sy, command.sw, command.sh, command.color, tint); break;
+			case RENDER_COMMAND_BEGIN_STATIC_LAYER:
+			{
+				beginStaticLayer(command.layer);
+				if(m_staticLayer < 0)
+				{
+					//Without a target the layer draws are left out instead of landing in the game scene
+					while((it + 1) != end && (*(it + 1)).type != RENDER_COMMAND_END_STATIC_LAYER)
+						++it;
+				}
+			}
+			break;
+			default: commands.drawCommand(this, command); break;
+		}
+	}
+
+	if(blend != RENDER_BLEND_NORMAL)
+	{
+		scheduleBatch();
+		setBlendMode(RENDER_BLEND_NORMAL);
+	}
+}
 #endif
@@ -151,12 +151,11 @@ struct OpenglCoreTexture
 
 struct OpenglCoreSpriteData
 {
-	OpenglCoreSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	OpenglCoreSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 struct OpenglCoreVertex
@@ -179,7 +178,6 @@ typedef enum
 } GLCORE_Attribute;
 
 typedef robin_hood::unordered_map<Uint32, OpenglCoreTexture> U32BGLCoreTextures;
-typedef robin_hood::unordered_map<Uint64, OpenglCoreSpriteData> U64BGLCoreTextures;
 
 class SurfaceOpenglCore : public Surface
 {
@@ -259,13 +257,23 @@ class SurfaceOpenglCore : public Surface
 		void uploadAutomapTile(OpenglCoreTexture* texture, Uint8 color[256][256]);
 		virtual void drawAutomapTile(Uint32 m_currentArea, bool& m_recreate, Uint8 m_color[256][256], Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh);
 
+		void setBlendMode(RenderBlendMode blend);
+		void drawTintedSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, DWORD color);
+		void drawTintedSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor, DWORD color);
+		virtual void drawCommands(RenderCommandList& commands);
+
+		virtual Uint32 getStaticLayerGeneration() {return m_staticLayerGeneration;}
+		virtual void beginStaticLayer(Uint8 floor);
+		virtual void endStaticLayer();
+		virtual void drawStaticLayer(Uint8 floor, Sint32 sx, Sint32 sy, Sint32 x, Sint32 y);
+		virtual void takeStaticLayerMisses(std::vector<Uint32>& misses);
+
 	protected:
 		std::vector<OpenglCoreVertex> m_vertices;
 		std::vector<OpenglCoreTexture> m_spritesAtlas;
 		U32BGLCoreTextures m_automapTiles;
-		U64BGLCoreTextures m_sprites;
+		std::vector<OpenglCoreSpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		OpenglCoreTexture* m_pictures = NULL;
 		char* m_software = NULL;
@@ -277,6 +285,10 @@ class SurfaceOpenglCore : public Surface
 		OpenglCoreTexture m_gameWindow;
 		OpenglCoreTexture m_scaled_gameWindow;
 		OpenglCoreTexture m_colorTexture;
+		OpenglCoreTexture m_staticLayers[GAME_MAP_FLOORS + 1];
+		std::vector<Uint32> m_staticLayerMisses;
+		Uint32 m_staticLayerGeneration = 1;
+		Sint32 m_staticLayer = -1;
 
 		PFN_OglActiveTexture OglActiveTexture;
 		PFN_OglBindTexture OglBindTexture;
@@ -361,8 +373,6 @@ class SurfaceOpenglCore : public Surface
 		ptrdiff_t m_vertex_buffer_size = 0;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedVertices = 0;
 
 		Uint32 m_spriteAtlases = 0;
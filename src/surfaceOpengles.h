@@ -127,16 +127,14 @@ struct OpenglESTexture
 
 struct OpenglESSpriteData
 {
-	OpenglESSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	OpenglESSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 typedef robin_hood::unordered_map<Uint32, OpenglESTexture> U32BGLESTextures;
-typedef robin_hood::unordered_map<Uint64, OpenglESSpriteData> U64BGLESTextures;
 
 class SurfaceOpenglES : public Surface
 {
@@ -222,9 +220,8 @@ class SurfaceOpenglES : public Surface
 		#endif
 		std::vector<OpenglESTexture> m_spritesAtlas;
 		U32BGLESTextures m_automapTiles;
-		U64BGLESTextures m_sprites;
+		std::vector<OpenglESSpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		OpenglESTexture* m_pictures = NULL;
 		char* m_software = NULL;
@@ -285,8 +282,6 @@ class SurfaceOpenglES : public Surface
 		Sint32 m_integer_scaling_height = 0;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedVertices = 0;
 
 		Uint32 m_spriteAtlases = 0;
@@ -147,12 +147,11 @@ struct OpenglES2Texture
 
 struct OpenglES2SpriteData
 {
-	OpenglES2SpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	OpenglES2SpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 struct OpenglES2Vertex
@@ -174,7 +173,6 @@ typedef enum
 } GLES_Attribute;
 
 typedef robin_hood::unordered_map<Uint32, OpenglES2Texture> U32BGLES2Textures;
-typedef robin_hood::unordered_map<Uint64, OpenglES2SpriteData> U64BGLES2Textures;
 
 class SurfaceOpenglES2 : public Surface
 {
@@ -258,9 +256,8 @@ class SurfaceOpenglES2 : public Surface
 		std::vector<OpenglES2Vertex> m_vertices;
 		std::vector<OpenglES2Texture> m_spritesAtlas;
 		U32BGLES2Textures m_automapTiles;
-		U64BGLES2Textures m_sprites;
+		std::vector<OpenglES2SpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		OpenglES2Texture* m_pictures = NULL;
 		char* m_software = NULL;
@@ -353,8 +350,6 @@ class SurfaceOpenglES2 : public Surface
 		ptrdiff_t m_vertex_buffer_size = 0;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedVertices = 0;
 
 		Uint32 m_spriteAtlases = 0;
@@ -21,6 +21,7 @@
 
 #include "surfaceSoftware.h"
 #include "softwareDrawning.h"
+#include "jobSystem.h"
 
 //I wouldn't recommend using software renderer
 //You can use it but it is much slower
@@ -28,6 +29,7 @@
 static const float inv255f = (1.0f / 255.0f);
 
 extern Engine g_engine;
+extern JobSystem g_jobSystem;
 extern Uint32 g_spriteCounts;
 extern Uint16 g_pictureCounts;
 
@@ -35,11 +37,12 @@ SurfaceSoftware::SurfaceSoftware()
 {
 	g_engine.RecreateWindow(false);
 
-	m_sprites.reserve(MAX_SPRITES);
 	m_automapTiles.reserve(MAX_AUTOMAPTILES);
 	m_pictureOptimizations.reserve(256);
 
 	SDL_SmoothStretch_init();
+	if(g_engine.isSoftwareKernelBenchmark())
+		SDL_SoftwareKernels_benchmark();
 }
 
 SurfaceSoftware::~SurfaceSoftware()
@@ -64,11 +67,14 @@ SurfaceSoftware::~SurfaceSoftware()
 	for(U32BOptimizer::iterator it = m_pictureOptimizations.begin(), end = m_pictureOptimizations.end(); it != end; ++it)
 		SDL_FreeSurface(it->second.m_surface);
 
-	for(U64BSurfaces::iterator it = m_sprites.begin(), end = m_sprites.end(); it != end; ++it)
-		SDL_FreeSurface(it->second.m_surface);
+	for(std::vector<SoftwareSpriteData>::iterator it = m_spriteSlots.begin(), end = m_spriteSlots.end(); it != end; ++it)
+	{
+		if((*it).m_surface)
+			SDL_FreeSurface((*it).m_surface);
+	}
 
-	m_sprites.clear();
-	m_spritesIds.clear();
+	m_spriteSlots.clear();
+	m_spriteResidency.release();
 	m_pictureOptimizations.clear();
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
@@ -84,7 +90,8 @@ SurfaceSoftware::~SurfaceSoftware()
 	if(m_background)
 		SDL_FreeSurface(m_background);
 
-	SDL_SmoothStretch_shutdown();
+	if(m_scaledSprite)
+		SDL_FreeSurface(m_scaledSprite);
 }
 
 bool SurfaceSoftware::isSupported()
@@ -177,6 +184,17 @@ void SurfaceSoftware::init()
 		m_gameWindow = n;
 	}
 	SDL_SetSurfaceBlendMode(m_gameWindow, SDL_BLENDMODE_NONE);
+
+	m_binColumns = (m_gameWindow->w + SOFTWARE_BIN_SIZE - 1) >> SOFTWARE_BIN_SHIFT;
+	m_binRows = (m_gameWindow->h + SOFTWARE_BIN_SIZE - 1) >> SOFTWARE_BIN_SHIFT;
+	m_blitBins.resize(m_binColumns * m_binRows);
+	m_binJobs.resize(m_binColumns * m_binRows);
+	for(Sint32 i = 0, end = m_binColumns * m_binRows; i < end; ++i)
+	{
+		m_binJobs[i].m_surface = this;
+		m_binJobs[i].m_bin = i;
+	}
+	m_blits.reserve(4096);
 }
 
 void SurfaceSoftware::doResize(Sint32 w, Sint32 h)
@@ -196,14 +214,22 @@ void SurfaceSoftware::doResize(Sint32 w, Sint32 h)
 
 void SurfaceSoftware::spriteManagerReset()
 {
+	flushBlits();
 	for(U32BSurfaces::iterator it = m_automapTiles.begin(), end = m_automapTiles.end(); it != end; ++it)
 		SDL_FreeSurface(it->second);
 
-	for(U64BSurfaces::iterator it = m_sprites.begin(), end = m_sprites.end(); it != end; ++it)
-		SDL_FreeSurface(it->second.m_surface);
+	for(std::vector<SoftwareSpriteData>::iterator it = m_spriteSlots.begin(), end = m_spriteSlots.end(); it != end; ++it)
+	{
+		if((*it).m_surface)
+		{
+			SDL_FreeSurface((*it).m_surface);
+			(*it).m_surface = NULL;
+		}
+	}
 
-	m_sprites.clear();
-	m_spritesIds.clear();
+	Uint32 maxSprites = g_engine.getSpriteBudget();
+	m_spriteSlots.resize(maxSprites);
+	m_spriteResidency.init(maxSprites);
 	m_automapTilesBuff.clear();
 	m_automapTiles.clear();
 }
@@ -260,8 +286,7 @@ unsigned char* SurfaceSoftware::getScreenPixels(Sint32& width, Sint32& height, b
 
 void SurfaceSoftware::beginScene()
 {
-	m_spriteChecker = 0;
-	++m_currentFrame;
+	m_spriteResidency.nextFrame();
 
 	if(m_useConvertSurface)
 		m_renderSurface = m_convertSurface;
@@ -343,6 +368,7 @@ void SurfaceSoftware::drawGameScene(Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh,
 void SurfaceSoftware::beginGameScene()
 {
 	m_renderSurface = m_gameWindow;
+	m_binning = (!g_engine.isSoftwareSdlBlit() && m_gameWindow->format->BytesPerPixel == 4 && !SDL_MUSTLOCK(m_gameWindow));
 
 	//black our game window(so empty tiles will be drawn as black rectangle)
 	//memset is several times faster than fillrect
@@ -351,6 +377,8 @@ void SurfaceSoftware::beginGameScene()
 
 void SurfaceSoftware::endGameScene()
 {
+	flushBlits();
+	m_binning = false;
 	if(m_useConvertSurface)
 		m_renderSurface = m_convertSurface;
 	else
@@ -359,6 +387,7 @@ void SurfaceSoftware::endGameScene()
 
 void SurfaceSoftware::drawLightMap_old(LightMap* lightmap, Sint32 x, Sint32 y, Sint32 scale, Sint32 width, Sint32 height)
 {
+	flushBlits();
 	SDL_DrawLightMap_old_MT(m_renderSurface, lightmap, x, y, scale, width, height);
 	/*Sint32 drawY = y - scale;
 	height -= 1;
@@ -379,22 +408,26 @@ void SurfaceSoftware::drawLightMap_old(LightMap* lightmap, Sint32 x, Sint32 y, S
 
 void SurfaceSoftware::drawLightMap_new(LightMap* lightmap, Sint32 x, Sint32 y, Sint32 scale, Sint32 width, Sint32 height)
 {
+	flushBlits();
 	SDL_DrawLightMap_new_MT(m_renderSurface, lightmap, x, y, scale, width, height);
 }
 
 void SurfaceSoftware::setClipRect(Sint32 x, Sint32 y, Sint32 w, Sint32 h)
 {
+	flushBlits();
 	SDL_Rect rect = {x,y,w,h};
 	SDL_SetClipRect(m_renderSurface, &rect);
 }
 
 void SurfaceSoftware::disableClipRect()
 {
+	flushBlits();
 	SDL_SetClipRect(m_renderSurface, NULL);
 }
 
 void SurfaceSoftware::drawRectangle(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 lineWidth, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
+	flushBlits();
 	if(a == 0)
 		return;
 	else if(a == 255)
@@ -423,6 +456,7 @@ void SurfaceSoftware::drawRectangle(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint
 
 void SurfaceSoftware::fillRectangle(Sint32 x, Sint32 y, Sint32 w, Sint32 h, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
+	flushBlits();
 	if(a == 0)
 		return;
 	else if(a == 255)
@@ -513,7 +547,14 @@ void SurfaceSoftware::drawFont(Uint16 pictureId, Sint32 x, Sint32 y, const std::
 		if(!surf)
 			return;//load failed
 	}
-	SDL_SetSurfaceColorMod(surf, r, g, b);
+
+	//Glyphs are tinted straight in the blend kernel so we don't need sdl color mod
+	bool tinted = (!g_engine.isSoftwareSdlBlit() && surf->format->BytesPerPixel == 4 && m_renderSurface->format->BytesPerPixel == 4 && !SDL_MUSTLOCK(surf) && !SDL_MUSTLOCK(m_renderSurface));
+	Uint32 tint = SDL_MapRGBA(surf->format, r, g, b, 255);
+	if(tinted)
+		flushBlits();
+	else
+		SDL_SetSurfaceColorMod(surf, r, g, b);
 	
 	Sint32 rx = x, ry = y;
 	Uint8 character;
@@ -538,7 +579,9 @@ void SurfaceSoftware::drawFont(Uint16 pictureId, Sint32 x, Sint32 y, const std::
 					Uint8 red = SDL_static_cast(Uint8, text[i + 1]);
 					Uint8 green = SDL_static_cast(Uint8, text[i + 2]);
 					Uint8 blue = SDL_static_cast(Uint8, text[i + 3]);
-					SDL_SetSurfaceColorMod(surf, red, green, blue);
+					tint = SDL_MapRGBA(surf->format, red, green, blue, 255);
+					if(!tinted)
+						SDL_SetSurfaceColorMod(surf, red, green, blue);
 					i += 3;
 				}
 				else
@@ -546,13 +589,27 @@ void SurfaceSoftware::drawFont(Uint16 pictureId, Sint32 x, Sint32 y, const std::
 			}
 			break;
 			case 0x0F://Special case - change back standard color
-				SDL_SetSurfaceColorMod(surf, r, g, b);
+				tint = SDL_MapRGBA(surf->format, r, g, b, 255);
+				if(!tinted)
+					SDL_SetSurfaceColorMod(surf, r, g, b);
 				break;
 			default:
 			{
-				SDL_Rect srcr = {SDL_static_cast(Sint32, cX[character]),SDL_static_cast(Sint32, cY[character]),SDL_static_cast(Sint32, cW[character]),SDL_static_cast(Sint32, cH[character])};
-				SDL_Rect dstr = {rx,ry,SDL_static_cast(Sint32, cW[character]),SDL_static_cast(Sint32, cH[character])};
-				SDL_BlitSurface(surf, &srcr, m_renderSurface, &dstr);
+				if(tinted)
+				{
+					SoftwareBlit blit;
+					if(clipBlit(blit, surf, SDL_static_cast(Sint32, cX[character]), SDL_static_cast(Sint32, cY[character]), rx, ry, SDL_static_cast(Sint32, cW[character]), SDL_static_cast(Sint32, cH[character])))
+					{
+						Sint32 pitch = m_renderSurface->pitch / 4;
+						SDL_BlendSpriteTinted(SDL_reinterpret_cast(Uint32*, m_renderSurface->pixels) + (blit.m_y * pitch) + blit.m_x, pitch, blit.m_pixels, blit.m_pitch, blit.m_width, blit.m_height, tint, surf->format->Ashift);
+					}
+				}
+				else
+				{
+					SDL_Rect srcr = {SDL_static_cast(Sint32, cX[character]),SDL_static_cast(Sint32, cY[character]),SDL_static_cast(Sint32, cW[character]),SDL_static_cast(Sint32, cH[character])};
+					SDL_Rect dstr = {rx,ry,SDL_static_cast(Sint32, cW[character]),SDL_static_cast(Sint32, cH[character])};
+					SDL_BlitSurface(surf, &srcr, m_renderSurface, &dstr);
+				}
 				rx += cW[character] + cX[0];
 			}
 			break;
@@ -712,45 +769,34 @@ SDL_Surface* SurfaceSoftware::loadSprite(Uint64 tempPos, Uint32 spriteId)
 		s = n;
 	}
 
-	SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
-	SDL_SetSurfaceRLE(s, 1);
-	if(m_sprites.size() >= MAX_SPRITES)
+	if(g_engine.isSoftwareSdlBlit() || s->format->BytesPerPixel != 4 || SDL_MUSTLOCK(s))
 	{
-		U64BSurfaces::iterator it;
-		while(++m_spriteChecker < MAX_SPRITES)
-		{
-			Uint64 oldSpriteId = m_spritesIds.front();
-			it = m_sprites.find(oldSpriteId);
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "Software: Sprite Manager failure.");
-				exit(-1);
-			}
-
-			m_spritesIds.pop_front();
-			if(it->second.m_lastUsage == m_currentFrame)
-				m_spritesIds.push_back(oldSpriteId);
-			else
-				goto Skip_Search;
-		}
-
-		it = m_sprites.find(m_spritesIds.front());
-		if(it == m_sprites.end())
-		{
-			UTIL_MessageBox(true, "Software: Sprite Manager failure.");
-			exit(-1);
-		}
-		m_spritesIds.pop_front();
+		SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
+		SDL_SetSurfaceRLE(s, 1);
+	}
+	else
+	{
+		//Our own blitter reads premultiplied pixels directly so they can't be rle'd
+		SOFTWARE_premultiplyAlpha(SDL_reinterpret_cast(Uint32*, s->pixels), (s->pitch / 4) * s->h, s->format->Ashift);
+		SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE);
+	}
+	bool slotInUse;
+	Uint32 spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
+	{
+		SDL_FreeSurface(s);
+		return NULL;
+	}
 
-		Skip_Search:
-		SDL_FreeSurface(it->second.m_surface);
-		m_sprites.erase(it);
+	SoftwareSpriteData& sprData = m_spriteSlots[spriteSlot];
+	if(sprData.m_surface)
+	{
+		//Evicted sprite might still be waiting in the bins
+		flushBlits();
+		SDL_FreeSurface(sprData.m_surface);
 	}
 
-	SoftwareSpriteData& sprData = m_sprites[tempPos];
 	sprData.m_surface = s;
-	sprData.m_lastUsage = m_currentFrame;
-	m_spritesIds.push_back(tempPos);
 	return s;
 }
 
@@ -780,45 +826,34 @@ SDL_Surface* SurfaceSoftware::loadSpriteMask(Uint64 tempPos, Uint32 spriteId, Ui
 		s = n;
 	}
 
-	SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
-	SDL_SetSurfaceRLE(s, 1);
-	if(m_sprites.size() >= MAX_SPRITES)
+	if(g_engine.isSoftwareSdlBlit() || s->format->BytesPerPixel != 4 || SDL_MUSTLOCK(s))
 	{
-		U64BSurfaces::iterator it;
-		while(++m_spriteChecker < MAX_SPRITES)
-		{
-			Uint64 oldSpriteId = m_spritesIds.front();
-			it = m_sprites.find(oldSpriteId);
-			if(it == m_sprites.end())
-			{
-				UTIL_MessageBox(true, "Software: Sprite Manager failure.");
-				exit(-1);
-			}
-
-			m_spritesIds.pop_front();
-			if(it->second.m_lastUsage == m_currentFrame)
-				m_spritesIds.push_back(oldSpriteId);
-			else
-				goto Skip_Search;
-		}
-
-		it = m_sprites.find(m_spritesIds.front());
-		if(it == m_sprites.end())
-		{
-			UTIL_MessageBox(true, "Software: Sprite Manager failure.");
-			exit(-1);
-		}
-		m_spritesIds.pop_front();
+		SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
+		SDL_SetSurfaceRLE(s, 1);
+	}
+	else
+	{
+		//Our own blitter reads premultiplied pixels directly so they can't be rle'd
+		SOFTWARE_premultiplyAlpha(SDL_reinterpret_cast(Uint32*, s->pixels), (s->pitch / 4) * s->h, s->format->Ashift);
+		SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE);
+	}
+	bool slotInUse;
+	Uint32 spriteSlot = m_spriteResidency.insert(tempPos, slotInUse);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
+	{
+		SDL_FreeSurface(s);
+		return NULL;
+	}
 
-		Skip_Search:
-		SDL_FreeSurface(it->second.m_surface);
-		m_sprites.erase(it);
+	SoftwareSpriteData& sprData = m_spriteSlots[spriteSlot];
+	if(sprData.m_surface)
+	{
+		//Evicted sprite might still be waiting in the bins
+		flushBlits();
+		SDL_FreeSurface(sprData.m_surface);
 	}
 
-	SoftwareSpriteData& sprData = m_sprites[tempPos];
 	sprData.m_surface = s;
-	sprData.m_lastUsage = m_currentFrame;
-	m_spritesIds.push_back(tempPos);
 	return s;
 }
 
@@ -836,27 +871,20 @@ void SurfaceSoftware::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y)
 	Uint64 tempPos = SDL_static_cast(Uint64, spriteId);
 	#endif
 	SDL_Surface* surf;
-	U64BSurfaces::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
+		if(!g_engine.isSpriteReady(spriteId))
+			return;//Still decoding in background
+
 		surf = loadSprite(tempPos, spriteId);
 		if(!surf)
 			return;//load failed
 	}
 	else
-	{
-		surf = it->second.m_surface;
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
-	}
+		surf = m_spriteSlots[spriteSlot].m_surface;
 
-	SDL_Rect srcr = {0,0,32,32};
-	SDL_Rect dstr = {x,y,32,32};
-	SDL_BlitSurface(surf, &srcr, m_renderSurface, &dstr);
+	blitSprite(surf, x, y);
 }
 
 void SurfaceSoftware::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh)
@@ -873,27 +901,20 @@ void SurfaceSoftware::drawSprite(Uint32 spriteId, Sint32 x, Sint32 y, Sint32 w,
 	Uint64 tempPos = SDL_static_cast(Uint64, spriteId);
 	#endif
 	SDL_Surface* surf;
-	U64BSurfaces::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
+		if(!g_engine.isSpriteReady(spriteId))
+			return;//Still decoding in background
+
 		surf = loadSprite(tempPos, spriteId);
 		if(!surf)
 			return;//load failed
 	}
 	else
-	{
-		surf = it->second.m_surface;
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
-	}
+		surf = m_spriteSlots[spriteSlot].m_surface;
 
-	SDL_Rect srcr = {sx,sy,sw,sh};
-	SDL_Rect dstr = {x,y,w,h};
-	SDL_BlitScaled(surf, &srcr, m_renderSurface, &dstr);
+	blitScaledSprite(surf, sx, sy, sw, sh, x, y, w, h);
 }
 
 void SurfaceSoftware::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Uint32 outfitColor)
@@ -910,27 +931,22 @@ void SurfaceSoftware::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint3
 	Uint64 tempPos = SDL_static_cast(Uint64, spriteId) | (SDL_static_cast(Uint64, outfitColor) << 32);
 	#endif
 	SDL_Surface* surf;
-	U64BSurfaces::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
+		//Wait for both sprites to be decoded before we reserve the cache slot
+		bool spriteReady = g_engine.isSpriteReady(spriteId);
+		if(!g_engine.isSpriteReady(maskSpriteId) || !spriteReady)
+			return;
+
 		surf = loadSpriteMask(tempPos, spriteId, maskSpriteId, outfitColor);
 		if(!surf)
 			return;//load failed
 	}
 	else
-	{
-		surf = it->second.m_surface;
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
-		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
-		}
-	}
+		surf = m_spriteSlots[spriteSlot].m_surface;
 
-	SDL_Rect srcr = {0,0,32,32};
-	SDL_Rect dstr = {x,y,32,32};
-	SDL_BlitSurface(surf, &srcr, m_renderSurface, &dstr);
+	blitSprite(surf, x, y);
 }
 
 void SurfaceSoftware::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor)
@@ -947,27 +963,178 @@ void SurfaceSoftware::drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint3
 	Uint64 tempPos = SDL_static_cast(Uint64, spriteId) | (SDL_static_cast(Uint64, outfitColor) << 32);
 	#endif
 	SDL_Surface* surf;
-	U64BSurfaces::iterator it = m_sprites.find(tempPos);
-	if(it == m_sprites.end())
+	Uint32 spriteSlot = m_spriteResidency.touch(tempPos);
+	if(spriteSlot == SPRITE_RESIDENCY_NONE)
 	{
+		//Wait for both sprites to be decoded before we reserve the cache slot
+		bool spriteReady = g_engine.isSpriteReady(spriteId);
+		if(!g_engine.isSpriteReady(maskSpriteId) || !spriteReady)
+			return;
+
 		surf = loadSpriteMask(tempPos, spriteId, maskSpriteId, outfitColor);
 		if(!surf)
 			return;//load failed
 	}
 	else
+		surf = m_spriteSlots[spriteSlot].m_surface;
+
+	blitScaledSprite(surf, sx, sy, sw, sh, x, y, w, h);
+}
+
+bool SurfaceSoftware::clipBlit(SoftwareBlit& blit, SDL_Surface* surf, Sint32 sx, Sint32 sy, Sint32 x, Sint32 y, Sint32 w, Sint32 h)
+{
+	const SDL_Rect& clip_rect = m_renderSurface->clip_rect;
+	if(x < clip_rect.x)
+	{
+		sx += clip_rect.x - x;
+		w -= clip_rect.x - x;
+		x = clip_rect.x;
+	}
+	if(y < clip_rect.y)
 	{
-		surf = it->second.m_surface;
-		it->second.m_lastUsage = m_currentFrame;
-		if(m_spritesIds.front() == tempPos)
+		sy += clip_rect.y - y;
+		h -= clip_rect.y - y;
+		y = clip_rect.y;
+	}
+	w = UTIL_min<Sint32>(w, clip_rect.x + clip_rect.w - x);
+	h = UTIL_min<Sint32>(h, clip_rect.y + clip_rect.h - y);
+	if(w <= 0 || h <= 0)
+		return false;
+
+	blit.m_pitch = surf->pitch / 4;
+	blit.m_pixels = SDL_reinterpret_cast(const Uint32*, surf->pixels) + (sy * blit.m_pitch) + sx;
+	blit.m_x = x;
+	blit.m_y = y;
+	blit.m_width = w;
+	blit.m_height = h;
+	return true;
+}
+
+void SurfaceSoftware::blitScaledSprite(SDL_Surface* surf, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h)
+{
+	flushBlits();
+	SDL_Rect srcr = {sx,sy,sw,sh};
+	SDL_BlendMode blendMode;
+	SDL_GetSurfaceBlendMode(surf, &blendMode);
+	if(blendMode != SDL_BLENDMODE_NONE || m_renderSurface->format->BytesPerPixel != 4 || SDL_MUSTLOCK(m_renderSurface))
+	{
+		SDL_Rect dstr = {x,y,w,h};
+		SDL_BlitScaled(surf, &srcr, m_renderSurface, &dstr);
+		return;
+	}
+
+	//Premultiplied sprites are stretched by sdl into scratch surface and blended from there
+	if(!m_scaledSprite || m_scaledSprite->w < w || m_scaledSprite->h < h)
+	{
+		Sint32 width = w, height = h;
+		if(m_scaledSprite)
 		{
-			m_spritesIds.pop_front();
-			m_spritesIds.push_back(tempPos);
+			width = UTIL_max<Sint32>(width, m_scaledSprite->w);
+			height = UTIL_max<Sint32>(height, m_scaledSprite->h);
+			SDL_FreeSurface(m_scaledSprite);
 		}
+
+		SDL_PixelFormat* format = surf->format;
+		m_scaledSprite = SDL_CreateRGBSurface(SDL_SWSURFACE, width, height, 32, format->Rmask, format->Gmask, format->Bmask, format->Amask);
+		if(!m_scaledSprite)
+			return;
+
+		SDL_SetSurfaceBlendMode(m_scaledSprite, SDL_BLENDMODE_NONE);
 	}
 
-	SDL_Rect srcr = {sx,sy,sw,sh};
-	SDL_Rect dstr = {x,y,w,h};
-	SDL_BlitScaled(surf, &srcr, m_renderSurface, &dstr);
+	SDL_Rect dstr = {0,0,w,h};
+	SDL_BlitScaled(surf, &srcr, m_scaledSprite, &dstr);
+
+	SoftwareBlit blit;
+	if(clipBlit(blit, m_scaledSprite, 0, 0, x, y, w, h))
+	{
+		Sint32 pitch = m_renderSurface->pitch / 4;
+		SDL_BlendSprite(SDL_reinterpret_cast(Uint32*, m_renderSurface->pixels) + (blit.m_y * pitch) + blit.m_x, pitch, blit.m_pixels, blit.m_pitch, blit.m_width, blit.m_height, m_scaledSprite->format->Ashift);
+	}
+}
+
+void SurfaceSoftware::blitSprite(SDL_Surface* surf, Sint32 x, Sint32 y)
+{
+	SDL_BlendMode blendMode;
+	SDL_GetSurfaceBlendMode(surf, &blendMode);
+	if(blendMode != SDL_BLENDMODE_NONE || m_renderSurface->format->BytesPerPixel != 4 || SDL_MUSTLOCK(m_renderSurface))
+	{
+		flushBlits();
+		SDL_Rect srcr = {0,0,32,32};
+		SDL_Rect dstr = {x,y,32,32};
+		SDL_BlitSurface(surf, &srcr, m_renderSurface, &dstr);
+		return;
+	}
+
+	SoftwareBlit blit;
+	if(!clipBlit(blit, surf, 0, 0, x, y, 32, 32))
+		return;
+
+	if(!m_binning)
+	{
+		Sint32 pitch = m_renderSurface->pitch / 4;
+		SDL_BlendSprite(SDL_reinterpret_cast(Uint32*, m_renderSurface->pixels) + (blit.m_y * pitch) + blit.m_x, pitch, blit.m_pixels, blit.m_pitch, blit.m_width, blit.m_height, surf->format->Ashift);
+		return;
+	}
+
+	Uint32 index = SDL_static_cast(Uint32, m_blits.size());
+	m_blits.push_back(blit);
+
+	Sint32 lastColumn = (blit.m_x + blit.m_width - 1) >> SOFTWARE_BIN_SHIFT;
+	Sint32 lastRow = (blit.m_y + blit.m_height - 1) >> SOFTWARE_BIN_SHIFT;
+	for(Sint32 row = (blit.m_y >> SOFTWARE_BIN_SHIFT); row <= lastRow; ++row)
+	{
+		for(Sint32 column = (blit.m_x >> SOFTWARE_BIN_SHIFT); column <= lastColumn; ++column)
+		{
+			Sint32 bin = row * m_binColumns + column;
+			std::vector<Uint32>& binBlits = m_blitBins[bin];
+			if(binBlits.empty())
+				m_activeBins.push_back(bin);
+
+			binBlits.push_back(index);
+		}
+	}
+}
+
+void SurfaceSoftware::compositeBin(Sint32 bin)
+{
+	Sint32 binX = (bin % m_binColumns) << SOFTWARE_BIN_SHIFT;
+	Sint32 binY = (bin / m_binColumns) << SOFTWARE_BIN_SHIFT;
+	Sint32 pitch = m_gameWindow->pitch / 4;
+	Uint32 ashift = m_gameWindow->format->Ashift;
+	Uint32* pixels = SDL_reinterpret_cast(Uint32*, m_gameWindow->pixels);
+
+	std::vector<Uint32>& binBlits = m_blitBins[bin];
+	for(std::vector<Uint32>::iterator it = binBlits.begin(), end = binBlits.end(); it != end; ++it)
+	{
+		const SoftwareBlit& blit = m_blits[*it];
+		Sint32 x1 = UTIL_max<Sint32>(blit.m_x, binX);
+		Sint32 y1 = UTIL_max<Sint32>(blit.m_y, binY);
+		Sint32 x2 = UTIL_min<Sint32>(blit.m_x + blit.m_width, binX + SOFTWARE_BIN_SIZE);
+		Sint32 y2 = UTIL_min<Sint32>(blit.m_y + blit.m_height, binY + SOFTWARE_BIN_SIZE);
+		SDL_BlendSprite(pixels + (y1 * pitch) + x1, pitch, blit.m_pixels + ((y1 - blit.m_y) * blit.m_pitch) + (x1 - blit.m_x), blit.m_pitch, x2 - x1, y2 - y1, ashift);
+	}
+}
+
+static void SOFTWARE_binJob(void* data)
+{
+	SoftwareBinJob* job = SDL_reinterpret_cast(SoftwareBinJob*, data);
+	job->m_surface->compositeBin(job->m_bin);
+}
+
+void SurfaceSoftware::compositeBlits()
+{
+	//Bins don't overlap so every one of them is an independent job
+	JobGroup group;
+	for(std::vector<Sint32>::iterator it = m_activeBins.begin(), end = m_activeBins.end(); it != end; ++it)
+		g_jobSystem.submit(group, SOFTWARE_binJob, SDL_reinterpret_cast(void*, &m_binJobs[*it]));
+	g_jobSystem.wait(group);
+
+	for(std::vector<Sint32>::iterator it = m_activeBins.begin(), end = m_activeBins.end(); it != end; ++it)
+		m_blitBins[*it].clear();
+
+	m_activeBins.clear();
+	m_blits.clear();
 }
 
 SDL_Surface* SurfaceSoftware::createAutomapTile(Uint32 currentArea)
@@ -1051,6 +1218,7 @@ void SurfaceSoftware::drawAutomapTile(Uint32 currentArea, bool& recreate, Uint8
 		}
 	}
 
+	flushBlits();
 	SDL_Rect srcr = {sx,sy,sw,sh};
 	SDL_Rect dstr = {x,y,w,h};
 	SDL_BlitScaled(surf, &srcr, m_renderSurface, &dstr);
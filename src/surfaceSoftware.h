@@ -24,6 +24,9 @@
 
 #include "engine.h"
 
+#define SOFTWARE_BIN_SHIFT 6
+#define SOFTWARE_BIN_SIZE (1 << SOFTWARE_BIN_SHIFT)
+
 struct PictureOptimization
 {
 	PictureOptimization() : m_surface(NULL) {}
@@ -38,15 +41,31 @@ struct PictureOptimization
 
 struct SoftwareSpriteData
 {
-	SoftwareSpriteData() : m_surface(NULL), m_lastUsage(0) {}
+	SoftwareSpriteData() : m_surface(NULL) {}
 
 	SDL_Surface* m_surface;
-	Uint32 m_lastUsage;
+};
+
+//Already clipped sprite blit waiting for the game scene composition
+struct SoftwareBlit
+{
+	const Uint32* m_pixels;
+	Sint32 m_pitch;
+	Sint32 m_x;
+	Sint32 m_y;
+	Sint32 m_width;
+	Sint32 m_height;
+};
+
+class SurfaceSoftware;
+struct SoftwareBinJob
+{
+	SurfaceSoftware* m_surface;
+	Sint32 m_bin;
 };
 
 typedef robin_hood::unordered_map<Uint32, PictureOptimization> U32BOptimizer;
 typedef robin_hood::unordered_map<Uint32, SDL_Surface*> U32BSurfaces;
-typedef robin_hood::unordered_map<Uint64, SoftwareSpriteData> U64BSurfaces;
 
 class SurfaceSoftware : public Surface
 {
@@ -103,16 +122,31 @@ class SurfaceSoftware : public Surface
 		virtual void drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Uint32 outfitColor);
 		virtual void drawSpriteMask(Uint32 spriteId, Uint32 maskSpriteId, Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Uint32 outfitColor);
 
+		bool clipBlit(SoftwareBlit& blit, SDL_Surface* surf, Sint32 sx, Sint32 sy, Sint32 x, Sint32 y, Sint32 w, Sint32 h);
+		void blitScaledSprite(SDL_Surface* surf, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh, Sint32 x, Sint32 y, Sint32 w, Sint32 h);
+		void blitSprite(SDL_Surface* surf, Sint32 x, Sint32 y);
+		void compositeBin(Sint32 bin);
+		SDL_INLINE void flushBlits() {if(!m_blits.empty()) compositeBlits();}
+
 		SDL_Surface* createAutomapTile(Uint32 currentArea);
 		void uploadAutomapTile(SDL_Surface* surface, Uint8 color[256][256]);
 		virtual void drawAutomapTile(Uint32 currentArea, bool& recreate, Uint8 color[256][256], Sint32 x, Sint32 y, Sint32 w, Sint32 h, Sint32 sx, Sint32 sy, Sint32 sw, Sint32 sh);
 
 	protected:
+		void compositeBlits();
+
 		U32BOptimizer m_pictureOptimizations;
 		U32BSurfaces m_automapTiles;
-		U64BSurfaces m_sprites;
+		std::vector<SoftwareSpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
+
+		//Game scene sprites are binned into screen tiles and composited in parallel, in draw order per tile
+		std::vector<SoftwareBlit> m_blits;
+		std::vector<std::vector<Uint32>> m_blitBins;
+		std::vector<SoftwareBinJob> m_binJobs;
+		std::vector<Sint32> m_activeBins;
+		Sint32 m_binColumns = 0;
+		Sint32 m_binRows = 0;
 
 		SDL_Surface** m_pictures = NULL;
 		char* m_hardware = NULL;
@@ -122,16 +156,16 @@ class SurfaceSoftware : public Surface
 		SDL_Surface* m_renderSurface = NULL;
 		SDL_Surface* m_background = NULL;
 		SDL_Surface* m_scaled_gameWindow = NULL;
+		SDL_Surface* m_scaledSprite = NULL;
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_convertFormat = SDL_PIXELFORMAT_UNKNOWN;
 
 		Sint32 m_integer_scaling_width = 0;
 		Sint32 m_integer_scaling_height = 0;
 
 		bool m_useConvertSurface = false;
+		bool m_binning = false;
 };
 
 #endif /* __FILE_SURFACE_SOFTWARE_h_ */
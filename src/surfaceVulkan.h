@@ -140,16 +140,14 @@ struct PushConstant_Sharpen
 
 struct VulkanSpriteData
 {
-	VulkanSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0), m_lastUsage(0) {}
+	VulkanSpriteData() : m_xOffset(0), m_yOffset(0), m_surface(0) {}
 
 	Uint32 m_xOffset;
 	Uint32 m_yOffset;
 	Uint32 m_surface;
-	Uint32 m_lastUsage;
 };
 
 typedef robin_hood::unordered_map<Uint32, VulkanTexture> U32BImages;
-typedef robin_hood::unordered_map<Uint64, VulkanSpriteData> U64BImages;
 
 class SurfaceVulkan : public Surface
 {
@@ -242,9 +240,8 @@ class SurfaceVulkan : public Surface
 	protected:
 		std::vector<VulkanTexture> m_spritesAtlas;
 		U32BImages m_automapTiles;
-		U64BImages m_sprites;
+		std::vector<VulkanSpriteData> m_spriteSlots;
 		std::circular_buffer<Uint32, MAX_AUTOMAPTILES> m_automapTilesBuff;
-		std::circular_buffer<Uint64, MAX_SPRITES> m_spritesIds;
 
 		VulkanTexture* m_pictures = NULL;
 		VulkanTexture m_gameWindow;
@@ -301,8 +298,6 @@ class SurfaceVulkan : public Surface
 		VkCommandBuffer m_commandBuffers[VULKAN_INFLIGHT_FRAMES] = {};
 
 		Uint32 m_totalVRAM = 0;
-		Uint32 m_spriteChecker = 0;
-		Uint32 m_currentFrame = 0;
 		Uint32 m_cachedIndices = 0;
 		Uint32 m_cachedVertices = 0;
 
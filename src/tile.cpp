@@ -24,16 +24,28 @@
 #include "creature.h"
 #include "effect.h"
 #include "thingManager.h"
+#include "spriteManager.h"
+#include "engine.h"
 
-extern std::vector<Effect*> g_effects;
+extern Engine g_engine;
+extern SpriteManager g_spriteManager;
 
 Tile::~Tile()
+{
+	recycle();
+}
+
+void Tile::recycle()
 {
 	for(std::vector<Creature*>::iterator it = m_walkCreatures.begin(), end = m_walkCreatures.end(); it != end; ++it)
 		(*it)->resetDrawnTile();
 	
 	m_walkCreatures.clear();
 	reset();
+
+	m_tileElevation = 0;
+	m_hasTranslucentLight = false;
+	m_lyingCorpses = false;
 }
 
 void Tile::reset()
@@ -56,50 +68,45 @@ void Tile::reset()
 	m_topItems.clear();
 	m_downItems.clear();
 	m_creatures.clear();
+	m_drawCache.clear();
+	invalidateDrawCache();
 	m_effects.clear();
 }
 
-void Tile::render(Sint32 posX, Sint32 posY, bool visible_tile)
+void Tile::render(Sint32 posX, Sint32 posY, bool visible_tile, bool staticLayer)
 {
-	Sint32 displacedItems = 0;
-	m_tileElevation = 0;
-	if(m_ground)
-	{
-		if(visible_tile)
-			m_ground->render(posX, posY, visible_tile);
+	updateDrawCache(visible_tile);
 
-		if(m_ground->hasElevation() && m_tileElevation < ITEM_MAX_ELEVATION)
-		{
-			m_tileElevation = UTIL_min<Sint32>(ITEM_MAX_ELEVATION, m_tileElevation + m_ground->getElevation());
-			visible_tile = true; //Make sure we get drawing everything
-		}
-	}
-
-	for(std::vector<Item*>::iterator it = m_topItems.begin(), end = m_topItems.end(); it != end; ++it)
+	RenderCommandList& renderer = g_engine.getRenderCommands();
+	bool lightEnabled = (g_engine.getLightMode() != CLIENT_LIGHT_MODE_NONE);
+	std::vector<TileDrawCommand>::iterator it = m_drawCache.begin(), end = m_drawCache.end();
+	if(staticLayer)
 	{
-		Item* item = (*it);
-		if(item->getTopOrder() != 3)
+		//The static sprites are already in the floor layer but their lights are needed every frame
+		for(std::vector<TileDrawCommand>::iterator staticEnd = it + m_drawCacheStatic; it != staticEnd; ++it)
 		{
-			item->render(posX - m_tileElevation, posY - m_tileElevation, visible_tile);
-			if(item->hasElevation() && displacedItems < ITEM_MAX_ELEVATION)
-			{
-				m_tileElevation = UTIL_min<Sint32>(ITEM_MAX_ELEVATION, m_tileElevation + item->getElevation());
-				visible_tile = true; //Make sure we get drawing everything
-			}
+			TileDrawCommand& command = (*it);
+			if(command.light && lightEnabled)
+				renderer.addLightSource(posX + command.x, posY + command.y, command.light);
 		}
 	}
 
-	for(std::vector<Item*>::reverse_iterator it = m_downItems.rbegin(), end = m_downItems.rend(); it != end; ++it)
+	for(; it != end; ++it)
 	{
-		Item* item = (*it);
-		item->render(posX - m_tileElevation, posY - m_tileElevation, visible_tile);
-		if(item->hasElevation() && displacedItems < ITEM_MAX_ELEVATION)
+		TileDrawCommand& command = (*it);
+		if(command.item)
+			command.item->render(posX + command.x, posY + command.y, command.visible);
+		else if(command.light)
 		{
-			m_tileElevation = UTIL_min<Sint32>(ITEM_MAX_ELEVATION, m_tileElevation + item->getElevation());
-			visible_tile = true; //Make sure we get drawing everything
+			if(lightEnabled)
+				renderer.addLightSource(posX + command.x, posY + command.y, command.light);
 		}
+		else
+			renderer.drawSprite(command.spriteId, posX + command.x, posY + command.y);
 	}
 
+	m_tileElevation = m_drawCacheElevation;
+	visible_tile = m_drawCacheTopVisible;
 	posX -= m_tileElevation;
 	posY -= m_tileElevation;
 	for(std::vector<Creature*>::reverse_iterator it = m_creatures.rbegin(), end = m_creatures.rend(); it != end; ++it)
@@ -127,14 +134,14 @@ void Tile::render(Sint32 posX, Sint32 posY, bool visible_tile)
 		
 		if(effect->canBeDeleted())
 		{
-			delete effect;
+			renderer.retireEffect(effect);
 			it = m_effects.erase(it);
 		}
 		else
 		{
 			effect->setCachedX(posX);
 			effect->setCachedY(posY);
-			g_effects.push_back(effect);
+			renderer.queueEffect(effect);
 			++it;
 		}
 	}
@@ -147,6 +154,99 @@ void Tile::render(Sint32 posX, Sint32 posY, bool visible_tile)
 	}
 }
 
+void Tile::renderStatic(RenderCommandList& commands, Sint32 posX, Sint32 posY)
+{
+	for(std::vector<TileDrawCommand>::iterator it = m_drawCache.begin(), end = it + m_drawCacheStatic; it != end; ++it)
+	{
+		TileDrawCommand& command = (*it);
+		if(!command.light)
+			commands.drawSprite(command.spriteId, posX, posY);
+	}
+}
+
+bool Tile::updateDrawCache(bool visible_tile)
+{
+	//Ground and items below the creatures only change through the stack functions so draw them from the cache
+	if(!m_drawCacheDirty && m_drawCacheVisible == visible_tile)
+		return false;
+
+	rebuildDrawCache(visible_tile);
+	return true;
+}
+
+void Tile::rebuildDrawCache(bool visible_tile)
+{
+	m_drawCache.clear();
+	m_drawCacheVisible = visible_tile;
+	m_drawCacheDirty = false;
+
+	Sint32 displacedItems = 0;
+	Sint32 tileElevation = 0;
+	if(m_ground)
+	{
+		if(visible_tile)
+		{
+			if(m_ground->isStaticDraw())
+				m_ground->cacheSprites(m_drawCache, 0, 0, visible_tile);
+			else
+				m_drawCache.push_back(TileDrawCommand{m_ground, NULL, 0, 0, 0, visible_tile});
+		}
+
+		if(m_ground->hasElevation() && tileElevation < ITEM_MAX_ELEVATION)
+		{
+			tileElevation = UTIL_min<Sint32>(ITEM_MAX_ELEVATION, tileElevation + m_ground->getElevation());
+			visible_tile = true; //Make sure we get drawing everything
+		}
+	}
+
+	for(std::vector<Item*>::iterator it = m_topItems.begin(), end = m_topItems.end(); it != end; ++it)
+	{
+		Item* item = (*it);
+		if(item->getTopOrder() != 3)
+		{
+			if(item->isStaticDraw())
+				item->cacheSprites(m_drawCache, -tileElevation, -tileElevation, visible_tile);
+			else
+				m_drawCache.push_back(TileDrawCommand{item, NULL, 0, -tileElevation, -tileElevation, visible_tile});
+
+			if(item->hasElevation() && displacedItems < ITEM_MAX_ELEVATION)
+			{
+				tileElevation = UTIL_min<Sint32>(ITEM_MAX_ELEVATION, tileElevation + item->getElevation());
+				visible_tile = true; //Make sure we get drawing everything
+			}
+		}
+	}
+
+	for(std::vector<Item*>::reverse_iterator it = m_downItems.rbegin(), end = m_downItems.rend(); it != end; ++it)
+	{
+		Item* item = (*it);
+		if(item->isStaticDraw())
+			item->cacheSprites(m_drawCache, -tileElevation, -tileElevation, visible_tile);
+		else
+			m_drawCache.push_back(TileDrawCommand{item, NULL, 0, -tileElevation, -tileElevation, visible_tile});
+
+		if(item->hasElevation() && displacedItems < ITEM_MAX_ELEVATION)
+		{
+			tileElevation = UTIL_min<Sint32>(ITEM_MAX_ELEVATION, tileElevation + item->getElevation());
+			visible_tile = true; //Make sure we get drawing everything
+		}
+	}
+
+	m_drawCacheElevation = tileElevation;
+	m_drawCacheTopVisible = visible_tile;
+
+	//Sprites covering exactly our cell before anything animated, displaced or elevated can go to the static layer
+	m_drawCacheStatic = 0;
+	for(std::vector<TileDrawCommand>::iterator it = m_drawCache.begin(), end = m_drawCache.end(); it != end; ++it)
+	{
+		TileDrawCommand& command = (*it);
+		if(command.item || (!command.light && (command.x | command.y) != 0))
+			break;
+
+		++m_drawCacheStatic;
+	}
+}
+
 void Tile::reRenderTile(Sint32 posX, Sint32 posY)
 {
 	posX -= m_tileElevation;
@@ -412,6 +512,7 @@ bool Tile::addThing(Thing* thing, bool insertThing, bool moveCreature)
 	}
 	else if(thing->isItem())
 	{
+		invalidateDrawCache();
 		Item* item = thing->getItem();
 		if(!item->getThingType())
 		{
@@ -500,6 +601,7 @@ bool Tile::insertThing(Thing* thing, Uint32 stackpos)
 	}
 	else if(thing->isItem())
 	{
+		invalidateDrawCache();
 		Item* item = thing->getItem();
 		if(!item->getThingType())
 		{
@@ -588,6 +690,7 @@ bool Tile::removeThing(Thing* thing, bool moveCreature)
 	}
 	else if(thing->isItem())
 	{
+		invalidateDrawCache();
 		bool removed = false;
 		Item* item = thing->getItem();
 		if(item == m_ground)
@@ -846,6 +949,26 @@ void Tile::recacheLyingCorpses()
 	}
 }
 
+void Tile::prefetchSprites()
+{
+	if(m_ground && m_ground->getThingType())
+		g_spriteManager.prefetchSprites(m_ground->getThingType()->m_frameGroup[ThingFrameGroup_Default].m_sprites);
+
+	for(std::vector<Item*>::iterator it = m_topItems.begin(), end = m_topItems.end(); it != end; ++it)
+	{
+		Item* item = (*it);
+		if(item->getThingType())
+			g_spriteManager.prefetchSprites(item->getThingType()->m_frameGroup[ThingFrameGroup_Default].m_sprites);
+	}
+
+	for(std::vector<Item*>::iterator it = m_downItems.begin(), end = m_downItems.end(); it != end; ++it)
+	{
+		Item* item = (*it);
+		if(item->getThingType())
+			g_spriteManager.prefetchSprites(item->getThingType()->m_frameGroup[ThingFrameGroup_Default].m_sprites);
+	}
+}
+
 size_t Tile::getThingCount()
 {
 	return (m_ground ? 1 : 0) + m_topItems.size() + m_downItems.size() + m_creatures.size();
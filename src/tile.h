@@ -30,6 +30,17 @@ class Thing;
 class Item;
 class Creature;
 class Effect;
+class RenderCommandList;
+
+struct TileDrawCommand
+{
+	Item* item;
+	Uint16* light;
+	Uint32 spriteId;
+	Sint32 x;
+	Sint32 y;
+	bool visible;
+};
 
 class Tile
 {
@@ -46,8 +57,13 @@ class Tile
 		Tile& operator=(Tile&&) = delete;
 
 		void reset();
+		void recycle();
 
-		void render(Sint32 posX, Sint32 posY, bool visible_tile);
+		void render(Sint32 posX, Sint32 posY, bool visible_tile, bool staticLayer);
+		void renderStatic(RenderCommandList& commands, Sint32 posX, Sint32 posY);
+		bool updateDrawCache(bool visible_tile);
+		void rebuildDrawCache(bool visible_tile);
+		SDL_INLINE void invalidateDrawCache() {m_drawCacheDirty = true;}
 		void reRenderTile(Sint32 posX, Sint32 posY);
 		void renderInformations(Sint32 posX, Sint32 posY, Sint32 drawX, Sint32 drawY, float scale, bool visible);
 
@@ -81,6 +97,7 @@ class Tile
 
 		void recacheTranslucentLight();
 		void recacheLyingCorpses();
+		void prefetchSprites();
 
 		size_t getThingCount();
 		Uint16 getGroundSpeed();
@@ -88,6 +105,7 @@ class Tile
 		Uint16 getMinimapColor();
 		SDL_INLINE Sint32 getTileElevation() {return m_tileElevation;}
 		SDL_INLINE Position& getPosition() {return m_position;}
+		SDL_INLINE void setPosition(const Position& position) {m_position = position;}
 
 		bool hasground();
 		bool isFullground();
@@ -101,9 +119,15 @@ class Tile
 		std::vector<Creature*> m_creatures;
 		std::vector<Creature*> m_walkCreatures;
 		std::vector<Effect*> m_effects;
+		std::vector<TileDrawCommand> m_drawCache;
 
 		Position m_position;
 		Sint32 m_tileElevation = 0;
+		Sint32 m_drawCacheElevation = 0;
+		Uint32 m_drawCacheStatic = 0;
+		bool m_drawCacheDirty = true;
+		bool m_drawCacheVisible = false;
+		bool m_drawCacheTopVisible = false;
 		bool m_hasTranslucentLight = false;
 		bool m_lyingCorpses = false;
 };
@@ -23,8 +23,14 @@
 #include "engine.h"
 
 #include <random>
+#include <new>
 #ifdef __WIN32__
 #include <Shellapi.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 LPUTIL_Faststrstr UTIL_Faststrstr;
@@ -32,6 +38,8 @@ LPUTIL_FastCopy UTIL_FastCopy;
 LPXTEA_DECRYPT XTEA_decrypt;
 LPXTEA_ENCRYPT XTEA_encrypt;
 LPADLER32CHECKSUM adler32Checksum;
+LPSPRITE_DECODERLE SPRITE_decodeRLE;
+LPOUTFIT_COLORIZE OUTFIT_colorize;
 
 extern Engine g_engine;
 
@@ -468,6 +476,72 @@ std::string SDL_ReadProtobufString(SDL_RWops* src)
 	return str;
 }
 
+unsigned char* UTIL_MapFile(const char* filename, size_t& fileSize)
+{
+	//Read-only view of the whole file - the handles can be closed right away because the view keeps the mapping alive
+	#if defined(__WIN32__)
+	wchar_t wFilename[MAX_PATH];
+	if(MultiByteToWideChar(CP_UTF8, 0, filename, -1, wFilename, MAX_PATH) == 0)
+		return NULL;
+
+	HANDLE hFile = CreateFileW(wFilename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(hFile, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(hFile);
+		return NULL;
+	}
+
+	HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(hFile);
+	if(!hMapping)
+		return NULL;
+
+	void* fileData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(hMapping);
+	if(!fileData)
+		return NULL;
+
+	fileSize = SDL_static_cast(size_t, size.QuadPart);
+	return SDL_reinterpret_cast(unsigned char*, fileData);
+	#else
+	int fd = open(filename, O_RDONLY);
+	if(fd == -1)
+		return NULL;
+
+	struct stat st;
+	if(fstat(fd, &st) == -1 || st.st_size == 0)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	void* fileData = mmap(NULL, SDL_static_cast(size_t, st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(fileData == MAP_FAILED)
+		return NULL;
+
+	fileSize = SDL_static_cast(size_t, st.st_size);
+	return SDL_reinterpret_cast(unsigned char*, fileData);
+	#endif
+}
+
+void UTIL_UnmapFile(unsigned char* fileData, size_t fileSize)
+{
+	if(!fileData)
+		return;
+
+	#if defined(__WIN32__)
+	(void)fileSize;
+	UnmapViewOfFile(fileData);
+	#else
+	munmap(fileData, fileSize);
+	#endif
+}
+
 void UTIL_SetClipboardTextLatin1(const char* clipboardText)
 {
 	char* utf8Text = SDL_iconv_string("UTF-8", "ISO-8859-1", clipboardText, SDL_strlen(clipboardText) + 1);
@@ -602,8 +676,9 @@ StringVector UTIL_explodeString(const std::string& inString, const std::string&
 
 Sint32 UTIL_random(Sint32 min_range, Sint32 max_range)
 {
-	static std::default_random_engine generator(SDL_static_cast(unsigned, time(NULL)));
-	static std::uniform_int_distribution<Sint32> uniformRand;
+	//Animations pick their phases from the scene jobs so every thread needs its own generator
+	static thread_local std::default_random_engine generator(SDL_static_cast(unsigned, time(NULL)) ^ SDL_static_cast(unsigned, SDL_ThreadID()));
+	static thread_local std::uniform_int_distribution<Sint32> uniformRand;
 	if(min_range == max_range)
 		return min_range;
 	else if(min_range > max_range)
@@ -612,6 +687,48 @@ Sint32 UTIL_random(Sint32 min_range, Sint32 max_range)
 	return uniformRand(generator, std::uniform_int_distribution<Sint32>::param_type(min_range, max_range));
 }
 
+#ifdef __ALLOCATION_COUNTER__
+static thread_local Uint64 g_threadAllocations = 0;
+
+Uint64 UTIL_getThreadAllocations()
+{
+	return g_threadAllocations;
+}
+
+void* operator new(size_t size)
+{
+	++g_threadAllocations;
+	void* ptr = SDL_malloc(size > 0 ? size : 1);
+	if(!ptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	++g_threadAllocations;
+	return SDL_malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept {SDL_free(ptr);}
+void operator delete[](void* ptr) noexcept {SDL_free(ptr);}
+void operator delete(void* ptr, size_t) noexcept {SDL_free(ptr);}
+void operator delete[](void* ptr, size_t) noexcept {SDL_free(ptr);}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {SDL_free(ptr);}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {SDL_free(ptr);}
+#endif
+
 Uint16 UTIL_parseModifiers(Uint16 mods)
 {
 	Uint16 result = KMOD_NONE;
@@ -1515,6 +1632,139 @@ void UTIL_FastCopy_SSE41(Uint8* dst, const Uint8* src, size_t size)
 }
 #endif
 
+#if defined(__ALPHA_SPRITES__)
+#define SPRITE_PIXEL_SIZE 4
+#else
+#define SPRITE_PIXEL_SIZE 3
+#endif
+
+static SDL_INLINE void SPRITE_convertPixels_scalar(Uint8* dst, const Uint8* src, size_t pixels, bool bgra)
+{
+	const size_t r = (bgra ? 2 : 0), b = (bgra ? 0 : 2);
+	for(size_t i = 0; i < pixels; ++i)
+	{
+		dst[0] = src[r];
+		dst[1] = src[1];
+		dst[2] = src[b];
+		#if defined(__ALPHA_SPRITES__)
+		dst[3] = src[3];
+		#else
+		dst[3] = SDL_ALPHA_OPAQUE;
+		#endif
+		src += SPRITE_PIXEL_SIZE;
+		dst += 4;
+	}
+}
+
+//Every chunk is [transparent pixels:u16][colored pixels:u16][colored pixels data]
+//Returns the number of colored pixels that fits both in the input and the 32x32 output
+static SDL_INLINE size_t SPRITE_readChunk(const Uint8* data, size_t dataSize, size_t& readData, size_t& writeData)
+{
+	size_t transparentPixels = SDL_static_cast(size_t, data[readData]) | (SDL_static_cast(size_t, data[readData + 1]) << 8);
+	size_t coloredPixels = SDL_static_cast(size_t, data[readData + 2]) | (SDL_static_cast(size_t, data[readData + 3]) << 8);
+	readData += 4;
+
+	writeData += transparentPixels * 4;
+	if(writeData >= 4096)
+		return 0;
+
+	coloredPixels = UTIL_min<size_t>(coloredPixels, (4096 - writeData) / 4);
+	return UTIL_min<size_t>(coloredPixels, (dataSize - readData) / SPRITE_PIXEL_SIZE);
+}
+
+void SPRITE_decodeRLE_scalar(Uint8* pixels, const Uint8* data, size_t dataSize, bool bgra)
+{
+	size_t writeData = 0, readData = 0;
+	while(readData + 4 <= dataSize && writeData < 4096)
+	{
+		size_t coloredPixels = SPRITE_readChunk(data, dataSize, readData, writeData);
+		SPRITE_convertPixels_scalar(pixels + writeData, data + readData, coloredPixels, bgra);
+		readData += coloredPixels * SPRITE_PIXEL_SIZE;
+		writeData += coloredPixels * 4;
+	}
+}
+
+#ifdef __USE_SSSE3__
+void SPRITE_decodeRLE_SSSE3(Uint8* pixels, const Uint8* data, size_t dataSize, bool bgra)
+{
+	#if defined(__ALPHA_SPRITES__)
+	const __m128i shuffleMask = (bgra ? _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15) : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+	const __m128i alphaMask = _mm_setzero_si128();
+	#else
+	const __m128i shuffleMask = (bgra ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1) : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+	const __m128i alphaMask = _mm_set1_epi32(SDL_static_cast(int, 0xFF000000));
+	#endif
+
+	size_t writeData = 0, readData = 0;
+	while(readData + 4 <= dataSize && writeData < 4096)
+	{
+		size_t coloredPixels = SPRITE_readChunk(data, dataSize, readData, writeData);
+		const Uint8* src = data + readData;
+		Uint8* dst = pixels + writeData;
+		readData += coloredPixels * SPRITE_PIXEL_SIZE;
+		writeData += coloredPixels * 4;
+
+		//We always load 16 bytes so make sure we don't read past the input
+		const Uint8* srcEnd = data + dataSize;
+		while(coloredPixels >= 4 && src + 16 <= srcEnd)
+		{
+			const __m128i rgb = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, src));
+			_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffleMask), alphaMask));
+			src += 4 * SPRITE_PIXEL_SIZE;
+			dst += 16;
+			coloredPixels -= 4;
+		}
+		SPRITE_convertPixels_scalar(dst, src, coloredPixels, bgra);
+	}
+}
+#endif
+
+#ifdef __USE_AVX2__
+void SPRITE_decodeRLE_AVX2(Uint8* pixels, const Uint8* data, size_t dataSize, bool bgra)
+{
+	#if defined(__ALPHA_SPRITES__)
+	const __m128i shuffleMask128 = (bgra ? _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15) : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+	const __m256i alphaMask = _mm256_setzero_si256();
+	#else
+	const __m128i shuffleMask128 = (bgra ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1) : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+	const __m256i alphaMask = _mm256_set1_epi32(SDL_static_cast(int, 0xFF000000));
+	#endif
+	const __m256i shuffleMask = _mm256_broadcastsi128_si256(shuffleMask128);
+
+	size_t writeData = 0, readData = 0;
+	while(readData + 4 <= dataSize && writeData < 4096)
+	{
+		size_t coloredPixels = SPRITE_readChunk(data, dataSize, readData, writeData);
+		const Uint8* src = data + readData;
+		Uint8* dst = pixels + writeData;
+		readData += coloredPixels * SPRITE_PIXEL_SIZE;
+		writeData += coloredPixels * 4;
+
+		//Shuffle works on 128-bit lanes so every lane gets its own 4 pixels
+		const Uint8* srcEnd = data + dataSize;
+		while(coloredPixels >= 8 && src + 4 * SPRITE_PIXEL_SIZE + 16 <= srcEnd)
+		{
+			const __m128i lo = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, src));
+			const __m128i hi = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, src + 4 * SPRITE_PIXEL_SIZE));
+			const __m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+			_mm256_storeu_si256(SDL_reinterpret_cast(__m256i*, dst), _mm256_or_si256(_mm256_shuffle_epi8(rgb, shuffleMask), alphaMask));
+			src += 8 * SPRITE_PIXEL_SIZE;
+			dst += 32;
+			coloredPixels -= 8;
+		}
+		while(coloredPixels >= 4 && src + 16 <= srcEnd)
+		{
+			const __m128i rgb = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, src));
+			_mm_storeu_si128(SDL_reinterpret_cast(__m128i*, dst), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffleMask128), _mm256_castsi256_si128(alphaMask)));
+			src += 4 * SPRITE_PIXEL_SIZE;
+			dst += 16;
+			coloredPixels -= 4;
+		}
+		SPRITE_convertPixels_scalar(dst, src, coloredPixels, bgra);
+	}
+}
+#endif
+
 size_t UTIL_Faststrstr_Scalar(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize)
 {
 	if(haystackSize == needleSize)
@@ -1720,6 +1970,147 @@ size_t UTIL_Faststrstr_AVX2(const char* haystack, size_t haystackSize, const cha
 }
 #endif
 
+//Outfit colors from the color table are integer so the old float multiply is always equal to (pixel * color) / 255
+static SDL_INLINE void OUTFIT_buildFactors(Uint32 outfitColor, bool bgra, Uint32 maskColors[4], Uint32 colorFactors[4])
+{
+	static const Uint8 outfitMasks[4][3] =
+	{
+		{0xFF, 0xFF, 0x00},//Head
+		{0xFF, 0x00, 0x00},//Body
+		{0x00, 0xFF, 0x00},//Legs
+		{0x00, 0x00, 0xFF}//Feet
+	};
+
+	const size_t r = (bgra ? 2 : 0), b = (bgra ? 0 : 2);
+	for(Sint32 i = 0; i < 4; ++i)
+	{
+		Uint8 maskColor[4], colorFactor[4];
+		maskColor[r] = outfitMasks[i][0];
+		maskColor[1] = outfitMasks[i][1];
+		maskColor[b] = outfitMasks[i][2];
+		maskColor[3] = SDL_ALPHA_OPAQUE;
+		getOutfitColorRGB(SDL_static_cast(Uint8, outfitColor >> (i * 8)), colorFactor[r], colorFactor[1], colorFactor[b]);
+		colorFactor[3] = 0xFF;
+		SDL_memcpy(&maskColors[i], maskColor, sizeof(Uint32));
+		SDL_memcpy(&colorFactors[i], colorFactor, sizeof(Uint32));
+	}
+}
+
+void OUTFIT_colorize_scalar(Uint8* pixels, const Uint8* mask, Uint32 outfitColor, bool bgra)
+{
+	Uint32 maskColors[4], colorFactors[4];
+	OUTFIT_buildFactors(outfitColor, bgra, maskColors, colorFactors);
+	for(Sint32 i = 0; i < 4096; i += 4)
+	{
+		Uint32 U32pixel;
+		SDL_memcpy(&U32pixel, mask + i, sizeof(Uint32));
+		for(Sint32 j = 0; j < 4; ++j)
+		{
+			if(U32pixel == maskColors[j])
+			{
+				const Uint8* colorFactor = SDL_reinterpret_cast(const Uint8*, &colorFactors[j]);
+				pixels[i] = SDL_static_cast(Uint8, (pixels[i] * colorFactor[0]) / 255);
+				pixels[i + 1] = SDL_static_cast(Uint8, (pixels[i + 1] * colorFactor[1]) / 255);
+				pixels[i + 2] = SDL_static_cast(Uint8, (pixels[i + 2] * colorFactor[2]) / 255);
+				break;
+			}
+		}
+	}
+}
+
+#ifdef __USE_SSE2__
+SDL_FORCE_INLINE __m128i OUTFIT_multiply_SSE2(__m128i pixels, __m128i factors)
+{
+	//(x + 1 + (x >> 8)) >> 8 is exact x / 255 for every product of two bytes
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi16(1);
+	__m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), _mm_unpacklo_epi8(factors, zero));
+	__m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), _mm_unpackhi_epi8(factors, zero));
+	lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+	hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+	return _mm_packus_epi16(lo, hi);
+}
+
+void OUTFIT_colorize_SSE2(Uint8* pixels, const Uint8* mask, Uint32 outfitColor, bool bgra)
+{
+	Uint32 maskColors[4], colorFactors[4];
+	OUTFIT_buildFactors(outfitColor, bgra, maskColors, colorFactors);
+
+	const __m128i headMask = _mm_set1_epi32(SDL_static_cast(int, maskColors[0]));
+	const __m128i bodyMask = _mm_set1_epi32(SDL_static_cast(int, maskColors[1]));
+	const __m128i legsMask = _mm_set1_epi32(SDL_static_cast(int, maskColors[2]));
+	const __m128i feetMask = _mm_set1_epi32(SDL_static_cast(int, maskColors[3]));
+	const __m128i headFactor = _mm_set1_epi32(SDL_static_cast(int, colorFactors[0]));
+	const __m128i bodyFactor = _mm_set1_epi32(SDL_static_cast(int, colorFactors[1]));
+	const __m128i legsFactor = _mm_set1_epi32(SDL_static_cast(int, colorFactors[2]));
+	const __m128i feetFactor = _mm_set1_epi32(SDL_static_cast(int, colorFactors[3]));
+	const __m128i allOnes = _mm_set1_epi32(-1);
+	for(Sint32 i = 0; i < 4096; i += 16)
+	{
+		const __m128i maskPixels = _mm_loadu_si128(SDL_reinterpret_cast(const __m128i*, mask + i));
+		const __m128i isHead = _mm_cmpeq_epi32(maskPixels, headMask);
+		const __m128i isBody = _mm_cmpeq_epi32(maskPixels, bodyMask);
+		const __m128i isLegs = _mm_cmpeq_epi32(maskPixels, legsMask);
+		const __m128i isFeet = _mm_cmpeq_epi32(maskPixels, feetMask);
+		const __m128i anyMask = _mm_or_si128(_mm_or_si128(isHead, isBody), _mm_or_si128(isLegs, isFeet));
+		if(_mm_movemask_epi8(anyMask) == 0)
+			continue;
+
+		//Pixels without mask get multiplied by 255 which leaves them untouched
+		__m128i factors = _mm_or_si128(_mm_and_si128(isHead, headFactor), _mm_and_si128(isBody, bodyFactor));
+		factors = _mm_or_si128(factors, _mm_or_si128(_mm_and_si128(isLegs, legsFactor), _mm_and_si128(isFeet, feetFactor)));
+		factors = _mm_or_si128(factors, _mm_andnot_si128(anyMask, allOnes));
+
+		__m128i* dst = SDL_reinterpret_cast(__m128i*, pixels + i);
+		_mm_storeu_si128(dst, OUTFIT_multiply_SSE2(_mm_loadu_si128(dst), factors));
+	}
+}
+#endif
+
+#ifdef __USE_AVX2__
+void OUTFIT_colorize_AVX2(Uint8* pixels, const Uint8* mask, Uint32 outfitColor, bool bgra)
+{
+	Uint32 maskColors[4], colorFactors[4];
+	OUTFIT_buildFactors(outfitColor, bgra, maskColors, colorFactors);
+
+	const __m256i headMask = _mm256_set1_epi32(SDL_static_cast(int, maskColors[0]));
+	const __m256i bodyMask = _mm256_set1_epi32(SDL_static_cast(int, maskColors[1]));
+	const __m256i legsMask = _mm256_set1_epi32(SDL_static_cast(int, maskColors[2]));
+	const __m256i feetMask = _mm256_set1_epi32(SDL_static_cast(int, maskColors[3]));
+	const __m256i headFactor = _mm256_set1_epi32(SDL_static_cast(int, colorFactors[0]));
+	const __m256i bodyFactor = _mm256_set1_epi32(SDL_static_cast(int, colorFactors[1]));
+	const __m256i legsFactor = _mm256_set1_epi32(SDL_static_cast(int, colorFactors[2]));
+	const __m256i feetFactor = _mm256_set1_epi32(SDL_static_cast(int, colorFactors[3]));
+	const __m256i allOnes = _mm256_set1_epi32(-1);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one = _mm256_set1_epi16(1);
+	for(Sint32 i = 0; i < 4096; i += 32)
+	{
+		const __m256i maskPixels = _mm256_loadu_si256(SDL_reinterpret_cast(const __m256i*, mask + i));
+		const __m256i isHead = _mm256_cmpeq_epi32(maskPixels, headMask);
+		const __m256i isBody = _mm256_cmpeq_epi32(maskPixels, bodyMask);
+		const __m256i isLegs = _mm256_cmpeq_epi32(maskPixels, legsMask);
+		const __m256i isFeet = _mm256_cmpeq_epi32(maskPixels, feetMask);
+		const __m256i anyMask = _mm256_or_si256(_mm256_or_si256(isHead, isBody), _mm256_or_si256(isLegs, isFeet));
+		if(_mm256_movemask_epi8(anyMask) == 0)
+			continue;
+
+		//Pixels without mask get multiplied by 255 which leaves them untouched
+		__m256i factors = _mm256_or_si256(_mm256_and_si256(isHead, headFactor), _mm256_and_si256(isBody, bodyFactor));
+		factors = _mm256_or_si256(factors, _mm256_or_si256(_mm256_and_si256(isLegs, legsFactor), _mm256_and_si256(isFeet, feetFactor)));
+		factors = _mm256_or_si256(factors, _mm256_andnot_si256(anyMask, allOnes));
+
+		__m256i* dst = SDL_reinterpret_cast(__m256i*, pixels + i);
+		const __m256i data = _mm256_loadu_si256(dst);
+		__m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(data, zero), _mm256_unpacklo_epi8(factors, zero));
+		__m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(data, zero), _mm256_unpackhi_epi8(factors, zero));
+		lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, one), _mm256_srli_epi16(lo, 8)), 8);
+		hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, one), _mm256_srli_epi16(hi, 8)), 8);
+		_mm256_storeu_si256(dst, _mm256_packus_epi16(lo, hi));
+	}
+}
+#endif
+
 void UTIL_initSubsystem()
 {
 	{
@@ -1745,21 +2136,35 @@ void UTIL_initSubsystem()
 	XTEA_decrypt = SDL_reinterpret_cast(LPXTEA_DECRYPT, XTEA_decrypt_scalar);
 	XTEA_encrypt = SDL_reinterpret_cast(LPXTEA_ENCRYPT, XTEA_encrypt_scalar);
 	adler32Checksum = SDL_reinterpret_cast(LPADLER32CHECKSUM, adler32Checksum_scalar);
+	SPRITE_decodeRLE = SDL_reinterpret_cast(LPSPRITE_DECODERLE, SPRITE_decodeRLE_scalar);
+	OUTFIT_colorize = SDL_reinterpret_cast(LPOUTFIT_COLORIZE, OUTFIT_colorize_scalar);
 	#ifdef __USE_SSE2__
 	if(SDL_HasSSE2())
 	{
 		XTEA_decrypt = SDL_reinterpret_cast(LPXTEA_DECRYPT, XTEA_decrypt_SSE2);
 		XTEA_encrypt = SDL_reinterpret_cast(LPXTEA_ENCRYPT, XTEA_encrypt_SSE2);
 		adler32Checksum = SDL_reinterpret_cast(LPADLER32CHECKSUM, adler32Checksum_SSE2);
+		OUTFIT_colorize = SDL_reinterpret_cast(LPOUTFIT_COLORIZE, OUTFIT_colorize_SSE2);
 		#ifdef __USE_AVX2__
 		if(SDL_HasAVX2())
 		{
 			XTEA_decrypt = SDL_reinterpret_cast(LPXTEA_DECRYPT, XTEA_decrypt_AVX2);
 			XTEA_encrypt = SDL_reinterpret_cast(LPXTEA_ENCRYPT, XTEA_encrypt_AVX2);
+			OUTFIT_colorize = SDL_reinterpret_cast(LPOUTFIT_COLORIZE, OUTFIT_colorize_AVX2);
 		}
 		#endif
 	}
 	#endif
+	#ifdef __USE_SSSE3__
+	if(SDL_HasSSSE3())
+	{
+		SPRITE_decodeRLE = SDL_reinterpret_cast(LPSPRITE_DECODERLE, SPRITE_decodeRLE_SSSE3);
+		#ifdef __USE_AVX2__
+		if(SDL_HasAVX2())
+			SPRITE_decodeRLE = SDL_reinterpret_cast(LPSPRITE_DECODERLE, SPRITE_decodeRLE_AVX2);
+		#endif
+	}
+	#endif
 	#ifdef __USE_SSE__
 	if(SDL_HasSSE())
 	{
@@ -1772,3 +2177,123 @@ void UTIL_initSubsystem()
 	}
 	#endif
 }
+
+static SDL_INLINE Uint32 UTIL_selfTestRandom(Uint32& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+static Sint32 UTIL_selfTestDecodeRLE(const char* name, LPSPRITE_DECODERLE decodeRLE)
+{
+	Uint8 data[8192];
+	Uint8 expected[4096];
+	Uint8 pixels[4096];
+	Uint32 seed = 0x9E3779B9;
+	Sint32 failures = 0;
+	for(Sint32 i = 0; i < 2000; ++i)
+	{
+		//Odd run lengths exercise the scalar tail after every vector loop
+		size_t dataSize = 0;
+		Uint32 chunks = 1 + (UTIL_selfTestRandom(seed) % 64);
+		for(Uint32 chunk = 0; chunk < chunks && dataSize + 4 + 63 * SPRITE_PIXEL_SIZE <= sizeof(data); ++chunk)
+		{
+			Uint32 transparentPixels = UTIL_selfTestRandom(seed) % 48;
+			Uint32 coloredPixels = UTIL_selfTestRandom(seed) % 64;
+			data[dataSize++] = SDL_static_cast(Uint8, transparentPixels);
+			data[dataSize++] = SDL_static_cast(Uint8, transparentPixels >> 8);
+			data[dataSize++] = SDL_static_cast(Uint8, coloredPixels);
+			data[dataSize++] = SDL_static_cast(Uint8, coloredPixels >> 8);
+			for(Uint32 j = 0; j < coloredPixels * SPRITE_PIXEL_SIZE; ++j)
+				data[dataSize++] = SDL_static_cast(Uint8, UTIL_selfTestRandom(seed));
+		}
+
+		//Truncated input has to stop both decoders at the same pixel
+		if(i & 1)
+			dataSize -= UTIL_selfTestRandom(seed) % UTIL_min<size_t>(dataSize, 64);
+
+		for(Sint32 bgra = 0; bgra < 2; ++bgra)
+		{
+			SDL_memset(expected, 0, sizeof(expected));
+			SDL_memset(pixels, 0, sizeof(pixels));
+			SPRITE_decodeRLE_scalar(expected, data, dataSize, (bgra != 0));
+			decodeRLE(pixels, data, dataSize, (bgra != 0));
+			if(SDL_memcmp(expected, pixels, sizeof(pixels)) != 0)
+				++failures;
+		}
+	}
+
+	SDL_Log("Self-test %s: %s(%d mismatches)", name, (failures == 0 ? "passed" : "FAILED"), failures);
+	return failures;
+}
+
+static Sint32 UTIL_selfTestColorize(const char* name, LPOUTFIT_COLORIZE colorize)
+{
+	Uint8 mask[4096];
+	Uint8 expected[4096];
+	Uint8 pixels[4096];
+	Uint32 seed = 0x2545F491;
+	Sint32 failures = 0;
+	for(Sint32 i = 0; i < 2000; ++i)
+	{
+		//Color bytes past the outfit table check the clamp to the first color
+		Uint32 outfitColor = 0;
+		for(Sint32 j = 0; j < 4; ++j)
+			outfitColor |= (UTIL_selfTestRandom(seed) % 140) << (j * 8);
+
+		for(Sint32 bgra = 0; bgra < 2; ++bgra)
+		{
+			Uint32 maskColors[4], colorFactors[4];
+			OUTFIT_buildFactors(outfitColor, (bgra != 0), maskColors, colorFactors);
+			for(Sint32 j = 0; j < 4096; j += 4)
+			{
+				Uint32 maskPixel;
+				Uint32 kind = UTIL_selfTestRandom(seed) % 6;
+				if(kind < 4)
+					maskPixel = maskColors[kind];
+				else if(kind == 4)
+					maskPixel = maskColors[UTIL_selfTestRandom(seed) % 4] ^ (1 << (UTIL_selfTestRandom(seed) % 32));
+				else
+					maskPixel = UTIL_selfTestRandom(seed);
+
+				SDL_memcpy(mask + j, &maskPixel, sizeof(Uint32));
+				Uint32 pixel = UTIL_selfTestRandom(seed);
+				SDL_memcpy(expected + j, &pixel, sizeof(Uint32));
+			}
+
+			SDL_memcpy(pixels, expected, sizeof(pixels));
+			OUTFIT_colorize_scalar(expected, mask, outfitColor, (bgra != 0));
+			colorize(pixels, mask, outfitColor, (bgra != 0));
+			if(SDL_memcmp(expected, pixels, sizeof(pixels)) != 0)
+				++failures;
+		}
+	}
+
+	SDL_Log("Self-test %s: %s(%d mismatches)", name, (failures == 0 ? "passed" : "FAILED"), failures);
+	return failures;
+}
+
+Sint32 UTIL_selfTestKernels()
+{
+	//Every vectorized kernel has to be bit-exact with its scalar version
+	Sint32 failures = 0;
+	#ifdef __USE_SSSE3__
+	if(SDL_HasSSSE3())
+		failures += UTIL_selfTestDecodeRLE("SPRITE_decodeRLE_SSSE3", SPRITE_decodeRLE_SSSE3);
+	#endif
+	#ifdef __USE_AVX2__
+	if(SDL_HasAVX2())
+		failures += UTIL_selfTestDecodeRLE("SPRITE_decodeRLE_AVX2", SPRITE_decodeRLE_AVX2);
+	#endif
+	#ifdef __USE_SSE2__
+	if(SDL_HasSSE2())
+		failures += UTIL_selfTestColorize("OUTFIT_colorize_SSE2", OUTFIT_colorize_SSE2);
+	#endif
+	#ifdef __USE_AVX2__
+	if(SDL_HasAVX2())
+		failures += UTIL_selfTestColorize("OUTFIT_colorize_AVX2", OUTFIT_colorize_AVX2);
+	#endif
+	return failures;
+}
@@ -60,6 +60,9 @@ Uint32 SDL_ReadProtobufSize(SDL_RWops* src);
 Uint64 SDL_ReadProtobufVariant(SDL_RWops* src);
 std::string SDL_ReadProtobufString(SDL_RWops* src);
 
+unsigned char* UTIL_MapFile(const char* filename, size_t& fileSize);
+void UTIL_UnmapFile(unsigned char* fileData, size_t fileSize);
+
 void UTIL_SetClipboardTextLatin1(const char* clipboardText);
 char* UTIL_GetClipboardTextLatin1();
 
@@ -74,6 +77,9 @@ void UTIL_ResizePanel(void* pPanel, Sint32 x, Sint32 y);
 void UTIL_replaceString(std::string& str, const std::string& sought, const std::string& replacement);
 StringVector UTIL_explodeString(const std::string& inString, const std::string& separator, Sint32 limit = -1);
 Sint32 UTIL_random(Sint32 min_range, Sint32 max_range);
+#ifdef __ALLOCATION_COUNTER__
+Uint64 UTIL_getThreadAllocations();
+#endif
 Uint16 UTIL_parseModifiers(Uint16 mods);
 std::string UTIL_ipv4_tostring(Uint32 ipV4);
 std::string UTIL_formatCreatureName(const std::string& name);
@@ -135,6 +141,7 @@ SDL_FORCE_INLINE bool UTIL_isPartySharedEnabled(Uint8 shield)
 }
 
 void UTIL_initSubsystem();
+Sint32 UTIL_selfTestKernels();
 
 typedef size_t(*LPUTIL_Faststrstr)(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize);
 extern LPUTIL_Faststrstr UTIL_Faststrstr;
@@ -146,5 +153,9 @@ typedef bool(*LPXTEA_ENCRYPT)(Uint8*, size_t, const Uint32*);
 extern LPXTEA_ENCRYPT XTEA_encrypt;
 typedef Uint32(*LPADLER32CHECKSUM)(const Uint8*, size_t);
 extern LPADLER32CHECKSUM adler32Checksum;
+typedef void(*LPSPRITE_DECODERLE)(Uint8*, const Uint8*, size_t, bool);
+extern LPSPRITE_DECODERLE SPRITE_decodeRLE;
+typedef void(*LPOUTFIT_COLORIZE)(Uint8*, const Uint8*, Uint32, bool);
+extern LPOUTFIT_COLORIZE OUTFIT_colorize;
 
 #endif /* __FILE_UTIL_h_ */